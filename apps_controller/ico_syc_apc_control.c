@@ -17,6 +17,7 @@
 #include    <unistd.h>
 #include    <stdbool.h>
 #include    <string.h>
+#include    <strings.h>
 #include    <errno.h>
 #include    <pthread.h>
 #include    <sys/ioctl.h>
@@ -31,6 +32,7 @@
 #include    "ico_apf.h"
 #include    "ico_uxf.h"
 #include    "ico_apf_ecore.h"
+#include    "ico_uxf_conf_ecore.h"
 #include    "ico_syc_apc.h"
 #include    "ico_syc_apc_private.h"
 
@@ -45,20 +47,48 @@ static ico_apc_dispzone_t       *dispzone = NULL;
 static int                      ndispzone = 0;
 static ico_apc_soundzone_t      *soundzone = NULL;
 static int                      nsoundzone = 0;
+static ico_apc_zoneset_t        *dispzoneset = NULL;    /* index of confsys->display  */
+static ico_apc_zoneset_t        *soundzoneset = NULL;   /* index of confsys->sound    */
 static ico_apc_inputsw_t        *inputsw = NULL;
 static int                      ninputsw = 0;
+static ico_apc_inputsw_t        *inputswhash[ICO_UXF_MISC_HASHSIZE];
+                                                        /* input switch by name       */
 
 /* free request save table              */
 static ico_apc_request_t        *free_request = NULL;
 
+/* active application epoch(count up each time application became active)  */
+static unsigned int             active_epoch = 0;
+
+/* request table of each application(hash by application id atom)  */
+#define APPREQ_HASHSIZE 64                      /* Must be 2's factorial            */
+#define APPREQ_HASH(atom)   ((int)(((unsigned long)(atom)) >> 3) & (APPREQ_HASHSIZE-1))
+static ico_apc_apprequest_t     *apprequest[APPREQ_HASHSIZE];
+
 /* user(HomeScreen) control functions   */
 static ico_apc_resource_control_t   displaycontrol = NULL;
 static ico_apc_resource_control_t   soundcontrol = NULL;
 static ico_apc_resource_control_t   inputcontrol = NULL;
 
-/* Ecore timer                          */
-static int  timer_count = 0;
-static Ecore_Timer *ecore_timer = NULL;
+/* batch arbitration(requests in a main loop turn are arbitrated at once)  */
+static int                      batch_mode = 0;
+static Ecore_Idle_Enterer       *batch_idler = NULL;
+static ico_apc_batch_stats_t    batch_stats;
+
+/* staged Multi Sound Manager commands(sent once per main loop turn)     */
+#define SOUNDCTL_HASHSIZE   64                  /* Must be 2's factorial            */
+#define SOUNDCTL_HASH(pid)  ((pid) & (SOUNDCTL_HASHSIZE-1))
+static ico_apc_soundctl_t       *soundctl[SOUNDCTL_HASHSIZE];
+static int                      soundctl_pending = 0;
+static Ecore_Idle_Enterer       *soundctl_idler = NULL;
+static ico_apc_soundctl_stats_t soundctl_stats;
+static int                      soundctl_listed = 0;    /* stream list received */
+static int                      soundctl_untracked = 0; /* stream not in table  */
+
+/* reply deadline queue and Ecore timer(armed to the earliest deadline)   */
+static ico_apc_reqheap_t        replyq;
+static Ecore_Timer              *ecore_timer = NULL;
+static double                   timer_deadline = 0.0;
 
 /* configuration                        */
 static Ico_Uxf_Sys_Config       *confsys = NULL;
@@ -71,26 +101,75 @@ static void resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data
 static void app_getdisplay(ico_apc_request_t *req, const int addprio);
 static void app_freedisplay(ico_apc_request_t *req, const int send);
 static void change_disprequest(ico_apc_request_t *req, const int active);
+static void wait_disprequest(ico_apc_request_t *req, const int lower);
+static void start_disprequest(ico_apc_request_t *req);
 static void recalc_dispzone(const int idx);
 static void app_getsound(ico_apc_request_t *req, const int addprio);
 static void app_freesound(ico_apc_request_t *req, const int send);
 static void change_soundrequest(ico_apc_request_t *req, const int active);
+static void wait_soundrequest(ico_apc_request_t *req);
+static void start_soundrequest(ico_apc_request_t *req);
 static void recalc_soundzone(const int idx);
 static void app_getinput(ico_apc_request_t *req, const int addprio);
 static void app_freeinput(ico_apc_request_t *req, const int send);
 static void change_inputrequest(ico_apc_request_t *req, const int active);
 static void recalc_inputsw(const int idx);
-static void regulation_listener(const int appcategory,
-                                const ico_apc_reguration_control_t control,
+static int search_inputsw(const char *device, const char *swname);
+static void regulation_listener(const ico_apc_regulation_change_t *change,
                                 void *user_data);
 static Eina_Bool request_timer(void *user_data);
+static void arm_replytimer(void);
+static void set_replytimer(ico_apc_request_t *req);
+static void cancel_replytimer(ico_apc_request_t *req);
+static void reply_received(ico_apc_request_t *req);
+static void get_replybounds(const char *appid, int *lower, int *upper, int *category);
+static void update_replystat(ico_apc_replystat_t *stat, const double latency,
+                             const int lower, const int upper);
 static void app_display_hook(const char *appid, const int surface, const int object);
+static void app_defaultdisplay(const Ico_Uxf_conf_application *appconf);
 static ico_apc_request_t *get_freereq(void);
+static void put_freereq(ico_apc_request_t *req);
+static ico_apc_apprequest_t *get_apprequest(const char *appatom, const int create);
+static void link_appreq(ico_apc_request_t *req);
+static ico_apc_request_t *search_samerequest(const ico_apc_request_t *req);
+static void set_zoneoccupied(ico_apc_zoneset_t *zoneset, const int zoneno,
+                             const ico_apc_reqheap_t *heap);
+static ico_apc_zonebits_t calc_activezone(const ico_apc_zoneset_t *zoneset,
+                                          ico_apc_request_t **tops);
+static void get_disptops(const ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops);
+static void get_soundtops(const ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops);
+static void batch_begin(ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops);
+static void batch_step(ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops);
+static void batch_end(ico_apc_zoneset_t *zoneset, const int flips);
+static Eina_Bool batch_flush(void *user_data);
+static ico_apc_soundctl_t *soundctl_get(const int pid);
+static void soundctl_track(const int pid);
+static void soundctl_system(const int pid);
+static int soundctl_stage(const ico_apf_sound_state_e cmd, const int pid);
+static void soundctl_forget(const int pid);
+static int soundctl_send(ico_apc_soundctl_t *ctl);
+static Eina_Bool soundctl_flush(void *user_data);
+static void recalc_changed(void);
 static ico_apc_request_t *search_disprequest(const Ico_Uxf_conf_application *conf,
                                              const int resid, const int id);
 static ico_apc_request_t *search_soundrequest(const Ico_Uxf_conf_application *conf,
                                               const int resid, const int id,
                                               ico_apc_request_t **first_req);
+static int find_dispzone(const Ico_Uxf_Sys_Config *conf,
+                         const Ico_Uxf_conf_display_zone *zone);
+static int find_soundzone(const Ico_Uxf_Sys_Config *conf,
+                          const Ico_Uxf_conf_sound_zone *zone);
+static int make_dispzone(const Ico_Uxf_Sys_Config *conf, ico_apc_dispzone_t **zone,
+                         ico_apc_zoneset_t **zoneset, int *num);
+static void switch_dispzone(const Ico_Uxf_Sys_Config *conf, ico_apc_dispzone_t *newzone,
+                            ico_apc_zoneset_t *newset, const int num, char *changed);
+static int make_soundzone(const Ico_Uxf_Sys_Config *conf, ico_apc_soundzone_t **zone,
+                          ico_apc_zoneset_t **zoneset, int *num);
+static void switch_soundzone(const Ico_Uxf_Sys_Config *conf, ico_apc_soundzone_t *newzone,
+                             ico_apc_zoneset_t *newset, const int num, char *changed);
+static const Ico_Uxf_conf_display_zone *app_dispzone(const Ico_Uxf_conf_application *appconf);
+static int sysconf_update(const Ico_Uxf_Sys_Config *newconf,
+                          const Ico_Uxf_Sys_Config *oldconf);
 
 /*==============================================================================*/
 /* define fixed value                                                           */
@@ -98,20 +177,16 @@ static ico_apc_request_t *search_soundrequest(const Ico_Uxf_conf_application *co
 /* initiale allocate request blocks     */
 #define INIT_REQCB  50
 
-/* maximum number of request blocks     */
-#if ICO_UXF_DISPLAY_ZONE_MAX > ICO_UXF_SOUND_ZONE_MAX
-  #if ICO_UXF_INPUT_SW_MAX > ICO_UXF_DISPLAY_ZONE_MAX
-    #define MAXREQ  ICO_UXF_INPUT_SW_MAX
-  #else
-    #define MAXREQ  ICO_UXF_DISPLAY_ZONE_MAX
-  #endif
-#else
-  #if ICO_UXF_INPUT_SW_MAX > ICO_UXF_SOUND_ZONE_MAX
-    #define MAXREQ  ICO_UXF_INPUT_SW_MAX
-  #else
-    #define MAXREQ  ICO_UXF_SOUND_ZONE_MAX
-  #endif
-#endif
+/* kind of request resource            */
+#define REQ_IS_DISPLAY(req) (((req)->resid == ICO_APF_RESID_BASIC_SCREEN) ||    \
+                             ((req)->resid == ICO_APF_RESID_INT_SCREEN) ||      \
+                             ((req)->resid == ICO_APF_RESID_ON_SCREEN))
+#define REQ_IS_SOUND(req)   (((req)->resid == ICO_APF_RESID_BASIC_SOUND) ||     \
+                             ((req)->resid == ICO_APF_RESID_INT_SOUND))
+#define REQ_IS_INPUT(req)   ((req)->resid == ICO_APF_RESID_INPUT_DEV)
+
+/* zone of zone number in same display or sound(zones are continuous in table) */
+#define ZONEOF(czone, no)   ((czone) - (czone)->zoneno + (no))
 
 /*--------------------------------------------------------------------------*/
 /**
@@ -170,220 +245,924 @@ get_freereq(void)
         }
     }
     req = free_request;
-    memset(req, 0, sizeof(ico_apc_request_t));
     free_request = free_request->next;
+    memset(req, 0, sizeof(ico_apc_request_t));
+    req->hidx = -1;
+    req->tidx = -1;
 
     return req;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   search_disprequest: search client display request(static function)
+ * @brief   put_freereq: release request block(static function)
  *
- * @param[in]   conf            application configuration
- * @param[in]   resid           resource type
- * @param[in]   id              resource id requested from client
- * @return      result
- * @retval      != NULL         success(request block)
- * @retval      == NULL         error(request was not found)
+ * @param[in]   req             request block(already removed from zone table)
+ * @return      none
  */
 /*--------------------------------------------------------------------------*/
-static ico_apc_request_t *
-search_disprequest(const Ico_Uxf_conf_application *conf, const int resid, const int id)
+static void
+put_freereq(ico_apc_request_t *req)
 {
-    int                 i;
-    ico_apc_request_t   *p;
-    ico_apc_request_t   *sameres = NULL;
+    ico_apc_apprequest_t    *app = req->app;
 
-    for (i = 0; i < ndispzone; i++) {
-        p = dispzone[i].req;
-        while (p)   {
-            if ((strcmp(p->appid, conf->appid) == 0) &&
-                ((int)p->resid == resid))    {
-                if ((id < 0) || (p->id == id))  {
-                    return p;
-                }
-                if (! sameres)  sameres = p;
-            }
-            p = p->next;
+    /* stop reply wait          */
+    cancel_replytimer(req);
+
+    /* remove from request list of application  */
+    if (app)    {
+        if (req->appprev)   {
+            req->appprev->appnext = req->appnext;
+        }
+        else    {
+            app->req = req->appnext;
+        }
+        if (req->appnext)   {
+            req->appnext->appprev = req->appprev;
         }
+        app->nreq --;
+        req->app = NULL;
     }
-    return sameres;
+    req->next = free_request;
+    free_request = req;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   search_soundrequest: search client sound request(static function)
+ * @brief   get_apprequest: get request table of application(static function)
  *
- * @param[in]   conf            application configuration
- * @param[in]   resid           resource type
- * @param[in]   id              resource id requested from client
- * @param[out]  first_req       request of top on same sound zone
+ * @param[in]   appatom         application id(interned atom)
+ * @param[in]   create          create if not exist(1=create/0=search only)
  * @return      result
- * @retval      != NULL         success(request block)
- * @retval      == NULL         error(request was not found)
+ * @retval      != NULL         success(application request table)
+ * @retval      == NULL         application has no request(or out of memory)
  */
 /*--------------------------------------------------------------------------*/
-static ico_apc_request_t *
-search_soundrequest(const Ico_Uxf_conf_application *conf, const int resid,
-                    const int id, ico_apc_request_t **first_req)
+static ico_apc_apprequest_t *
+get_apprequest(const char *appatom, const int create)
 {
-    int                 i;
-    ico_apc_request_t   *p;
-    ico_apc_request_t   *sameres = NULL;
+    ico_apc_apprequest_t    *app;
+    int     hash;
 
-    for (i = 0; i < nsoundzone; i++) {
-        p = soundzone[i].req;
-        while (p)   {
-            if ((strcmp(p->appid, conf->appid) == 0) &&
-                ((int)p->resid == resid))    {
-                if ((id < 0) || (p->id == id))  {
-                    if (first_req)  {
-                        *first_req = soundzone[i].req;
-                    }
-                    return p;
-                }
-                if (! sameres)  sameres = p;
-            }
-            p = p->next;
+    hash = APPREQ_HASH(appatom);
+    for (app = apprequest[hash]; app; app = app->next)  {
+        if (app->appatom == appatom)    {
+            return app;
         }
     }
-    return sameres;
+    if (! create)   {
+        return NULL;
+    }
+    app = malloc(sizeof(ico_apc_apprequest_t));
+    if (! app)  {
+        apfw_error("get_apprequest: No Memory");
+        return NULL;
+    }
+    memset(app, 0, sizeof(ico_apc_apprequest_t));
+    app->appatom = appatom;
+    app->next = apprequest[hash];
+    apprequest[hash] = app;
+
+    return app;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   resource_reqcb: resource request callback(static function)
+ * @brief   link_appreq: link request to request list of application
+ *          (static function)
  *
- * @param[in]   info            request information
- * @param[in]   user_data       user data(unused)
+ * @param[in]   req             request block(linked to zone table)
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 static void
-resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
+link_appreq(ico_apc_request_t *req)
 {
-    Ico_Uxf_conf_application    *appconf;
-    ico_apc_request_t           *req;
-    ico_apc_request_t           *p;
-    ico_apc_request_t           *freq;
-    int                         i;
-    int                         count;
-    ico_apc_request_t           *reqsave[MAXREQ];
-
-    apfw_trace("resource_reqcb: Entry(cmd=%d res=%d id=%d bid=%d app=%s[%d])",
-               info->state, info->resid, info->id, info->bid, info->appid, info->pid);
+    ico_apc_apprequest_t    *app;
 
-    if (info->state == ICO_APF_RESOURCE_STATE_CONNECTED)    {
-        apfw_trace("resource_reqcb: Leave(application connected)");
+    if (req->app)   {
+        /* already linked       */
+        return;
+    }
+    app = get_apprequest(req->appatom, 1);
+    if (! app)  {
         return;
     }
+    req->app = app;
+    req->appprev = NULL;
+    req->appnext = app->req;
+    if (app->req)   {
+        app->req->appprev = req;
+    }
+    app->req = req;
+    app->nreq ++;
+}
 
-    if (info->state >= ICO_APF_SOUND_COMMAND_MIN)   {
-        /* Multi Sound Manager, data check          */
-        if ((int)info->state == (int)ICO_APF_SOUND_REPLY_LIST)  {
-            apfw_trace("resource_reqcb: Leave(Sound Reply, no need)");
-            return;
-        }
-        if (info->appid[0] == 0)    {
-            apfw_warn("resource_reqcb: Leave(Sound Event, but no appid)");
-            return;
-        }
-        if ((int)info->state == (int)ICO_APF_SOUND_EVENT_FREE)  {
-            apfw_trace("resource_reqcb: Leave(Sound Free, no need)");
-            return;
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   search_samerequest: search same request(same application, resource
+ *          and zone) in request list of application(static function)
+ *
+ * @param[in]   req             request block(not linked)
+ * @return      result
+ * @retval      != NULL         same request
+ * @retval      == NULL         no same request
+ */
+/*--------------------------------------------------------------------------*/
+static ico_apc_request_t *
+search_samerequest(const ico_apc_request_t *req)
+{
+    ico_apc_apprequest_t    *app;
+    ico_apc_request_t       *p;
+
+    app = get_apprequest(req->appatom, 0);
+    for (p = (app ? app->req : NULL); p; p = p->appnext)    {
+        if ((p != req) && (p->resid == req->resid) && (p->zoneidx == req->zoneidx)) {
+            return p;
         }
     }
+    return NULL;
+}
 
-    /* check and search application id      */
-    appconf = (Ico_Uxf_conf_application *)ico_uxf_getAppByAppid(info->appid);
-    if (! appconf)  {
-        /* application id dose not exist, search application name   */
-        appconf = (Ico_Uxf_conf_application *)ico_uxf_getAppByName(info->appid);
-        if (! appconf)  {
-            apfw_error("resource_reqcb: Leave(appid[%s] dose not exist)",
-                       info->appid);
-            return;
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   set_zoneoccupied: set occupied bit of a zone after its request
+ *          queue was changed(static function)
+ *
+ * @param[in]   zoneset         zones of the display or sound
+ * @param[in]   zoneno          zone number in the display or sound
+ * @param[in]   heap            request priority queue of the zone
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+set_zoneoccupied(ico_apc_zoneset_t *zoneset, const int zoneno,
+                 const ico_apc_reqheap_t *heap)
+{
+    if (heap->num > 0)  {
+        zoneset->occupied |= ICO_APC_ZONEBIT(zoneno);
+    }
+    else    {
+        zoneset->occupied &= ~ICO_APC_ZONEBIT(zoneno);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   calc_activezone: calculate active(visible or sounding) zones of
+ *          a display or sound. zone of higher priority request is active and
+ *          hides its overlap zones(static function)
+ *
+ * @param[in]   zoneset         zones of the display or sound
+ * @param[in]   tops            top request of each occupied zone(index is zone number)
+ * @return      active zones
+ */
+/*--------------------------------------------------------------------------*/
+static ico_apc_zonebits_t
+calc_activezone(const ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops)
+{
+    int     order[ICO_UXF_DISPLAY_ZONE_MAX];
+    int     num;
+    int     i, j;
+    ico_apc_zonebits_t  bits;
+    ico_apc_zonebits_t  active;
+    ico_apc_zonebits_t  hidden;
+
+    /* sort occupied zones by priority of top request   */
+    num = 0;
+    for (bits = zoneset->occupied; bits; bits &= (bits - 1))    {
+        i = ffs((int)bits) - 1;
+        for (j = num; j > 0; j--)   {
+            if (ico_syc_apc_reqheap_cmp(tops[order[j-1]], tops[i]) > 0) break;
+            order[j] = order[j-1];
         }
+        order[j] = i;
+        num ++;
     }
-    if ((info->state >= ICO_APF_SOUND_COMMAND_MIN) &&
-        ((confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_ALMIGHTY) ||
-         (confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_SYSTEM) ||
-         (confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_SYSTEM_AUDIO)))  {
-        /* System Program(ex. HomeScreen) no need resource control  */
-        apfw_trace("resource_reqcb: Leave(appid[%s] is system program)",
-                   info->appid);
-        return;
+
+    /* higher priority zone hides overlap zones         */
+    active = 0;
+    hidden = 0;
+    for (i = 0; i < num; i++)   {
+        if (hidden & ICO_APC_ZONEBIT(order[i])) continue;
+        active |= ICO_APC_ZONEBIT(order[i]);
+        hidden |= zoneset->overlap[order[i]];
     }
+    return active;
+}
 
-    if (info->state == ICO_APF_RESOURCE_STATE_DISCONNECTED) {
-        apfw_trace("resource_reqcb: DISCONNECTED[%s]", info->appid);
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   get_disptops: get top request of each occupied zone of a display
+ *          (static function)
+ *
+ * @param[in]   zoneset         zones of the display
+ * @param[out]  tops            top request of each occupied zone(index is zone number)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+get_disptops(const ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops)
+{
+    ico_apc_zonebits_t  bits;
+    int     i;
 
-        /* free all screen request from this application    */
-        count = 0;
-        for (i = 0; i < ndispzone; i++) {
-            p = dispzone[i].req;
-            while (p)   {
-                if (strcmp(p->appid, appconf->appid) == 0) {
-                    reqsave[count++] = p;
-                }
-                p = p->next;
-            }
-        }
-        for (i = 0; i < count; i++) {
-            app_freedisplay(reqsave[i], 0);
-        }
-        /* free all sound request from this application     */
-        count = 0;
-        for (i = 0; i < nsoundzone; i++)    {
-            p = soundzone[i].req;
-            while (p)   {
-                if (strcmp(p->appid, appconf->appid) == 0) {
-                    reqsave[count++] = p;
-                }
-                p = p->next;
-            }
+    for (bits = zoneset->occupied; bits; bits &= (bits - 1))    {
+        i = ffs((int)bits) - 1;
+        tops[i] = ICO_APC_REQHEAP_TOP(&dispzone[zoneset->zonebase + i].heap);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   get_soundtops: get top request of each occupied zone of a sound
+ *          (static function)
+ *
+ * @param[in]   zoneset         zones of the sound
+ * @param[out]  tops            top request of each occupied zone(index is zone number)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+get_soundtops(const ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops)
+{
+    ico_apc_zonebits_t  bits;
+    int     i;
+
+    for (bits = zoneset->occupied; bits; bits &= (bits - 1))    {
+        i = ffs((int)bits) - 1;
+        tops[i] = ICO_APC_REQHEAP_TOP(&soundzone[zoneset->zonebase + i].heap);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   batch_begin: start batch arbitration of a display or sound before
+ *          its requests are changed, and schedule arbitration at the end of
+ *          this main loop turn(static function)
+ *
+ * @param[in]   zoneset         zones of the display or sound
+ * @param[in]   tops            top request of each occupied zone(before change)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+batch_begin(ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops)
+{
+    ico_apc_zonebits_t  bits;
+    int     i;
+
+    batch_stats.requests ++;
+    if (! batch_idler)  {
+        batch_idler = ecore_idle_enterer_add(batch_flush, NULL);
+        if (! batch_idler)  {
+            apfw_warn("batch_begin: can not add idle enterer");
         }
-        for (i = 0; i < count; i++) {
-            app_freesound(reqsave[i], 0);
+    }
+    if (zoneset->batch) return;
+
+    /* arbitration result before this main loop turn    */
+    zoneset->batch = 1;
+    zoneset->vflips = 0;
+    zoneset->vactive = calc_activezone(zoneset, tops);
+    for (bits = zoneset->vactive; bits; bits &= (bits - 1)) {
+        i = ffs((int)bits) - 1;
+        zoneset->vtop[i] = tops[i];
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   batch_step: count show/hide changes that would be made by this
+ *          request without batch arbitration(static function)
+ *
+ * @param[in]   zoneset         zones of the display or sound
+ * @param[in]   tops            top request of each occupied zone(after change)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+batch_step(ico_apc_zoneset_t *zoneset, ico_apc_request_t **tops)
+{
+    ico_apc_zonebits_t  bits;
+    ico_apc_zonebits_t  active;
+    int     i;
+
+    active = calc_activezone(zoneset, tops);
+    for (bits = active | zoneset->vactive; bits; bits &= (bits - 1))    {
+        i = ffs((int)bits) - 1;
+        if ((active & zoneset->vactive & ICO_APC_ZONEBIT(i)) == 0)  {
+            /* zone is shown or hidden                  */
+            zoneset->vflips ++;
         }
-        /* free all input switch request from this application*/
-        count = 0;
-        for (i = 0; i < ninputsw; i++)  {
-            p = inputsw[i].req;
-            while (p)   {
-                if (strcmp(p->appid, appconf->appid) == 0) {
-                    reqsave[count++] = p;
-                }
-                p = p->next;
-            }
+        else if (tops[i] != zoneset->vtop[i])   {
+            /* top request of zone is replaced(hide and show)  */
+            zoneset->vflips += 2;
         }
-        for (i = 0; i < count; i++) {
-            app_freeinput(reqsave[i], 0);
+        if (active & ICO_APC_ZONEBIT(i))    {
+            zoneset->vtop[i] = tops[i];
         }
-        apfw_trace("resource_reqcb: Leave");
-        return;
     }
+    zoneset->vactive = active;
+}
 
-    req = get_freereq();
-    if (! req)  {
-        return;
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   batch_end: end batch arbitration of a display or sound
+ *          (static function)
+ *
+ * @param[in]   zoneset         zones of the display or sound
+ * @param[in]   flips           number of emitted show/hide changes
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+batch_end(ico_apc_zoneset_t *zoneset, const int flips)
+{
+    if (! zoneset->batch)   return;
+
+    zoneset->batch = 0;
+    batch_stats.recalcs ++;
+    batch_stats.flips += flips;
+    if (zoneset->vflips > flips)    {
+        batch_stats.avoided += zoneset->vflips - flips;
     }
-    strncpy(req->appid, appconf->appid, ICO_UXF_MAX_PROCESS_NAME);
-    req->resid = info->resid;
-    if (info->device[0])    {
-        strcpy(req->device, info->device);
+    apfw_trace("batch_end: flips=%d(without batch %d) total avoided=%d",
+               flips, zoneset->vflips, batch_stats.avoided);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   batch_flush: arbitrate requests of this main loop turn at once
+ *          (Ecore idle enterer, static function)
+ *
+ * @param[in]   user_data       user data(unused)
+ * @return      always ECORE_CALLBACK_CANCEL(one shot)
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+batch_flush(void *user_data)
+{
+    apfw_trace("batch_flush: Enter");
+    batch_idler = NULL;
+    recalc_changed();
+    apfw_trace("batch_flush: Leave");
+    return ECORE_CALLBACK_CANCEL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   soundctl_get: get staged state of a stream(static function)
+ *
+ * @param[in]   pid             process id of stream
+ * @return      staged state
+ * @retval      !=NULL          success(staged state, created if not exist)
+ * @retval      ==NULL          error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static ico_apc_soundctl_t *
+soundctl_get(const int pid)
+{
+    ico_apc_soundctl_t  *ctl;
+
+    for (ctl = soundctl[SOUNDCTL_HASH(pid)]; ctl; ctl = ctl->next)  {
+        if (ctl->pid == pid)    return ctl;
+    }
+    ctl = malloc(sizeof(ico_apc_soundctl_t));
+    if (! ctl)  {
+        apfw_error("soundctl_get: No Memory");
+        return NULL;
+    }
+    ctl->pid = pid;
+    ctl->want = ICO_APC_SOUNDCTL_UNKNOWN;
+    ctl->sent = ICO_APC_SOUNDCTL_UNKNOWN;
+    ctl->retry = 0;
+    ctl->next = soundctl[SOUNDCTL_HASH(pid)];
+    soundctl[SOUNDCTL_HASH(pid)] = ctl;
+    return ctl;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   soundctl_track: register a stream that Multi Sound Manager reported,
+ *          all stream command is used only while all streams are registered
+ *          (static function)
+ *
+ * @param[in]   pid             process id of stream
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+soundctl_track(const int pid)
+{
+    if ((pid <= 0) || (! soundctl_get(pid)))    {
+        if (! soundctl_untracked)   {
+            apfw_warn("soundctl_track: stream(pid=%d) is not registered, "
+                      "all stream command is not used", pid);
+        }
+        soundctl_untracked = 1;
     }
-    else    {
-        strcpy(req->device, "UnKnown");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   soundctl_system: register a stream of system program, it is never
+ *          muted, so all stream mute is followed by unmute of it
+ *          (static function)
+ *
+ * @param[in]   pid             process id of stream
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+soundctl_system(const int pid)
+{
+    ico_apc_soundctl_t  *ctl;
+
+    if (pid <= 0)   return;
+
+    ctl = soundctl_get(pid);
+    if (! ctl)  {
+        soundctl_untracked = 1;
     }
-    req->id = info->id;
-    req->bid = info->bid;
-    req->pid = info->pid;
-    req->reqtype = ICO_APC_REQTYPE_REQUEST;
+    else if (ctl->want == ICO_APC_SOUNDCTL_UNKNOWN) {
+        ctl->want = ICO_APC_SOUNDCTL_PLAY;
+        ctl->sent = ICO_APC_SOUNDCTL_PLAY;
+    }
+}
 
-    switch (info->resid)    {
-    case ICO_APF_RESID_BASIC_SCREEN:                /* basic screen             */
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   soundctl_stage: stage mute/unmute command of a stream, commands are
+ *          sent at the end of this main loop turn(static function)
+ *
+ * @param[in]   cmd             ICO_APF_SOUND_COMMAND_MUTEON or MUTEOFF
+ * @param[in]   pid             process id of stream
+ * @return      result
+ * @retval      ICO_APF_RESOURCE_E_NONE         success
+ * @retval      others          error(not staged command was sent and failed)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+soundctl_stage(const ico_apf_sound_state_e cmd, const int pid)
+{
+    ico_apc_soundctl_t  *ctl;
+    int     want;
+
+    if (pid <= 0)   {
+        /* stream is not known, no need to stage    */
+        return ico_apf_resource_send_to_soundctl(cmd, pid);
+    }
+    want = (cmd == ICO_APF_SOUND_COMMAND_MUTEON) ?
+                ICO_APC_SOUNDCTL_MUTE : ICO_APC_SOUNDCTL_PLAY;
+
+    ctl = soundctl_get(pid);
+    if (! ctl)  {
+        soundctl_untracked = 1;
+        return ico_apf_resource_send_to_soundctl(cmd, pid);
+    }
+    soundctl_stats.staged ++;
+    if (ctl->want == want)  {
+        /* same as staged(or sent) command  */
+        return ICO_APF_RESOURCE_E_NONE;
+    }
+    if (ctl->want != ctl->sent) {
+        /* opposite command in this turn, cancel it */
+        soundctl_pending --;
+        soundctl_stats.cancelled ++;
+        apfw_trace("soundctl_stage: pid=%d %s cancelled", pid,
+                   (want == ICO_APC_SOUNDCTL_MUTE) ? "unmute" : "mute");
+    }
+    ctl->want = want;
+    ctl->retry = 0;
+    if (ctl->want != ctl->sent) {
+        soundctl_pending ++;
+    }
+
+    if ((soundctl_pending > 0) && (! soundctl_idler))   {
+        soundctl_idler = ecore_idle_enterer_add(soundctl_flush, NULL);
+        if (! soundctl_idler)   {
+            apfw_warn("soundctl_stage: can not add idle enterer, send now");
+            (void) soundctl_flush(NULL);
+        }
+    }
+    return ICO_APF_RESOURCE_E_NONE;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   soundctl_forget: release staged state of a destroyed stream
+ *          (static function)
+ *
+ * @param[in]   pid             process id of stream
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+soundctl_forget(const int pid)
+{
+    ico_apc_soundctl_t  *ctl;
+    ico_apc_soundctl_t  *bctl = NULL;
+
+    if (pid <= 0)   return;
+
+    for (ctl = soundctl[SOUNDCTL_HASH(pid)]; ctl; ctl = ctl->next)  {
+        if (ctl->pid == pid)    break;
+        bctl = ctl;
+    }
+    if (! ctl)  return;
+
+    if (ctl->want != ctl->sent) {
+        soundctl_pending --;
+    }
+    if (bctl)   {
+        bctl->next = ctl->next;
+    }
+    else    {
+        soundctl[SOUNDCTL_HASH(pid)] = ctl->next;
+    }
+    free(ctl);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   soundctl_send: send staged command of a stream(static function)
+ *          failed command is left staged and sent again at next flush, after
+ *          ICO_APC_SOUNDCTL_RETRY failures the state of stream is unknown.
+ *
+ * @param[in]   ctl             staged state of stream
+ * @return      result
+ * @retval      ICO_APF_RESOURCE_E_NONE         success
+ * @retval      others          error(command is still staged or given up)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+soundctl_send(ico_apc_soundctl_t *ctl)
+{
+    int     ret;
+
+    ret = ico_apf_resource_send_to_soundctl(
+                (ctl->want == ICO_APC_SOUNDCTL_MUTE) ?
+                    ICO_APF_SOUND_COMMAND_MUTEON : ICO_APF_SOUND_COMMAND_MUTEOFF,
+                ctl->pid);
+    soundctl_stats.sent ++;
+    if (ret == ICO_APF_RESOURCE_E_NONE) {
+        ctl->sent = ctl->want;
+        ctl->retry = 0;
+        return ret;
+    }
+    ctl->retry ++;
+    if (ctl->retry < ICO_APC_SOUNDCTL_RETRY)    {
+        apfw_warn("soundctl_send: send MSM Error(pid=%d), retry(%d)",
+                  ctl->pid, ctl->retry);
+    }
+    else    {
+        /* give up, next command of the stream is always sent   */
+        apfw_error("soundctl_send: send MSM Error(pid=%d), give up", ctl->pid);
+        ctl->want = ICO_APC_SOUNDCTL_UNKNOWN;
+        ctl->sent = ICO_APC_SOUNDCTL_UNKNOWN;
+        ctl->retry = 0;
+    }
+    return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   soundctl_flush: send net result of staged sound commands of this
+ *          main loop turn(Ecore idle enterer, static function)
+ *          if most streams are changed to same state, all stream command and
+ *          commands of remaining streams are sent(only while all streams
+ *          are registered). failed commands are sent at next main loop turn.
+ *
+ * @param[in]   user_data       user data(unused)
+ * @return      always ECORE_CALLBACK_CANCEL(one shot)
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+soundctl_flush(void *user_data)
+{
+    ico_apc_soundctl_t  *ctl;
+    int     nmute = 0;
+    int     nplay = 0;
+    int     bulk = ICO_APC_SOUNDCTL_UNKNOWN;
+    int     i;
+
+    apfw_trace("soundctl_flush: Enter(pending=%d)", soundctl_pending);
+    soundctl_idler = NULL;
+    if (soundctl_pending <= 0)  {
+        apfw_trace("soundctl_flush: Leave(no command)");
+        return ECORE_CALLBACK_CANCEL;
+    }
+
+    if ((soundctl_listed) && (! soundctl_untracked) &&
+        (soundctl_pending >= ICO_APC_SOUNDCTL_BULKMIN))    {
+        for (i = 0; i < SOUNDCTL_HASHSIZE; i++) {
+            for (ctl = soundctl[i]; ctl; ctl = ctl->next)   {
+                if (ctl->want == ICO_APC_SOUNDCTL_MUTE) nmute ++;
+                else                                    nplay ++;
+            }
+        }
+        /* all stream command and commands of exceptions are fewer  */
+        if ((1 + nplay) < soundctl_pending) {
+            bulk = ICO_APC_SOUNDCTL_MUTE;
+        }
+        else if ((1 + nmute) < soundctl_pending)    {
+            bulk = ICO_APC_SOUNDCTL_PLAY;
+        }
+    }
+    if (bulk != ICO_APC_SOUNDCTL_UNKNOWN)   {
+        apfw_trace("soundctl_flush: %s all streams(mute=%d play=%d pending=%d)",
+                   (bulk == ICO_APC_SOUNDCTL_MUTE) ? "mute" : "unmute",
+                   nmute, nplay, soundctl_pending);
+        if (ico_apf_resource_send_to_soundctl(
+                    (bulk == ICO_APC_SOUNDCTL_MUTE) ?
+                        ICO_APF_SOUND_COMMAND_ALLMUTEON : ICO_APF_SOUND_COMMAND_ALLMUTEOFF,
+                    0) != ICO_APF_RESOURCE_E_NONE)  {
+            /* send command of each stream  */
+            apfw_warn("soundctl_flush: send MSM Error, send each stream");
+            bulk = ICO_APC_SOUNDCTL_UNKNOWN;
+        }
+        else    {
+            soundctl_stats.bulk ++;
+        }
+    }
+    soundctl_pending = 0;
+    for (i = 0; i < SOUNDCTL_HASHSIZE; i++) {
+        for (ctl = soundctl[i]; ctl; ctl = ctl->next)   {
+            if (bulk != ICO_APC_SOUNDCTL_UNKNOWN)   {
+                ctl->sent = bulk;
+            }
+            if ((ctl->want != ctl->sent) &&
+                (soundctl_send(ctl) != ICO_APF_RESOURCE_E_NONE) &&
+                (ctl->want != ctl->sent))   {
+                /* send again at next main loop turn    */
+                soundctl_pending ++;
+            }
+        }
+    }
+    if ((soundctl_pending > 0) && (! soundctl_idler))   {
+        soundctl_idler = ecore_idle_enterer_add(soundctl_flush, NULL);
+        if (! soundctl_idler)   {
+            apfw_warn("soundctl_flush: can not add idle enterer");
+        }
+    }
+    apfw_trace("soundctl_flush: Leave(pending=%d)", soundctl_pending);
+    return ECORE_CALLBACK_CANCEL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   recalc_changed: recalculate displays, sounds and input switchs
+ *          that has changed request(static function)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+recalc_changed(void)
+{
+    int     i, j;
+    int     idx;
+    int     flag;
+
+    for (i = 0; i < confsys->displayNum; i++)   {
+        flag = 0;
+        for (j = 0; j < confsys->display[i].zoneNum; j++)   {
+            idx = confsys->display[i].zone[j].zoneidx;
+            if (dispzone[idx].change)   {
+                /* change flags are cleared by recalc_dispzone  */
+                flag ++;
+                break;
+            }
+        }
+        if (flag)   {
+            recalc_dispzone(confsys->display[i].id);
+        }
+    }
+    for (i = 0; i < confsys->soundNum; i++) {
+        flag = 0;
+        for (j = 0; j < confsys->sound[i].zoneNum; j++) {
+            idx = confsys->sound[i].zone[j].zoneidx;
+            if (soundzone[idx].change)  {
+                /* change flags are cleared by recalc_soundzone */
+                flag ++;
+                break;
+            }
+        }
+        if (flag)   {
+            recalc_soundzone(confsys->sound[i].id);
+        }
+    }
+    for (i = 0; i < ninputsw; i++)  {
+        if (inputsw[i].change)  {
+            inputsw[i].change = 0;
+            recalc_inputsw(i);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   search_disprequest: search client display request(static function)
+ *
+ * @param[in]   conf            application configuration
+ * @param[in]   resid           resource type
+ * @param[in]   id              resource id requested from client
+ * @return      result
+ * @retval      != NULL         success(request block)
+ * @retval      == NULL         error(request was not found)
+ */
+/*--------------------------------------------------------------------------*/
+static ico_apc_request_t *
+search_disprequest(const Ico_Uxf_conf_application *conf, const int resid, const int id)
+{
+    ico_apc_apprequest_t    *app;
+    ico_apc_request_t       *p;
+    ico_apc_request_t       *sameres = NULL;
+
+    app = get_apprequest(conf->appid, 0);
+    if (! app)  {
+        return NULL;
+    }
+    for (p = app->req; p; p = p->appnext)   {
+        if (((int)p->resid == resid) && (REQ_IS_DISPLAY(p)))   {
+            if ((id < 0) || (p->id == id))  {
+                return p;
+            }
+            if (! sameres)  sameres = p;
+        }
+    }
+    return sameres;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   search_soundrequest: search client sound request(static function)
+ *
+ * @param[in]   conf            application configuration
+ * @param[in]   resid           resource type
+ * @param[in]   id              resource id requested from client
+ * @param[out]  first_req       request of top on same sound zone
+ * @return      result
+ * @retval      != NULL         success(request block)
+ * @retval      == NULL         error(request was not found)
+ */
+/*--------------------------------------------------------------------------*/
+static ico_apc_request_t *
+search_soundrequest(const Ico_Uxf_conf_application *conf, const int resid,
+                    const int id, ico_apc_request_t **first_req)
+{
+    ico_apc_apprequest_t    *app;
+    ico_apc_request_t       *p;
+    ico_apc_request_t       *sameres = NULL;
+
+    app = get_apprequest(conf->appid, 0);
+    if (! app)  {
+        return NULL;
+    }
+    for (p = app->req; p; p = p->appnext)   {
+        if (((int)p->resid == resid) && (REQ_IS_SOUND(p)))    {
+            if ((id < 0) || (p->id == id))  {
+                if (first_req)  {
+                    *first_req = ICO_APC_REQHEAP_TOP(&soundzone[p->zoneidx].heap);
+                }
+                return p;
+            }
+            if (! sameres)  sameres = p;
+        }
+    }
+    return sameres;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   resource_reqcb: resource request callback(static function)
+ *
+ * @param[in]   info            request information
+ * @param[in]   user_data       user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
+{
+    Ico_Uxf_conf_application    *appconf;
+    ico_apc_request_t           *req;
+    ico_apc_request_t           *p;
+    ico_apc_request_t           *freq;
+    ico_apc_request_t           *next;
+    ico_apc_apprequest_t        *app;
+
+    apfw_trace("resource_reqcb: Entry(cmd=%d res=%d id=%d bid=%d app=%s[%d])",
+               info->state, info->resid, info->id, info->bid, info->appid, info->pid);
+
+    if (info->state == ICO_APF_RESOURCE_STATE_CONNECTED)    {
+        apfw_trace("resource_reqcb: Leave(application connected)");
+        return;
+    }
+
+    if (info->state >= ICO_APF_SOUND_COMMAND_MIN)   {
+        /* Multi Sound Manager, data check          */
+        if ((int)info->state == (int)ICO_APF_SOUND_REPLY_LIST)  {
+            /* stream created before AppsController started(pid 0: no stream)  */
+            if (info->pid > 0)  {
+                soundctl_track(info->pid);
+            }
+            soundctl_listed = 1;
+            apfw_trace("resource_reqcb: Leave(Sound Reply List)");
+            return;
+        }
+        if ((int)info->state == (int)ICO_APF_SOUND_EVENT_FREE)  {
+            soundctl_forget(info->pid);
+            apfw_trace("resource_reqcb: Leave(Sound Free, no need)");
+            return;
+        }
+        if ((int)info->state == (int)ICO_APF_SOUND_EVENT_NEW)   {
+            /* all stream command affects streams of any application    */
+            soundctl_track(info->pid);
+        }
+        if (info->appid[0] == 0)    {
+            apfw_warn("resource_reqcb: Leave(Sound Event, but no appid)");
+            return;
+        }
+    }
+
+    /* check and search application id      */
+    appconf = (Ico_Uxf_conf_application *)ico_uxf_getAppByAppid(info->appid);
+    if (! appconf)  {
+        /* application id dose not exist, search application name   */
+        appconf = (Ico_Uxf_conf_application *)ico_uxf_getAppByName(info->appid);
+        if (! appconf)  {
+            apfw_error("resource_reqcb: Leave(appid[%s] dose not exist)",
+                       info->appid);
+            return;
+        }
+    }
+    if ((info->state >= ICO_APF_SOUND_COMMAND_MIN) &&
+        ((confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_ALMIGHTY) ||
+         (confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_SYSTEM) ||
+         (confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_SYSTEM_AUDIO)))  {
+        /* System Program(ex. HomeScreen) no need resource control  */
+        if ((int)info->state == (int)ICO_APF_SOUND_EVENT_NEW)   {
+            soundctl_system(info->pid);
+        }
+        apfw_trace("resource_reqcb: Leave(appid[%s] is system program)",
+                   info->appid);
+        return;
+    }
+
+    if (info->state == ICO_APF_RESOURCE_STATE_DISCONNECTED) {
+        apfw_trace("resource_reqcb: DISCONNECTED[%s]", info->appid);
+
+        app = get_apprequest(appconf->appid, 0);
+        if (app)    {
+            /* free all screen request from this application    */
+            for (p = app->req; p; p = next) {
+                next = p->appnext;
+                if (REQ_IS_DISPLAY(p))  {
+                    app_freedisplay(p, 0);
+                }
+            }
+            /* free all sound request from this application     */
+            for (p = app->req; p; p = next) {
+                next = p->appnext;
+                if (REQ_IS_SOUND(p))    {
+                    app_freesound(p, 0);
+                }
+            }
+            /* free all input switch request from this application*/
+            for (p = app->req; p; p = next) {
+                next = p->appnext;
+                if (REQ_IS_INPUT(p))    {
+                    app_freeinput(p, 0);
+                }
+            }
+        }
+        apfw_trace("resource_reqcb: Leave");
+        return;
+    }
+
+    req = get_freereq();
+    if (! req)  {
+        return;
+    }
+    strncpy(req->appid, appconf->appid, ICO_UXF_MAX_PROCESS_NAME);
+    req->appatom = appconf->appid;
+    req->resid = info->resid;
+    if (info->device[0])    {
+        strcpy(req->device, info->device);
+    }
+    else    {
+        strcpy(req->device, "UnKnown");
+    }
+    req->id = info->id;
+    req->bid = info->bid;
+    req->pid = info->pid;
+    req->reqtype = ICO_APC_REQTYPE_REQUEST;
+
+    switch (info->resid)    {
+    case ICO_APF_RESID_BASIC_SCREEN:                /* basic screen             */
         switch (info->state)    {
         case ICO_APF_RESOURCE_COMMAND_GET:          /* get resource             */
             apfw_trace("resource_reqcb: app(%s) get BasicScreen(%d)",
@@ -394,8 +1173,11 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
         case ICO_APF_RESOURCE_COMMAND_RELEASE:      /* release resource         */
             apfw_trace("resource_reqcb: app(%s) release BasicScreen(%d)",
                        info->appid, info->id);
-            app_freedisplay(req, 1);
-            req = NULL;
+            /* release the request that was got(req is only a release command) */
+            p = search_disprequest(appconf, ICO_APF_RESID_BASIC_SCREEN, info->id);
+            if ((p) && (p->id == info->id)) {
+                app_freedisplay(p, 1);
+            }
             break;
         case ICO_APF_RESOURCE_REPLY_OK:             /* ack reply                */
         case ICO_APF_RESOURCE_REPLY_NG:             /* nak reply                */
@@ -411,7 +1193,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
                     }
                 }
                 p->state &= ~(ICO_APC_REQSTATE_REPLYACTIVE|ICO_APC_REQSTATE_REPLYQUIET);
-                p->timer = 0;
+                reply_received(p);
             }
             break;
         default:
@@ -430,8 +1212,11 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
         case ICO_APF_RESOURCE_COMMAND_RELEASE:      /* release resource         */
             apfw_trace("resource_reqcb: app(%s) release IntScreen(%d)",
                        info->appid, info->id);
-            app_freedisplay(req, 1);
-            req = NULL;
+            /* release the request that was got(req is only a release command) */
+            p = search_disprequest(appconf, ICO_APF_RESID_INT_SCREEN, info->id);
+            if ((p) && (p->id == info->id)) {
+                app_freedisplay(p, 1);
+            }
             break;
         case ICO_APF_RESOURCE_REPLY_OK:             /* ack reply                */
         case ICO_APF_RESOURCE_REPLY_NG:             /* nak reply                */
@@ -447,7 +1232,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
                     }
                 }
                 p->state &= ~(ICO_APC_REQSTATE_REPLYACTIVE|ICO_APC_REQSTATE_REPLYQUIET);
-                p->timer = 0;
+                reply_received(p);
             }
             break;
         default:
@@ -466,8 +1251,11 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
         case ICO_APF_RESOURCE_COMMAND_RELEASE:      /* release resource         */
             apfw_trace("resource_reqcb: app(%s) release OnScreen(%d)",
                        info->appid, info->id);
-            app_freedisplay(req, 1);
-            req = NULL;
+            /* release the request that was got(req is only a release command) */
+            p = search_disprequest(appconf, ICO_APF_RESID_ON_SCREEN, info->id);
+            if ((p) && (p->id == info->id)) {
+                app_freedisplay(p, 1);
+            }
             break;
         case ICO_APF_RESOURCE_REPLY_OK:             /* ack reply                */
         case ICO_APF_RESOURCE_REPLY_NG:             /* nak reply                */
@@ -483,7 +1271,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
                     }
                 }
                 p->state &= ~(ICO_APC_REQSTATE_REPLYACTIVE|ICO_APC_REQSTATE_REPLYQUIET);
-                p->timer = 0;
+                reply_received(p);
             }
             break;
         default:
@@ -502,8 +1290,11 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
         case ICO_APF_RESOURCE_COMMAND_RELEASE:      /* release resource         */
             apfw_trace("resource_reqcb: app(%s) release BasicSound(%d)",
                        info->appid, info->id);
-            app_freesound(req, 1);
-            req = NULL;
+            /* release the request that was got(req is only a release command) */
+            p = search_soundrequest(appconf, ICO_APF_RESID_BASIC_SOUND, info->id, NULL);
+            if ((p) && (p->id == info->id)) {
+                app_freesound(p, 1);
+            }
             break;
         case ICO_APF_RESOURCE_REPLY_OK:             /* ack reply                */
         case ICO_APF_RESOURCE_REPLY_NG:             /* nak reply                */
@@ -512,8 +1303,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
             p = search_soundrequest(appconf, ICO_APF_RESID_BASIC_SOUND, info->id, NULL);
             if (p)  {
                 if (p->state & ICO_APC_REQSTATE_REPLYACTIVE)    {
-                    if (ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_MUTEOFF,
-                                                          p->pid)
+                    if (soundctl_stage(ICO_APF_SOUND_COMMAND_MUTEOFF, p->pid)
                             != ICO_APF_RESOURCE_E_NONE) {
                         apfw_warn("resource_reqcb: send MSM Error");
                     }
@@ -522,7 +1312,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
                     }
                 }
                 p->state &= ~(ICO_APC_REQSTATE_REPLYACTIVE|ICO_APC_REQSTATE_REPLYQUIET);
-                p->timer = 0;
+                reply_received(p);
             }
             break;
         case ICO_APF_SOUND_EVENT_NEW:               /* create new sound stream  */
@@ -534,8 +1324,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
                            p->pid, info->pid);
                 p->pid = info->pid;
                 if (p->state & ICO_APC_REQSTATE_WAITREQ)    {
-                    if (ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_MUTEON,
-                                                          p->pid)
+                    if (soundctl_stage(ICO_APF_SOUND_COMMAND_MUTEON, p->pid)
                             != ICO_APF_RESOURCE_E_NONE) {
                         apfw_warn("resource_reqcb: send MSM Error");
                     }
@@ -543,8 +1332,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
                         (*soundcontrol)(get_appconf(p->appid), 0);
                     }
                     if ((freq->state & ICO_APC_REQSTATE_WAITREQ) == 0)  {
-                        if (ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_MUTEOFF,
-                                                              freq->pid)
+                        if (soundctl_stage(ICO_APF_SOUND_COMMAND_MUTEOFF, freq->pid)
                                     != ICO_APF_RESOURCE_E_NONE) {
                             apfw_warn("resource_reqcb: send MSM Error");
                         }
@@ -581,8 +1369,11 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
         case ICO_APF_RESOURCE_COMMAND_RELEASE:      /* release resource         */
             apfw_trace("resource_reqcb: app(%s) release IntSound(%d)",
                        info->appid, info->id);
-            app_freesound(req, 1);
-            req = NULL;
+            /* release the request that was got(req is only a release command) */
+            p = search_soundrequest(appconf, ICO_APF_RESID_INT_SOUND, info->id, NULL);
+            if ((p) && (p->id == info->id)) {
+                app_freesound(p, 1);
+            }
             break;
         case ICO_APF_RESOURCE_REPLY_OK:             /* ack reply                */
         case ICO_APF_RESOURCE_REPLY_NG:             /* nak reply                */
@@ -591,8 +1382,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
             p = search_soundrequest(appconf, ICO_APF_RESID_INT_SOUND, info->id, NULL);
             if (p)  {
                 if (p->state & ICO_APC_REQSTATE_REPLYACTIVE)    {
-                    if (ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_MUTEOFF,
-                                                          p->pid)
+                    if (soundctl_stage(ICO_APF_SOUND_COMMAND_MUTEOFF, p->pid)
                             != ICO_APF_RESOURCE_E_NONE) {
                         apfw_warn("resource_reqcb: send MSM Error");
                     }
@@ -601,7 +1391,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
                     }
                 }
                 p->state &= ~(ICO_APC_REQSTATE_REPLYACTIVE|ICO_APC_REQSTATE_REPLYQUIET);
-                p->timer = 0;
+                reply_received(p);
             }
             break;
         default:
@@ -645,8 +1435,7 @@ resource_reqcb(ico_apf_resource_notify_info_t* info, void *user_data)
         break;
     }
     if (req)    {
-        req->next = free_request;
-        free_request = req;
+        put_freereq(req);
     }
     apfw_trace("resource_reqcb: Leave");
 }
@@ -668,29 +1457,22 @@ app_getdisplay(ico_apc_request_t *req, const int addprio)
     Ico_Uxf_conf_application    *conf = (Ico_Uxf_conf_application *)get_appconf(req->appid);
     Ico_Uxf_conf_display_zone   *zone;
     ico_apc_dispzone_t          *czone;
+    ico_apc_zonebits_t          bits;
+    ico_apc_request_t           *tops[ICO_UXF_DISPLAY_ZONE_MAX];
     ico_apc_request_t           *p;
-    ico_apc_request_t           *bp;
+    ico_apc_request_t           *top;
+    ico_apc_request_t           *next;
 
     /* priority     */
-    prio = getpriority(PRIO_PROCESS, req->pid);
-    if (prio > 19)          prio = 19;
-    else if (prio < -20)    prio = -20;
+    prio = ico_uxf_process_priority(conf->appid, req->pid);
     prio = confsys->category[conf->categoryId].priority * ICO_UXF_PRIO_CATEGORY + 19 - prio;
     prio += addprio;
     if (ico_syc_apc_regulation_app_visible(conf->categoryId))   {
         prio |= ICO_UXF_PRIO_REGULATION;
     }
     if (ico_uxf_process_is_active(conf->appid)) {
-        for (i = 0; i < ndispzone; i++) {
-            p = dispzone[i].req;
-            while (p)   {
-                if (p->prio & ICO_UXF_PRIO_ACTIVEAPP)  {
-                    p->prio -= ICO_UXF_PRIO_ACTIVECOUNT;
-                }
-                p = p->next;
-            }
-        }
-        prio |= ICO_UXF_PRIO_ACTIVEAPP;
+        /* newest active application, other active applications are aged by epoch */
+        req->actepoch = ++active_epoch;
     }
 
     /* get display zone from device name        */
@@ -713,67 +1495,71 @@ app_getdisplay(ico_apc_request_t *req, const int addprio)
     zone = czone->conf;
 
     /* search same request          */
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if ((strcmp(p->appid, req->appid) == 0) && (p->resid == req->resid) &&
-            (p->zoneidx == req->zoneidx))   {
-            break;
-        }
-        bp = p;
-        p = p->next;
+    req->prio = prio;
+    p = search_samerequest(req);
+    if ((p) && (p->reqtype != ICO_APC_REQTYPE_REQUEST)) {
+        apfw_trace("app_getdisplay: Leave(found same request)");
+        put_freereq(req);
+        return;
+    }
+    if (batch_mode) {
+        /* batch arbitration, arbitration result before this request    */
+        get_disptops(czone->zoneset, tops);
+        batch_begin(czone->zoneset, tops);
+        czone->change = 1;
     }
     if (p)  {
-        if (p->reqtype != ICO_APC_REQTYPE_REQUEST)  {
-            apfw_trace("app_getdisplay: Leave(found same request)");
-            return;
-        }
-
-        if (p->prio > prio) {
-            prio = p->prio;
+        if (ico_syc_apc_reqheap_cmp(p, req) > 0)    {
+            req->prio = p->prio;
+            req->actepoch = p->actepoch;
         }
         apfw_trace("app_getdisplay: found same request(app=%s zone=%s res=%d prio=%d)",
-                   conf->appid, dispzone[i].conf->name, req->resid, prio);
-        if (bp) {
-            bp->next = p->next;
-        }
-        else    {
-            czone->req = p->next;
-        }
-        p->next = free_request;
-        free_request = p;
+                   conf->appid, dispzone[i].conf->name, req->resid, req->prio);
+        ico_syc_apc_reqheap_del(&czone->heap, p);
+        put_freereq(p);
     }
 
     /* link request to zone table   */
-    req->prio = prio;
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if (p->prio <= prio)    break;
-        bp = p;
-        p = p->next;
-    }
-    if (bp) {
-        req->next = bp->next;
-        bp->next = req;
-        apfw_trace("app_getdisplay: app(%s) set after(%s) of zone(%s)",
-                   conf->appid, bp->appid, req->device);
+    if (ico_syc_apc_reqheap_add(&czone->heap, req) != ICO_SYC_EOK)  {
+        apfw_trace("app_getdisplay: Leave(No Memory)");
+        put_freereq(req);
+        set_zoneoccupied(czone->zoneset, czone->zoneno, &czone->heap);
+        return;
+    }
+    link_appreq(req);
+    set_zoneoccupied(czone->zoneset, czone->zoneno, &czone->heap);
+    if (batch_mode) {
+        /* answer and show/hide at the end of this main loop turn   */
+        req->state |= (ICO_APC_REQSTATE_WAITREQ|ICO_APC_REQSTATE_NEWREQ);
+        get_disptops(czone->zoneset, tops);
+        batch_step(czone->zoneset, tops);
+        if (! batch_idler)  {
+            recalc_changed();
+        }
+        apfw_trace("app_getdisplay: Leave(batch)");
+        return;
+    }
+    top = ICO_APC_REQHEAP_TOP(&czone->heap);
+    next = ico_syc_apc_reqheap_next(&czone->heap);
+    if (top != req) {
+        apfw_trace("app_getdisplay: app(%s) lower than(%s) of zone(%s)",
+                   conf->appid, top->appid, req->device);
     }
     else    {
-        req->next = czone->req;
-        czone->req = req;
         apfw_trace("app_getdisplay: app(%s) set top of zone(%s) next %s",
-                   conf->appid, req->device, req->next ? req->next->appid : "(NULL)");
+                   conf->appid, req->device, next ? next->appid : "(NULL)");
     }
 
     /* check if maximum priority    */
-    if (! bp)   {
+    if (top == req) {
         j = -1;
-        for (i = 0; i < czone->noverlap; i++)    {
-            if (((czone->overlap[i])->req != NULL) &&
-                ((czone->overlap[i])->req->prio > prio))    {
+        for (bits = czone->zoneset->overlap[czone->zoneno] & czone->zoneset->occupied;
+             bits; bits &= (bits - 1))  {
+            i = ffs((int)bits) - 1;
+            p = ICO_APC_REQHEAP_TOP(&ZONEOF(czone, i)->heap);
+            if (ico_syc_apc_reqheap_cmp(p, top) > 0)    {
                 j = i;
-                prio = czone->overlap[i]->req->prio;
+                top = p;
             }
         }
     }
@@ -782,77 +1568,25 @@ app_getdisplay(ico_apc_request_t *req, const int addprio)
     }
     if ((j >= 0) || ((req->prio & ICO_UXF_PRIO_REGULATION) == 0))   {
         /* lower priority, waitting this application.           */
-        /* insert application to zone application list and      */
-        /* change zone priority, if request application is top priority */
-        req->state |= ICO_APC_REQSTATE_WAITREQ;
-        if (j >= 0) {
-            /* lower priority       */
-            apfw_trace("app_getdisplay: priority low, waitting %s", conf->appid);
-            ico_uxf_window_control(conf->appid, req->id, ICO_UXF_APPSCTL_INVISIBLE, 1);
-            if (displaycontrol) {
-                (*displaycontrol)(conf, 0);
-            }
-        }
-        if ((req->prio & ICO_UXF_PRIO_REGULATION) == 0) {
-            /* regulation control   */
-            apfw_trace("app_getdisplay: regulation, waitting %s", conf->appid);
-            ico_uxf_window_control(conf->appid, req->id, ICO_UXF_APPSCTL_REGULATION, 1);
-            if ((j < 0) && (displaycontrol)) {
-                (*displaycontrol)(conf, 0);
-            }
-        }
-        if (req->reqtype == ICO_APC_REQTYPE_REQUEST)    {
-            if (ico_apf_resource_send_to_client(
-                    conf->appid, ICO_APF_RESOURCE_STATE_WAITTING,
-                    req->resid, req->device, req->id) != ICO_APF_RESOURCE_E_NONE)   {
-                apfw_warn("app_getdisplay: Leave(send(%s) Error)", conf->appid);
-            }
-            else    {
-                req->state &= ~ICO_APC_REQSTATE_REPLYACTIVE;
-                req->state |= ICO_APC_REQSTATE_REPLYQUIET;
-                req->timer = ICO_APC_REQREPLY_MAXTIME;
-                timer_count ++;
-            }
-        }
+        wait_disprequest(req, (j >= 0));
     }
     else    {
         /* maximum priority, ok             */
         apfw_trace("app_getdisplay: priority heigh");
-        if (req->reqtype == ICO_APC_REQTYPE_REQUEST)    {
-            if (ico_apf_resource_send_to_client(
-                        conf->appid, ICO_APF_RESOURCE_STATE_ACQUIRED,
-                        req->resid, req->device, req->id) != ICO_APF_RESOURCE_E_NONE) {
-                apfw_warn("app_getdisplay: Leave(send(%s) Error)", conf->appid);
-                ico_uxf_window_control(conf->appid, req->id, ICO_UXF_APPSCTL_INVISIBLE, 0);
-                if (displaycontrol) {
-                    (*displaycontrol)(conf, 1);
-                }
-            }
-            else    {
-                req->state &= ~ICO_APC_REQSTATE_REPLYQUIET;
-                req->state |= ICO_APC_REQSTATE_REPLYACTIVE;
-                req->timer = ICO_APC_REQREPLY_MAXTIME;
-                timer_count ++;
-            }
-        }
-        else    {
-            ico_uxf_window_control(conf->appid, req->id, ICO_UXF_APPSCTL_INVISIBLE, 0);
-            if (displaycontrol) {
-                (*displaycontrol)(conf, 1);
-            }
-        }
+        start_disprequest(req);
+
         /* send change event to invisible application   */
         apfw_trace("app_getdisplay: next=%08x %s next_state=%x",
-                   req->next, req->next ? req->next->appid : " ",
-                   req->next ? req->next->state : 0x9999);
-        if ((req->next) && ((req->next->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
-            p = req->next;
+                   (int)next, next ? next->appid : " ",
+                   next ? next->state : 0x9999);
+        if ((next) && ((next->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
+            p = next;
         }
         else    {
             p = NULL;
         }
         /* send all waitting applications   */
-        i = 0;
+        bits = czone->zoneset->overlap[czone->zoneno] & czone->zoneset->occupied;
         while (1)   {
             if (p != NULL)  {
                 if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0)   {
@@ -867,8 +1601,7 @@ app_getdisplay(ico_apc_request_t *req, const int addprio)
                         else    {
                             req->state &= ~ICO_APC_REQSTATE_REPLYACTIVE;
                             p->state |= ICO_APC_REQSTATE_REPLYQUIET;
-                            p->timer = ICO_APC_REQREPLY_MAXTIME;
-                            timer_count ++;
+                            set_replytimer(p);
                         }
                     }
                     ico_uxf_window_control(p->appid, -1, ICO_UXF_APPSCTL_INVISIBLE, 1);
@@ -877,9 +1610,10 @@ app_getdisplay(ico_apc_request_t *req, const int addprio)
                     }
                 }
             }
-            if (i >= czone->noverlap)   break;
-            p = czone->overlap[i]->req;
-            i ++;
+            if (! bits) break;
+            i = ffs((int)bits) - 1;
+            bits &= (bits - 1);
+            p = ICO_APC_REQHEAP_TOP(&ZONEOF(czone, i)->heap);
         }
     }
     apfw_trace("app_getdisplay: Leave");
@@ -900,8 +1634,8 @@ app_freedisplay(ico_apc_request_t *req, const int send)
     int     idx;
     Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
     ico_apc_dispzone_t          *czone;
-    ico_apc_request_t           *p;
-    ico_apc_request_t           *bp;
+    ico_apc_request_t           *tops[ICO_UXF_DISPLAY_ZONE_MAX];
+    int                         top;
 
     apfw_trace("app_freedisplay: Entry(app=%s)", req->appid);
 
@@ -919,31 +1653,38 @@ app_freedisplay(ico_apc_request_t *req, const int send)
     }
 
     /* find request                     */
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if (p == req)   break;
-        bp = p;
-        p = p->next;
-    }
-    if (! p)    {
+    if (! ICO_APC_REQHEAP_LINKED(&czone->heap, req))    {
         apfw_warn("app_freedisplay: Leave(request dose not exist)");
         return;
     }
 
-    /* release request table from zone table    */
-    if (bp) {
-        bp->next = p->next;
+    if (batch_mode) {
+        /* batch arbitration, arbitration result before this request    */
+        get_disptops(czone->zoneset, tops);
+        batch_begin(czone->zoneset, tops);
+        czone->change = 1;
+    }
 
+    /* release request table from zone table    */
+    top = (ICO_APC_REQHEAP_TOP(&czone->heap) == req);
+    ico_syc_apc_reqheap_del(&czone->heap, req);
+    put_freereq(req);
+    set_zoneoccupied(czone->zoneset, czone->zoneno, &czone->heap);
+    if (batch_mode) {
+        /* show/hide at the end of this main loop turn  */
+        get_disptops(czone->zoneset, tops);
+        batch_step(czone->zoneset, tops);
+        if (! batch_idler)  {
+            recalc_changed();
+        }
+        apfw_trace("app_freedisplay: Leave(batch)");
+        return;
+    }
+    if (! top)  {
         /* request is waitted, no need other control*/
-        p->next = free_request;
-        free_request = p;
         apfw_trace("app_freedisplay: Leave(request waited)");
         return;
     }
-    czone->req = p->next;
-    p->next = free_request;
-    free_request = p;
 
     /* recalculate visible zone         */
     recalc_dispzone(idx);
@@ -979,8 +1720,7 @@ change_disprequest(ico_apc_request_t *req, const int active)
         else    {
             req->state |= (active ? ICO_APC_REQSTATE_REPLYACTIVE :
                                     ICO_APC_REQSTATE_REPLYQUIET);
-            req->timer = ICO_APC_REQREPLY_MAXTIME;
-            timer_count ++;
+            set_replytimer(req);
         }
     }
     if ((req->state & ICO_APC_REQSTATE_REPLYACTIVE) == 0)   {
@@ -998,6 +1738,92 @@ change_disprequest(ico_apc_request_t *req, const int active)
     }
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   wait_disprequest: answer waitting to a new display zone request
+ *          (static function)
+ *
+ * @param[in]   req             request block
+ * @param[in]   lower           priority is lower than other request(1) or
+ *                              only regulated(0)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+wait_disprequest(ico_apc_request_t *req, const int lower)
+{
+    Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
+
+    req->state |= ICO_APC_REQSTATE_WAITREQ;
+    if (lower)  {
+        /* lower priority       */
+        apfw_trace("wait_disprequest: priority low, waitting %s", conf->appid);
+        ico_uxf_window_control(conf->appid, req->id, ICO_UXF_APPSCTL_INVISIBLE, 1);
+        if (displaycontrol) {
+            (*displaycontrol)(conf, 0);
+        }
+    }
+    if ((req->prio & ICO_UXF_PRIO_REGULATION) == 0) {
+        /* regulation control   */
+        apfw_trace("wait_disprequest: regulation, waitting %s", conf->appid);
+        ico_uxf_window_control(conf->appid, req->id, ICO_UXF_APPSCTL_REGULATION, 1);
+        if ((! lower) && (displaycontrol))  {
+            (*displaycontrol)(conf, 0);
+        }
+    }
+    if (req->reqtype == ICO_APC_REQTYPE_REQUEST)    {
+        if (ico_apf_resource_send_to_client(
+                conf->appid, ICO_APF_RESOURCE_STATE_WAITTING,
+                req->resid, req->device, req->id) != ICO_APF_RESOURCE_E_NONE)   {
+            apfw_warn("wait_disprequest: send(%s) Error", conf->appid);
+        }
+        else    {
+            req->state &= ~ICO_APC_REQSTATE_REPLYACTIVE;
+            req->state |= ICO_APC_REQSTATE_REPLYQUIET;
+            set_replytimer(req);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   start_disprequest: answer acquired to a new display zone request
+ *          (static function)
+ *
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+start_disprequest(ico_apc_request_t *req)
+{
+    Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
+
+    req->state &= ~ICO_APC_REQSTATE_WAITREQ;
+    if (req->reqtype == ICO_APC_REQTYPE_REQUEST)    {
+        if (ico_apf_resource_send_to_client(
+                    conf->appid, ICO_APF_RESOURCE_STATE_ACQUIRED,
+                    req->resid, req->device, req->id) != ICO_APF_RESOURCE_E_NONE) {
+            apfw_warn("start_disprequest: send(%s) Error", conf->appid);
+            ico_uxf_window_control(conf->appid, req->id, ICO_UXF_APPSCTL_INVISIBLE, 0);
+            if (displaycontrol) {
+                (*displaycontrol)(conf, 1);
+            }
+        }
+        else    {
+            req->state &= ~ICO_APC_REQSTATE_REPLYQUIET;
+            req->state |= ICO_APC_REQSTATE_REPLYACTIVE;
+            set_replytimer(req);
+        }
+    }
+    else    {
+        ico_uxf_window_control(conf->appid, req->id, ICO_UXF_APPSCTL_INVISIBLE, 0);
+        if (displaycontrol) {
+            (*displaycontrol)(conf, 1);
+        }
+    }
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   recalc_dispzone: calculate all display zone request priority(static function)
@@ -1009,71 +1835,89 @@ change_disprequest(ico_apc_request_t *req, const int active)
 static void
 recalc_dispzone(const int idx)
 {
-    int     i;
-    int     prio;
+    int     i, k;
+    int     flips = 0;
+    ico_apc_zoneset_t   *zoneset = &dispzoneset[idx];
     ico_apc_dispzone_t  *czone;
-    ico_apc_dispzone_t  *czone2;
+    ico_apc_request_t   *tops[ICO_UXF_DISPLAY_ZONE_MAX];
     ico_apc_request_t   *p;
-    Ico_Uxf_conf_display *disp = &confsys->display[idx];
-
-    apfw_trace("recalc_dispzone: Enter(disp=%s)", disp->name);
-
-    /* get top of priority of this display  */
-    prio = -1;
-    czone2 = NULL;
-    for (i = 0; i < disp->zoneNum; i++)    {
-        czone = &dispzone[disp->zone[i].zoneidx];
-        p = czone->req;
-        if (! p)    continue;
-        p->state |= ICO_APC_REQSTATE_WAITPROC;
-        if (p->prio > prio)    {
-            czone2 = czone;
-            prio = p->prio;
+    ico_apc_zonebits_t  bits;
+    ico_apc_zonebits_t  visible;
+    ico_apc_zonebits_t  active;
+
+    apfw_trace("recalc_dispzone: Enter(disp=%s)", confsys->display[idx].name);
+
+    /* lower requests of changed zones      */
+    for (i = 0; i < zoneset->zoneNum; i++)  {
+        czone = &dispzone[zoneset->zonebase + i];
+        if (! czone->change)    continue;
+        czone->change = 0;
+        for (k = 1; k < czone->heap.num; k++)   {
+            p = czone->heap.req[k];
+            if (p->state & ICO_APC_REQSTATE_NEWREQ) {
+                /* new request(batch arbitration), waitting */
+                p->state &= ~ICO_APC_REQSTATE_NEWREQ;
+                wait_disprequest(p, 1);
+            }
+            else if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0)    {
+                /* top of zone was replaced, hide           */
+                change_disprequest(p, 0);
+                flips ++;
+            }
         }
     }
-    if (czone2 == NULL) {
+
+    if (zoneset->occupied == 0) {
         /* no visible zone, end         */
+        batch_end(zoneset, flips);
         apfw_trace("recalc_dispzone: Leave(no request)");
         return;
     }
-    if ((czone2->req->state & ICO_APC_REQSTATE_WAITREQ) == 0)   {
-        /* not unvisible zone           */
-        for (i = 0; i < disp->zoneNum; i++)    {
-            czone = &dispzone[disp->zone[i].zoneidx];
-            p = czone->req;
-            if (! p)    continue;
-            p->state &= ~ICO_APC_REQSTATE_WAITPROC;
+
+    /* top request and current visible zones    */
+    get_disptops(zoneset, tops);
+    visible = 0;
+    for (bits = zoneset->occupied; bits; bits &= (bits - 1))    {
+        i = ffs((int)bits) - 1;
+        if ((tops[i]->state & ICO_APC_REQSTATE_WAITREQ) == 0)   {
+            visible |= ICO_APC_ZONEBIT(i);
         }
-        apfw_trace("recalc_dispzone: Leave(%s no need visible control)",
-                   czone2->req->appid);
-        return;
     }
+    active = calc_activezone(zoneset, tops);
 
-    /* change to show for top priority  */
-    p = czone2->req;
-    p->state &= ~ICO_APC_REQSTATE_WAITPROC;
-    change_disprequest(p, 1);
-
-    /* hide overlap zone                */
-    for (i = 0; i < czone2->noverlap; i++)  {
-        p = czone2->overlap[i]->req;
-        if (p)    {
-            if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                p->state &= ~ICO_APC_REQSTATE_WAITPROC;
-                change_disprequest(p, 0);
+    /* hide zone that is overlapped by higher zone  */
+    for (bits = visible & ~active; bits; bits &= (bits - 1))    {
+        change_disprequest(tops[ffs((int)bits) - 1], 0);
+        flips ++;
+    }
+    /* show zone that is not overlapped             */
+    for (bits = active & ~visible; bits; bits &= (bits - 1))    {
+        p = tops[ffs((int)bits) - 1];
+        if ((p->state & ICO_APC_REQSTATE_NEWREQ) == 0)  {
+            change_disprequest(p, 1);
+            flips ++;
+        }
+        else    {
+            p->state &= ~ICO_APC_REQSTATE_NEWREQ;
+            if (p->prio & ICO_UXF_PRIO_REGULATION)  {
+                start_disprequest(p);
+                flips ++;
+            }
+            else    {
+                wait_disprequest(p, 0);
             }
         }
     }
-
-    /* show not overlap zone            */
-    for (i = 0; i < disp->zoneNum; i++)    {
-        czone = &dispzone[disp->zone[i].zoneidx];
-        p = czone->req;
-        if ((p == NULL) || ((p->state & ICO_APC_REQSTATE_WAITPROC) == 0))   continue;
-        p->state &= ~ICO_APC_REQSTATE_WAITPROC;
-        change_disprequest(p, 1);
+    /* new request of overlapped zone, waitting     */
+    for (bits = zoneset->occupied & ~active; bits; bits &= (bits - 1))  {
+        p = tops[ffs((int)bits) - 1];
+        if (p->state & ICO_APC_REQSTATE_NEWREQ) {
+            p->state &= ~ICO_APC_REQSTATE_NEWREQ;
+            wait_disprequest(p, 1);
+        }
     }
-    apfw_trace("recalc_dispzone: Leave");
+    batch_end(zoneset, flips);
+    apfw_trace("recalc_dispzone: Leave(visible %08x -> %08x)", visible, active);
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1093,29 +1937,22 @@ app_getsound(ico_apc_request_t *req, const int addprio)
     Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
     Ico_Uxf_conf_sound_zone     *zone;
     ico_apc_soundzone_t         *czone;
+    ico_apc_zonebits_t          bits;
+    ico_apc_request_t           *tops[ICO_UXF_DISPLAY_ZONE_MAX];
     ico_apc_request_t           *p;
-    ico_apc_request_t           *bp;
+    ico_apc_request_t           *top;
+    ico_apc_request_t           *next;
 
     /* priority     */
-    prio = getpriority(PRIO_PROCESS, req->pid);
-    if (prio > 19)          prio = 19;
-    else if (prio < -20)    prio = -20;
+    prio = ico_uxf_process_priority(conf->appid, req->pid);
     prio = (confsys->category[conf->categoryId].priority * ICO_UXF_PRIO_CATEGORY) + 19 - prio;
     prio += addprio;
     if (ico_syc_apc_regulation_app_sound(conf->categoryId)) {
         prio |= ICO_UXF_PRIO_REGULATION;
     }
     if (ico_uxf_process_is_active(conf->appid)) {
-        for (i = 0; i < nsoundzone; i++) {
-            p = soundzone[i].req;
-            while (p)   {
-                if (p->prio & ICO_UXF_PRIO_ACTIVEAPP)  {
-                    p->prio -= ICO_UXF_PRIO_ACTIVECOUNT;
-                }
-                p = p->next;
-            }
-        }
-        prio |= ICO_UXF_PRIO_ACTIVEAPP;
+        /* newest active application, other active applications are aged by epoch */
+        req->actepoch = ++active_epoch;
     }
 
     /* get sound zone from device name      */
@@ -1138,63 +1975,63 @@ app_getsound(ico_apc_request_t *req, const int addprio)
     zone = czone->conf;
 
     /* search same request          */
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if ((strcmp(p->appid, req->appid) == 0) && (p->resid == req->resid) &&
-            (p->zoneidx == req->zoneidx))   {
-            break;
-        }
-        bp = p;
-        p = p->next;
+    req->prio = prio;
+    p = search_samerequest(req);
+    if ((p) && (p->reqtype != ICO_APC_REQTYPE_REQUEST)) {
+        apfw_trace("app_getsound: Leave(found same request)");
+        put_freereq(req);
+        return;
+    }
+    if (batch_mode) {
+        /* batch arbitration, arbitration result before this request    */
+        get_soundtops(czone->zoneset, tops);
+        batch_begin(czone->zoneset, tops);
+        czone->change = 1;
     }
     if (p)  {
-        if (p->reqtype != ICO_APC_REQTYPE_REQUEST)  {
-            apfw_trace("app_getsound: Leave(found same request)");
-            return;
-        }
-
-        if (p->prio > prio) {
-            prio = p->prio;
+        if (ico_syc_apc_reqheap_cmp(p, req) > 0)    {
+            req->prio = p->prio;
+            req->actepoch = p->actepoch;
         }
         apfw_trace("app_getsound: found same request(app=%s zone=%s res=%d prio=%d)",
-                   conf->appid, soundzone[i].conf->name, req->resid, prio);
-        if (bp) {
-            bp->next = p->next;
-        }
-        else    {
-            czone->req = p->next;
-        }
-        p->next = free_request;
-        free_request = p;
+                   conf->appid, soundzone[i].conf->name, req->resid, req->prio);
+        ico_syc_apc_reqheap_del(&czone->heap, p);
+        put_freereq(p);
     }
 
     /* link request to zone table   */
-    req->prio = prio;
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if (p->prio <= prio)    break;
-        bp = p;
-        p = p->next;
-    }
-    if (bp) {
-        req->next = bp->next;
-        bp->next = req;
+    if (ico_syc_apc_reqheap_add(&czone->heap, req) != ICO_SYC_EOK)  {
+        apfw_trace("app_getsound: Leave(No Memory)");
+        put_freereq(req);
+        set_zoneoccupied(czone->zoneset, czone->zoneno, &czone->heap);
+        return;
     }
-    else    {
-        req->next = czone->req;
-        czone->req = req;
+    link_appreq(req);
+    set_zoneoccupied(czone->zoneset, czone->zoneno, &czone->heap);
+    if (batch_mode) {
+        /* answer and show/hide at the end of this main loop turn   */
+        req->state |= (ICO_APC_REQSTATE_WAITREQ|ICO_APC_REQSTATE_NEWREQ);
+        get_soundtops(czone->zoneset, tops);
+        batch_step(czone->zoneset, tops);
+        if (! batch_idler)  {
+            recalc_changed();
+        }
+        apfw_trace("app_getsound: Leave(batch)");
+        return;
     }
+    top = ICO_APC_REQHEAP_TOP(&czone->heap);
+    next = ico_syc_apc_reqheap_next(&czone->heap);
 
     /* check if maximum priority    */
-    if (! bp)   {
+    if (top == req) {
         j = -1;
-        for (i =0; i < czone->noverlap; i++)    {
-            if (((czone->overlap[i])->req != NULL) &&
-                ((czone->overlap[i])->req->prio > prio))    {
+        for (bits = czone->zoneset->overlap[czone->zoneno] & czone->zoneset->occupied;
+             bits; bits &= (bits - 1))  {
+            i = ffs((int)bits) - 1;
+            p = ICO_APC_REQHEAP_TOP(&ZONEOF(czone, i)->heap);
+            if (ico_syc_apc_reqheap_cmp(p, top) > 0)    {
                 j = i;
-                prio = czone->overlap[i]->req->prio;
+                top = p;
             }
         }
     }
@@ -1203,52 +2040,25 @@ app_getsound(ico_apc_request_t *req, const int addprio)
     }
     if ((j >= 0) || ((req->prio & ICO_UXF_PRIO_REGULATION) == 0))   {
         /* lower priority, waitting this application.           */
-        /* insert application to zone application list and      */
-        /* change zone priority, if request application is top priority */
-        req->state |= ICO_APC_REQSTATE_WAITREQ;
-        if (ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_MUTEON, req->pid)
-                != ICO_APF_RESOURCE_E_NONE) {
-            apfw_warn("app_getsound: send MSM Error");
-        }
-        if (soundcontrol) {
-            (*soundcontrol)(conf, 0);
-        }
-        apfw_trace("app_getsound: priority low, waitting %s", conf->appid);
-        if (req->reqtype == ICO_APC_REQTYPE_REQUEST)    {
-            if (ico_apf_resource_send_to_client(
-                    conf->appid, ICO_APF_RESOURCE_STATE_WAITTING,
-                    req->resid, req->device, req->id) != ICO_APF_RESOURCE_E_NONE)   {
-                apfw_warn("app_getsound: Leave(send(%s) Error)", conf->appid);
-            }
-            else    {
-                req->state |= ICO_APC_REQSTATE_REPLYQUIET;
-                req->timer = ICO_APC_REQREPLY_MAXTIME;
-                timer_count ++;
-            }
-        }
+        wait_soundrequest(req);
     }
     else    {
         /* maximum priority, ok             */
         apfw_trace("app_getsound: priority heigh(%08x)", req->prio);
-        if (req->reqtype == ICO_APC_REQTYPE_REQUEST)    {
-            if (ico_apf_resource_send_to_client(
-                        conf->appid, ICO_APF_RESOURCE_STATE_ACQUIRED,
-                        req->resid, req->device, req->id) != ICO_APF_RESOURCE_E_NONE) {
-                apfw_warn("app_getsound: Leave(send(%s) Error)", conf->appid);
-            }
-        }
+        start_soundrequest(req);
+
         /* send change event to mute application    */
         apfw_trace("app_getsound: next=%08x %s next_state=%x",
-                   req->next, req->next ? req->next->appid : " ",
-                   req->next ? req->next->state : 0x9999);
-        if ((req->next) && ((req->next->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
-            p = req->next;
+                   (int)next, next ? next->appid : " ",
+                   next ? next->state : 0x9999);
+        if ((next) && ((next->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
+            p = next;
         }
         else    {
             p = NULL;
         }
         /* send all waitting applications   */
-        i = 0;
+        bits = czone->zoneset->overlap[czone->zoneno] & czone->zoneset->occupied;
         while (1)   {
             if (p != NULL)  {
                 if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0)   {
@@ -1262,12 +2072,11 @@ app_getsound(ico_apc_request_t *req, const int addprio)
                         }
                         else    {
                             p->state |= ICO_APC_REQSTATE_REPLYQUIET;
-                            p->timer = ICO_APC_REQREPLY_MAXTIME;
-                            timer_count ++;
+                            set_replytimer(p);
                         }
                     }
                 }
-                if (ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_MUTEON, p->pid)
+                if (soundctl_stage(ICO_APF_SOUND_COMMAND_MUTEON, p->pid)
                         != ICO_APF_RESOURCE_E_NONE) {
                     apfw_warn("app_getsound: send MSM Error");
                 }
@@ -1275,9 +2084,10 @@ app_getsound(ico_apc_request_t *req, const int addprio)
                     (*soundcontrol)(get_appconf(p->appid), 0);
                 }
             }
-            if (i >= czone->noverlap)   break;
-            p = czone->overlap[i]->req;
-            i ++;
+            if (! bits) break;
+            i = ffs((int)bits) - 1;
+            bits &= (bits - 1);
+            p = ICO_APC_REQHEAP_TOP(&ZONEOF(czone, i)->heap);
         }
     }
     apfw_trace("app_getsound: Leave(req=%08x,state=%x,prio=%08x)",
@@ -1299,15 +2109,15 @@ app_freesound(ico_apc_request_t *req, const int send)
     int     idx;
     Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
     ico_apc_soundzone_t         *czone;
-    ico_apc_request_t           *p;
-    ico_apc_request_t           *bp;
+    ico_apc_request_t           *tops[ICO_UXF_DISPLAY_ZONE_MAX];
+    int                         top;
 
     apfw_trace("app_freesound: Entry(app=%s)", req->appid);
 
     czone = &soundzone[req->zoneidx];
     idx = czone->conf->sound->id;
 
-    if (ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_MUTEON, req->pid)
+    if (soundctl_stage(ICO_APF_SOUND_COMMAND_MUTEON, req->pid)
                 != ICO_APF_RESOURCE_E_NONE) {
         apfw_warn("app_freesound: send MSM Error");
     }
@@ -1321,31 +2131,38 @@ app_freesound(ico_apc_request_t *req, const int send)
     }
 
     /* find request                     */
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if (p == req)   break;
-        bp = p;
-        p = p->next;
-    }
-    if (! p)    {
+    if (! ICO_APC_REQHEAP_LINKED(&czone->heap, req))    {
         apfw_warn("app_freesound: Leave(request dose not exist)");
         return;
     }
 
-    /* release request table from zone table    */
-    if (bp) {
-        bp->next = p->next;
+    if (batch_mode) {
+        /* batch arbitration, arbitration result before this request    */
+        get_soundtops(czone->zoneset, tops);
+        batch_begin(czone->zoneset, tops);
+        czone->change = 1;
+    }
 
+    /* release request table from zone table    */
+    top = (ICO_APC_REQHEAP_TOP(&czone->heap) == req);
+    ico_syc_apc_reqheap_del(&czone->heap, req);
+    put_freereq(req);
+    set_zoneoccupied(czone->zoneset, czone->zoneno, &czone->heap);
+    if (batch_mode) {
+        /* show/hide at the end of this main loop turn  */
+        get_soundtops(czone->zoneset, tops);
+        batch_step(czone->zoneset, tops);
+        if (! batch_idler)  {
+            recalc_changed();
+        }
+        apfw_trace("app_freesound: Leave(batch)");
+        return;
+    }
+    if (! top)  {
         /* request is waitted, no need other control*/
-        p->next = free_request;
-        free_request = p;
         apfw_trace("app_freesound: Leave(request waited)");
         return;
     }
-    czone->req = p->next;
-    p->next = free_request;
-    free_request = p;
 
     /* recalculate visible zone         */
     recalc_soundzone(idx);
@@ -1381,12 +2198,11 @@ change_soundrequest(ico_apc_request_t *req, const int active)
         else    {
             req->state |= (active ? ICO_APC_REQSTATE_REPLYACTIVE :
                                     ICO_APC_REQSTATE_REPLYQUIET);
-            req->timer = ICO_APC_REQREPLY_MAXTIME;
-            timer_count ++;
+            set_replytimer(req);
         }
     }
     if ((req->state & ICO_APC_REQSTATE_REPLYACTIVE) == 0)   {
-        if (ico_apf_resource_send_to_soundctl(
+        if (soundctl_stage(
                     active ? ICO_APF_SOUND_COMMAND_MUTEOFF : ICO_APF_SOUND_COMMAND_MUTEON,
                     req->pid) != ICO_APF_RESOURCE_E_NONE)   {
             apfw_warn("change_soundrequest: send MSM Error");
@@ -1405,146 +2221,205 @@ change_soundrequest(ico_apc_request_t *req, const int active)
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   recalc_soundzone: calculate all sound zone request priority(static function)
+ * @brief   wait_soundrequest: answer waitting to a new sound zone request
+ *          (static function)
  *
- * @param[in]   idx         sound index number
+ * @param[in]   req             request block
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 static void
-recalc_soundzone(const int idx)
+wait_soundrequest(ico_apc_request_t *req)
 {
-    int     i;
-    int     prio;
-    ico_apc_soundzone_t *czone;
-    ico_apc_soundzone_t *czone2;
-    ico_apc_request_t   *p;
-    Ico_Uxf_conf_sound  *sound = &confsys->sound[idx];
-
-    apfw_trace("recalc_soundzone: Enter(sound=%s)", sound->name);
+    Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
 
-    /* get top of priority of this sound  */
-    prio = -1;
-    czone2 = NULL;
-    for (i = 0; i < sound->zoneNum; i++)    {
-        czone = &soundzone[sound->zone[i].zoneidx];
-        p = czone->req;
-        if (! p)    continue;
-        p->state |= ICO_APC_REQSTATE_WAITPROC;
-        if (p->prio > prio)    {
-            czone2 = czone;
-            prio = p->prio;
-        }
-    }
-    if (czone2 == NULL) {
-        /* no active zone, end          */
-        apfw_trace("recalc_soundzone: Leave(no request)");
-        return;
+    req->state |= ICO_APC_REQSTATE_WAITREQ;
+    if (soundctl_stage(ICO_APF_SOUND_COMMAND_MUTEON, req->pid)
+            != ICO_APF_RESOURCE_E_NONE) {
+        apfw_warn("wait_soundrequest: send MSM Error");
     }
-    if ((czone2->req->state & ICO_APC_REQSTATE_WAITREQ) == 0)   {
-        /* not quiet zone               */
-        for (i = 0; i < sound->zoneNum; i++)    {
-            czone = &soundzone[sound->zone[i].zoneidx];
-            p = czone->req;
-            if (! p)    continue;
-            p->state &= ~ICO_APC_REQSTATE_WAITPROC;
-        }
-        apfw_trace("recalc_soundzone: Leave(%s no need sound control)",
-                   czone2->req->appid);
-        return;
+    if (soundcontrol) {
+        (*soundcontrol)(conf, 0);
     }
-
-    /* change to active for top priority*/
-    p = czone2->req;
-    p->state &= ~ICO_APC_REQSTATE_WAITPROC;
-    if (p->prio & ICO_UXF_PRIO_REGULATION)  {
-        apfw_trace("recalc_soundzone: Start %s(prio=%08x and no regulation)",
-                   p->appid, p->prio);
-        change_soundrequest(p, 1);
-    }
-
-    /* mute overlap zone                */
-    for (i = 0; i < czone2->noverlap; i++)  {
-        p = czone2->overlap[i]->req;
-        if (p)    {
-            if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                p->state &= ~ICO_APC_REQSTATE_WAITPROC;
-                if (p->prio & ICO_UXF_PRIO_REGULATION)  {
-                    apfw_trace("recalc_soundzone: Overlap Stop %s(top and no regulation)",
-                               p->appid);
-                    change_soundrequest(p, 0);
-                }
-                else    {
-                    p->state |= ICO_APC_REQSTATE_WAITREQ;
-                }
-            }
+    apfw_trace("wait_soundrequest: priority low, waitting %s", conf->appid);
+    if (req->reqtype == ICO_APC_REQTYPE_REQUEST)    {
+        if (ico_apf_resource_send_to_client(
+                conf->appid, ICO_APF_RESOURCE_STATE_WAITTING,
+                req->resid, req->device, req->id) != ICO_APF_RESOURCE_E_NONE)   {
+            apfw_warn("wait_soundrequest: send(%s) Error", conf->appid);
         }
-    }
-
-    /* reset mute not overlap zone      */
-    for (i = 0; i < sound->zoneNum; i++)    {
-        czone = &soundzone[sound->zone[i].zoneidx];
-        p = czone->req;
-        if ((p == NULL) || ((p->state & ICO_APC_REQSTATE_WAITPROC) == 0))   continue;
-        p->state &= ~ICO_APC_REQSTATE_WAITPROC;
-        if (p->state & ICO_APC_REQSTATE_WAITREQ)    {
-            if (p->prio & ICO_UXF_PRIO_REGULATION)  {
-                apfw_trace("recalc_soundzone: Overlap Start %s(top and no regulation)",
-                           p->appid);
-                change_soundrequest(p, 1);
-            }
+        else    {
+            req->state |= ICO_APC_REQSTATE_REPLYQUIET;
+            set_replytimer(req);
         }
     }
-    apfw_trace("recalc_soundzone: Leave");
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   app_getinput: get input switch resource(static function)
+ * @brief   start_soundrequest: answer acquired to a new sound zone request
+ *          (static function)
  *
  * @param[in]   req             request block
- * @param[in]   addprio         a priority to add to the priority of the request
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 static void
-app_getinput(ico_apc_request_t *req, const int addprio)
+start_soundrequest(ico_apc_request_t *req)
 {
-    int     prio;
-    int     i;
-    Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
-    ico_apc_inputsw_t           *czone;
-    ico_apc_request_t           *p;
-    ico_apc_request_t           *bp;
-
-    /* priority     */
-    prio = getpriority(PRIO_PROCESS, req->pid);
-    if (prio > 19)          prio = 19;
-    else if (prio < -20)    prio = -20;
-    prio = (confsys->category[conf->categoryId].priority * ICO_UXF_PRIO_CATEGORY) + 19 - prio;
-    prio += addprio;
-    if (ico_syc_apc_regulation_app_input(conf->categoryId)) {
-        prio |= ICO_UXF_PRIO_REGULATION;
-    }
-    if (ico_uxf_process_is_active(conf->appid)) {
-        for (i = 0; i < ninputsw; i++) {
-            p = inputsw[i].req;
-            while (p)   {
-                if (p->prio & ICO_UXF_PRIO_ACTIVEAPP)  {
-                    p->prio -= ICO_UXF_PRIO_ACTIVECOUNT;
-                }
-                p = p->next;
-            }
+    req->state &= ~ICO_APC_REQSTATE_WAITREQ;
+    if (req->reqtype == ICO_APC_REQTYPE_REQUEST)    {
+        if (ico_apf_resource_send_to_client(
+                    req->appid, ICO_APF_RESOURCE_STATE_ACQUIRED,
+                    req->resid, req->device, req->id) != ICO_APF_RESOURCE_E_NONE) {
+            apfw_warn("start_soundrequest: send(%s) Error", req->appid);
         }
-        prio |= ICO_UXF_PRIO_ACTIVEAPP;
     }
+}
 
-    /* get input switch from device name    */
-    for (i = 0; i < ninputsw; i++) {
-        if (strcasecmp(inputsw[i].inputsw->swname, req->device) == 0)  break;
-    }
-    if (i >= ninputsw) {
-        i = confsys->misc.default_inputswId;
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   recalc_soundzone: calculate all sound zone request priority(static function)
+ *
+ * @param[in]   idx         sound index number
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+recalc_soundzone(const int idx)
+{
+    int     i, k;
+    int     flips = 0;
+    ico_apc_zoneset_t   *zoneset = &soundzoneset[idx];
+    ico_apc_soundzone_t *czone;
+    ico_apc_request_t   *tops[ICO_UXF_DISPLAY_ZONE_MAX];
+    ico_apc_request_t   *p;
+    ico_apc_zonebits_t  bits;
+    ico_apc_zonebits_t  sounding;
+    ico_apc_zonebits_t  active;
+
+    apfw_trace("recalc_soundzone: Enter(sound=%s)", confsys->sound[idx].name);
+
+    /* lower requests of changed zones      */
+    for (i = 0; i < zoneset->zoneNum; i++)  {
+        czone = &soundzone[zoneset->zonebase + i];
+        if (! czone->change)    continue;
+        czone->change = 0;
+        for (k = 1; k < czone->heap.num; k++)   {
+            p = czone->heap.req[k];
+            if (p->state & ICO_APC_REQSTATE_NEWREQ) {
+                /* new request(batch arbitration), waitting */
+                p->state &= ~ICO_APC_REQSTATE_NEWREQ;
+                wait_soundrequest(p);
+            }
+            else if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0)    {
+                /* top of zone was replaced, mute           */
+                change_soundrequest(p, 0);
+                flips ++;
+            }
+        }
+    }
+
+    if (zoneset->occupied == 0) {
+        /* no active zone, end          */
+        batch_end(zoneset, flips);
+        apfw_trace("recalc_soundzone: Leave(no request)");
+        return;
+    }
+
+    /* top request and current sounding zones   */
+    get_soundtops(zoneset, tops);
+    sounding = 0;
+    for (bits = zoneset->occupied; bits; bits &= (bits - 1))    {
+        i = ffs((int)bits) - 1;
+        if ((tops[i]->state & ICO_APC_REQSTATE_WAITREQ) == 0)   {
+            sounding |= ICO_APC_ZONEBIT(i);
+        }
+    }
+    /* regulated request keeps its zone(and mutes overlap zones) in quiet  */
+    active = calc_activezone(zoneset, tops);
+
+    /* mute zone that is overlapped by higher zone  */
+    for (bits = sounding & ~active; bits; bits &= (bits - 1))   {
+        p = tops[ffs((int)bits) - 1];
+        if (p->prio & ICO_UXF_PRIO_REGULATION)  {
+            apfw_trace("recalc_soundzone: Overlap Stop %s(top and no regulation)",
+                       p->appid);
+            change_soundrequest(p, 0);
+            flips ++;
+        }
+        else    {
+            p->state |= ICO_APC_REQSTATE_WAITREQ;
+        }
+    }
+    /* reset mute zone that is not overlapped       */
+    for (bits = active & ~sounding; bits; bits &= (bits - 1))   {
+        p = tops[ffs((int)bits) - 1];
+        if (p->state & ICO_APC_REQSTATE_NEWREQ) {
+            p->state &= ~ICO_APC_REQSTATE_NEWREQ;
+            if (p->prio & ICO_UXF_PRIO_REGULATION)  {
+                start_soundrequest(p);
+                flips ++;
+            }
+            else    {
+                wait_soundrequest(p);
+            }
+        }
+        else if (p->prio & ICO_UXF_PRIO_REGULATION) {
+            apfw_trace("recalc_soundzone: Start %s(prio=%08x and no regulation)",
+                       p->appid, p->prio);
+            change_soundrequest(p, 1);
+            flips ++;
+        }
+    }
+    /* new request of overlapped zone, waitting     */
+    for (bits = zoneset->occupied & ~active; bits; bits &= (bits - 1))  {
+        p = tops[ffs((int)bits) - 1];
+        if (p->state & ICO_APC_REQSTATE_NEWREQ) {
+            p->state &= ~ICO_APC_REQSTATE_NEWREQ;
+            wait_soundrequest(p);
+        }
+    }
+    batch_end(zoneset, flips);
+    apfw_trace("recalc_soundzone: Leave(sounding %08x -> %08x)", sounding, active);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   app_getinput: get input switch resource(static function)
+ *
+ * @param[in]   req             request block
+ * @param[in]   addprio         a priority to add to the priority of the request
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+app_getinput(ico_apc_request_t *req, const int addprio)
+{
+    int     prio;
+    int     i;
+    Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
+    ico_apc_inputsw_t           *czone;
+    ico_apc_request_t           *p;
+    ico_apc_request_t           *top;
+    ico_apc_request_t           *next;
+
+    /* priority     */
+    prio = ico_uxf_process_priority(conf->appid, req->pid);
+    prio = (confsys->category[conf->categoryId].priority * ICO_UXF_PRIO_CATEGORY) + 19 - prio;
+    prio += addprio;
+    if (ico_syc_apc_regulation_app_input(conf->categoryId)) {
+        prio |= ICO_UXF_PRIO_REGULATION;
+    }
+    if (ico_uxf_process_is_active(conf->appid)) {
+        /* newest active application, other active applications are aged by epoch */
+        req->actepoch = ++active_epoch;
+    }
+
+    /* get input switch from device name    */
+    i = search_inputsw(NULL, req->device);
+    if (i < 0)  {
+        i = confsys->misc.default_inputswId;
         apfw_trace("app_getinput: Entry(app=%s inputsw=%s(%s none) prio=%x(+%x) pid=%d)",
                    conf->appid, inputsw[i].inputsw->swname, req->device, prio, addprio,
                    req->pid);
@@ -1558,54 +2433,37 @@ app_getinput(ico_apc_request_t *req, const int addprio)
     czone = &inputsw[i];
 
     /* search same request          */
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if ((strcmp(p->appid, req->appid) == 0) && (p->resid == req->resid) &&
-            (p->zoneidx == req->zoneidx))   {
-            break;
-        }
-        bp = p;
-        p = p->next;
-    }
+    req->prio = prio;
+    p = search_samerequest(req);
     if (p)  {
         if (p->reqtype != ICO_APC_REQTYPE_REQUEST)  {
             apfw_trace("app_getinput: Leave(found same request)");
+            put_freereq(req);
             return;
         }
 
-        if (p->prio > prio) {
-            prio = p->prio;
+        if (ico_syc_apc_reqheap_cmp(p, req) > 0)    {
+            req->prio = p->prio;
+            req->actepoch = p->actepoch;
         }
         apfw_trace("app_getinput: found same request(app=%s sw=%s res=%d prio=%d)",
-                   conf->appid, inputsw[i].inputsw->swname, req->resid, prio);
-        if (bp) {
-            bp->next = p->next;
-        }
-        else    {
-            czone->req = p->next;
+                   conf->appid, inputsw[i].inputsw->swname, req->resid, req->prio);
+        if (czone->owner == p)  {
+            czone->owner = NULL;
         }
-        p->next = free_request;
-        free_request = p;
+        ico_syc_apc_reqheap_del(&czone->heap, p);
+        put_freereq(p);
     }
 
     /* link request to zone table   */
-    req->prio = prio;
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if (p->prio <= prio)    break;
-        bp = p;
-        p = p->next;
-    }
-    if (bp) {
-        req->next = bp->next;
-        bp->next = req;
-    }
-    else    {
-        req->next = czone->req;
-        czone->req = req;
+    if (ico_syc_apc_reqheap_add(&czone->heap, req) != ICO_SYC_EOK)  {
+        apfw_trace("app_getinput: Leave(No Memory)");
+        put_freereq(req);
+        return;
     }
+    link_appreq(req);
+    top = ICO_APC_REQHEAP_TOP(&czone->heap);
+    next = (top == req) ? ico_syc_apc_reqheap_next(&czone->heap) : NULL;
 
     if ((req->prio & ICO_UXF_PRIO_REGULATION) == 0) {
         /* lower priority, waitting this application.           */
@@ -1628,8 +2486,7 @@ app_getinput(ico_apc_request_t *req, const int addprio)
             }
             else    {
                 req->state |= ICO_APC_REQSTATE_REPLYQUIET;
-                req->timer = ICO_APC_REQREPLY_MAXTIME;
-                timer_count ++;
+                set_replytimer(req);
             }
         }
     }
@@ -1644,17 +2501,17 @@ app_getinput(ico_apc_request_t *req, const int addprio)
             }
             else    {
                 req->state |= ICO_APC_REQSTATE_REPLYACTIVE;
-                req->timer = ICO_APC_REQREPLY_MAXTIME;
-                timer_count ++;
+                set_replytimer(req);
             }
         }
         if (ico_uxf_input_control(1, req->appid, czone->inputdev->device,
                                   czone->inputsw->input) != ICO_UXF_EOK)    {
             apfw_warn("app_getinput: send MIM Error");
         }
+        czone->owner = req;
         /* change lower priority stateus            */
-        if ((req->next) && ((req->next->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
-            p = req->next;
+        if ((next) && ((next->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
+            p = next;
             p->state |= ICO_APC_REQSTATE_WAITREQ;
             apfw_trace("app_getinput: lower priority(%s), waitting", p->appid);
             if (p->reqtype == ICO_APC_REQTYPE_REQUEST)  {
@@ -1665,8 +2522,7 @@ app_getinput(ico_apc_request_t *req, const int addprio)
                 }
                 else    {
                     p->state |= ICO_APC_REQSTATE_REPLYQUIET;
-                    p->timer = ICO_APC_REQREPLY_MAXTIME;
-                    timer_count ++;
+                    set_replytimer(p);
                 }
             }
         }
@@ -1689,12 +2545,14 @@ app_freeinput(ico_apc_request_t *req, const int send)
 {
     Ico_Uxf_conf_application    *conf = get_appconf(req->appid);
     ico_apc_inputsw_t           *czone;
-    ico_apc_request_t           *p;
-    ico_apc_request_t           *bp;
+    int                         top;
 
     apfw_trace("app_freeinput: Entry(app=%s)", req->appid);
 
     czone = &inputsw[req->zoneidx];
+    if (czone->owner == req)    {
+        czone->owner = NULL;
+    }
 
     if (ico_uxf_input_control(0, conf->appid, czone->inputdev->device,
                               czone->inputsw->input) != ICO_UXF_EOK)    {
@@ -1710,34 +2568,23 @@ app_freeinput(ico_apc_request_t *req, const int send)
     }
 
     /* find request                     */
-    p = czone->req;
-    bp = NULL;
-    while (p)   {
-        if (p == req)   break;
-        bp = p;
-        p = p->next;
-    }
-    if (! p)    {
+    if (! ICO_APC_REQHEAP_LINKED(&czone->heap, req))    {
         apfw_warn("app_freeinput: Leave(request dose not exist)");
         return;
     }
 
     /* release request table from zone table    */
-    if (bp) {
-        bp->next = p->next;
-
+    top = (ICO_APC_REQHEAP_TOP(&czone->heap) == req);
+    ico_syc_apc_reqheap_del(&czone->heap, req);
+    put_freereq(req);
+    if (! top)  {
         /* request is waitted, no need other control*/
-        p->next = free_request;
-        free_request = p;
         apfw_trace("app_freeinput: Leave(request waited)");
         return;
     }
-    czone->req = p->next;
-    p->next = free_request;
-    free_request = p;
 
     /* recalculate visible zone         */
-    recalc_inputsw(czone->inputsw->input);
+    recalc_inputsw(czone - inputsw);
 
     apfw_trace("app_freeinput: Leave");
 }
@@ -1772,8 +2619,7 @@ change_inputrequest(ico_apc_request_t *req, const int active)
         else    {
             req->state |= (active ? ICO_APC_REQSTATE_REPLYACTIVE :
                                     ICO_APC_REQSTATE_REPLYQUIET);
-            req->timer = ICO_APC_REQREPLY_MAXTIME;
-            timer_count ++;
+            set_replytimer(req);
         }
     }
     if (ico_uxf_input_control(active, req->appid, czone->inputdev->device,
@@ -1786,9 +2632,13 @@ change_inputrequest(ico_apc_request_t *req, const int active)
     if (active)   {
         req->state &= ~ICO_APC_REQSTATE_WAITREQ;
         req->state |= ICO_APC_REQSTATE_REPLYACTIVE;
+        czone->owner = req;
     }
     else    {
         req->state |= (ICO_APC_REQSTATE_WAITREQ | ICO_APC_REQSTATE_REPLYQUIET);
+        if (czone->owner == req)    {
+            czone->owner = NULL;
+        }
     }
 }
 
@@ -1809,12 +2659,17 @@ recalc_inputsw(const int idx)
     apfw_trace("recalc_inputsw: Enter(input=%s)", czone->inputsw->swname);
 
     /* get top of priority of this input    */
-    p = czone->req;
+    p = ICO_APC_REQHEAP_TOP(&czone->heap);
     if (p == NULL) {
         /* no active request, end           */
         apfw_trace("recalc_inputsw: Leave(no request)");
         return;
     }
+    if (p == czone->owner)  {
+        /* top priority already has the switch  */
+        apfw_trace("recalc_inputsw: Leave(%s is owner)", p->appid);
+        return;
+    }
     if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0)   {
         /* not wait request                 */
         apfw_trace("recalc_inputsw: Leave(%s no need input control)", p->appid);
@@ -1832,841 +2687,1392 @@ recalc_inputsw(const int idx)
     apfw_trace("recalc_inputsw: Leave");
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   search_inputsw: search input switch by device and switch name
+ *          (static function)
+ *
+ * @param[in]   device      input device name(if NULL, any device)
+ * @param[in]   swname      input switch name
+ * @return      input switch index number
+ * @retval      >= 0            success(index of inputsw)
+ * @retval      < 0             error(switch dose not exist)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+search_inputsw(const char *device, const char *swname)
+{
+    ico_apc_inputsw_t   *sw;
+
+    if ((! swname) || (*swname == 0))   {
+        return -1;
+    }
+    for (sw = inputswhash[ICO_UXF_MISC_HASHBYNAME(swname)]; sw; sw = sw->nexthash)  {
+        if ((strcasecmp(sw->inputsw->swname, swname) == 0) &&
+            ((! device) || (strcasecmp(sw->inputdev->device, device) == 0)))  {
+            return sw - inputsw;
+        }
+    }
+    return -1;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   regulation_listener: change regulation callback(static function)
+ *          (all changed categorys of one evaluation are processed in one pass)
  *
- * @param[in]   appcategory     category Id
- * @param[in]   control         control(display/sound/input active/inactive)
+ * @param[in]   change          changed categorys and controls
+ *                              (display/sound/input active/inactive)
  * @param[in]   user_data       user data(unused)
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 static void
-regulation_listener(const int appcategory,
-                    const ico_apc_reguration_control_t control, void *user_data)
+regulation_listener(const ico_apc_regulation_change_t *change, void *user_data)
 {
-    int     i, j, k;
+    int     i;
     int     flag;
-    int     disp, sound, input;
+    int     appcategory;
+    ico_apc_reguration_control_t    control;
+    ico_apc_apprequest_t    *app;
+    ico_apc_reqheap_t   *heap;
     ico_apc_request_t   *p;
-    ico_apc_request_t   *bp;
-    ico_apc_request_t   *p2;
-    ico_apc_request_t   *bp2;
-    unsigned short  reqdisp[MAXREQ];
-    unsigned short  reqsound[MAXREQ];
-    unsigned short  reqinput[MAXREQ];
-
-    disp = 0;
-    sound = 0;
-    input = 0;
+    ico_apc_request_t   *next;
 
     confapp = (Ico_Uxf_App_Config *)ico_uxf_getAppConfig();
 
-    if (control.display != ICO_SYC_APC_REGULATION_NOCHANGE) {
-        /* display regulation control       */
-        apfw_trace("regulation_listener: disp category=%d display=%d",
-                   appcategory, control.display);
-        for (i = 0; i < confapp->applicationNum; i++)   {
-            if (confapp->application[i].categoryId != appcategory)  continue;
-            for (k = 0; k < ndispzone; k++) {
-                p = dispzone[k].req;
-                if (!p) continue;
-                bp = NULL;
-                while (p)   {
-                    if (strcmp(p->appid, confapp->application[i].appid) == 0)    {
-                        flag = 0;
-                        if (control.display == ICO_SYC_APC_REGULATION_REGULATION)   {
-                            if (p->prio & ICO_UXF_PRIO_REGULATION)  {
-                                p->prio &= ~ICO_UXF_PRIO_REGULATION;
-                                flag ++;
-                                ico_uxf_window_control(p->appid, p->id,
-                                                       ICO_UXF_APPSCTL_REGULATION, 1);
-                            }
-                        }
-                        else    {
-                            if ((p->prio & ICO_UXF_PRIO_REGULATION) == 0)   {
-                                p->prio |= ICO_UXF_PRIO_REGULATION;
-                                flag ++;
-                                ico_uxf_window_control(p->appid, p->id,
-                                                       ICO_UXF_APPSCTL_REGULATION, 0);
-                            }
+    for (appcategory = 0; appcategory < ICO_UXF_CATEGORY_MAX; appcategory++)    {
+        if ((change->changed & ICO_SYC_APC_CATEGORY_BIT(appcategory)) == 0) continue;
+        control = change->control[appcategory];
+        if (control.display != ICO_SYC_APC_REGULATION_NOCHANGE) {
+            apfw_trace("regulation_listener: disp category=%d display=%d",
+                       appcategory, control.display);
+        }
+        if (control.sound != ICO_SYC_APC_REGULATION_NOCHANGE) {
+            apfw_trace("regulation_listener: sound category=%d sound=%d",
+                       appcategory, control.sound);
+        }
+        if (control.input != ICO_SYC_APC_REGULATION_NOCHANGE)   {
+            apfw_trace("regulation_listener: input category=%d input=%d",
+                       appcategory, control.input);
+        }
+    }
+
+    for (i = 0; i < confapp->applicationNum; i++)   {
+        appcategory = confapp->application[i].categoryId;
+        if ((appcategory < 0) || (appcategory >= ICO_UXF_CATEGORY_MAX) ||
+            ((change->changed & ICO_SYC_APC_CATEGORY_BIT(appcategory)) == 0)) continue;
+        app = get_apprequest(confapp->application[i].appid, 0);
+        if (! app)  continue;
+        control = change->control[appcategory];
+
+        /* only requests of this application    */
+        for (p = app->req; p; p = p->appnext)   {
+            if (REQ_IS_DISPLAY(p))  {
+                /* display regulation control       */
+                if (control.display == ICO_SYC_APC_REGULATION_NOCHANGE) continue;
+                flag = 0;
+                if (control.display == ICO_SYC_APC_REGULATION_REGULATION)   {
+                    if (p->prio & ICO_UXF_PRIO_REGULATION)  {
+                        p->prio &= ~ICO_UXF_PRIO_REGULATION;
+                        flag ++;
+                        ico_uxf_window_control(p->appid, p->id,
+                                               ICO_UXF_APPSCTL_REGULATION, 1);
+                    }
+                }
+                else    {
+                    if ((p->prio & ICO_UXF_PRIO_REGULATION) == 0)   {
+                        p->prio |= ICO_UXF_PRIO_REGULATION;
+                        flag ++;
+                        ico_uxf_window_control(p->appid, p->id,
+                                               ICO_UXF_APPSCTL_REGULATION, 0);
+                    }
+                }
+                if (! flag) continue;
+
+                apfw_trace("regulation_listener: disp %s %08x", p->appid, p->prio);
+                dispzone[p->zoneidx].change = 1;
+                heap = &dispzone[p->zoneidx].heap;
+                ico_syc_apc_reqheap_update(heap, p, 0);
+                if (ICO_APC_REQHEAP_TOP(heap) != p) {
+                    if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
+                        change_disprequest(p, 0);
+                    }
+                }
+                else    {
+                    next = ico_syc_apc_reqheap_next(heap);
+                    if ((next != NULL) &&
+                        ((next->state & ICO_APC_REQSTATE_WAITREQ) == 0))    {
+                        change_disprequest(next, 0);
+                    }
+                }
+            }
+            else if (REQ_IS_SOUND(p))   {
+                /* sound regulation control         */
+                if (control.sound == ICO_SYC_APC_REGULATION_NOCHANGE)   continue;
+                flag = 0;
+                if (control.sound == ICO_SYC_APC_REGULATION_REGULATION) {
+                    if (p->prio & ICO_UXF_PRIO_REGULATION)  {
+                        p->prio &= ~ICO_UXF_PRIO_REGULATION;
+                        flag ++;
+                        if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
+                            change_soundrequest(p, 0);
                         }
-                        if (flag)   {
-                            for (j = 0; j < disp; j++)  {
-                                if (dispzone[k].conf->display->id == reqdisp[j])    break;
-                            }
-                            if (j >= disp)  {
-                                reqdisp[disp++] = dispzone[k].conf->display->id;
-                            }
-                            apfw_trace("regulation_listener: disp %s %08x",
-                                       p->appid, p->prio);
-                            if (bp) {
-                                bp->next = p->next;
-                            }
-                            else    {
-                                dispzone[k].req = p->next;
-                            }
-                            p2 = dispzone[k].req;
-                            bp2 = NULL;
-                            while (p2)  {
-                                if (p2->prio < p->prio) {
-                                    if (bp2)    {
-                                        bp2->next = p;
-                                        p->next = p2;
-                                        if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                                            change_disprequest(p, 0);
-                                        }
-                                    }
-                                    else    {
-                                        p->next = dispzone[k].req;
-                                        dispzone[k].req = p;
-                                        if ((p->next != NULL) &&
-                                            ((p->next->state & ICO_APC_REQSTATE_WAITREQ)
-                                                == 0)) {
-                                            change_disprequest(p->next, 0);
-                                        }
-                                    }
-                                    break;
-                                }
-                                bp2 = p2;
-                                p2 = p2->next;
-                            }
-                            if (! p2)   {
-                                if (bp2)    {
-                                    bp2->next = p;
-                                    if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                                        change_disprequest(p, 0);
-                                    }
-                                }
-                                else    {
-                                    dispzone[k].req = p;
-                                }
-                                p->next = NULL;
-                            }
-                            break;
+                    }
+                }
+                else    {
+                    if ((p->prio & ICO_UXF_PRIO_REGULATION) == 0)   {
+                        p->prio |= ICO_UXF_PRIO_REGULATION;
+                        flag ++;
+                    }
+                }
+                if (! flag) continue;
+
+                apfw_trace("regulation_listener: sound change category=%d "
+                           "app(%s) sound=%d prio=%08x",
+                           appcategory, p->appid, control.sound, p->prio);
+                soundzone[p->zoneidx].change = 1;
+                heap = &soundzone[p->zoneidx].heap;
+                ico_syc_apc_reqheap_update(heap, p, 0);
+                if (ICO_APC_REQHEAP_TOP(heap) != p) {
+                    if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
+                        change_soundrequest(p, 0);
+                    }
+                }
+                else    {
+                    next = ico_syc_apc_reqheap_next(heap);
+                    if ((next != NULL) &&
+                        ((next->state & ICO_APC_REQSTATE_WAITREQ) == 0))    {
+                        change_soundrequest(next, 0);
+                    }
+                }
+            }
+            else if (REQ_IS_INPUT(p))   {
+                /* input reguration control     */
+                if (control.input == ICO_SYC_APC_REGULATION_NOCHANGE)   continue;
+                flag = 0;
+                if (control.input == ICO_SYC_APC_REGULATION_REGULATION) {
+                    if (p->prio & ICO_UXF_PRIO_REGULATION)  {
+                        p->prio &= ~ICO_UXF_PRIO_REGULATION;
+                        flag ++;
+                        if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
+                            change_inputrequest(p, 0);
                         }
                     }
-                    bp = p;
-                    p = p->next;
+                }
+                else    {
+                    if ((p->prio & ICO_UXF_PRIO_REGULATION) == 0)   {
+                        p->prio |= ICO_UXF_PRIO_REGULATION;
+                        flag ++;
+                    }
+                }
+                if (! flag) continue;
+
+                apfw_trace("regulation_listener: input change category=%d "
+                           "app(%s) input=%d prio=%08x",
+                           appcategory, p->appid, control.input, p->prio);
+                inputsw[p->zoneidx].change = 1;
+                heap = &inputsw[p->zoneidx].heap;
+                ico_syc_apc_reqheap_update(heap, p, 0);
+                if ((ICO_APC_REQHEAP_TOP(heap) != p) &&
+                    ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0))   {
+                    change_inputrequest(p, 0);
                 }
             }
         }
     }
 
-    if (control.sound != ICO_SYC_APC_REGULATION_NOCHANGE) {
-        /* sound regulation control         */
-        apfw_trace("regulation_listener: sound category=%d sound=%d",
-                   appcategory, control.sound);
-        for (i = 0; i < confapp->applicationNum; i++)   {
-            if (confapp->application[i].categoryId != appcategory)  continue;
-            for (k = 0; k < nsoundzone; k++)    {
-                p = soundzone[k].req;
-                if (!p) continue;
-                bp = NULL;
-                while (p)   {
-                    if (strcmp(p->appid, confapp->application[i].appid) == 0)    {
-                        flag = 0;
-                        if (control.sound == ICO_SYC_APC_REGULATION_REGULATION) {
-                            if (p->prio & ICO_UXF_PRIO_REGULATION)  {
-                                p->prio &= ~ICO_UXF_PRIO_REGULATION;
-                                flag ++;
-                                if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                                    change_soundrequest(p, 0);
-                                }
-                            }
-                        }
-                        else    {
-                            if ((p->prio & ICO_UXF_PRIO_REGULATION) == 0)   {
-                                p->prio |= ICO_UXF_PRIO_REGULATION;
-                                flag ++;
-                            }
-                        }
-                        if (flag)   {
-                            apfw_trace("regulation_listener: sound change category=%d "
-                                       "app(%s) sound=%d prio=%08x",
-                                       appcategory, p->appid, control.sound, p->prio);
-                            for (j = 0; j < sound; j++)  {
-                                if (soundzone[k].conf->sound->id == reqsound[j])    break;
-                            }
-                            if (j >= sound)  {
-                                reqsound[sound++] = soundzone[k].conf->sound->id;
-                            }
-                            apfw_trace("regulation_listener: sound %s %08x %08x",
-                                       p->appid, p->prio, (int)bp);
-                            if (bp) {
-                                bp->next = p->next;
-                            }
-                            else    {
-                                soundzone[k].req = p->next;
-                            }
-                            p2 = soundzone[k].req;
-                            bp2 = NULL;
-                            while (p2)  {
-                                if (p2->prio < p->prio) {
-                                    if (bp2)    {
-                                        bp2->next = p;
-                                        p->next = p2;
-                                        if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                                            change_soundrequest(p, 0);
-                                        }
-                                    }
-                                    else    {
-                                        p->next = soundzone[k].req;
-                                        soundzone[k].req = p;
-                                        if ((p->next != NULL) &&
-                                            ((p->next->state & ICO_APC_REQSTATE_WAITREQ)
-                                                == 0)) {
-                                            change_soundrequest(p->next, 0);
-                                        }
-                                    }
-                                    break;
-                                }
-                                bp2 = p2;
-                                p2 = p2->next;
-                            }
-                            if (! p2)   {
-                                if (bp2)    {
-                                    bp2->next = p;
-                                    if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                                        change_soundrequest(p, 0);
-                                    }
-                                }
-                                else    {
-                                    soundzone[k].req = p;
-                                }
-                                p->next = NULL;
-                            }
-                            break;
-                        }
-                    }
-                    bp = p;
-                    p = p->next;
-                }
+    /* re-calculate display zone, sound zone and inout switch priority  */
+    recalc_changed();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   arm_replytimer: arm Ecore timer to the earliest reply deadline
+ *          (static function)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+arm_replytimer(void)
+{
+    ico_apc_request_t   *p;
+    double  delay;
+
+    p = ICO_APC_REQHEAP_TOP(&replyq);
+    if (! p)    {
+        /* no reply wait, no timer  */
+        if (ecore_timer)    {
+            ecore_timer_del(ecore_timer);
+            ecore_timer = NULL;
+        }
+        return;
+    }
+    if ((ecore_timer) && (timer_deadline == p->deadline))   {
+        /* already armed            */
+        return;
+    }
+    if (ecore_timer)    {
+        ecore_timer_del(ecore_timer);
+    }
+    delay = p->deadline - ecore_time_get();
+    if (delay < 0.0)    delay = 0.0;
+    timer_deadline = p->deadline;
+    ecore_timer = ecore_timer_add(delay, request_timer, NULL);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   set_replytimer: start reply wait of request(static function)
+ *
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+set_replytimer(ico_apc_request_t *req)
+{
+    int     timeout;
+    int     lower, upper;
+
+    /* reply timeout adapted to the application   */
+    if ((req->app) && (req->app->reply.timeout > 0))    {
+        timeout = req->app->reply.timeout;
+    }
+    else    {
+        get_replybounds(req->appid, &lower, &upper, NULL);
+        timeout = ICO_APC_REQREPLY_MAXTIME;
+        if (timeout < lower)    timeout = lower;
+        if (timeout > upper)    timeout = upper;
+    }
+    req->replystart = ecore_time_get();
+    if (ico_syc_apc_replyq_set(&replyq, req,
+                               req->replystart + ((double)timeout)/1000.0)
+            != ICO_SYC_EOK) {
+        apfw_warn("set_replytimer: %s reply is not timed", req->appid);
+        return;
+    }
+    arm_replytimer();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   cancel_replytimer: stop reply wait of request(static function)
+ *
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+cancel_replytimer(ico_apc_request_t *req)
+{
+    if (req->tidx < 0)  {
+        return;
+    }
+    ico_syc_apc_replyq_del(&replyq, req);
+    arm_replytimer();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   reply_received: application replied(ACK/NAK) to request,
+ *          record reply latency and stop reply wait(static function)
+ *
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+reply_received(ico_apc_request_t *req)
+{
+    int     lower, upper;
+
+    if (req->tidx < 0)  {
+        /* not waiting reply(already timedout)  */
+        return;
+    }
+    if (req->app)   {
+        get_replybounds(req->appid, &lower, &upper, NULL);
+        req->app->reply.replies ++;
+        update_replystat(&req->app->reply,
+                         (ecore_time_get() - req->replystart) * 1000.0, lower, upper);
+    }
+    cancel_replytimer(req);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   get_replybounds: get bounds of reply timeout of application
+ *          (static function)
+ *
+ * @param[in]   appid           application id
+ * @param[out]  lower           lower bound of reply timeout(ms)
+ * @param[out]  upper           upper bound of reply timeout(ms)
+ * @param[out]  category        category Id of application(-1=unknown, if NULL, no set)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+get_replybounds(const char *appid, int *lower, int *upper, int *category)
+{
+    Ico_Uxf_conf_application    *appconf;
+    Ico_Uxf_conf_category       *cat = NULL;
+
+    appconf = get_appconf(appid);
+    if ((appconf) && (confsys) &&
+        (appconf->categoryId >= 0) && (appconf->categoryId < confsys->categoryNum))  {
+        cat = &confsys->category[appconf->categoryId];
+    }
+    *lower = ((cat) && (cat->replymin > 0)) ? cat->replymin : ICO_APC_REQREPLY_LOWER;
+    *upper = ((cat) && (cat->replymax > 0)) ? cat->replymax : ICO_APC_REQREPLY_UPPER;
+    if (*upper < *lower)    {
+        *upper = *lower;
+    }
+    if (category)   {
+        *category = appconf ? appconf->categoryId : -1;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   update_replystat: add reply latency sample and adapt reply timeout
+ *          (timeout = max(2 * average, 1.5 * 95 percentile) in bounds)
+ *          (static function)
+ *
+ * @param[in]   stat            reply latency statistics of application
+ * @param[in]   latency         reply latency(ms)
+ * @param[in]   lower           lower bound of reply timeout(ms)
+ * @param[in]   upper           upper bound of reply timeout(ms)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+update_replystat(ico_apc_replystat_t *stat, const double latency,
+                 const int lower, const int upper)
+{
+    float   sorted[ICO_APC_REPLYSTAT_SAMPLES];
+    float   v;
+    double  timeout;
+    int     i, j;
+
+    /* average(EWMA)            */
+    if (stat->nsample <= 0) {
+        stat->ewma = latency;
+    }
+    else    {
+        stat->ewma += (latency - stat->ewma) * ICO_APC_REPLYSTAT_WEIGHT;
+    }
+
+    /* 95 percentile of latest samples  */
+    stat->sample[stat->next] = (float)latency;
+    stat->next = (stat->next + 1) % ICO_APC_REPLYSTAT_SAMPLES;
+    if (stat->nsample < ICO_APC_REPLYSTAT_SAMPLES)  {
+        stat->nsample ++;
+    }
+    for (i = 0; i < stat->nsample; i++) {
+        v = stat->sample[i];
+        for (j = i; (j > 0) && (sorted[j-1] > v); j--)  {
+            sorted[j] = sorted[j-1];
+        }
+        sorted[j] = v;
+    }
+    stat->p95 = (int)(sorted[(stat->nsample * 95 - 1) / 100] + 0.5);
+
+    if (stat->nsample < ICO_APC_REPLYSTAT_MINSAMPLE)    {
+        /* not enough samples, initial reply timeout    */
+        timeout = ICO_APC_REQREPLY_MAXTIME;
+    }
+    else    {
+        timeout = stat->ewma * 2.0;
+        if (timeout < (stat->p95 * 1.5))    {
+            timeout = stat->p95 * 1.5;
+        }
+    }
+    if (timeout < lower)    timeout = lower;
+    if (timeout > upper)    timeout = upper;
+    stat->timeout = (int)timeout;
+
+    apfw_trace("update_replystat: latency=%d average=%d p95=%d timeout=%d(%d-%d)",
+               (int)latency, (int)stat->ewma, stat->p95, stat->timeout, lower, upper);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   request_timer: request timedout timer(static function)
+ *
+ * @param[in]   user_data       user data(unused)
+ * @return      always ECORE_CALLBACK_CANCEL(timer is armed again if need)
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+request_timer(void *user_data)
+{
+    ico_apc_request_t   *p;
+    double  now;
+    int     lower, upper;
+
+    /* this timer is deleted by return value    */
+    ecore_timer = NULL;
+    now = ecore_time_get();
+    apfw_trace("request_timer: start(%d)", replyq.num);
+
+    while (((p = ICO_APC_REQHEAP_TOP(&replyq)) != NULL) && (p->deadline <= now))   {
+        ico_syc_apc_replyq_del(&replyq, p);
+
+        /* timedout is sampled as latency of reply timeout(it raises timeout)  */
+        if (p->app) {
+            get_replybounds(p->appid, &lower, &upper, NULL);
+            p->app->reply.timeouts ++;
+            update_replystat(&p->app->reply, (p->deadline - p->replystart) * 1000.0,
+                             lower, upper);
+        }
+
+        if (REQ_IS_DISPLAY(p))  {
+            /* display request timedout */
+            apfw_trace("request_timer: display timedout(%s %d %d prio=%08x)",
+                       p->appid, p->resid, p->id, p->prio);
+            if ((p->state & ICO_APC_REQSTATE_REPLYACTIVE) &&
+                ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
+                ico_uxf_window_control(p->appid, p->id,
+                                       ICO_UXF_APPSCTL_INVISIBLE, 0);
+                if (displaycontrol) {
+                    (*displaycontrol)(get_appconf(p->appid), 1);
+                }
+            }
+        }
+        else if (REQ_IS_SOUND(p))   {
+            /* sound request timedout   */
+            apfw_trace("request_timer: sound timedout(%s %d %d prio=%08x)",
+                       p->appid, p->resid, p->id, p->prio);
+            if ((p->state & ICO_APC_REQSTATE_REPLYACTIVE) &&
+                ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
+                if (soundctl_stage(ICO_APF_SOUND_COMMAND_MUTEOFF, p->pid)
+                        != ICO_APF_RESOURCE_E_NONE) {
+                    apfw_warn("request_timer: send MSM Error");
+                }
+                if (soundcontrol) {
+                    (*soundcontrol)(get_appconf(p->appid), 1);
+                }
+            }
+        }
+        else    {
+            /* input switch request timedout    */
+            apfw_trace("request_timer: input timedout(%s %d %d prio=%08x)",
+                       p->appid, p->resid, p->id, p->prio);
+        }
+        p->state &= ~(ICO_APC_REQSTATE_REPLYACTIVE|ICO_APC_REQSTATE_REPLYQUIET);
+    }
+
+    /* arm timer to next deadline   */
+    arm_replytimer();
+    apfw_trace("request_timer: end(%d)", replyq.num);
+    return ECORE_CALLBACK_CANCEL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_is_waitshow: check if application is waiting show
+ *
+ * @param[in]   appid           application Id
+ * @return      answer
+ * @retval      =1              waiting show
+ * @retval      =0              not wait
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_is_waitshow(const char *appid)
+{
+    ico_apc_apprequest_t    *app;
+    ico_apc_request_t   *p;
+    const char          *atom;
+
+    /* application that is not interned has no request  */
+    atom = ico_uxf_misc_findIntern(appid);
+    if (! atom) {
+        uifw_trace("ico_syc_apc_is_waitshow: %s is not wait", appid);
+        return 0;
+    }
+
+    /* check display request list of the application    */
+    app = get_apprequest(atom, 0);
+    for (p = (app ? app->req : NULL); p; p = p->appnext)    {
+        if (REQ_IS_DISPLAY(p) &&
+            ((p->tidx >= 0) || (p->state & ICO_APC_REQSTATE_NEWREQ)))   {
+            /* found waiting show   */
+            uifw_trace("ico_syc_apc_is_waitshow: %s is waiting", appid);
+            return 1;
+        }
+    }
+    uifw_trace("ico_syc_apc_is_waitshow: %s is not wait", appid);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_active: application change to active
+ *
+ * @param[in]   appid           application Id
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_active(const char *appid)
+{
+    unsigned int    lastepoch;
+    unsigned int    newepoch;
+    Ico_Uxf_conf_application    *appconf;
+    ico_apc_apprequest_t        *app;
+    char    *child_appid;
+    ico_apc_reqheap_t   *heap;
+    ico_apc_request_t   *p;
+    ico_apc_request_t   *p2;
+    ico_apc_request_t   *top;
+
+    apfw_trace("ico_syc_apc_active: Enter(%s)", appid ? appid : "(NULL)");
+
+    if ((appid != NULL) && (*appid != 0))   {
+        /* get active application           */
+        appconf = (Ico_Uxf_conf_application *)ico_uxf_getAppByAppid(appid);
+        if (! appconf)  {
+            apfw_trace("ico_syc_apc_active: appid(%s) dose not exist", appid);
+        }
+    }
+    else    {
+        /* chane to no active application   */
+        appconf = NULL;
+    }
+
+    if (appconf)    {
+        /* save child process if exist          */
+        child_appid = ico_uxf_getchild_appid(appconf->appid);
+        /* set last active process for child process    */
+        ico_uxf_set_lastapp(appconf->appid);
+        app = get_apprequest(appconf->appid, 0);
+    }
+    else    {
+        /* reset last active process for child process  */
+        ico_uxf_set_lastapp(NULL);
+        child_appid = NULL;
+        app = NULL;
+    }
+
+    /* change all screen, sound and input switch request from this application */
+    lastepoch = active_epoch;
+    newepoch = 0;
+    for (p = (app ? app->req : NULL); p; p = p->appnext)    {
+        if ((p->actepoch != 0) && (p->actepoch == lastepoch))   continue;
+
+        if (REQ_IS_DISPLAY(p))  {
+            heap = &dispzone[p->zoneidx].heap;
+            dispzone[p->zoneidx].change = 1;
+        }
+        else if (REQ_IS_SOUND(p))   {
+            heap = &soundzone[p->zoneidx].heap;
+            soundzone[p->zoneidx].change = 1;
+        }
+        else    {
+            heap = &inputsw[p->zoneidx].heap;
+            inputsw[p->zoneidx].change = 1;
+        }
+        top = ICO_APC_REQHEAP_TOP(heap);
+        apfw_trace("ico_syc_apc_active: %s prio=%08x is %s",
+                   p->appid, p->prio, (top == p) ? "top" : "not top");
+
+        /* newest active application, other active applications are aged by epoch */
+        if (newepoch == 0)  {
+            newepoch = ++active_epoch;
+        }
+        p->actepoch = newepoch;
+        apfw_trace("ico_syc_apc_active: cgange active %s epoch to %u", p->appid, p->actepoch);
+        ico_syc_apc_reqheap_update(heap, p, 1);
+
+        if (top == p)   {
+            apfw_trace("ico_syc_apc_active: app %s is top", p->appid);
+            continue;
+        }
+        top = ICO_APC_REQHEAP_TOP(heap);
+        if (top != p)   {
+            apfw_trace("ico_syc_apc_active: %s is not top=%s(%08x)",
+                       p->appid, top->appid, top->prio);
+            continue;
+        }
+        /* application became top, stop old top         */
+        p2 = ico_syc_apc_reqheap_next(heap);
+        if ((p2 != NULL) && (p2->appatom != appconf->appid) &&
+            ((p2->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
+            if (REQ_IS_DISPLAY(p2)) {
+                change_disprequest(p2, 0);
+            }
+            else if (REQ_IS_SOUND(p2))  {
+                change_soundrequest(p2, 0);
+            }
+            else    {
+                change_inputrequest(p2, 0);
+            }
+        }
+    }
+
+    /* re-calculate display zone, sound zone and inout switch priority  */
+    recalc_changed();
+    if (child_appid)    {
+        apfw_trace("ico_syc_apc_active: active child app(%s)", child_appid);
+        ico_syc_apc_active(child_appid);
+    }
+    apfw_trace("ico_syc_apc_active: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_batch: set batch arbitration mode.
+ *          in batch arbitration, requests received in a main loop turn are
+ *          arbitrated at once for each display and sound at the end of the
+ *          turn, and only final show/hide(active/mute) changes are sent
+ *
+ * @param[in]   batch           batch arbitration(1) or arbitration by each request(0)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_batch(const int batch)
+{
+    apfw_trace("ico_syc_apc_batch: Enter(%d->%d)", batch_mode, batch);
+
+    batch_mode = batch ? 1 : 0;
+    if ((! batch_mode) && (batch_idler))    {
+        /* arbitrate deferred requests now  */
+        ecore_idle_enterer_del(batch_idler);
+        batch_idler = NULL;
+        recalc_changed();
+    }
+    apfw_trace("ico_syc_apc_batch: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_batch_stats: get statistics of batch arbitration
+ *
+ * @param[out]  stats           statistics of batch arbitration
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_batch_stats(ico_apc_batch_stats_t *stats)
+{
+    if (stats)  {
+        memcpy(stats, &batch_stats, sizeof(ico_apc_batch_stats_t));
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_soundctl_stats: get statistics of staged Multi Sound
+ *          Manager commands
+ *
+ * @param[out]  stats           statistics of sound commands
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_soundctl_stats(ico_apc_soundctl_stats_t *stats)
+{
+    if (stats)  {
+        memcpy(stats, &soundctl_stats, sizeof(ico_apc_soundctl_stats_t));
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_reply_stats: get reply latency statistics of application
+ *          (for tuning of reply timeout bounds of category)
+ *
+ * @param[in]   appid           application Id
+ * @param[out]  stats           reply latency statistics
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_EINVAL  illegal parameter
+ * @retval      ICO_SYC_ENOENT  application has never made request
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_reply_stats(const char *appid, ico_apc_reply_stats_t *stats)
+{
+    ico_apc_apprequest_t    *app;
+    const char              *atom;
+
+    if ((! appid) || (! stats)) {
+        return ICO_SYC_EINVAL;
+    }
+    atom = ico_uxf_misc_findIntern(appid);
+    app = atom ? get_apprequest(atom, 0) : NULL;
+    if (! app)  {
+        return ICO_SYC_ENOENT;
+    }
+    memset(stats, 0, sizeof(ico_apc_reply_stats_t));
+    get_replybounds(appid, &stats->lower, &stats->upper, &stats->category);
+    stats->replies = app->reply.replies;
+    stats->timeouts = app->reply.timeouts;
+    stats->average = (int)(app->reply.ewma + 0.5);
+    stats->p95 = app->reply.p95;
+    stats->timeout = app->reply.timeout;
+    if (stats->timeout <= 0)    {
+        stats->timeout = ICO_APC_REQREPLY_MAXTIME;
+        if (stats->timeout < stats->lower)  stats->timeout = stats->lower;
+        if (stats->timeout > stats->upper)  stats->timeout = stats->upper;
+    }
+    return ICO_SYC_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_prelaunch: HomeScreen launches application in background
+ *          (pre-launch), or the pre-launch ends. main window of pre-launched
+ *          application is not requested display until the user uses it, so it
+ *          does not take display zone from the foreground application
+ *
+ * @param[in]   appid           application Id
+ * @param[in]   prelaunch       ICO_SYC_APC_PRELAUNCH_START(launched in background)/
+ *                              ICO_SYC_APC_PRELAUNCH_END(used, request display)/
+ *                              ICO_SYC_APC_PRELAUNCH_CANCEL(evicted, no display)
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_EINVAL  illegal parameter
+ * @retval      ICO_SYC_ENOENT  application dose not exist
+ * @retval      ICO_SYC_ENOMEM  out of memory
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_prelaunch(const char *appid, const int prelaunch)
+{
+    const Ico_Uxf_conf_application  *appconf;
+    ico_apc_apprequest_t    *app;
+    int     hold;
+
+    apfw_trace("ico_syc_apc_prelaunch: Enter(%s,%d)", appid ? appid : "(NULL)", prelaunch);
+
+    if ((! appid) || (prelaunch < ICO_SYC_APC_PRELAUNCH_END) ||
+        (prelaunch > ICO_SYC_APC_PRELAUNCH_CANCEL)) {
+        apfw_warn("ico_syc_apc_prelaunch: Leave(EINVAL)");
+        return ICO_SYC_EINVAL;
+    }
+    appconf = ico_uxf_getAppByAppid(appid);
+    if (! appconf)  {
+        apfw_warn("ico_syc_apc_prelaunch: Leave(appid[%s] dose not exist)", appid);
+        return ICO_SYC_ENOENT;
+    }
+
+    app = get_apprequest(appconf->appid, prelaunch == ICO_SYC_APC_PRELAUNCH_START);
+    if (prelaunch == ICO_SYC_APC_PRELAUNCH_START)   {
+        if (! app)  {
+            apfw_warn("ico_syc_apc_prelaunch: Leave(ENOMEM)");
+            return ICO_SYC_ENOMEM;
+        }
+        if (app->prelaunch == ICO_APC_PRELAUNCH_NONE)   {
+            app->prelaunch = ICO_APC_PRELAUNCH_WAIT;
+        }
+        apfw_trace("ico_syc_apc_prelaunch: Leave(EOK)");
+        return ICO_SYC_EOK;
+    }
+
+    if ((! app) || (app->prelaunch == ICO_APC_PRELAUNCH_NONE))  {
+        apfw_trace("ico_syc_apc_prelaunch: Leave(not pre-launched)");
+        return ICO_SYC_EOK;
+    }
+    hold = (app->prelaunch == ICO_APC_PRELAUNCH_HOLD);
+    app->prelaunch = ICO_APC_PRELAUNCH_NONE;
+    if ((hold) && (prelaunch == ICO_SYC_APC_PRELAUNCH_END)) {
+        /* main window was created in background, request display now  */
+        app_defaultdisplay(appconf);
+    }
+    apfw_trace("ico_syc_apc_prelaunch: Leave(EOK)");
+    return ICO_SYC_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   app_display_hook: hook function for surface create/destroy(static function)
+ *
+ * @param[in]   appid           application Id
+ * @param[in]   surface         surface Id
+ * @param[in]   object          target surface type and operation
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+app_display_hook(const char *appid, const int surface, const int object)
+{
+    Ico_Uxf_conf_application    *appconf;
+    ico_apc_apprequest_t        *app;
+    ico_apc_request_t           *req;
+    ico_apc_request_t           *next;
+
+    apfw_trace("app_display_hook: Enter(%s,%08x,%x)", appid, surface, object);
+
+    appconf = (Ico_Uxf_conf_application *)ico_uxf_getAppByAppid(appid);
+    if (! appconf)  {
+        apfw_warn("app_display_hook: Leave(appid[%s] dose not exist)", appid);
+        return;
+    }
+    if ((confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_ALMIGHTY) ||
+        (confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_SYSTEM) ||
+        (confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_SYSTEM_VISIBLE))  {
+        /* System Program(ex. HomeScreen) no need resource control  */
+        apfw_trace("app_display_hook: Leave(appid[%s] is system program)", appid);
+        return;
+    }
+
+    switch (object) {
+    case ICO_UXF_HOOK_WINDOW_CREATE_MAIN:   /* created application main window  */
+        /* search display request   */
+        app = get_apprequest(appconf->appid, 0);
+        for (req = (app ? app->req : NULL); req; req = req->appnext) {
+            if ((req->resid == ICO_APF_RESID_BASIC_SCREEN) ||
+                (req->resid == ICO_APF_RESID_ON_SCREEN))    break;
+        }
+        if (req)    {
+            apfw_trace("app_display_hook: app(%s) requested display, Nop", appid);
+        }
+        else if ((app) && (app->prelaunch != ICO_APC_PRELAUNCH_NONE))   {
+            /* pre-launched application is hidden until the user uses it   */
+            apfw_trace("app_display_hook: app(%s) is pre-launched, hold display", appid);
+            app->prelaunch = ICO_APC_PRELAUNCH_HOLD;
+        }
+        else    {
+            app_defaultdisplay(appconf);
+        }
+        break;
+    case ICO_UXF_HOOK_WINDOW_DESTORY_MAIN:  /* destoryed application main window*/
+        /* delete all request from this application */
+        app = get_apprequest(appconf->appid, 0);
+        if ((app) && (app->prelaunch == ICO_APC_PRELAUNCH_HOLD))    {
+            app->prelaunch = ICO_APC_PRELAUNCH_WAIT;
+        }
+        if (app)    {
+            apfw_trace("app_display_hook: free app(%s) all display request", appid);
+            for (req = app->req; req; req = next)   {
+                next = req->appnext;
+                if (REQ_IS_DISPLAY(req))    {
+                    app_freedisplay(req, 0);
+                }
+            }
+        }
+        break;
+    default:                                /* other, Nop   */
+        break;
+    }
+
+    apfw_trace("app_display_hook: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   app_defaultdisplay: request default display zone for main window of
+ *          application that did not request display(static function)
+ *
+ * @param[in]   appconf         application configuration
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+app_defaultdisplay(const Ico_Uxf_conf_application *appconf)
+{
+    ico_apc_request_t           *req;
+    const Ico_Uxf_conf_display_zone *zone;
+
+    zone = app_dispzone(appconf);
+    if (! zone) {
+        apfw_warn("app_defaultdisplay: app(%s) has no display zone", appconf->appid);
+        return;
+    }
+    apfw_trace("app_defaultdisplay: app(%s) not requested display, set default[%s]",
+               appconf->appid, zone->name);
+    req = get_freereq();
+    if (req)    {
+        strncpy(req->appid, appconf->appid, ICO_UXF_MAX_PROCESS_NAME);
+        req->appatom = appconf->appid;
+        req->resid = ICO_APF_RESID_BASIC_SCREEN;
+        req->reqtype = ICO_APC_REQTYPE_CREATE;
+        strncpy(req->device, zone->name, ICO_UXF_MAX_DEVICE_NAME);
+        app_getdisplay(req, 0);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   app_dispzone: default display zone of application(static function)
+ *          display and zone id of application configuration may be out of
+ *          current system configuration after live reload, then default zone
+ *          of system configuration is used
+ *
+ * @param[in]   appconf         application configuration
+ * @return      display zone
+ * @retval      != NULL         success(display zone in current configuration)
+ * @retval      NULL            error(no display zone)
+ */
+/*--------------------------------------------------------------------------*/
+static const Ico_Uxf_conf_display_zone *
+app_dispzone(const Ico_Uxf_conf_application *appconf)
+{
+    int     displayId = appconf->display[0].displayId;
+    int     zoneId = appconf->display[0].zoneId;
+
+    if ((displayId < 0) || (displayId >= confsys->displayNum) ||
+        (zoneId < 0) || (zoneId >= confsys->display[displayId].zoneNum))    {
+        apfw_trace("app_dispzone: %s zone(%d.%d) is not in configuration",
+                   appconf->appid, displayId, zoneId);
+        displayId = confsys->misc.default_displayId;
+        zoneId = confsys->misc.default_dispzoneId;
+        if ((displayId < 0) || (displayId >= confsys->displayNum) ||
+            (zoneId < 0) || (zoneId >= confsys->display[displayId].zoneNum))    {
+            return NULL;
+        }
+    }
+    return &confsys->display[displayId].zone[zoneId];
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   find_dispzone: find display zone in system configuration(static function)
+ *          zone is compared by display name and zone name, because index and id
+ *          may be changed by live reload of system configuration
+ *
+ * @param[in]   conf            system configuration
+ * @param[in]   zone            display zone(in other system configuration)
+ * @return      zone index
+ * @retval      >= 0            success(zone index in conf)
+ * @retval      -1              zone dose not exist
+ */
+/*--------------------------------------------------------------------------*/
+static int
+find_dispzone(const Ico_Uxf_Sys_Config *conf, const Ico_Uxf_conf_display_zone *zone)
+{
+    int     i, j;
+
+    for (i = 0; i < conf->displayNum; i++)  {
+        if (strcasecmp(conf->display[i].name, zone->display->name) != 0)   continue;
+        for (j = 0; j < conf->display[i].zoneNum; j++) {
+            if (strcasecmp(conf->display[i].zone[j].name, zone->name) == 0)    {
+                return conf->display[i].zone[j].zoneidx;
+            }
+        }
+        break;
+    }
+    return -1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   find_soundzone: find sound zone in system configuration(static function)
+ *
+ * @param[in]   conf            system configuration
+ * @param[in]   zone            sound zone(in other system configuration)
+ * @return      zone index
+ * @retval      >= 0            success(zone index in conf)
+ * @retval      -1              zone dose not exist
+ */
+/*--------------------------------------------------------------------------*/
+static int
+find_soundzone(const Ico_Uxf_Sys_Config *conf, const Ico_Uxf_conf_sound_zone *zone)
+{
+    int     i, j;
+
+    for (i = 0; i < conf->soundNum; i++)    {
+        if (strcasecmp(conf->sound[i].name, zone->sound->name) != 0)   continue;
+        for (j = 0; j < conf->sound[i].zoneNum; j++)   {
+            if (strcasecmp(conf->sound[i].zone[j].name, zone->name) == 0)  {
+                return conf->sound[i].zone[j].zoneidx;
             }
         }
+        break;
     }
+    return -1;
+}
 
-    if (control.input != ICO_SYC_APC_REGULATION_NOCHANGE)   {
-        /* input reguration control     */
-        apfw_trace("regulation_listener: input category=%d input=%d",
-                   appcategory, control.input);
-        for (i = 0; i < confapp->applicationNum; i++)   {
-            if (confapp->application[i].categoryId != appcategory)  continue;
-            for (k = 0; k < ninputsw; k++)    {
-                p = inputsw[k].req;
-                if (!p) continue;
-                bp = NULL;
-                while (p)   {
-                    if (strcmp(p->appid, confapp->application[i].appid) == 0)    {
-                        flag = 0;
-                        if (control.input == ICO_SYC_APC_REGULATION_REGULATION) {
-                            if (p->prio & ICO_UXF_PRIO_REGULATION)  {
-                                p->prio &= ~ICO_UXF_PRIO_REGULATION;
-                                flag ++;
-                                if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                                    change_inputrequest(p, 0);
-                                }
-                            }
-                        }
-                        else    {
-                            if ((p->prio & ICO_UXF_PRIO_REGULATION) == 0)   {
-                                p->prio |= ICO_UXF_PRIO_REGULATION;
-                                flag ++;
-                            }
-                        }
-                        if (flag)   {
-                            apfw_trace("regulation_listener: input change category=%d "
-                                       "app(%s) input=%d prio=%08x",
-                                       appcategory, p->appid, control.input, p->prio);
-                            for (j = 0; j < sound; j++)  {
-                                if (inputsw[k].inputsw->input == reqinput[j])    break;
-                            }
-                            if (j >= input)  {
-                                reqinput[input++] = inputsw[k].inputsw->input;
-                            }
-                            apfw_trace("regulation_listener: input %s %08x %08x",
-                                       p->appid, p->prio, (int)bp);
-                            if (bp) {
-                                bp->next = p->next;
-                            }
-                            else    {
-                                inputsw[k].req = p->next;
-                            }
-                            p2 = inputsw[k].req;
-                            bp2 = NULL;
-                            while (p2)  {
-                                if (p2->prio < p->prio) {
-                                    if (bp2)    {
-                                        bp2->next = p;
-                                        p->next = p2;
-                                        if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                                            change_inputrequest(p, 0);
-                                        }
-                                    }
-                                    else    {
-                                        p->next = inputsw[k].req;
-                                        inputsw[k].req = p;
-                                    }
-                                    break;
-                                }
-                                bp2 = p2;
-                                p2 = p2->next;
-                            }
-                            if (! p2)   {
-                                if (bp2)    {
-                                    bp2->next = p;
-                                    if ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0) {
-                                        change_inputrequest(p, 0);
-                                    }
-                                }
-                                else    {
-                                    inputsw[k].req = p;
-                                }
-                                p->next = NULL;
-                            }
-                            break;
-                        }
-                    }
-                    bp = p;
-                    p = p->next;
-                }
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   make_dispzone: make display zone table from system configuration
+ *          (static function, current table is not changed)
+ *
+ * @param[in]   conf            system configuration
+ * @param[out]  zone            new display zone table
+ * @param[out]  zoneset         new zone set table(index of conf->display)
+ * @param[out]  num             number of display zones
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_ENOMEM  error(out of memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+make_dispzone(const Ico_Uxf_Sys_Config *conf, ico_apc_dispzone_t **zone,
+              ico_apc_zoneset_t **zoneset, int *num)
+{
+    ico_apc_dispzone_t          *newzone;
+    ico_apc_zoneset_t           *newset;
+    int     count;
+    int     i, j, k;
+
+    count = 0;
+    for (i = 0; i < conf->displayNum; i++)  {
+        count += conf->display[i].zoneNum;
+    }
+    newzone = malloc(sizeof(ico_apc_dispzone_t) * (count + 1));
+    newset = malloc(sizeof(ico_apc_zoneset_t) * (conf->displayNum + 1));
+    if ((! newzone) || (! newset))  {
+        free(newzone);
+        free(newset);
+        return ICO_SYC_ENOMEM;
+    }
+    memset(newzone, 0, sizeof(ico_apc_dispzone_t) * (count + 1));
+    memset(newset, 0, sizeof(ico_apc_zoneset_t) * (conf->displayNum + 1));
+
+    count = 0;
+    for (i = 0; i < conf->displayNum; i++)  {
+        /* compile overlap zones to bitset  */
+        newset[i].zonebase = count;
+        newset[i].zoneNum = conf->display[i].zoneNum;
+        for (j = 0; j < conf->display[i].zoneNum; j++)  {
+            newzone[count].conf = &conf->display[i].zone[j];
+            newzone[count].zoneset = &newset[i];
+            newzone[count].zoneno = j;
+            for (k = 0; k < conf->display[i].zone[j].overlapNum; k++)   {
+                newset[i].overlap[j] |= ICO_APC_ZONEBIT(conf->display[i].zone[j].overlap[k]);
             }
+            count ++;
         }
     }
+    *zone = newzone;
+    *zoneset = newset;
+    *num = count;
 
-    /* re-calculate display zone, sound zone and inout switch priority  */
-    for (i = 0; i < disp; i++)  {
-        recalc_dispzone(reqdisp[i]);
-    }
-    for (i = 0; i < sound; i++) {
-        recalc_soundzone(reqsound[i]);
-    }
-    for (i = 0; i < input; i++) {
-        recalc_inputsw(reqinput[i]);
-    }
+    return ICO_SYC_EOK;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   request_timer: request timedout timer(static function)
+ * @brief   switch_dispzone: move requests from current display zone table to
+ *          new table, and change current table to new table(static function)
+ *          (requests of the zones that were removed must be released before)
  *
- * @param[in]   user_data       user data(unused)
- * @return      always ECORE_CALLBACK_RENEW(periodic timer)
+ * @param[in]   conf            system configuration of new table
+ * @param[in]   newzone         new display zone table(made by make_dispzone)
+ * @param[in]   newset          new zone set table
+ * @param[in]   num             number of display zones of new table
+ * @param[out]  changed         changed display flags(index of conf->display)
+ *                              (if NULL, no check)
+ * @return      none
  */
 /*--------------------------------------------------------------------------*/
-static Eina_Bool
-request_timer(void *user_data)
+static void
+switch_dispzone(const Ico_Uxf_Sys_Config *conf, ico_apc_dispzone_t *newzone,
+                ico_apc_zoneset_t *newset, const int num, char *changed)
 {
-    int                 i;
-    ico_apc_request_t   *p;
-
-    if (timer_count <= 0)   {
-        /* no need timedout check   */
-        return ECORE_CALLBACK_RENEW;
-    }
-    apfw_trace("request_timer: start(%d)", timer_count);
-    timer_count = 0;
+    Ico_Uxf_conf_display_zone   *ozone;
+    Ico_Uxf_conf_display_zone   *nzone;
+    int     i, j, k;
+    int     idx;
 
-    /* check display request timedout   */
+    /* move requests from current table(change is used as moved flag)   */
     for (i = 0; i < ndispzone; i++) {
-        p = dispzone[i].req;
-        while (p)   {
-            if (p->timer > 0)   {
-                if (p->timer >= ICO_APC_REQREPLY_INTERVAL)
-                    p->timer -= ICO_APC_REQREPLY_INTERVAL;
-                else
-                    p->timer = 0;
-                apfw_trace("request_timer: dispzone[%d] timer(%d)", i, p->timer);
-                if (p->timer == 0)  {
-                    apfw_trace("request_timer: display timedout(%s %d %d prio=%08x)",
-                               p->appid, p->resid, p->id, p->prio);
-                    if ((p->state & ICO_APC_REQSTATE_REPLYACTIVE) &&
-                        ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
-                        ico_uxf_window_control(p->appid, p->id,
-                                               ICO_UXF_APPSCTL_INVISIBLE, 0);
-                        if (displaycontrol) {
-                            (*displaycontrol)(get_appconf(p->appid), 1);
-                        }
+        ozone = dispzone[i].conf;
+        idx = find_dispzone(conf, ozone);
+        if (idx < 0)    {
+            /* removed zone, display of the zone is changed */
+            if (changed)    {
+                for (j = 0; j < conf->displayNum; j++)  {
+                    if (strcasecmp(conf->display[j].name, ozone->display->name) == 0)  {
+                        changed[j] = 1;
                     }
-                    p->state &= ~(ICO_APC_REQSTATE_REPLYACTIVE|ICO_APC_REQSTATE_REPLYQUIET);
-                }
-                else    {
-                    timer_count ++;
                 }
             }
-            p = p->next;
+            ico_syc_apc_reqheap_free(&dispzone[i].heap);
+            continue;
+        }
+        newzone[idx].change = 1;
+        newzone[idx].heap = dispzone[i].heap;
+        for (k = 0; k < newzone[idx].heap.num; k++)  {
+            newzone[idx].heap.req[k]->zoneidx = idx;
+        }
+        if (! changed)  continue;
+
+        /* check zone geometry and overlap zones    */
+        nzone = newzone[idx].conf;
+        if ((nzone->x != ozone->x) || (nzone->y != ozone->y) ||
+            (nzone->width != ozone->width) || (nzone->height != ozone->height) ||
+            (nzone->overlapNum != ozone->overlapNum))   {
+            changed[nzone->display - conf->display] = 1;
+            continue;
+        }
+        for (k = 0; k < nzone->overlapNum; k++) {
+            if (strcasecmp(nzone->display->zone[nzone->overlap[k]].name,
+                           ozone->display->zone[ozone->overlap[k]].name) != 0)   {
+                changed[nzone->display - conf->display] = 1;
+                break;
+            }
         }
     }
-
-    /* check sound request timedout */
-    for (i = 0; i < nsoundzone; i++) {
-        p = soundzone[i].req;
-        while (p)   {
-            if (p->timer > 0)   {
-                if (p->timer >= ICO_APC_REQREPLY_INTERVAL)
-                    p->timer -= ICO_APC_REQREPLY_INTERVAL;
-                else
-                    p->timer = 0;
-                apfw_trace("request_timer: soundzone[%d] timer(%d)", i, p->timer);
-                if (p->timer == 0)  {
-                    apfw_trace("request_timer: sound timedout(%s %d %d prio=%08x)",
-                               p->appid, p->resid, p->id, p->prio);
-                    if ((p->state & ICO_APC_REQSTATE_REPLYACTIVE) &&
-                        ((p->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
-                        if (ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_MUTEOFF,
-                                                              p->pid)
-                                != ICO_APF_RESOURCE_E_NONE) {
-                            apfw_warn("request_timer: send MSM Error");
-                        }
-                        if (soundcontrol) {
-                            (*soundcontrol)(get_appconf(p->appid), 1);
-                        }
-                    }
-                    p->state &= ~(ICO_APC_REQSTATE_REPLYACTIVE|ICO_APC_REQSTATE_REPLYQUIET);
-                }
-                else    {
-                    timer_count ++;
-                }
+    /* added zone, display of the zone is changed   */
+    if ((changed) && (dispzone))    {
+        for (idx = 0; idx < num; idx++) {
+            if (! newzone[idx].change)  {
+                changed[newzone[idx].conf->display - conf->display] = 1;
             }
-            p = p->next;
         }
     }
-    apfw_trace("request_timer: end(%d)", timer_count);
-    return ECORE_CALLBACK_RENEW;
+
+    /* zones that have requests     */
+    for (idx = 0; idx < num; idx++) {
+        newzone[idx].change = 0;
+        set_zoneoccupied(newzone[idx].zoneset, newzone[idx].zoneno, &newzone[idx].heap);
+    }
+
+    free(dispzone);
+    dispzone = newzone;
+    ndispzone = num;
+    free(dispzoneset);
+    dispzoneset = newset;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_syc_apc_is_waitshow: check if application is waiting show
+ * @brief   make_soundzone: make sound zone table from system configuration
+ *          (static function, current table is not changed)
  *
- * @param[in]   appid           application Id
- * @return      answer
- * @retval      =1              waiting show
- * @retval      =0              not wait
+ * @param[in]   conf            system configuration
+ * @param[out]  zone            new sound zone table
+ * @param[out]  zoneset         new zone set table(index of conf->sound)
+ * @param[out]  num             number of sound zones
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_ENOMEM  error(out of memory)
  */
 /*--------------------------------------------------------------------------*/
-int
-ico_syc_apc_is_waitshow(const char *appid)
+static int
+make_soundzone(const Ico_Uxf_Sys_Config *conf, ico_apc_soundzone_t **zone,
+               ico_apc_zoneset_t **zoneset, int *num)
 {
-    int                 i;
-    ico_apc_request_t   *p;
+    ico_apc_soundzone_t         *newzone;
+    ico_apc_zoneset_t           *newset;
+    int     count;
+    int     i, j, k;
 
-    /* check display request list   */
-    for (i = 0; i < ndispzone; i++) {
-        p = dispzone[i].req;
-        while (p)   {
-            if (p->timer > 0)   {
-                /* waiting show         */
-                if (strcmp(p->appid, appid) == 0)   {
-                    /* found application    */
-                    uifw_trace("ico_syc_apc_is_waitshow: %s is waiting", appid);
-                    return 1;
-                }
+    count = 0;
+    for (i = 0; i < conf->soundNum; i++)    {
+        count += conf->sound[i].zoneNum;
+    }
+    newzone = malloc(sizeof(ico_apc_soundzone_t) * (count + 1));
+    newset = malloc(sizeof(ico_apc_zoneset_t) * (conf->soundNum + 1));
+    if ((! newzone) || (! newset))  {
+        free(newzone);
+        free(newset);
+        return ICO_SYC_ENOMEM;
+    }
+    memset(newzone, 0, sizeof(ico_apc_soundzone_t) * (count + 1));
+    memset(newset, 0, sizeof(ico_apc_zoneset_t) * (conf->soundNum + 1));
+
+    count = 0;
+    for (i = 0; i < conf->soundNum; i++)    {
+        /* compile overlap zones to bitset  */
+        newset[i].zonebase = count;
+        newset[i].zoneNum = conf->sound[i].zoneNum;
+        for (j = 0; j < conf->sound[i].zoneNum; j++)    {
+            newzone[count].conf = &conf->sound[i].zone[j];
+            newzone[count].zoneset = &newset[i];
+            newzone[count].zoneno = j;
+            for (k = 0; k < conf->sound[i].zone[j].overlapNum; k++)   {
+                newset[i].overlap[j] |= ICO_APC_ZONEBIT(conf->sound[i].zone[j].overlap[k]);
             }
-            p = p->next;
+            count ++;
         }
     }
-    uifw_trace("ico_syc_apc_is_waitshow: %s is not wait", appid);
-    return 0;
+    *zone = newzone;
+    *zoneset = newset;
+    *num = count;
+
+    return ICO_SYC_EOK;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_syc_apc_active: application change to active
+ * @brief   switch_soundzone: move requests from current sound zone table to
+ *          new table, and change current table to new table(static function)
+ *          (requests of the zones that were removed must be released before)
  *
- * @param[in]   appid           application Id
+ * @param[in]   conf            system configuration of new table
+ * @param[in]   newzone         new sound zone table(made by make_soundzone)
+ * @param[in]   newset          new zone set table
+ * @param[in]   num             number of sound zones of new table
+ * @param[out]  changed         changed sound flags(index of conf->sound)
+ *                              (if NULL, no check)
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
-void
-ico_syc_apc_active(const char *appid)
+static void
+switch_soundzone(const Ico_Uxf_Sys_Config *conf, ico_apc_soundzone_t *newzone,
+                 ico_apc_zoneset_t *newset, const int num, char *changed)
 {
-    int     i, j;
-    int     disp, sound, input;
-    int     flag;
-    Ico_Uxf_conf_application    *appconf;
-    char    *child_appid;
-    ico_apc_request_t   *p;
-    ico_apc_request_t   *bp;
-    ico_apc_request_t   *p2;
-    ico_apc_request_t   *bp2;
-    unsigned short  reqdisp[MAXREQ];
-    unsigned short  reqsound[MAXREQ];
-    unsigned short  reqinput[MAXREQ];
-
-    apfw_trace("ico_syc_apc_active: Enter(%s)", appid ? appid : "(NULL)");
-
-    if ((appid != NULL) && (*appid != 0))   {
-        /* get active application           */
-        appconf = (Ico_Uxf_conf_application *)ico_uxf_getAppByAppid(appid);
-        if (! appconf)  {
-            apfw_trace("ico_syc_apc_active: appid(%s) dose not exist", appid);
-        }
-    }
-    else    {
-        /* chane to no active application   */
-        appconf = NULL;
-    }
-
-    if (appconf)    {
-        /* save child process if exist          */
-        child_appid = ico_uxf_getchild_appid(appconf->appid);
-        /* set last active process for child process    */
-        ico_uxf_set_lastapp(appconf->appid);
-    }
-    else    {
-        /* reset last active process for child process  */
-        ico_uxf_set_lastapp(NULL);
-        child_appid = NULL;
-    }
+    Ico_Uxf_conf_sound_zone     *ozone;
+    Ico_Uxf_conf_sound_zone     *nzone;
+    int     i, j, k;
+    int     idx;
 
-    /* change all screen request from this application  */
-    disp = 0;
-    for (i = 0; i < ndispzone; i++) {
-        p = dispzone[i].req;
-        flag = 0;
-        bp = NULL;
-        while (p)   {
-            if (appconf && (strcmp(p->appid, appconf->appid) == 0)) {
-                apfw_trace("ico_syc_apc_active: disp %s prio=%08x is %s",
-                           p->appid, p->prio, bp ? "not top" : "top");
-                if ((p->prio & ICO_UXF_PRIO_ACTIVEAPP) != ICO_UXF_PRIO_ACTIVEAPP)   {
-                    p->prio |= ICO_UXF_PRIO_ACTIVEAPP;
-                    apfw_trace("ico_syc_apc_active: cgange active %s prio to %08x",
-                               p->appid, p->prio);
-                    flag ++;
-
-                    if (bp) {
-                        bp->next = p->next;
-                        p2 = dispzone[i].req;
-                        bp2 = NULL;
-                        while (p2)  {
-                            if (p2->prio <= p->prio)    {
-                                p->next = p2;
-                                if (bp2) {
-                                    apfw_trace("ico_syc_apc_active: %s is not top=%s(%08x)",
-                                               p->appid, dispzone[i].req->appid,
-                                               dispzone[i].req->prio);
-                                    bp2->next = p;
-                                }
-                                else    {
-                                    if (appconf && (strcmp(p2->appid, appconf->appid) != 0) &&
-                                        ((p2->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
-                                        change_disprequest(p2, 0);
-                                    }
-                                    dispzone[i].req = p;
-                                }
-                                break;
-                            }
-                            bp2 = p2;
-                            p2 = p2->next;
-                        }
-                        if (! p2)   {
-                            apfw_trace("ico_syc_apc_active: %s is not top=%s(%08x)",
-                                       p->appid, dispzone[i].req->appid,
-                                       dispzone[i].req->prio);
-                            if (bp2)    {
-                                bp2->next = p;
-                            }
-                            else    {
-                                dispzone[i].req = p;
-                            }
-                            p->next = NULL;
-                        }
-                    }
-                    else    {
-                        apfw_trace("ico_syc_apc_active: app %s is top", p->appid);
+    /* move requests from current table(change is used as moved flag)   */
+    for (i = 0; i < nsoundzone; i++)    {
+        ozone = soundzone[i].conf;
+        idx = find_soundzone(conf, ozone);
+        if (idx < 0)    {
+            /* removed zone, sound of the zone is changed   */
+            if (changed)    {
+                for (j = 0; j < conf->soundNum; j++)    {
+                    if (strcasecmp(conf->sound[j].name, ozone->sound->name) == 0)  {
+                        changed[j] = 1;
                     }
                 }
             }
-            bp = p;
-            p = p->next;
+            ico_syc_apc_reqheap_free(&soundzone[i].heap);
+            continue;
         }
-        if (flag)   {
-            p = dispzone[i].req;
-            while (p)   {
-                if (p->prio & ICO_UXF_PRIO_ACTIVEAPP)  {
-                    p->prio -= ICO_UXF_PRIO_ACTIVECOUNT;
-                }
-                p = p->next;
-            }
-
-            for (j = 0; j < disp; j++)  {
-                if (dispzone[i].conf->display->id == reqdisp[j])    break;
-            }
-            if (j >= disp)  {
-                reqdisp[disp++] = dispzone[i].conf->display->id;
-            }
+        newzone[idx].change = 1;
+        newzone[idx].heap = soundzone[i].heap;
+        for (k = 0; k < newzone[idx].heap.num; k++)  {
+            newzone[idx].heap.req[k]->zoneidx = idx;
         }
-    }
+        if (! changed)  continue;
 
-    /* change all sound request from this application   */
-    sound = 0;
-    for (i = 0; i < nsoundzone; i++) {
-        p = soundzone[i].req;
-        flag = 0;
-        bp = NULL;
-        while (p)   {
-            if (appconf && (strcmp(p->appid, appconf->appid) == 0)) {
-                apfw_trace("ico_syc_apc_active: sound %s prio=%08x is %s",
-                           p->appid, p->prio, bp ? "not top" : "top");
-                if ((p->prio & ICO_UXF_PRIO_ACTIVEAPP) != ICO_UXF_PRIO_ACTIVEAPP)   {
-                    p->prio |= ICO_UXF_PRIO_ACTIVEAPP;
-                    apfw_trace("ico_syc_apc_active: cgange active %s prio to %08x",
-                               p->appid, p->prio);
-                    flag ++;
-
-                    if (bp) {
-                        bp->next = p->next;
-                        p2 = soundzone[i].req;
-                        bp2 = NULL;
-                        while (p2)  {
-                            if (p2->prio <= p->prio)    {
-                                p->next = p2;
-                                if (bp2) {
-                                    apfw_trace("ico_syc_apc_active: %s is not top=%s(%08x)",
-                                               p->appid, soundzone[i].req->appid,
-                                               soundzone[i].req->prio);
-                                    bp2->next = p;
-                                }
-                                else    {
-                                    if (appconf && (strcmp(p2->appid, appconf->appid) != 0) &&
-                                        ((p2->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
-                                        change_soundrequest(p2, 0);
-                                    }
-                                    soundzone[i].req = p;
-                                }
-                                break;
-                            }
-                            bp2 = p2;
-                            p2 = p2->next;
-                        }
-                        if (! p2)   {
-                            apfw_trace("ico_syc_apc_active: %s is not top=%s(%08x)",
-                                       p->appid, soundzone[i].req->appid,
-                                       soundzone[i].req->prio);
-                            if (bp2)    {
-                                bp2->next = p;
-                            }
-                            else    {
-                                soundzone[i].req = p;
-                            }
-                            p->next = NULL;
-                        }
-                    }
-                    else    {
-                        apfw_trace("ico_syc_apc_active: app %s is top", p->appid);
-                    }
-                }
-            }
-            bp = p;
-            p = p->next;
+        /* check overlap zones      */
+        nzone = newzone[idx].conf;
+        if (nzone->overlapNum != ozone->overlapNum) {
+            changed[nzone->sound - conf->sound] = 1;
+            continue;
         }
-        if (flag)   {
-            p = soundzone[i].req;
-            while (p)   {
-                if (p->prio & ICO_UXF_PRIO_ACTIVEAPP)  {
-                    p->prio -= ICO_UXF_PRIO_ACTIVECOUNT;
-                }
-                p = p->next;
-            }
-
-            for (j = 0; j < sound; j++) {
-                if (soundzone[i].conf->sound->id == reqsound[j])    break;
-            }
-            if (j >= sound) {
-                reqsound[sound++] = soundzone[i].conf->sound->id;
+        for (k = 0; k < nzone->overlapNum; k++) {
+            if (strcasecmp(nzone->sound->zone[nzone->overlap[k]].name,
+                           ozone->sound->zone[ozone->overlap[k]].name) != 0)   {
+                changed[nzone->sound - conf->sound] = 1;
+                break;
             }
         }
     }
-
-    /* change all inputsw request from this application */
-    input = 0;
-    for (i = 0; i < ninputsw; i++) {
-        p = inputsw[i].req;
-        flag = 0;
-        bp = NULL;
-        while (p)   {
-            if (appconf && (strcmp(p->appid, appconf->appid) == 0)) {
-                if ((p->prio & ICO_UXF_PRIO_ACTIVEAPP) != ICO_UXF_PRIO_ACTIVEAPP)   {
-                    p->prio |= ICO_UXF_PRIO_ACTIVEAPP;
-                    apfw_trace("ico_syc_apc_active: cgange active %s prio to %08x",
-                               p->appid, p->prio);
-                    flag ++;
-
-                    if (bp) {
-                        bp->next = p->next;
-                        p2 = inputsw[i].req;
-                        bp2 = NULL;
-                        while (p2)  {
-                            if (p2->prio <= p->prio)    {
-                                p->next = p2;
-                                if (bp2) {
-                                    apfw_trace("ico_syc_apc_active: %s is not top=%s(%08x)",
-                                               p->appid, inputsw[i].req->appid,
-                                               inputsw[i].req->prio);
-                                    bp2->next = p;
-                                }
-                                else    {
-                                    if (appconf && (strcmp(p2->appid, appconf->appid) != 0) &&
-                                        ((p2->state & ICO_APC_REQSTATE_WAITREQ) == 0))  {
-                                        change_inputrequest(p2, 0);
-                                    }
-                                    inputsw[i].req = p;
-                                }
-                                break;
-                            }
-                            bp2 = p2;
-                            p2 = p2->next;
-                        }
-                        if (! p2)   {
-                            apfw_trace("ico_syc_apc_active: %s is not top=%s(%08x)",
-                                       p->appid, inputsw[i].req->appid,
-                                       inputsw[i].req->prio);
-                            if (bp2)    {
-                                bp2->next = p;
-                            }
-                            else    {
-                                inputsw[i].req = p;
-                            }
-                            p->next = NULL;
-                        }
-                    }
-                    else    {
-                        apfw_trace("ico_syc_apc_active: app %s is top", p->appid);
-                    }
-                }
-            }
-            bp = p;
-            p = p->next;
-        }
-        if (flag)   {
-            p = inputsw[i].req;
-            while (p)   {
-                if (p->prio & ICO_UXF_PRIO_ACTIVEAPP)  {
-                    p->prio -= ICO_UXF_PRIO_ACTIVECOUNT;
-                }
-                p = p->next;
-            }
-
-            for (j = 0; j < input; j++) {
-                if (inputsw[i].inputsw->input == reqinput[j])   break;
-            }
-            if (j >= input) {
-                reqinput[input++] = inputsw[i].inputsw->input;
+    /* added zone, sound of the zone is changed     */
+    if ((changed) && (soundzone))   {
+        for (idx = 0; idx < num; idx++) {
+            if (! newzone[idx].change)  {
+                changed[newzone[idx].conf->sound - conf->sound] = 1;
             }
         }
     }
 
-    /* re-calculate display zone, sound zone and inout switch priority  */
-    for (i = 0; i < disp; i++)  {
-        recalc_dispzone(reqdisp[i]);
+    /* zones that have requests     */
+    for (idx = 0; idx < num; idx++) {
+        newzone[idx].change = 0;
+        set_zoneoccupied(newzone[idx].zoneset, newzone[idx].zoneno, &newzone[idx].heap);
     }
-    for (i = 0; i < sound; i++) {
-        recalc_soundzone(reqsound[i]);
-    }
-    for (i = 0; i < input; i++) {
-        recalc_inputsw(reqinput[i]);
-    }
-    if (child_appid)    {
-        apfw_trace("ico_syc_apc_active: active child app(%s)", child_appid);
-        ico_syc_apc_active(child_appid);
-    }
-    apfw_trace("ico_syc_apc_active: Leave");
+
+    free(soundzone);
+    soundzone = newzone;
+    nsoundzone = num;
+    free(soundzoneset);
+    soundzoneset = newset;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   app_display_hook: hook function for surface create/destroy(static function)
+ * @brief   sysconf_update: system configuration was changed by live reload
+ *          (static function)
  *
- * @param[in]   appid           application Id
- * @param[in]   surface         surface Id
- * @param[in]   object          target surface type and operation
- * @return      none
+ * @param[in]   newconf         new system configuration
+ * @param[in]   oldconf         old system configuration(released after this)
+ * @return      result
+ * @retval      ICO_UXF_EOK     success(changed to new configuration)
+ * @retval      ICO_UXF_ENOMEM  error(out of memory, current configuration is
+ *                              still used, so it must not be released)
  */
 /*--------------------------------------------------------------------------*/
-static void
-app_display_hook(const char *appid, const int surface, const int object)
+static int
+sysconf_update(const Ico_Uxf_Sys_Config *newconf, const Ico_Uxf_Sys_Config *oldconf)
 {
+    ico_apc_dispzone_t  *newdisp;
+    ico_apc_soundzone_t *newsound;
+    ico_apc_zoneset_t   *newdispset;
+    ico_apc_zoneset_t   *newsoundset;
+    int     ndisp;
+    int     nsound;
+    char    *dispchg;
+    char    *soundchg;
     int     i;
-    int     count;
-    ico_apc_request_t           *reqsave[MAXREQ];
-    Ico_Uxf_conf_application    *appconf;
-    ico_apc_request_t           *req;
 
-    apfw_trace("app_display_hook: Enter(%s,%08x,%x)", appid, surface, object);
+    apfw_trace("sysconf_update: Enter(display=%d->%d, sound=%d->%d)",
+               oldconf->displayNum, newconf->displayNum,
+               oldconf->soundNum, newconf->soundNum);
 
-    appconf = (Ico_Uxf_conf_application *)ico_uxf_getAppByAppid(appid);
-    if (! appconf)  {
-        apfw_warn("app_display_hook: Leave(appid[%s] dose not exist)", appid);
-        return;
+    /* arbitrate deferred requests(batch arbitration) with current configuration */
+    if (batch_idler)    {
+        ecore_idle_enterer_del(batch_idler);
+        batch_idler = NULL;
+        recalc_changed();
     }
-    if ((confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_ALMIGHTY) ||
-        (confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_SYSTEM) ||
-        (confsys->kind[appconf->kindId].priv == ICO_UXF_PRIVILEGE_SYSTEM_VISIBLE))  {
-        /* System Program(ex. HomeScreen) no need resource control  */
-        apfw_trace("app_display_hook: Leave(appid[%s] is system program)", appid);
-        return;
+
+    /* make all tables of new configuration before current tables are changed */
+    dispchg = malloc(newconf->displayNum + newconf->soundNum + 1);
+    if (! dispchg)  {
+        apfw_error("sysconf_update: Leave(No Memory)");
+        return ICO_UXF_ENOMEM;
     }
+    memset(dispchg, 0, newconf->displayNum + newconf->soundNum + 1);
+    soundchg = dispchg + newconf->displayNum;
 
-    switch (object) {
-    case ICO_UXF_HOOK_WINDOW_CREATE_MAIN:   /* created application main window  */
-        /* search display request   */
-        for (i = 0; i < ndispzone; i++) {
-            req = dispzone[i].req;
-            while (req)   {
-                if ((strcmp(req->appid, appconf->appid) == 0) &&
-                    ((req->resid == ICO_APF_RESID_BASIC_SCREEN) ||
-                     (req->resid == ICO_APF_RESID_ON_SCREEN)))  break;
-                req = req->next;
-            }
-            if (req)    break;
-        }
-        if (i < ndispzone)  {
-            apfw_trace("app_display_hook: app(%s) requested display, Nop", appid);
+    if (make_dispzone(newconf, &newdisp, &newdispset, &ndisp) != ICO_SYC_EOK)    {
+        free(dispchg);
+        apfw_error("sysconf_update: Leave(No Memory)");
+        return ICO_UXF_ENOMEM;
+    }
+    if (make_soundzone(newconf, &newsound, &newsoundset, &nsound) != ICO_SYC_EOK)    {
+        free(newdisp);
+        free(newdispset);
+        free(dispchg);
+        apfw_error("sysconf_update: Leave(No Memory)");
+        return ICO_UXF_ENOMEM;
+    }
+
+    /* release requests of removed zones with current configuration */
+    for (i = 0; i < ndispzone; i++) {
+        if (find_dispzone(newconf, dispzone[i].conf) >= 0)  continue;
+        apfw_trace("sysconf_update: display zone %s.%s is removed",
+                   dispzone[i].conf->display->name, dispzone[i].conf->name);
+        while (dispzone[i].heap.num > 0)    {
+            app_freedisplay(dispzone[i].heap.req[0], 1);
         }
-        else    {
-            apfw_trace("app_display_hook: app(%s) not requested display, set default[%s]",
-                       appid,
-                       confsys->display[appconf->display[0].displayId].
-                           zone[appconf->display[0].zoneId].name);
-            req = get_freereq();
-            if (req)    {
-                strncpy(req->appid, appconf->appid, ICO_UXF_MAX_PROCESS_NAME);
-                req->resid = ICO_APF_RESID_BASIC_SCREEN;
-                req->reqtype = ICO_APC_REQTYPE_CREATE;
-                strcpy(req->device,
-                       confsys->display[appconf->display[0].displayId].
-                           zone[appconf->display[0].zoneId].name);
-                app_getdisplay(req, 0);
-            }
+    }
+    for (i = 0; i < nsoundzone; i++)    {
+        if (find_soundzone(newconf, soundzone[i].conf) >= 0)    continue;
+        apfw_trace("sysconf_update: sound zone %s.%s is removed",
+                   soundzone[i].conf->sound->name, soundzone[i].conf->name);
+        while (soundzone[i].heap.num > 0)   {
+            app_freesound(soundzone[i].heap.req[0], 1);
         }
-        break;
-    case ICO_UXF_HOOK_WINDOW_DESTORY_MAIN:  /* destoryed application main window*/
-        /* delete all request from this application */
-        count = 0;
-        for (i = 0; i < ndispzone; i++) {
-            req = dispzone[i].req;
-            while (req)   {
-                if (strcmp(req->appid, appconf->appid) == 0) {
-                    reqsave[count++] = req;
-                }
-                req = req->next;
-            }
+    }
+
+    /* change zone tables to new configuration  */
+    switch_dispzone(newconf, newdisp, newdispset, ndisp, dispchg);
+    switch_soundzone(newconf, newsound, newsoundset, nsound, soundchg);
+    confsys = (Ico_Uxf_Sys_Config *)newconf;
+    (void) ico_syc_apc_regulation_reconfig(newconf);
+
+    /* recalculate changed zones            */
+    for (i = 0; i < newconf->displayNum; i++)   {
+        if (dispchg[i]) {
+            recalc_dispzone(newconf->display[i].id);
         }
-        if (count > 0)  {
-            apfw_trace("app_display_hook: free app(%s) all display request", appid);
-            for (i = 0; i < count; i++) {
-                app_freedisplay(reqsave[i], 0);
-            }
+    }
+    for (i = 0; i < newconf->soundNum; i++) {
+        if (soundchg[i])    {
+            recalc_soundzone(newconf->sound[i].id);
         }
-        break;
-    default:                                /* other, Nop   */
-        break;
     }
+    free(dispchg);
 
-    apfw_trace("app_display_hook: Leave");
+    apfw_trace("sysconf_update: Leave");
+    return ICO_UXF_EOK;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -2687,11 +4093,17 @@ ico_syc_apc_init(ico_apc_resource_control_t display, ico_apc_resource_control_t
                  ico_apc_resource_control_t input)
 {
     int     count;
-    int     base_count;
-    int     i, j, k;
+    int     i, j;
+    int     hash;
     int     ret;
     Ico_Uxf_InputDev    *pdev;
     Ico_Uxf_InputSw     *psw;
+    ico_apc_dispzone_t  *newdisp;
+    ico_apc_soundzone_t *newsound;
+    ico_apc_zoneset_t   *newdispset;
+    ico_apc_zoneset_t   *newsoundset;
+    int     ndisp;
+    int     nsound;
 
     apfw_trace("ico_syc_apc_init: Enter");
 
@@ -2719,56 +4131,20 @@ ico_syc_apc_init(ico_apc_resource_control_t display, ico_apc_resource_control_t
 
     /* initialize internal tables                   */
     /* display zone table                           */
-    ndispzone = 0;
-    for (i = 0; i < confsys->displayNum; i++)   {
-        ndispzone += confsys->display[i].zoneNum;
-    }
-    dispzone = malloc(sizeof(ico_apc_dispzone_t) * ndispzone);
-    if (! dispzone) {
+    if (make_dispzone(confsys, &newdisp, &newdispset, &ndisp) != ICO_SYC_EOK)    {
         ico_apps_controller_init = 0;
         apfw_error("ico_syc_apc_init: Leave(No Memory)");
         return ICO_SYC_ENOMEM;
     }
-    memset(dispzone, 0, sizeof(ico_apc_dispzone_t) * ndispzone);
-    count = 0;
-    for (i = 0; i < confsys->displayNum; i++)   {
-        base_count = count;
-        for (j = 0; j < confsys->display[i].zoneNum; j++)   {
-            dispzone[count].conf = &confsys->display[i].zone[j];
-            dispzone[count].noverlap = confsys->display[i].zone[j].overlapNum;
-            for (k = 0; k < dispzone[count].noverlap; k++)  {
-                dispzone[count].overlap[k] =
-                    &dispzone[base_count + confsys->display[i].zone[j].overlap[k]];
-            }
-            count ++;
-        }
-    }
+    switch_dispzone(confsys, newdisp, newdispset, ndisp, NULL);
 
     /* sound zone table                         */
-    nsoundzone = 0;
-    for (i = 0; i < confsys->soundNum; i++) {
-        nsoundzone += confsys->sound[i].zoneNum;
-    }
-    soundzone = malloc(sizeof(ico_apc_soundzone_t) * nsoundzone);
-    if (! soundzone)    {
+    if (make_soundzone(confsys, &newsound, &newsoundset, &nsound) != ICO_SYC_EOK)   {
         ico_apps_controller_init = 0;
         apfw_error("ico_syc_apc_init: Leave(No Memory)");
         return ICO_SYC_ENOMEM;
     }
-    memset(soundzone, 0, sizeof(ico_apc_soundzone_t) * nsoundzone);
-    count = 0;
-    for (i = 0; i < confsys->soundNum; i++) {
-        base_count = count;
-        for (j = 0; j < confsys->sound[i].zoneNum; j++) {
-            soundzone[count].conf = &confsys->sound[i].zone[j];
-            soundzone[count].noverlap = confsys->sound[i].zone[j].overlapNum;
-            for (k = 0; k < soundzone[count].noverlap; j++) {
-                soundzone[count].overlap[k] =
-                    &soundzone[base_count + confsys->sound[i].zone[j].overlap[k]];
-            }
-            count ++;
-        }
-    }
+    switch_soundzone(confsys, newsound, newsoundset, nsound, NULL);
     /* input sw table                           */
     ninputsw = 0;
     for (i = 0; ; i++)  {
@@ -2805,6 +4181,13 @@ ico_syc_apc_init(ico_apc_resource_control_t display, ico_apc_resource_control_t
                 count ++;
             }
         }
+        /* switch name hash(same name switches are searched in table order) */
+        memset(inputswhash, 0, sizeof(inputswhash));
+        for (i = count - 1; i >= 0; i--)    {
+            hash = ICO_UXF_MISC_HASHBYNAME(inputsw[i].inputsw->swname);
+            inputsw[i].nexthash = inputswhash[hash];
+            inputswhash[hash] = &inputsw[i];
+        }
     }
 
     /* initialize request table                     */
@@ -2851,16 +4234,16 @@ ico_syc_apc_init(ico_apc_resource_control_t display, ico_apc_resource_control_t
         return ICO_SYC_ENOSYS;
     }
 
-    ico_syc_apc_regulation_listener(regulation_listener, NULL);
+    ico_syc_apc_regulation_set_listener(regulation_listener, ICO_SYC_APC_CATEGORY_ALL, NULL);
+
+    /* follow live reload of system configuration   */
+    if (ico_uxf_econf_setSysUpdateCb(sysconf_update) != ICO_UXF_EOK)    {
+        apfw_warn("ico_syc_apc_init: system configuration is not reloaded");
+    }
 
     /* set hook for window create/destory   */
     (void) ico_uxf_window_hook(app_display_hook);
 
-    /* create timer     */
-    ecore_timer = ecore_timer_add(((double)ICO_APC_REQREPLY_INTERVAL)/1000.0,
-                                  request_timer, NULL);
-    timer_count = 1;
-
     /* send sound stream list request to Multi Sound manager    */
     ret = ico_apf_resource_send_to_soundctl(ICO_APF_SOUND_COMMAND_GETLIST, 0);
     if (ret != ICO_APF_RESOURCE_E_NONE) {
@@ -2893,6 +4276,14 @@ ico_syc_apc_term(void)
         ecore_timer_del(ecore_timer);
         ecore_timer = NULL;
     }
+    if (batch_idler)    {
+        ecore_idle_enterer_del(batch_idler);
+        batch_idler = NULL;
+    }
+    if (soundctl_idler) {
+        ecore_idle_enterer_del(soundctl_idler);
+        soundctl_idler = NULL;
+    }
 
     ico_syc_apc_regulation_term();
     ico_apf_resource_term_server();
@@ -30,22 +30,40 @@ extern "C" {
 #define DBUS_SERVICE   "org.automotive.message.broker"
 #define DBUS_INTERFACE "org.freedesktop.DBus.Properties"
 #define DBUS_METHOD    "Get"
+#define DBUS_SIGNAL    "PropertiesChanged"
+
+/* vehicle information from AMB                 */
+#define ICO_SYC_APC_REGULATION_RESYNC   50      /* resync by Get every 50 ticks(5s) */
+                                                /* when PropertiesChanged is used   */
+#define ICO_SYC_APC_REGULATION_MISSMAX  3       /* changes found only by resync to  */
+                                                /* fall back to polling             */
+                                                /* vehicle signal record file(env)  */
+#define ICO_SYC_APC_REGULATION_RECORD   "ICO_SYC_APC_VEHICLE_RECORD"
 
 /* define struct                                */
 /* request information                          */
 typedef struct  _ico_apc_request    {
-    struct _ico_apc_request     *next;          /* requestt list link               */
+    struct _ico_apc_request     *next;          /* free list link                   */
+    struct _ico_apc_request     *appnext;       /* request list link of application */
+    struct _ico_apc_request     *appprev;       /* (previous link)                  */
+    struct _ico_apc_apprequest  *app;           /* application request table        */
     char                        appid[ICO_UXF_MAX_PROCESS_NAME+1];
                                                 /* application id                   */
+    const char                  *appatom;       /* application id(interned atom)    */
     ico_apf_resid_e             resid;          /* resource id                      */
     char                        device[ICO_UXF_MAX_DEVICE_NAME+1];
                                                 /* request device                   */
     int                         id;             /* request object                   */
     int                         bid;            /* request base object              */
     int                         pid;            /* request client pid               */
-    int                         prio;           /* request priority                 */
+    int                         prio;           /* request priority(without active) */
+    unsigned int                actepoch;       /* active application epoch(0=none) */
+    int                         seq;            /* order in same priority           */
+    int                         hidx;           /* index in zone heap(-1=not linked)*/
+    int                         tidx;           /* index in reply queue(-1=no wait) */
+    double                      deadline;       /* Reply wait deadline(ecore time)  */
+    double                      replystart;     /* Reply wait start(ecore time)     */
     unsigned short              zoneidx;        /* request target zone index        */
-    unsigned short              timer;          /* Reply wait timer                 */
     unsigned short              state;          /* status                           */
     unsigned short              reqtype;        /* Request type                     */
 } ico_apc_request_t;
@@ -53,45 +71,140 @@ typedef struct  _ico_apc_request    {
 #define ICO_APC_REQTYPE_REQUEST 0               /* Request from application         */
 #define ICO_APC_REQTYPE_CREATE  1               /* Request automaticaly             */
 
-#define ICO_APC_REQREPLY_INTERVAL    100        /* Request timer interval (ms)      */
-#define ICO_APC_REQREPLY_MAXTIME     500        /* Maximum reply wait (ms)          */
+#define ICO_APC_REQREPLY_MAXTIME     500        /* Initial reply wait (ms)          */
+#define ICO_APC_REQREPLY_LOWER       100        /* Default lower bound of reply wait*/
+#define ICO_APC_REQREPLY_UPPER       3000       /* Default upper bound of reply wait*/
 #define ICO_APC_REQSTATE_WAITREQ     0x01       /* Waitting resource                */
+#define ICO_APC_REQSTATE_NEWREQ      0x02       /* Not answered(batch arbitration)  */
 #define ICO_APC_REQSTATE_WAITPROC    0x08       /* Priotiry process work flag       */
 #define ICO_APC_REQSTATE_MASK        0x0f       /* State mask                       */
 #define ICO_APC_REQSTATE_REPLYACTIVE 0x20       /* Wait reply for active            */
 #define ICO_APC_REQSTATE_REPLYQUIET  0x10       /* Wait reply for hide              */
 
+/* priority field of request(active application field is made by epoch)  */
+#define ICO_APC_PRIO_UPPER      (~(ICO_UXF_PRIO_ACTIVEAPP|(ICO_UXF_PRIO_ACTIVECOUNT-1)))
+#define ICO_APC_PRIO_LOWER      (ICO_UXF_PRIO_ACTIVECOUNT-1)
+
+/* request priority queue of zone(indexed binary heap, req[0] is top)   */
+/* (also used as reply deadline queue, req[0] is the earliest deadline)  */
+typedef struct  _ico_apc_reqheap    {
+    ico_apc_request_t   **req;                  /* heap array                       */
+    int                 num;                    /* number of requests               */
+    int                 size;                   /* size of heap array               */
+} ico_apc_reqheap_t;
+
+#define ICO_APC_REQHEAP_INIT    16              /* initial size of heap array       */
+#define ICO_APC_REQHEAP_TOP(heap)   (((heap)->num > 0) ? (heap)->req[0] : NULL)
+#define ICO_APC_REQHEAP_LINKED(heap, rq)                                    \
+            (((rq)->hidx >= 0) && ((rq)->hidx < (heap)->num) &&             \
+             ((heap)->req[(rq)->hidx] == (rq)))
+
+/* reply latency statistics of application(adaptive reply timeout)  */
+#define ICO_APC_REPLYSTAT_SAMPLES   32          /* latency samples for percentile   */
+#define ICO_APC_REPLYSTAT_MINSAMPLE 4           /* samples to adapt reply timeout   */
+#define ICO_APC_REPLYSTAT_WEIGHT    0.125       /* weight of new sample in EWMA     */
+typedef struct  _ico_apc_replystat  {
+    int                 replies;                /* number of replies(ACK/NAK)       */
+    int                 timeouts;               /* number of reply timeouts         */
+    double              ewma;                   /* average latency(EWMA, ms)        */
+    int                 p95;                    /* 95 percentile latency(ms)        */
+    int                 timeout;                /* current reply timeout(ms)        */
+    int                 nsample;                /* number of samples                */
+    int                 next;                   /* next sample position             */
+    float               sample[ICO_APC_REPLYSTAT_SAMPLES];
+                                                /* latency samples(ring, ms)        */
+} ico_apc_replystat_t;
+
 /* application request table                    */
+#define ICO_APC_PRELAUNCH_NONE      0           /* not pre-launched                 */
+#define ICO_APC_PRELAUNCH_WAIT      1           /* pre-launched, no main window     */
+#define ICO_APC_PRELAUNCH_HOLD      2           /* pre-launched, display request of */
+                                                /* main window is held              */
 typedef struct  _ico_apc_apprequest {
+    struct _ico_apc_apprequest  *next;          /* hash link                        */
+    const char          *appatom;               /* application id(interned atom)    */
+    ico_apc_request_t   *req;                   /* request list of application      */
+    int                 nreq;                   /* number of requests               */
+    int                 prelaunch;              /* pre-launch state                 */
+    ico_apc_replystat_t reply;                  /* reply latency statistics         */
 } ico_apc_apprequest_t;
 
+/* staged Multi Sound Manager command of a stream(process)  */
+#define ICO_APC_SOUNDCTL_UNKNOWN    0           /* mute state is not known          */
+#define ICO_APC_SOUNDCTL_MUTE       1           /* muted                            */
+#define ICO_APC_SOUNDCTL_PLAY       2           /* not muted                        */
+#define ICO_APC_SOUNDCTL_BULKMIN    4           /* changes to use all stream command*/
+#define ICO_APC_SOUNDCTL_RETRY      3           /* maximum sends of a command       */
+typedef struct  _ico_apc_soundctl   {
+    struct _ico_apc_soundctl    *next;          /* hash link                        */
+    int                 pid;                    /* process id of stream             */
+    short               want;                   /* desired mute state               */
+    short               sent;                   /* mute state sent to Sound Manager */
+    int                 retry;                  /* failed sends of desired state    */
+} ico_apc_soundctl_t;
+
+/* zone bitset(bit number is zone number in display or sound)  */
+typedef unsigned int    ico_apc_zonebits_t;
+#define ICO_APC_ZONEBIT(n)      (((ico_apc_zonebits_t)1) << (n))
+#if (ICO_UXF_DISPLAY_ZONE_MAX > 32) || (ICO_UXF_SOUND_ZONE_MAX > 32)
+#error  "zone bitset(ico_apc_zonebits_t) is too small for zones in a display or sound"
+#endif
+
+/* zones of a display or a sound                */
+typedef struct  _ico_apc_zoneset    {
+    int                 zonebase;               /* index of first zone in zone table*/
+    int                 zoneNum;                /* number of zones                  */
+    ico_apc_zonebits_t  occupied;               /* zones that have requests         */
+                                                /* overlap zones of each zone       */
+    ico_apc_zonebits_t  overlap[ICO_UXF_DISPLAY_ZONE_MAX];
+    /* batch arbitration work(result of arbitration of each request) */
+    int                 batch;                  /* arbitration is deferred          */
+    int                 vflips;                 /* flips without batch arbitration  */
+    ico_apc_zonebits_t  vactive;                /* active zones                     */
+                                                /* top request of active zones      */
+    const ico_apc_request_t *vtop[ICO_UXF_DISPLAY_ZONE_MAX];
+} ico_apc_zoneset_t;
+
 /* display zone                                 */
 typedef struct  _ico_apc_dispzone   {
-    ico_apc_request_t   *req;                   /* request list link                */
+    ico_apc_reqheap_t   heap;                   /* request priority queue           */
     Ico_Uxf_conf_display_zone   *conf;          /* configuration                    */
-    short               res;                    /* (unused)                         */
-    short               noverlap;               /* number of overlap zone           */
-                                                /* overlap zone                     */
-    struct _ico_apc_dispzone    *overlap[ICO_UXF_DISPLAY_ZONE_MAX];
+    ico_apc_zoneset_t   *zoneset;               /* zones of the display             */
+    short               zoneno;                 /* zone number in the display       */
+    short               change;                 /* request changed(work)            */
 } ico_apc_dispzone_t;
 
 /* sound zone                                   */
 typedef struct  _ico_apc_soundzone  {
-    ico_apc_request_t   *req;                   /* request list link                */
+    ico_apc_reqheap_t   heap;                   /* request priority queue           */
     Ico_Uxf_conf_sound_zone     *conf;          /* configuration                    */
-    short               res;                    /* (unused)                         */
-    short               noverlap;               /* number of overlap zone           */
-                                                /* overlap zone                     */
-    struct _ico_apc_soundzone   *overlap[ICO_UXF_SOUND_ZONE_MAX];
+    ico_apc_zoneset_t   *zoneset;               /* zones of the sound               */
+    short               zoneno;                 /* zone number in the sound         */
+    short               change;                 /* request changed(work)            */
 } ico_apc_soundzone_t;
 
 /* input sw                                     */
 typedef struct  _ico_apc_inputsw    {
-    ico_apc_request_t   *req;                   /* request list link                */
+    ico_apc_reqheap_t   heap;                   /* request priority queue           */
     Ico_Uxf_InputDev    *inputdev;              /* input device attribute           */
     Ico_Uxf_InputSw     *inputsw;               /* input switch attribute           */
+    ico_apc_request_t   *owner;                 /* request that has the switch      */
+    struct _ico_apc_inputsw *nexthash;          /* next switch of same name hash    */
+    int                 change;                 /* request changed(work)            */
 } ico_apc_inputsw_t;
 
+/* request priority queue(ico_syc_apc_reqheap.c)   */
+int ico_syc_apc_reqheap_cmp(const ico_apc_request_t *a, const ico_apc_request_t *b);
+int ico_syc_apc_reqheap_add(ico_apc_reqheap_t *heap, ico_apc_request_t *req);
+void ico_syc_apc_reqheap_del(ico_apc_reqheap_t *heap, ico_apc_request_t *req);
+void ico_syc_apc_reqheap_update(ico_apc_reqheap_t *heap, ico_apc_request_t *req,
+                                const int equal);
+ico_apc_request_t *ico_syc_apc_reqheap_next(const ico_apc_reqheap_t *heap);
+void ico_syc_apc_reqheap_free(ico_apc_reqheap_t *heap);
+int ico_syc_apc_replyq_set(ico_apc_reqheap_t *queue, ico_apc_request_t *req,
+                           const double deadline);
+void ico_syc_apc_replyq_del(ico_apc_reqheap_t *queue, ico_apc_request_t *req);
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,11 +16,13 @@
 #include    <stdlib.h>
 #include    <unistd.h>
 #include    <stdbool.h>
+#include    <stdint.h>
 #include    <string.h>
 #include    <errno.h>
 #include    <pthread.h>
 #include    <sys/ioctl.h>
 #include    <sys/time.h>
+#include    <time.h>
 #include    <fcntl.h>
 
 #include    <wayland-client.h>
@@ -37,14 +39,29 @@
 /*==============================================================================*/
 /* callback function            */
 static int  nregulation_cb = 0;
-static ico_apc_regulation_cb_t  regulation_cb[ICO_SYC_APC_REGULATION_LISTENERS];
-static void                     *regulation_cb_user_data[ICO_SYC_APC_REGULATION_LISTENERS];
+static struct _regulation_listener  {
+    ico_apc_regulation_cb_t     func;   /* listener of each category                */
+    ico_apc_regulation_set_cb_t setfunc;/* listener of change set                   */
+    ico_apc_category_set_t      categorys;  /* subscribed categorys                 */
+    void                        *user_data; /* user data                            */
+}           regulation_cb[ICO_SYC_APC_REGULATION_LISTENERS];
 
 /* Ecore/D-Bus static valiables */
 static Ecore_Timer *vehicle_timer = NULL;
 static DBusConnection *dbus_connection = NULL;
+static Ecore_Idler *dbus_idler = NULL;
 static ico_apc_reguration_control_t control[ICO_UXF_CATEGORY_MAX];
 
+/* AMB notifies changes by PropertiesChanged signal(1), or polling by Get(0)  */
+static int vehicle_signal = 0;
+static int vehicle_matched = 0;         /* PropertiesChanged is subscribed          */
+static int vehicle_tick = 0;            /* timer ticks from last resync             */
+
+/* vehicle signal recorder and injection(replay)    */
+static FILE *vehicle_record = NULL;     /* record file                              */
+static struct timespec vehicle_record_start;    /* start time of record             */
+static int vehicle_inject = 0;          /* values are injected, AMB is ignored      */
+
 /* vehicle information          */
 static const struct _vehicle_info_property {
     int     key;                        /* Vehicle Information key                  */
@@ -74,9 +91,57 @@ static struct _vehicle_info_data    {
     DBusPendingCall *pending;
     int             request;
     int             errcount;
+    int             signal;             /* notified changes(PropertiesChanged)      */
+    int             missed;             /* changes found only by resync(cleared by  */
+                                        /* PropertiesChanged of this property)      */
+    int             valid;              /* value was received                       */
     double          val;
 }                   vehicle_data[ICO_UXF_REGULATION_VIC_MAX];
 
+/* regulation rule engine       */
+#define RULE_PRED(pred)     (1 << (pred))   /* bit of predicate                     */
+
+/* policy is no regulation when predicates of 'on' are true and 'off' are false */
+static const struct _rule_policy {
+    unsigned int    on;                 /* predicates that must be true             */
+    unsigned int    off;                /* predicates that must be false            */
+}                   rule_policy[] = {
+    /* ICO_UXF_POLICY_ALWAYS            */
+    { 0, 0 },
+    /* ICO_UXF_POLICY_RUNNING           */
+    { RULE_PRED(ICO_UXF_REGULATION_RUNNING), 0 },
+    /* ICO_UXF_POLICY_PARKED            */
+    { 0, RULE_PRED(ICO_UXF_REGULATION_RUNNING) },
+    /* ICO_UXF_POLICY_SHIFT_PARKING     */
+    { RULE_PRED(ICO_UXF_REGULATION_SHIFT_PARKING), RULE_PRED(ICO_UXF_REGULATION_RUNNING) },
+    /* ICO_UXF_POLICY_SHIFT_REVERSES    */
+    { RULE_PRED(ICO_UXF_REGULATION_SHIFT_REVERSES), 0 },
+    /* ICO_UXF_POLICY_BLINKER_LEFT      */
+    { RULE_PRED(ICO_UXF_REGULATION_BLINKER_LEFT),
+      RULE_PRED(ICO_UXF_REGULATION_SHIFT_REVERSES) },
+    /* ICO_UXF_POLICY_BLINKER_RIGHT     */
+    { RULE_PRED(ICO_UXF_REGULATION_BLINKER_RIGHT),
+      RULE_PRED(ICO_UXF_REGULATION_SHIFT_REVERSES) }
+};
+#define RULE_POLICY_MAX     ((int)(sizeof(rule_policy)/sizeof(rule_policy[0])))
+
+/* state of predicates          */
+static struct _rule_predicate   {
+    const Ico_Uxf_conf_regulation   *conf;  /* predicate of system configuration    */
+    int             raw;                /* result of comparison(with hysteresis)    */
+    Ecore_Timer     *timer;             /* debounce timer                           */
+}                   rule_pred[ICO_UXF_REGULATION_MAX];
+static unsigned int rule_state = 0;     /* debounced predicates(bit mask)           */
+                                        /* predicates that depend on signal         */
+static unsigned int rule_sigdep[ICO_UXF_REGULATION_SIG_MAX];
+                                        /* predicates that category depends on      */
+static unsigned int rule_catdep[ICO_UXF_CATEGORY_MAX];
+                                        /* current values of vehicle signals        */
+static double       rule_signal[ICO_UXF_REGULATION_SIG_MAX];
+static int          rule_judged = 0;    /* all categorys were judged                */
+static ico_apc_regulation_stats_t   regulation_stats;
+static long long    rule_cpu = 0;       /* CPU time of rule engine(ns)              */
+
 /* system configuration         */
 static Ico_Uxf_Sys_Config       *confsys = NULL;
 static int      ncategory;
@@ -86,12 +151,43 @@ static Ico_Uxf_conf_category    *category;
 /* define static function prototype                                             */
 /*==============================================================================*/
 static int request_vehicle_info(void);
-static int get_vehicle_info(void);
+static int vehicle_value(DBusMessageIter *iter, const int idx);
+static void vehicle_reply(DBusPendingCall *pending, void *user_data);
+static DBusHandlerResult vehicle_changed(DBusConnection *connection,
+                                         DBusMessage *message, void *user_data);
+static int rule_compare(const Ico_Uxf_conf_regulation *conf, const double val,
+                        const double hys);
+static int rule_policy_judge(const int policy, unsigned char *ctl);
+static unsigned int rule_policy_mask(const int policy);
+static void rule_engine_compile(void);
+static unsigned int rule_predicate_set(const int pred, const int raw);
+static Eina_Bool rule_debounce_timer(void *user_data);
+static void vehicle_record_put(const int idx);
+static long long rule_cputime(void);
+static void rule_engine_eval(void);
+static void rule_engine_judge(const unsigned int changed, const int all);
+static void rule_engine_notify(const ico_apc_regulation_change_t *change);
+static int regulation_add_listener(ico_apc_regulation_cb_t func,
+                                   ico_apc_regulation_set_cb_t setfunc,
+                                   const ico_apc_category_set_t categorys, void *user_data);
 static Eina_Bool rule_engine_wake(void *user_data);
+static dbus_bool_t loop_add_watch(DBusWatch *watch, void *data);
+static void loop_remove_watch(DBusWatch *watch, void *data);
+static void loop_toggle_watch(DBusWatch *watch, void *data);
+static Eina_Bool loop_watch_handler(void *data, Ecore_Fd_Handler *handler);
+static dbus_bool_t loop_add_timeout(DBusTimeout *timeout, void *data);
+static void loop_remove_timeout(DBusTimeout *timeout, void *data);
+static void loop_toggle_timeout(DBusTimeout *timeout, void *data);
+static Eina_Bool loop_timeout_handler(void *data);
+static void loop_dispatch_status(DBusConnection *connection,
+                                 DBusDispatchStatus status, void *data);
+static Eina_Bool loop_dispatch_idler(void *data);
+static void loop_dispatch(void);
 
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   request_vehicle_info: request to AMB(static function)
+ *          replies are received by vehicle_reply from Ecore main loop.
  *
  * @param       none
  * @return      result
@@ -142,43 +238,50 @@ request_vehicle_info(void)
             ret = ICO_SYC_EIO;
         }
         /* Send message                 */
-        else if (! dbus_connection_send_with_reply(
+        else if ((! dbus_connection_send_with_reply(
                             dbus_connection, dbus_message,
-                            &vehicle_data[idx].pending, 200))    {
+                            &vehicle_data[idx].pending, 200)) ||
+                 (! vehicle_data[idx].pending)) {
             apfw_warn("request_vehicle_info: ERROR dbus_connection_send" );
             vehicle_data[idx].pending = NULL;
             ret = ICO_SYC_EIO;
         }
+        /* Receive reply                */
+        else if (! dbus_pending_call_set_notify(vehicle_data[idx].pending, vehicle_reply,
+                                                &vehicle_data[idx], NULL))  {
+            apfw_warn("request_vehicle_info: ERROR dbus_pending_call_set_notify" );
+            dbus_pending_call_cancel(vehicle_data[idx].pending);
+            dbus_pending_call_unref(vehicle_data[idx].pending);
+            vehicle_data[idx].pending = NULL;
+            ret = ICO_SYC_EIO;
+        }
+        else    {
+            vehicle_data[idx].request ++;
+        }
         if (dbus_message)   {
             /* Release message                  */
             dbus_message_unref(dbus_message);
         }
     }
-
-    /* dispatch if data queue exist         */
-    do  {
-        dbus_connection_read_write_dispatch(dbus_connection, 0);
-    } while (dbus_connection_get_dispatch_status(dbus_connection)
-             == DBUS_DISPATCH_DATA_REMAINS);
-
     return(ret);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   get_vehicle_info: get vercle information from AMB(static function)
+ * @brief   vehicle_value: set vehicle information value from D-Bus variant
+ *          (static function)
  *
- * @param       none
- * @return      always ICO_SYC_EOK(success)
+ * @param[in]   iter            D-Bus message iterator(variant)
+ * @param[in]   idx             index of vehicle information
+ * @return      result
+ * @retval      1               value is changed
+ * @retval      0               value is not changed(or illegal data type)
  */
 /*--------------------------------------------------------------------------*/
 static int
-get_vehicle_info(void)
+vehicle_value(DBusMessageIter *iter, const int idx)
 {
-    DBusMessage *dbus_message = NULL;
-    DBusMessageIter iter_head;
-    DBusMessageIter iter;
-    int         idx;
+    DBusMessageIter variant;
     char        type;
     int32_t     i32;
     int16_t     i16;
@@ -187,94 +290,227 @@ get_vehicle_info(void)
     dbus_bool_t b;
     uint8_t     u8;
     double      d64;
+    double      val;
 
-    /* dispatch if data queue exist         */
-    do {
-        dbus_connection_read_write_dispatch(dbus_connection, 0);
-    } while (dbus_connection_get_dispatch_status(dbus_connection)
-             == DBUS_DISPATCH_DATA_REMAINS);
+    dbus_message_iter_recurse(iter, &variant);
 
-    /* analize reply datas                  */
-    for (idx = 0; vehicle_info[idx].key; idx++) {
-        if (! vehicle_data[idx].pending)    {
-            continue;
+    type = dbus_message_iter_get_arg_type(&variant);
+    switch (type)   {
+    case DBUS_TYPE_INT32:
+        dbus_message_iter_get_basic(&variant, &i32);
+        val = (double)i32;
+        break;
+    case DBUS_TYPE_INT16:
+        dbus_message_iter_get_basic(&variant, &i16);
+        val = (double)i16;
+        break;
+    case DBUS_TYPE_UINT32:
+        dbus_message_iter_get_basic(&variant, &u32);
+        val = (double)u32;
+        break;
+    case DBUS_TYPE_UINT16:
+        dbus_message_iter_get_basic(&variant, &u16);
+        val = (double)u16;
+        break;
+    case DBUS_TYPE_BOOLEAN:
+        dbus_message_iter_get_basic(&variant, &b);
+        if (b)      val = (double)1.0;
+        else        val = (double)0.0;
+        break;
+    case DBUS_TYPE_BYTE:
+        dbus_message_iter_get_basic(&variant, &u8);
+        val = (double)u8;
+        break;
+    case DBUS_TYPE_DOUBLE:
+        dbus_message_iter_get_basic(&variant, &d64);
+        val = (double)d64;
+        break;
+    default:
+        apfw_warn("vehicle_value: (%s) illegal data type(0x%02x)",
+                  vehicle_info[idx].property, ((int)type) & 0x0ff);
+        return 0;
+    }
+    if (((vehicle_data[idx].valid) && (vehicle_data[idx].val == val)) ||
+        (vehicle_inject))   {
+        return 0;
+    }
+    apfw_trace("vehicle_value: %s = %d", vehicle_info[idx].property, (int)val);
+    vehicle_data[idx].val = val;
+    vehicle_data[idx].valid = 1;
+    if (vehicle_record) {
+        vehicle_record_put(idx);
+    }
+    return 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   vehicle_record_put: write vehicle signal change to record file
+ *          (static function)
+ *          <time(ms)> <property> <value>
+ *
+ * @param[in]   idx             index of vehicle information
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+vehicle_record_put(const int idx)
+{
+    struct timespec now;
+    long    ms;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    ms = (now.tv_sec - vehicle_record_start.tv_sec) * 1000L +
+         (now.tv_nsec - vehicle_record_start.tv_nsec) / 1000000L;
+    if ((fprintf(vehicle_record, "%ld\t%s\t%g\n", ms, vehicle_info[idx].property,
+                 vehicle_data[idx].val) < 0) ||
+        (fflush(vehicle_record) != 0))  {
+        apfw_warn("vehicle_record_put: write error(%d), record stopped", errno);
+        fclose(vehicle_record);
+        vehicle_record = NULL;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   vehicle_reply: receive reply of Get from AMB(static function)
+ *
+ * @param[in]   pending         D-Bus pending call
+ * @param[in]   user_data       vehicle information data
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+vehicle_reply(DBusPendingCall *pending, void *user_data)
+{
+    struct _vehicle_info_data   *data = (struct _vehicle_info_data *)user_data;
+    DBusMessage *dbus_message;
+    DBusMessageIter iter;
+    int         idx = data - vehicle_data;
+    int         known;
+
+    dbus_message = dbus_pending_call_steal_reply(pending);
+    dbus_pending_call_unref(pending);
+    data->pending = NULL;
+    if (! dbus_message) {
+        apfw_trace("vehicle_reply: (%s) NO reply", vehicle_info[idx].property);
+        return;
+    }
+
+    if (dbus_message_get_type(dbus_message) == DBUS_MESSAGE_TYPE_ERROR) {
+        dbus_message_unref(dbus_message);
+        data->errcount ++;
+        if (data->errcount <= 5)    {
+            apfw_trace("vehicle_reply: (%s) reply error", vehicle_info[idx].property);
         }
-        if (! dbus_pending_call_get_completed(vehicle_data[idx].pending))   {
-            continue;
+        return;
+    }
+
+    known = data->valid;
+    dbus_message_iter_init(dbus_message, &iter);
+    if ((dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_VARIANT) &&
+        (vehicle_value(&iter, idx)))    {
+        if ((vehicle_signal) && (known))    {
+            /* signal is subscribed, but change was found by resync(reply of */
+            /* resync may arrive before the signal, the signal clears this)  */
+            data->missed ++;
+            apfw_warn("vehicle_reply: (%s) change was not notified(%d)",
+                      vehicle_info[idx].property, data->missed);
+            if (data->missed >= ICO_SYC_APC_REGULATION_MISSMAX) {
+                apfw_warn("vehicle_reply: PropertiesChanged of %s is not reliable, "
+                          "fall back to polling", vehicle_info[idx].property);
+                vehicle_signal = 0;
+            }
         }
+        rule_engine_eval();
+    }
+    dbus_message_unref(dbus_message);
+}
 
-        dbus_message = dbus_pending_call_steal_reply(vehicle_data[idx].pending);
-        if (! dbus_message) {
-            apfw_trace("get_vehicle_info: (%s) NO reply", vehicle_info[idx].property);
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   vehicle_changed: receive PropertiesChanged signal from AMB
+ *          (D-Bus filter, static function)
+ *
+ * @param[in]   connection      D-Bus connection
+ * @param[in]   message         received message
+ * @param[in]   user_data       user data(unused)
+ * @return      result
+ * @retval      DBUS_HANDLER_RESULT_HANDLED             PropertiesChanged of AMB
+ * @retval      DBUS_HANDLER_RESULT_NOT_YET_HANDLED     other message
+ */
+/*--------------------------------------------------------------------------*/
+static DBusHandlerResult
+vehicle_changed(DBusConnection *connection, DBusMessage *message, void *user_data)
+{
+    DBusMessageIter iter;
+    DBusMessageIter dict;
+    DBusMessageIter entry;
+    const char  *path;
+    const char  *interface;
+    const char  *property;
+    int         idx;
+    int         change = 0;
+
+    if (! dbus_message_is_signal(message, DBUS_INTERFACE, DBUS_SIGNAL)) {
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    }
+    path = dbus_message_get_path(message);
+    if ((! path) || (! dbus_message_iter_init(message, &iter)) ||
+        (dbus_message_iter_get_arg_type(&iter) != DBUS_TYPE_STRING))    {
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    }
+    dbus_message_iter_get_basic(&iter, &interface);
+    if ((! dbus_message_iter_next(&iter)) ||
+        (dbus_message_iter_get_arg_type(&iter) != DBUS_TYPE_ARRAY)) {
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    }
+
+    /* changed properties(a{sv})    */
+    dbus_message_iter_recurse(&iter, &dict);
+    while (dbus_message_iter_get_arg_type(&dict) == DBUS_TYPE_DICT_ENTRY)   {
+        dbus_message_iter_recurse(&dict, &entry);
+        if (dbus_message_iter_get_arg_type(&entry) != DBUS_TYPE_STRING)    {
+            /* key is not a property name, ignore this entry    */
+            dbus_message_iter_next(&dict);
             continue;
         }
-
-        if (dbus_message_get_type(dbus_message) == DBUS_MESSAGE_TYPE_ERROR) {
-            dbus_message_unref(dbus_message);
-            dbus_pending_call_unref(vehicle_data[idx].pending);
-            vehicle_data[idx].pending = NULL;
-            vehicle_data[idx].errcount ++;
-            if (vehicle_data[idx].errcount <= 5)    {
-                apfw_trace("get_vehicle_info: (%s) reply error", vehicle_info[idx].property);
+        dbus_message_iter_get_basic(&entry, &property);
+        if (dbus_message_iter_next(&entry)) {
+            for (idx = 0; vehicle_info[idx].key; idx++) {
+                if ((strcmp(vehicle_info[idx].property, property) == 0) &&
+                    (strcmp(vehicle_info[idx].path, path) == 0) &&
+                    (strcmp(vehicle_info[idx].interface, interface) == 0))  {
+                    vehicle_data[idx].signal ++;
+                    vehicle_data[idx].missed = 0;
+                    change += vehicle_value(&entry, idx);
+                }
             }
-            continue;
         }
-
-        dbus_message_iter_init(dbus_message, &iter_head);
-        dbus_message_iter_recurse(&iter_head, &iter);
-
-        type = dbus_message_iter_get_arg_type(&iter);
-        switch (type)   {
-        case DBUS_TYPE_INT32:
-            dbus_message_iter_get_basic(&iter, &i32);
-            vehicle_data[idx].val = (double)i32;
-            break;
-        case DBUS_TYPE_INT16:
-            dbus_message_iter_get_basic(&iter, &i16);
-            vehicle_data[idx].val = (double)i16;
-            break;
-        case DBUS_TYPE_UINT32:
-            dbus_message_iter_get_basic(&iter, &u32);
-            vehicle_data[idx].val = (double)u32;
-            break;
-        case DBUS_TYPE_UINT16:
-            dbus_message_iter_get_basic(&iter, &u16);
-            vehicle_data[idx].val = (double)u16;
-            break;
-        case DBUS_TYPE_BOOLEAN:
-            dbus_message_iter_get_basic(&iter, &b);
-            if (b)      vehicle_data[idx].val = (double)1.0;
-            else        vehicle_data[idx].val = (double)0.0;
-            break;
-        case DBUS_TYPE_BYTE:
-            dbus_message_iter_get_basic(&iter, &u8);
-            vehicle_data[idx].val = (double)u8;
-            break;
-        case DBUS_TYPE_DOUBLE:
-            dbus_message_iter_get_basic(&iter, &d64);
-            vehicle_data[idx].val = (double)d64;
-            break;
-        default:
-            apfw_warn("get_vehicle_info: (%s) illegal data type(0x%02x)",
-                      vehicle_info[idx].property, ((int)type) & 0x0ff);
-            break;
-        }
-#if 0   /* too many logout, change to comment   */
-        apfw_trace("get_vehicle_info: %s = %d",
-                   vehicle_info[idx].property, (int)vehicle_data[idx].val);
-#endif  /* too many logout, change to comment   */
-
-        /* free message and pending     */
-        dbus_message_unref(dbus_message);
-        dbus_pending_call_unref(vehicle_data[idx].pending);
-        vehicle_data[idx].pending = NULL;
-    };
-    return ICO_SYC_EOK;
+        dbus_message_iter_next(&dict);
+    }
+    if ((! vehicle_signal) && (vehicle_matched))    {
+        /* polling after fall back, signals of all properties arrive again */
+        for (idx = 0; vehicle_info[idx].key; idx++) {
+            if (vehicle_data[idx].missed >= ICO_SYC_APC_REGULATION_MISSMAX)  break;
+        }
+        if (! vehicle_info[idx].key)    {
+            apfw_trace("vehicle_changed: PropertiesChanged arrives, stop polling");
+            vehicle_signal = 1;
+            vehicle_tick = 0;
+        }
+    }
+    if (change) {
+        rule_engine_eval();
+    }
+    return DBUS_HANDLER_RESULT_HANDLED;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   rule_engine_wake: judge a run regulation state(static function)
+ * @brief   rule_engine_wake: periodic timer of regulation controller,
+ *          polls AMB(or resync when PropertiesChanged is used)
+ *          (static function)
  *
  * @param[in]   user_data       user data(unused)
  * @return      always ECORE_CALLBACK_RENEW(periodic timer)
@@ -283,21 +519,265 @@ get_vehicle_info(void)
 static Eina_Bool
 rule_engine_wake(void *user_data)
 {
-    int     idx;
+    /* send request to AMB                  */
+    vehicle_tick ++;
+    if ((! vehicle_signal) || (vehicle_tick >= ICO_SYC_APC_REGULATION_RESYNC))  {
+        vehicle_tick = 0;
+        request_vehicle_info();
+    }
+    return ECORE_CALLBACK_RENEW;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_compare: compare vehicle signal with predicate(static function)
+ *
+ * @param[in]   conf            regulation predicate
+ * @param[in]   val             value of vehicle signal
+ * @param[in]   hys             hysteresis(0.0 if predicate is false)
+ * @return      result
+ * @retval      1               predicate is true
+ * @retval      0               predicate is false
+ */
+/*--------------------------------------------------------------------------*/
+static int
+rule_compare(const Ico_Uxf_conf_regulation *conf, const double val, const double hys)
+{
+    int     i;
+
+    switch (conf->op)   {
+    case ICO_UXF_REGULATION_OP_EQ:
+    case ICO_UXF_REGULATION_OP_NE:
+        for (i = 0; i < conf->valueNum; i++)    {
+            if (val == conf->value[i])  break;
+        }
+        if (conf->op == ICO_UXF_REGULATION_OP_EQ)   {
+            return (i < conf->valueNum) ? 1 : 0;
+        }
+        return (i < conf->valueNum) ? 0 : 1;
+    case ICO_UXF_REGULATION_OP_GE:
+        return (val >= (conf->value[0] - hys)) ? 1 : 0;
+    case ICO_UXF_REGULATION_OP_GT:
+        return (val > (conf->value[0] - hys)) ? 1 : 0;
+    case ICO_UXF_REGULATION_OP_LE:
+        return (val <= (conf->value[0] + hys)) ? 1 : 0;
+    case ICO_UXF_REGULATION_OP_LT:
+        return (val < (conf->value[0] + hys)) ? 1 : 0;
+    default:
+        break;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_policy_judge: judge a regulation of policy by current
+ *          predicates(static function)
+ *
+ * @param[in]   policy          policy(ICO_UXF_POLICY_xxx)
+ * @param[out]  ctl             regulation(ICO_SYC_APC_REGULATION_(NO)REGULATION)
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              unknown policy(regulation is not changed)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+rule_policy_judge(const int policy, unsigned char *ctl)
+{
+    if ((policy < 0) || (policy >= RULE_POLICY_MAX))    {
+        return -1;
+    }
+    if (((rule_state & rule_policy[policy].on) == rule_policy[policy].on) &&
+        ((rule_state & rule_policy[policy].off) == 0))  {
+        *ctl = ICO_SYC_APC_REGULATION_NOREGULATION;
+    }
+    else    {
+        *ctl = ICO_SYC_APC_REGULATION_REGULATION;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_policy_mask: predicates that policy depends on(static function)
+ *
+ * @param[in]   policy          policy(ICO_UXF_POLICY_xxx)
+ * @return      predicates(bit mask)
+ */
+/*--------------------------------------------------------------------------*/
+static unsigned int
+rule_policy_mask(const int policy)
+{
+    if ((policy < 0) || (policy >= RULE_POLICY_MAX))    {
+        return 0;
+    }
+    return rule_policy[policy].on | rule_policy[policy].off;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_engine_compile: compile regulation predicates and policies of
+ *          system configuration(static function)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+rule_engine_compile(void)
+{
+    const Ico_Uxf_conf_regulation   *conf;
     int     i;
-    ico_apc_reguration_control_t    wkcontrol[ICO_UXF_CATEGORY_MAX];
-    ico_apc_reguration_control_t    change;
+
+    memset(rule_sigdep, 0, sizeof(rule_sigdep));
+    rule_state = 0;
+    for (i = 0; i < ICO_UXF_REGULATION_MAX; i++)    {
+        if (rule_pred[i].timer) {
+            ecore_timer_del(rule_pred[i].timer);
+            rule_pred[i].timer = NULL;
+        }
+        conf = &confsys->regulation[i];
+        rule_pred[i].conf = conf;
+        if ((conf->signal < 0) || (conf->signal >= ICO_UXF_REGULATION_SIG_MAX))  {
+            apfw_warn("rule_engine_compile: predicate.%d has unknown signal(%d)",
+                      i, conf->signal);
+            rule_pred[i].raw = 0;
+            continue;
+        }
+        rule_sigdep[conf->signal] |= RULE_PRED(i);
+
+        /* current state is judged without debounce */
+        rule_pred[i].raw = rule_compare(conf, rule_signal[conf->signal],
+                                        rule_pred[i].raw ? conf->hysteresis : 0.0);
+        if (rule_pred[i].raw)   {
+            rule_state |= RULE_PRED(i);
+        }
+    }
+    for (i = 0; i < ncategory; i++) {
+        rule_catdep[i] = rule_policy_mask(category[i].view) |
+                         rule_policy_mask(category[i].sound) |
+                         rule_policy_mask(category[i].input);
+    }
+    apfw_trace("rule_engine_compile: signal depends %x %x %x, state %x",
+               rule_sigdep[ICO_UXF_REGULATION_SIG_SPEED],
+               rule_sigdep[ICO_UXF_REGULATION_SIG_SHIFT],
+               rule_sigdep[ICO_UXF_REGULATION_SIG_BLINKER], rule_state);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_predicate_set: set new result of predicate, with debounce
+ *          (static function)
+ *
+ * @param[in]   pred            predicate(ICO_UXF_REGULATION_xxx)
+ * @param[in]   raw             result of comparison
+ * @return      changed predicates(bit mask)
+ */
+/*--------------------------------------------------------------------------*/
+static unsigned int
+rule_predicate_set(const int pred, const int raw)
+{
+    struct _rule_predicate  *p = &rule_pred[pred];
+    int     debounce;
+
+    p->raw = raw;
+    if (raw == ((rule_state & RULE_PRED(pred)) ? 1 : 0))    {
+        if (p->timer)   {
+            /* bounced back before debounce time    */
+            ecore_timer_del(p->timer);
+            p->timer = NULL;
+            regulation_stats.suppressed ++;
+            apfw_trace("rule_predicate_set: predicate.%d bounced(%d)", pred, raw);
+        }
+        return 0;
+    }
+
+    debounce = raw ? p->conf->debounce_on : p->conf->debounce_off;
+    if ((debounce > 0) && (! p->timer)) {
+        p->timer = ecore_timer_add((double)debounce / 1000.0,
+                                   rule_debounce_timer, (void *)(intptr_t)pred);
+        if (! p->timer) {
+            apfw_warn("rule_predicate_set: can not create debounce timer");
+        }
+    }
+    if (p->timer)   {
+        return 0;
+    }
+    rule_state ^= RULE_PRED(pred);
+    regulation_stats.changes ++;
+    return RULE_PRED(pred);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_debounce_timer: predicate was stable for debounce time
+ *          (static function)
+ *
+ * @param[in]   user_data       predicate(ICO_UXF_REGULATION_xxx)
+ * @return      always ECORE_CALLBACK_CANCEL(one shot)
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+rule_debounce_timer(void *user_data)
+{
+    int     pred = (int)(intptr_t)user_data;
+    long long   start;
+
+    rule_pred[pred].timer = NULL;
+    if (rule_pred[pred].raw != ((rule_state & RULE_PRED(pred)) ? 1 : 0))   {
+        start = rule_cputime();
+        rule_state ^= RULE_PRED(pred);
+        regulation_stats.changes ++;
+        rule_engine_judge(RULE_PRED(pred), 0);
+        rule_cpu += rule_cputime() - start;
+        regulation_stats.cputime = (int)(rule_cpu / 1000LL);
+    }
+    return ECORE_CALLBACK_CANCEL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_cputime: CPU time of this thread(static function)
+ *
+ * @param       none
+ * @return      CPU time(nano seconds)
+ */
+/*--------------------------------------------------------------------------*/
+static long long
+rule_cputime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_engine_eval: judge a run regulation state(static function)
+ *          called when vehicle information is changed.
+ *          only predicates of changed signals are evaluated.
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+rule_engine_eval(void)
+{
+    int     idx;
+    unsigned int    dirty = 0;
+    unsigned int    changed = 0;
+    double  value[ICO_UXF_REGULATION_SIG_MAX];
+    const Ico_Uxf_conf_regulation   *conf;
+    int     raw;
     double  VehicleSpeed = 0.0;
     int     ShiftPosition = ICO_SYC_APC_REGULATION_SHIFT_NEUTRALS;
     int     Blinker = ICO_SYC_APC_REGULATION_BLINKER_NONE;
+    long long   start;
 
-    /* call UX-FW timer     */
-    ico_uxf_timer_wake(100);
-
-    memset(wkcontrol, 0, sizeof(ico_apc_reguration_control_t) * ncategory);
-
-    /* get reply (vehicle ifno) */
-    get_vehicle_info();
+    regulation_stats.evals ++;
+    start = rule_cputime();
 
     /* get vehicle info values  */
     for (idx = 0; vehicle_data[idx].key; idx++)   {
@@ -334,216 +814,463 @@ rule_engine_wake(void *user_data)
         }
 #endif  /* use LightStatus, because AMB not support access of TurnSignal by D-Bus   */
     }
+    value[ICO_UXF_REGULATION_SIG_SPEED] = VehicleSpeed;
+    value[ICO_UXF_REGULATION_SIG_SHIFT] = (double)ShiftPosition;
+    value[ICO_UXF_REGULATION_SIG_BLINKER] = (double)Blinker;
 
-    /* Make control code            */
-    memcpy(wkcontrol, control, sizeof(ico_apc_reguration_control_t) * ncategory);
+    /* predicates that depend on changed signals    */
+    for (idx = 0; idx < ICO_UXF_REGULATION_SIG_MAX; idx++)  {
+        if (value[idx] != rule_signal[idx]) {
+            rule_signal[idx] = value[idx];
+            dirty |= rule_sigdep[idx];
+        }
+    }
 
-    /* Check Vehicle Speed          */
-    for (idx = 0; idx < ncategory; idx++)   {
-        switch (category[idx].view) {
-        case ICO_UXF_POLICY_ALWAYS:
-            wkcontrol[idx].display = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_RUNNING:
-            if (VehicleSpeed >= ICO_SYC_APC_REGULATION_SPEED_RUNNING)
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_NOREGULATION;
-            else
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_PARKED:
-            if (VehicleSpeed >= ICO_SYC_APC_REGULATION_SPEED_RUNNING)
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_REGULATION;
-            else
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_SHIFT_PARKING:
-            if ((VehicleSpeed < ICO_SYC_APC_REGULATION_SPEED_RUNNING) &&
-                ((ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_PARKING) ||
-                 (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_NEUTRALS)))
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_NOREGULATION;
-            else
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_SHIFT_REVERSES:
-            if (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES)
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_NOREGULATION;
-            else
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_BLINKER_LEFT:
-            if ((Blinker != ICO_SYC_APC_REGULATION_BLINKER_LEFT) ||
-                (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES))
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_REGULATION;
-            else
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_BLINKER_RIGHT:
-            if ((Blinker != ICO_SYC_APC_REGULATION_BLINKER_RIGHT) ||
-                (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES))
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_REGULATION;
-            else
-                wkcontrol[idx].display = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        default:
-            apfw_trace("rule_engine_wake: category(%d) has unknown view(%d)",
-                       idx, category[idx].view);
-            break;
+    for (idx = 0; idx < ICO_UXF_REGULATION_MAX; idx++)  {
+        if ((dirty & RULE_PRED(idx)) == 0)  continue;
+
+        regulation_stats.predicates ++;
+        conf = rule_pred[idx].conf;
+        raw = rule_compare(conf, rule_signal[conf->signal],
+                           rule_pred[idx].raw ? conf->hysteresis : 0.0);
+        if ((raw) && (rule_pred[idx].raw) && (conf->hysteresis > 0.0) &&
+            (! rule_compare(conf, rule_signal[conf->signal], 0.0)))  {
+            /* held by hysteresis       */
+            regulation_stats.suppressed ++;
         }
+        changed |= rule_predicate_set(idx, raw);
+    }
 
-        switch (category[idx].sound)    {
-        case ICO_UXF_POLICY_ALWAYS:
-            wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_RUNNING:
-            if (VehicleSpeed >= ICO_SYC_APC_REGULATION_SPEED_RUNNING)
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_NOREGULATION;
-            else
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_PARKED:
-            if (VehicleSpeed >= ICO_SYC_APC_REGULATION_SPEED_RUNNING)
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_REGULATION;
-            else
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_SHIFT_PARKING:
-            if ((VehicleSpeed < ICO_SYC_APC_REGULATION_SPEED_RUNNING) &&
-                ((ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_PARKING) ||
-                 (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_NEUTRALS)))
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_NOREGULATION;
-            else
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_SHIFT_REVERSES:
-            if (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES)
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_NOREGULATION;
-            else
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_BLINKER_LEFT:
-            if ((Blinker != ICO_SYC_APC_REGULATION_BLINKER_LEFT) ||
-                (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES))
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_REGULATION;
-            else
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_BLINKER_RIGHT:
-            if ((Blinker != ICO_SYC_APC_REGULATION_BLINKER_RIGHT) ||
-                (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES))
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_REGULATION;
-            else
-                wkcontrol[idx].sound = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        default:
-            apfw_trace("rule_engine_wake: category(%d) has unknown sound(%d)",
+    /* first evaluation judges all categorys    */
+    rule_engine_judge(changed, rule_judged ? 0 : 1);
+
+    rule_cpu += rule_cputime() - start;
+    regulation_stats.cputime = (int)(rule_cpu / 1000LL);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   rule_engine_judge: judge regulation of categorys that depend on
+ *          changed predicates, and notify changes to listeners(static function)
+ *
+ * @param[in]   changed         changed predicates(bit mask)
+ * @param[in]   all             judge all categorys(1) or only depend categorys(0)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+rule_engine_judge(const unsigned int changed, const int all)
+{
+    int     idx;
+    ico_apc_reguration_control_t    wkcontrol;
+    ico_apc_regulation_change_t     change;
+
+    if ((! all) && (changed == 0))  {
+        return;
+    }
+    rule_judged = 1;
+    change.changed = 0;
+
+    for (idx = 0; idx < ncategory; idx++) {
+        if ((! all) && ((rule_catdep[idx] & changed) == 0)) continue;
+
+        regulation_stats.categories ++;
+        memcpy(&wkcontrol, &control[idx], sizeof(ico_apc_reguration_control_t));
+        if (rule_policy_judge(category[idx].view, &wkcontrol.display) < 0)  {
+            apfw_trace("rule_engine_judge: category(%d) has unknown view(%d)",
+                       idx, category[idx].view);
+        }
+        if (rule_policy_judge(category[idx].sound, &wkcontrol.sound) < 0)   {
+            apfw_trace("rule_engine_judge: category(%d) has unknown sound(%d)",
                        idx, category[idx].sound);
-            break;
+        }
+        if (rule_policy_judge(category[idx].input, &wkcontrol.input) < 0)   {
+            apfw_trace("rule_engine_judge: category(%d) has unknown input(%d)",
+                       idx, category[idx].input);
         }
 
-        switch (category[idx].input)    {
-        case ICO_UXF_POLICY_ALWAYS:
-            wkcontrol[idx].input = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_RUNNING:
-            if (VehicleSpeed >= ICO_SYC_APC_REGULATION_SPEED_RUNNING)
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_NOREGULATION;
-            else
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_PARKED:
-            if (VehicleSpeed >= ICO_SYC_APC_REGULATION_SPEED_RUNNING)
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_REGULATION;
-            else
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_SHIFT_PARKING:
-            if ((VehicleSpeed < ICO_SYC_APC_REGULATION_SPEED_RUNNING) &&
-                ((ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_PARKING) ||
-                 (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_NEUTRALS)))
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_NOREGULATION;
-            else
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_SHIFT_REVERSES:
-            if (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES)
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_NOREGULATION;
+        if ((control[idx].display != wkcontrol.display) ||
+            (control[idx].sound != wkcontrol.sound) ||
+            (control[idx].input != wkcontrol.input))   {
+            apfw_trace("rule_engine_judge: Category.%d view.%d>%d sound.%d>%d inp.%d>%d",
+                       idx, control[idx].display, wkcontrol.display,
+                       control[idx].sound, wkcontrol.sound,
+                       control[idx].input, wkcontrol.input);
+
+            change.changed |= ICO_SYC_APC_CATEGORY_BIT(idx);
+            if (control[idx].display != wkcontrol.display)
+                change.control[idx].display = wkcontrol.display;
             else
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_REGULATION;
-            break;
-        case ICO_UXF_POLICY_BLINKER_LEFT:
-            if ((Blinker != ICO_SYC_APC_REGULATION_BLINKER_LEFT) ||
-                (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES))
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_REGULATION;
+                change.control[idx].display = ICO_SYC_APC_REGULATION_NOCHANGE;
+            if (control[idx].sound != wkcontrol.sound)
+                change.control[idx].sound = wkcontrol.sound;
             else
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        case ICO_UXF_POLICY_BLINKER_RIGHT:
-            if ((Blinker != ICO_SYC_APC_REGULATION_BLINKER_RIGHT) ||
-                (ShiftPosition == ICO_SYC_APC_REGULATION_SHIFT_REVERSES))
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_REGULATION;
+                change.control[idx].sound = ICO_SYC_APC_REGULATION_NOCHANGE;
+            if (control[idx].input != wkcontrol.input)
+                change.control[idx].input = wkcontrol.input;
             else
-                wkcontrol[idx].input = ICO_SYC_APC_REGULATION_NOREGULATION;
-            break;
-        default:
-            apfw_trace("rule_engine_wake: category(%d) has unknown input(%d)",
-                       idx, category[idx].input);
-            break;
-        }
-    }
+                change.control[idx].input = ICO_SYC_APC_REGULATION_NOCHANGE;
+            change.control[idx].res = 0;
 
-    for (idx = 0; idx < ncategory; idx++) {
-        if ((control[idx].display != wkcontrol[idx].display) ||
-            (control[idx].sound != wkcontrol[idx].sound) ||
-            (control[idx].input != wkcontrol[idx].input))   {
-            apfw_trace("rule_engine_wake: Category.%d view.%d>%d sound.%d>%d inp.%d>%d",
-                       idx, control[idx].display, wkcontrol[idx].display,
-                       control[idx].sound, wkcontrol[idx].sound,
-                       control[idx].input, wkcontrol[idx].input);
-
-            if (nregulation_cb > 0)  {
-                if (control[idx].display != wkcontrol[idx].display)
-                    change.display = wkcontrol[idx].display;
-                else
-                    change.display = ICO_SYC_APC_REGULATION_NOCHANGE;
-                if (control[idx].sound != wkcontrol[idx].sound)
-                    change.sound = wkcontrol[idx].sound;
-                else
-                    change.sound = ICO_SYC_APC_REGULATION_NOCHANGE;
-                if (control[idx].input != wkcontrol[idx].input)
-                    change.input = wkcontrol[idx].input;
-                else
-                    change.input = ICO_SYC_APC_REGULATION_NOCHANGE;
-
-                for (i = 0; i < nregulation_cb; i++)    {
-                    (*regulation_cb[i])(idx, change, regulation_cb_user_data[i]);
-                }
-            }
-            control[idx].display = wkcontrol[idx].display;
-            control[idx].sound = wkcontrol[idx].sound;
-            control[idx].input = wkcontrol[idx].input;
+            control[idx].display = wkcontrol.display;
+            control[idx].sound = wkcontrol.sound;
+            control[idx].input = wkcontrol.input;
         }
     }
-    /* send request to AMB                  */
-    request_vehicle_info();
 
-    return ECORE_CALLBACK_RENEW;
+    /* notify all changes of this evaluation at once    */
+    if (change.changed) {
+        rule_engine_notify(&change);
+    }
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_syc_apc_regulation_init: initialize regulation control
+ * @brief   rule_engine_notify: notify regulation changes to listeners
+ *          (static function)
  *
- * @param       none
- * @return      result
- * @retval      ICO_SYC_EOK     success
- * @retval      ICO_SYC_EIO     error(D-Bus initialize error)
+ * @param[in]   change          changed categorys and new controls
+ * @return      none
  */
 /*--------------------------------------------------------------------------*/
-int
-ico_syc_apc_regulation_init(void)
+static void
+rule_engine_notify(const ico_apc_regulation_change_t *change)
 {
+    ico_apc_regulation_change_t wkchange;
+    ico_apc_category_set_t      categorys;
     int     i;
-    DBusError dbus_error;
+    int     idx;
+
+    regulation_stats.notifies ++;
+    for (i = 0; i < nregulation_cb; i++)    {
+        categorys = change->changed & regulation_cb[i].categorys;
+        if (categorys == 0) continue;
+
+        if (regulation_cb[i].setfunc)   {
+            if (categorys == change->changed)   {
+                (*regulation_cb[i].setfunc)(change, regulation_cb[i].user_data);
+            }
+            else    {
+                /* only subscribed categorys    */
+                memcpy(&wkchange, change, sizeof(wkchange));
+                wkchange.changed = categorys;
+                (*regulation_cb[i].setfunc)(&wkchange, regulation_cb[i].user_data);
+            }
+        }
+        else    {
+            for (idx = 0; idx < ncategory; idx++)   {
+                if (categorys & ICO_SYC_APC_CATEGORY_BIT(idx))  {
+                    (*regulation_cb[i].func)(idx, change->control[idx],
+                                             regulation_cb[i].user_data);
+                }
+            }
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   regulation_add_listener: add or update regulation listener
+ *          (static function)
+ *
+ * @param[in]   func            listener of each category(or NULL)
+ * @param[in]   setfunc         listener of change set(or NULL)
+ * @param[in]   categorys       subscribed categorys
+ * @param[in]   user_data       user data
+ * @return      result
+ * @retval      >= 0            index of listener
+ * @retval      -1              error(too many listeners)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+regulation_add_listener(ico_apc_regulation_cb_t func, ico_apc_regulation_set_cb_t setfunc,
+                        const ico_apc_category_set_t categorys, void *user_data)
+{
+    int     idx;
+
+    for (idx = 0; idx < nregulation_cb; idx++)  {
+        if ((regulation_cb[idx].func == func) &&
+            (regulation_cb[idx].setfunc == setfunc))    break;
+    }
+    if (idx >= nregulation_cb)  {
+        if (nregulation_cb >= ICO_SYC_APC_REGULATION_LISTENERS) {
+            return -1;
+        }
+        idx = nregulation_cb;
+        nregulation_cb ++;
+    }
+    regulation_cb[idx].func = func;
+    regulation_cb[idx].setfunc = setfunc;
+    regulation_cb[idx].categorys = categorys;
+    regulation_cb[idx].user_data = user_data;
+    return idx;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_add_watch: add D-Bus watch to Ecore main loop(static function)
+ *
+ * @param[in]   watch           D-Bus watch
+ * @param[in]   data            user data(unused)
+ * @return      result
+ * @retval      TRUE            success
+ * @retval      FALSE           error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static dbus_bool_t
+loop_add_watch(DBusWatch *watch, void *data)
+{
+    Ecore_Fd_Handler    *handler;
+    unsigned int        flags;
+    int                 eflags = ECORE_FD_ERROR;
+
+    if (! dbus_watch_get_enabled(watch))    {
+        return TRUE;
+    }
+    flags = dbus_watch_get_flags(watch);
+    if (flags & DBUS_WATCH_READABLE)    eflags |= ECORE_FD_READ;
+    if (flags & DBUS_WATCH_WRITABLE)    eflags |= ECORE_FD_WRITE;
+
+    handler = ecore_main_fd_handler_add(dbus_watch_get_unix_fd(watch), eflags,
+                                        loop_watch_handler, watch, NULL, NULL);
+    if (! handler)  {
+        apfw_error("loop_add_watch: can not add Ecore fd handler");
+        return FALSE;
+    }
+    dbus_watch_set_data(watch, handler, NULL);
+    return TRUE;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_remove_watch: remove D-Bus watch from Ecore main loop
+ *          (static function)
+ *
+ * @param[in]   watch           D-Bus watch
+ * @param[in]   data            user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+loop_remove_watch(DBusWatch *watch, void *data)
+{
+    Ecore_Fd_Handler    *handler = (Ecore_Fd_Handler *)dbus_watch_get_data(watch);
+
+    if (handler)    {
+        ecore_main_fd_handler_del(handler);
+        dbus_watch_set_data(watch, NULL, NULL);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_toggle_watch: D-Bus watch is enabled or disabled
+ *          (static function)
+ *
+ * @param[in]   watch           D-Bus watch
+ * @param[in]   data            user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+loop_toggle_watch(DBusWatch *watch, void *data)
+{
+    loop_remove_watch(watch, data);
+    (void) loop_add_watch(watch, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_watch_handler: D-Bus connection is readable or writable
+ *          (Ecore fd handler, static function)
+ *
+ * @param[in]   data            D-Bus watch
+ * @param[in]   handler         Ecore fd handler
+ * @return      always ECORE_CALLBACK_RENEW
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+loop_watch_handler(void *data, Ecore_Fd_Handler *handler)
+{
+    DBusWatch       *watch = (DBusWatch *)data;
+    unsigned int    flags = 0;
+
+    if (ecore_main_fd_handler_active_get(handler, ECORE_FD_READ))   {
+        flags |= DBUS_WATCH_READABLE;
+    }
+    if (ecore_main_fd_handler_active_get(handler, ECORE_FD_WRITE))  {
+        flags |= DBUS_WATCH_WRITABLE;
+    }
+    if (ecore_main_fd_handler_active_get(handler, ECORE_FD_ERROR))  {
+        flags |= DBUS_WATCH_ERROR;
+    }
+    (void) dbus_watch_handle(watch, flags);
+
+    /* dispatch received messages   */
+    loop_dispatch();
+    return ECORE_CALLBACK_RENEW;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_add_timeout: add D-Bus timeout to Ecore main loop
+ *          (static function)
+ *
+ * @param[in]   timeout         D-Bus timeout
+ * @param[in]   data            user data(unused)
+ * @return      result
+ * @retval      TRUE            success
+ * @retval      FALSE           error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static dbus_bool_t
+loop_add_timeout(DBusTimeout *timeout, void *data)
+{
+    Ecore_Timer     *timer;
+
+    if (! dbus_timeout_get_enabled(timeout))    {
+        return TRUE;
+    }
+    timer = ecore_timer_add(((double)dbus_timeout_get_interval(timeout)) / 1000.0,
+                            loop_timeout_handler, timeout);
+    if (! timer)    {
+        apfw_error("loop_add_timeout: can not add Ecore timer");
+        return FALSE;
+    }
+    dbus_timeout_set_data(timeout, timer, NULL);
+    return TRUE;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_remove_timeout: remove D-Bus timeout from Ecore main loop
+ *          (static function)
+ *
+ * @param[in]   timeout         D-Bus timeout
+ * @param[in]   data            user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+loop_remove_timeout(DBusTimeout *timeout, void *data)
+{
+    Ecore_Timer     *timer = (Ecore_Timer *)dbus_timeout_get_data(timeout);
+
+    if (timer)  {
+        ecore_timer_del(timer);
+        dbus_timeout_set_data(timeout, NULL, NULL);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_toggle_timeout: D-Bus timeout is enabled or disabled
+ *          (static function)
+ *
+ * @param[in]   timeout         D-Bus timeout
+ * @param[in]   data            user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+loop_toggle_timeout(DBusTimeout *timeout, void *data)
+{
+    loop_remove_timeout(timeout, data);
+    (void) loop_add_timeout(timeout, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_timeout_handler: D-Bus timeout expired(Ecore timer,
+ *          static function)
+ *
+ * @param[in]   data            D-Bus timeout
+ * @return      always ECORE_CALLBACK_RENEW(D-Bus removes timeout)
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+loop_timeout_handler(void *data)
+{
+    (void) dbus_timeout_handle((DBusTimeout *)data);
+
+    /* timed out pending calls are completed    */
+    loop_dispatch();
+    return ECORE_CALLBACK_RENEW;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_dispatch_status: D-Bus dispatch status is changed
+ *          (static function)
+ *
+ * @param[in]   connection      D-Bus connection
+ * @param[in]   status          dispatch status
+ * @param[in]   data            user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+loop_dispatch_status(DBusConnection *connection, DBusDispatchStatus status, void *data)
+{
+    if ((status == DBUS_DISPATCH_DATA_REMAINS) && (! dbus_idler))   {
+        /* messages are queued without fd event, dispatch them in main loop   */
+        dbus_idler = ecore_idler_add(loop_dispatch_idler, NULL);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_dispatch_idler: dispatch queued D-Bus messages
+ *          (Ecore idler, static function)
+ *
+ * @param[in]   data            user data(unused)
+ * @return      always ECORE_CALLBACK_CANCEL(one shot)
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+loop_dispatch_idler(void *data)
+{
+    dbus_idler = NULL;
+    loop_dispatch();
+    return ECORE_CALLBACK_CANCEL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loop_dispatch: dispatch all received D-Bus messages(static function)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+loop_dispatch(void)
+{
+    if (dbus_idler) {
+        ecore_idler_del(dbus_idler);
+        dbus_idler = NULL;
+    }
+    while (dbus_connection_dispatch(dbus_connection) == DBUS_DISPATCH_DATA_REMAINS)    {
+        ;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_regulation_init: initialize regulation control
+ *
+ * @param       none
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_EIO     error(D-Bus initialize error)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_regulation_init(void)
+{
+    int     i, j;
+    DBusError dbus_error;
+    char    rule[256];
 
     apfw_trace("ico_syc_apc_regulation_init: Enter");
 
@@ -565,17 +1292,78 @@ ico_syc_apc_regulation_init(void)
         control[i].input = ICO_SYC_APC_REGULATION_NOREGULATION;
     }
 
+    /* compile regulation rules(judged by first vehicle information)    */
+    memset(rule_pred, 0, sizeof(rule_pred));
+    memset(rule_signal, 0, sizeof(rule_signal));
+    memset(&regulation_stats, 0, sizeof(regulation_stats));
+    rule_cpu = 0;
+    rule_judged = 0;
+    vehicle_inject = 0;
+    rule_engine_compile();
+
     /* Reset D-Bus error        */
     dbus_error_init(&dbus_error);
 
-    /* Get D-Bus connection     */
-    dbus_connection = dbus_bus_get(DBUS_BUS_SYSTEM, &dbus_error);
+    /* Get D-Bus connection(private, because main loop functions are set)  */
+    dbus_connection = dbus_bus_get_private(DBUS_BUS_SYSTEM, &dbus_error);
     if (! dbus_connection){
         apfw_warn("ico_syc_apc_regulation_init: Leave(ERROR dbus_bus_get)" );
+        dbus_error_free(&dbus_error);
         return ICO_SYC_EIO;
     }
+    dbus_connection_set_exit_on_disconnect(dbus_connection, FALSE);
 
-    /* send request to AMB                  */
+    /* D-Bus connection in Ecore main loop  */
+    if ((! dbus_connection_set_watch_functions(dbus_connection, loop_add_watch,
+                                               loop_remove_watch, loop_toggle_watch,
+                                               NULL, NULL)) ||
+        (! dbus_connection_set_timeout_functions(dbus_connection, loop_add_timeout,
+                                                 loop_remove_timeout, loop_toggle_timeout,
+                                                 NULL, NULL)))  {
+        apfw_warn("ico_syc_apc_regulation_init: Leave(ERROR set main loop functions)");
+        dbus_connection_close(dbus_connection);
+        dbus_connection_unref(dbus_connection);
+        dbus_connection = NULL;
+        return ICO_SYC_EIO;
+    }
+    dbus_connection_set_dispatch_status_function(dbus_connection, loop_dispatch_status,
+                                                 NULL, NULL);
+
+    /* subscribe PropertiesChanged of AMB, polling if it is not supported   */
+    vehicle_signal = 0;
+    vehicle_tick = 0;
+    if (dbus_connection_add_filter(dbus_connection, vehicle_changed, NULL, NULL))  {
+        vehicle_signal = 1;
+        for (i = 0; vehicle_info[i].key; i++)   {
+            if (vehicle_info[i].path[0] == 0)   continue;
+            for (j = 0; j < i; j++) {
+                if (strcmp(vehicle_info[j].path, vehicle_info[i].path) == 0)    break;
+            }
+            if (j < i)  continue;
+
+            snprintf(rule, sizeof(rule), "type='signal',sender='%s',path='%s',"
+                     "interface='%s',member='%s'", DBUS_SERVICE,
+                     vehicle_info[i].path, DBUS_INTERFACE, DBUS_SIGNAL);
+            dbus_bus_add_match(dbus_connection, rule, &dbus_error);
+            if (dbus_error_is_set(&dbus_error)) {
+                apfw_warn("ico_syc_apc_regulation_init: add match(%s) Error(%s), "
+                          "polling", vehicle_info[i].path, dbus_error.message);
+                dbus_error_free(&dbus_error);
+                vehicle_signal = 0;
+                break;
+            }
+        }
+    }
+    vehicle_matched = vehicle_signal;
+    apfw_trace("ico_syc_apc_regulation_init: vehicle information by %s",
+               vehicle_signal ? "PropertiesChanged" : "polling");
+
+    /* record vehicle signals(for replay of drive cycle) */
+    if (getenv(ICO_SYC_APC_REGULATION_RECORD))  {
+        (void) ico_syc_apc_regulation_record(getenv(ICO_SYC_APC_REGULATION_RECORD));
+    }
+
+    /* send request to AMB(current values)  */
     request_vehicle_info();
 
     vehicle_timer = ecore_timer_add(0.1, rule_engine_wake, NULL);
@@ -588,6 +1376,48 @@ ico_syc_apc_regulation_init(void)
     return ICO_SYC_EOK;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_regulation_reconfig: change system configuration
+ *          (live reload of system configuration)
+ *
+ * @param[in]   conf            new system configuration
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_EINVAL  error(illegal configuration)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_regulation_reconfig(const Ico_Uxf_Sys_Config *conf)
+{
+    int     i;
+
+    apfw_trace("ico_syc_apc_regulation_reconfig: Enter(category=%d->%d)",
+               ncategory, conf ? conf->categoryNum : -1);
+
+    if ((! conf) || (conf->categoryNum > ICO_UXF_CATEGORY_MAX)) {
+        apfw_warn("ico_syc_apc_regulation_reconfig: Leave(illegal configuration)");
+        return ICO_SYC_EINVAL;
+    }
+
+    /* added categorys has no regulation until judged by current values */
+    for (i = ncategory; i < conf->categoryNum; i++) {
+        control[i].display = ICO_SYC_APC_REGULATION_NOREGULATION;
+        control[i].sound = ICO_SYC_APC_REGULATION_NOREGULATION;
+        control[i].input = ICO_SYC_APC_REGULATION_NOREGULATION;
+    }
+    confsys = (Ico_Uxf_Sys_Config *)conf;
+    ncategory = confsys->categoryNum;
+    category = confsys->category;
+
+    /* predicates and policies may be changed, judge again  */
+    rule_engine_compile();
+    rule_engine_judge(0, 1);
+
+    apfw_trace("ico_syc_apc_regulation_reconfig: Leave(EOK)");
+    return ICO_SYC_EOK;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_syc_apc_regulation_term: terminate regulation control
@@ -599,6 +1429,8 @@ ico_syc_apc_regulation_init(void)
 int
 ico_syc_apc_regulation_term(void)
 {
+    int     i;
+
     apfw_trace("ico_syc_apc_regulation_term: Enter");
 
     if (! confsys) {
@@ -606,6 +1438,35 @@ ico_syc_apc_regulation_term(void)
         return ICO_SYC_EOK;
     }
     ecore_timer_del(vehicle_timer);
+    vehicle_timer = NULL;
+    for (i = 0; i < ICO_UXF_REGULATION_MAX; i++)    {
+        if (rule_pred[i].timer) {
+            ecore_timer_del(rule_pred[i].timer);
+            rule_pred[i].timer = NULL;
+        }
+    }
+
+    for (i = 0; vehicle_info[i].key; i++)   {
+        if (vehicle_data[i].pending)    {
+            dbus_pending_call_cancel(vehicle_data[i].pending);
+            dbus_pending_call_unref(vehicle_data[i].pending);
+            vehicle_data[i].pending = NULL;
+        }
+    }
+    if (dbus_connection)    {
+        dbus_connection_remove_filter(dbus_connection, vehicle_changed, NULL);
+        vehicle_signal = 0;
+        vehicle_matched = 0;
+        dbus_connection_close(dbus_connection);
+        dbus_connection_unref(dbus_connection);
+        dbus_connection = NULL;
+    }
+    if (dbus_idler) {
+        ecore_idler_del(dbus_idler);
+        dbus_idler = NULL;
+    }
+    (void) ico_syc_apc_regulation_record(NULL);
+    vehicle_inject = 0;
 
     confsys = NULL;
 
@@ -631,23 +1492,56 @@ ico_syc_apc_regulation_listener(ico_apc_regulation_cb_t func, void *user_data)
         nregulation_cb = 0;
         return;
     }
+    if (regulation_add_listener(func, NULL, ICO_SYC_APC_CATEGORY_ALL, user_data) < 0) {
+        apfw_error("ico_syc_apc_regulation_listener: Too many listeners");
+        return;
+    }
 
-    for (idx = 0; idx < nregulation_cb; idx++)  {
-        if (regulation_cb[idx] == func) break;
+    for (idx = 0; idx < ncategory; idx++) {
+        (*func)(idx, control[idx], user_data);
     }
-    if (idx >= nregulation_cb)  {
-        if (nregulation_cb >= ICO_SYC_APC_REGULATION_LISTENERS) {
-            apfw_error("ico_syc_apc_regulation_listener: Too many listeners");
-            return;
-        }
-        idx = nregulation_cb;
-        nregulation_cb ++;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_regulation_set_listener: set regulation change set listener
+ *          (listener is called once each evaluation with all changed categorys,
+ *           and called with current controls of subscribed categorys at set)
+ *
+ * @param[in]   func            listener function(NULL is remove all listeners)
+ * @param[in]   categorys       subscribed categorys(ICO_SYC_APC_CATEGORY_BIT(id)
+ *                              or ICO_SYC_APC_CATEGORY_ALL)
+ * @param[in]   user_data       user data
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_regulation_set_listener(ico_apc_regulation_set_cb_t func,
+                                    const ico_apc_category_set_t categorys,
+                                    void *user_data)
+{
+    ico_apc_regulation_change_t current;
+    int     idx;
+
+    if (func == NULL)   {
+        nregulation_cb = 0;
+        return;
+    }
+    if (regulation_add_listener(NULL, func, categorys, user_data) < 0)  {
+        apfw_error("ico_syc_apc_regulation_set_listener: Too many listeners");
+        return;
     }
-    regulation_cb[idx] = func;
-    regulation_cb_user_data[idx] = user_data;
 
+    memset(&current, 0, sizeof(current));
     for (idx = 0; idx < ncategory; idx++) {
-        (*func)(idx, control[idx], user_data);
+        if (categorys & ICO_SYC_APC_CATEGORY_BIT(idx))  {
+            current.changed |= ICO_SYC_APC_CATEGORY_BIT(idx);
+            memcpy(&current.control[idx], &control[idx],
+                   sizeof(ico_apc_reguration_control_t));
+        }
+    }
+    if (current.changed)    {
+        (*func)(&current, user_data);
     }
 }
 
@@ -720,3 +1614,117 @@ ico_syc_apc_regulation_app_input(const int category)
     return FALSE;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_regulation_stats: get statistics of regulation rule engine
+ *
+ * @param[out]  stats           statistics of rule engine
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_regulation_stats(ico_apc_regulation_stats_t *stats)
+{
+    if (stats)  {
+        memcpy(stats, &regulation_stats, sizeof(ico_apc_regulation_stats_t));
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_regulation_record: record vehicle signal changes to file
+ *          (replayed by sim_apc -r or amb_fake -r)
+ *
+ * @param[in]   file            record file name(NULL is stop record)
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_EIO     error(can not create file)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_regulation_record(const char *file)
+{
+    int     idx;
+
+    if (vehicle_record) {
+        fclose(vehicle_record);
+        vehicle_record = NULL;
+        apfw_trace("ico_syc_apc_regulation_record: record stopped");
+    }
+    if (! file) {
+        return ICO_SYC_EOK;
+    }
+
+    vehicle_record = fopen(file, "w");
+    if (! vehicle_record)   {
+        apfw_warn("ico_syc_apc_regulation_record: can not create %s(%d)", file, errno);
+        return ICO_SYC_EIO;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &vehicle_record_start);
+    fprintf(vehicle_record, "## vehicle signal record(ico_syc_apc_regulation_record)\n"
+                            "##  <time(ms)> <property> <value>\n");
+
+    /* current values are start of record   */
+    for (idx = 0; vehicle_info[idx].key; idx++) {
+        if (vehicle_data[idx].valid)    {
+            vehicle_record_put(idx);
+            if (! vehicle_record)   {
+                return ICO_SYC_EIO;
+            }
+        }
+    }
+    apfw_trace("ico_syc_apc_regulation_record: record to %s", file);
+    return ICO_SYC_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_regulation_inject: inject vehicle signal in process
+ *          (replay of record, values from AMB are ignored while injecting)
+ *
+ * @param[in]   property        D-Bus property name of vehicle information
+ *                              (NULL is end of injection, values are got from AMB)
+ * @param[in]   value           value of vehicle information
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_ESRCH   error(regulation controller is not initialized)
+ * @retval      ICO_SYC_ENOENT  error(unknown property)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_regulation_inject(const char *property, const double value)
+{
+    int     idx;
+
+    if (! confsys)  {
+        return ICO_SYC_ESRCH;
+    }
+    if (! property) {
+        /* end of injection, resync with AMB    */
+        if (vehicle_inject) {
+            vehicle_inject = 0;
+            for (idx = 0; vehicle_info[idx].key; idx++) {
+                vehicle_data[idx].valid = 0;
+            }
+            request_vehicle_info();
+        }
+        return ICO_SYC_EOK;
+    }
+
+    for (idx = 0; vehicle_info[idx].key; idx++) {
+        if (strcmp(vehicle_info[idx].property, property) == 0)  break;
+    }
+    if (! vehicle_info[idx].key)    {
+        apfw_trace("ico_syc_apc_regulation_inject: unknown property(%s)", property);
+        return ICO_SYC_ENOENT;
+    }
+    vehicle_inject = 1;
+    if ((vehicle_data[idx].valid) && (vehicle_data[idx].val == value))  {
+        return ICO_SYC_EOK;
+    }
+    apfw_trace("ico_syc_apc_regulation_inject: %s = %g", property, value);
+    vehicle_data[idx].val = value;
+    vehicle_data[idx].valid = 1;
+    rule_engine_eval();
+    return ICO_SYC_EOK;
+}
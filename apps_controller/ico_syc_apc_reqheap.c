@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   request priority queue of display/sound zone and input switch,
+ *          and reply deadline queue(indexed binary heap)
+ *
+ * @date    Feb-28-2013
+ */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+
+#include    "ico_syc_apc.h"
+#include    "ico_syc_apc_private.h"
+
+/*==============================================================================*/
+/* static tables                                                                */
+/*==============================================================================*/
+/* order of same priority requests(newer request is higher)                 */
+static int  seq_high = 0;                   /* last order of before same priority   */
+static int  seq_low = 0;                    /* last order of after same priority    */
+
+/*==============================================================================*/
+/* define static function prototype                                             */
+/*==============================================================================*/
+static void reqheap_set(ico_apc_reqheap_t *heap, const int idx, ico_apc_request_t *req);
+static void reqheap_up(ico_apc_reqheap_t *heap, int idx);
+static void reqheap_down(ico_apc_reqheap_t *heap, int idx);
+static int reqheap_grow(ico_apc_reqheap_t *heap);
+static void replyq_set(ico_apc_reqheap_t *queue, const int idx, ico_apc_request_t *req);
+static void replyq_up(ico_apc_reqheap_t *queue, int idx);
+static void replyq_down(ico_apc_reqheap_t *queue, int idx);
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_reqheap_cmp: compare priority of requests
+ *
+ * @param[in]   a               request block 1
+ * @param[in]   b               request block 2
+ * @return      result of compare
+ * @retval      > 0             a is higher priority than b
+ * @retval      < 0             a is lower priority than b
+ * @retval      = 0             same request
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_reqheap_cmp(const ico_apc_request_t *a, const ico_apc_request_t *b)
+{
+    unsigned int    ua, ub;
+
+    /* regulation and interrupt priority    */
+    ua = (unsigned int)a->prio & ICO_APC_PRIO_UPPER;
+    ub = (unsigned int)b->prio & ICO_APC_PRIO_UPPER;
+    if (ua != ub)   {
+        return (ua > ub) ? 1 : -1;
+    }
+    /* active application(newer active application is higher)  */
+    if (a->actepoch != b->actepoch) {
+        return (a->actepoch > b->actepoch) ? 1 : -1;
+    }
+    /* category and process priority    */
+    ua = (unsigned int)a->prio & ICO_APC_PRIO_LOWER;
+    ub = (unsigned int)b->prio & ICO_APC_PRIO_LOWER;
+    if (ua != ub)   {
+        return (ua > ub) ? 1 : -1;
+    }
+    /* order of request                 */
+    if (a->seq != b->seq)   {
+        return (a->seq > b->seq) ? 1 : -1;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   reqheap_set: set request to heap array(static function)
+ *
+ * @param[in]   heap            request priority queue
+ * @param[in]   idx             index of heap array
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+reqheap_set(ico_apc_reqheap_t *heap, const int idx, ico_apc_request_t *req)
+{
+    heap->req[idx] = req;
+    req->hidx = idx;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   reqheap_up: move request to upper in heap(static function)
+ *
+ * @param[in]   heap            request priority queue
+ * @param[in]   idx             index of moving request
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+reqheap_up(ico_apc_reqheap_t *heap, int idx)
+{
+    ico_apc_request_t   *req = heap->req[idx];
+    int     parent;
+
+    while (idx > 0) {
+        parent = (idx - 1) / 2;
+        if (ico_syc_apc_reqheap_cmp(req, heap->req[parent]) <= 0)   break;
+        reqheap_set(heap, idx, heap->req[parent]);
+        idx = parent;
+    }
+    reqheap_set(heap, idx, req);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   reqheap_down: move request to lower in heap(static function)
+ *
+ * @param[in]   heap            request priority queue
+ * @param[in]   idx             index of moving request
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+reqheap_down(ico_apc_reqheap_t *heap, int idx)
+{
+    ico_apc_request_t   *req = heap->req[idx];
+    int     child;
+
+    while (1)   {
+        child = idx * 2 + 1;
+        if (child >= heap->num) break;
+        if ((child + 1 < heap->num) &&
+            (ico_syc_apc_reqheap_cmp(heap->req[child + 1], heap->req[child]) > 0)) {
+            child ++;
+        }
+        if (ico_syc_apc_reqheap_cmp(heap->req[child], req) <= 0)    break;
+        reqheap_set(heap, idx, heap->req[child]);
+        idx = child;
+    }
+    reqheap_set(heap, idx, req);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   reqheap_grow: expand heap array, if heap array is full(static function)
+ *
+ * @param[in]   heap            request priority queue
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_ENOMEM  error(out of memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+reqheap_grow(ico_apc_reqheap_t *heap)
+{
+    ico_apc_request_t   **newreq;
+    int     newsize;
+
+    if (heap->num < heap->size) {
+        return ICO_SYC_EOK;
+    }
+    newsize = (heap->size > 0) ? (heap->size * 2) : ICO_APC_REQHEAP_INIT;
+    newreq = realloc(heap->req, sizeof(ico_apc_request_t *) * newsize);
+    if (! newreq)   {
+        apfw_error("reqheap_grow: No Memory");
+        return ICO_SYC_ENOMEM;
+    }
+    heap->req = newreq;
+    heap->size = newsize;
+    return ICO_SYC_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_reqheap_add: add request to priority queue
+ *          (request is placed before requests of same priority)
+ *
+ * @param[in]   heap            request priority queue
+ * @param[in]   req             request block(prio and actepoch are set)
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_ENOMEM  error(out of memory)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_reqheap_add(ico_apc_reqheap_t *heap, ico_apc_request_t *req)
+{
+    if (reqheap_grow(heap) != ICO_SYC_EOK)  {
+        req->hidx = -1;
+        return ICO_SYC_ENOMEM;
+    }
+    req->seq = ++seq_high;
+    reqheap_set(heap, heap->num, req);
+    heap->num ++;
+    reqheap_up(heap, heap->num - 1);
+
+    return ICO_SYC_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_reqheap_del: remove request from priority queue
+ *
+ * @param[in]   heap            request priority queue
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_reqheap_del(ico_apc_reqheap_t *heap, ico_apc_request_t *req)
+{
+    int     idx = req->hidx;
+
+    if ((idx < 0) || (idx >= heap->num) || (heap->req[idx] != req))   {
+        /* not linked to this queue */
+        return;
+    }
+    req->hidx = -1;
+    heap->num --;
+    if (idx == heap->num)   {
+        return;
+    }
+    reqheap_set(heap, idx, heap->req[heap->num]);
+    if ((idx > 0) &&
+        (ico_syc_apc_reqheap_cmp(heap->req[idx], heap->req[(idx - 1) / 2]) > 0))  {
+        reqheap_up(heap, idx);
+    }
+    else    {
+        reqheap_down(heap, idx);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_reqheap_update: change position of request in priority
+ *          queue after priority changed
+ *
+ * @param[in]   heap            request priority queue
+ * @param[in]   req             request block(linked in the queue)
+ * @param[in]   equal           place before same priority(1) or after(0)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_reqheap_update(ico_apc_reqheap_t *heap, ico_apc_request_t *req,
+                           const int equal)
+{
+    int     idx = req->hidx;
+
+    if ((idx < 0) || (idx >= heap->num) || (heap->req[idx] != req))   {
+        /* not linked to this queue */
+        return;
+    }
+    req->seq = equal ? ++seq_high : --seq_low;
+    reqheap_up(heap, idx);
+    if (req->hidx == idx)   {
+        reqheap_down(heap, idx);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_reqheap_next: get second priority request
+ *          (request that becomes top, if top request is removed)
+ *
+ * @param[in]   heap            request priority queue
+ * @return      request block
+ * @retval      != NULL         second priority request
+ * @retval      == NULL         less than 2 requests
+ */
+/*--------------------------------------------------------------------------*/
+ico_apc_request_t *
+ico_syc_apc_reqheap_next(const ico_apc_reqheap_t *heap)
+{
+    if (heap->num < 2)  {
+        return NULL;
+    }
+    if ((heap->num > 2) &&
+        (ico_syc_apc_reqheap_cmp(heap->req[2], heap->req[1]) > 0))  {
+        return heap->req[2];
+    }
+    return heap->req[1];
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_reqheap_free: release heap array of priority queue
+ *          (request blocks are not released)
+ *
+ * @param[in]   heap            request priority queue
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_reqheap_free(ico_apc_reqheap_t *heap)
+{
+    if (heap->req)  {
+        free(heap->req);
+    }
+    memset(heap, 0, sizeof(ico_apc_reqheap_t));
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   replyq_set: set request to reply deadline queue(static function)
+ *
+ * @param[in]   queue           reply deadline queue
+ * @param[in]   idx             index of queue array
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+replyq_set(ico_apc_reqheap_t *queue, const int idx, ico_apc_request_t *req)
+{
+    queue->req[idx] = req;
+    req->tidx = idx;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   replyq_up: move request to earlier in reply deadline queue
+ *          (static function)
+ *
+ * @param[in]   queue           reply deadline queue
+ * @param[in]   idx             index of moving request
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+replyq_up(ico_apc_reqheap_t *queue, int idx)
+{
+    ico_apc_request_t   *req = queue->req[idx];
+    int     parent;
+
+    while (idx > 0) {
+        parent = (idx - 1) / 2;
+        if (queue->req[parent]->deadline <= req->deadline)  break;
+        replyq_set(queue, idx, queue->req[parent]);
+        idx = parent;
+    }
+    replyq_set(queue, idx, req);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   replyq_down: move request to later in reply deadline queue
+ *          (static function)
+ *
+ * @param[in]   queue           reply deadline queue
+ * @param[in]   idx             index of moving request
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+replyq_down(ico_apc_reqheap_t *queue, int idx)
+{
+    ico_apc_request_t   *req = queue->req[idx];
+    int     child;
+
+    while (1)   {
+        child = idx * 2 + 1;
+        if (child >= queue->num)    break;
+        if ((child + 1 < queue->num) &&
+            (queue->req[child + 1]->deadline < queue->req[child]->deadline))    {
+            child ++;
+        }
+        if (req->deadline <= queue->req[child]->deadline)   break;
+        replyq_set(queue, idx, queue->req[child]);
+        idx = child;
+    }
+    replyq_set(queue, idx, req);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_replyq_set: set reply deadline of request
+ *          (add to reply deadline queue, or change deadline if already added)
+ *
+ * @param[in]   queue           reply deadline queue
+ * @param[in]   req             request block
+ * @param[in]   deadline        reply deadline
+ * @return      result
+ * @retval      ICO_SYC_EOK     success
+ * @retval      ICO_SYC_ENOMEM  error(out of memory)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_syc_apc_replyq_set(ico_apc_reqheap_t *queue, ico_apc_request_t *req,
+                       const double deadline)
+{
+    int     idx = req->tidx;
+
+    if ((idx >= 0) && (idx < queue->num) && (queue->req[idx] == req))   {
+        /* change deadline          */
+        req->deadline = deadline;
+        replyq_up(queue, idx);
+        if (req->tidx == idx)   {
+            replyq_down(queue, idx);
+        }
+        return ICO_SYC_EOK;
+    }
+    if (reqheap_grow(queue) != ICO_SYC_EOK) {
+        req->tidx = -1;
+        return ICO_SYC_ENOMEM;
+    }
+    req->deadline = deadline;
+    replyq_set(queue, queue->num, req);
+    queue->num ++;
+    replyq_up(queue, queue->num - 1);
+
+    return ICO_SYC_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_syc_apc_replyq_del: remove request from reply deadline queue
+ *
+ * @param[in]   queue           reply deadline queue
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_syc_apc_replyq_del(ico_apc_reqheap_t *queue, ico_apc_request_t *req)
+{
+    int     idx = req->tidx;
+
+    if ((idx < 0) || (idx >= queue->num) || (queue->req[idx] != req))   {
+        /* not wait reply           */
+        return;
+    }
+    req->tidx = -1;
+    queue->num --;
+    if (idx == queue->num)  {
+        return;
+    }
+    replyq_set(queue, idx, queue->req[queue->num]);
+    if ((idx > 0) && (queue->req[idx]->deadline < queue->req[(idx - 1) / 2]->deadline)) {
+        replyq_up(queue, idx);
+    }
+    else    {
+        replyq_down(queue, idx);
+    }
+}
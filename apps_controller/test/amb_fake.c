@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   fake of Automotive Message Broker(test of regulation controller)
+ *
+ *          usage: amb_fake [-r record [-x]]
+ *          (owns org.automotive.message.broker on system bus(or bus of
+ *           DBUS_SYSTEM_BUS_ADDRESS), answers Get of vehicle information and
+ *           emits PropertiesChanged when value is changed by command of stdin.
+ *           commands: speed <km/h>, shift <park|neutral|drive|reverse|value>,
+ *                     blinker <left|right|none>, signal <on|off>, quit
+ *           "signal off" changes values without PropertiesChanged(test of
+ *           fall back to polling).
+ *           -r replays vehicle signal record(see drive_cycle.rec, recorded by
+ *           ICO_SYC_APC_VEHICLE_RECORD) from first Get of vehicle information,
+ *           at recorded time(1x) or without wait(-x))
+ *
+ * @date    Feb-28-2013
+ */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <unistd.h>
+#include    <string.h>
+#include    <strings.h>
+#include    <poll.h>
+#include    <time.h>
+#include    <dbus/dbus.h>
+
+#include    "ico_syc_apc.h"
+
+#define AMB_SERVICE     "org.automotive.message.broker"
+#define AMB_PROPERTIES  "org.freedesktop.DBus.Properties"
+
+/* vehicle information of fake AMB  */
+static struct _amb_property {
+    const char  *property;              /* D-Bus property name                      */
+    const char  *path;                  /* D-Bus path name                          */
+    const char  *interface;             /* D-Bus interface name                     */
+    int         type;                   /* D-Bus type of value                      */
+    int         value;                  /* current value                            */
+}           amb_property[] = {
+    { "VehicleSpeed", "/org/automotive/runningstatus/vehicleSpeed",
+      "org.automotive.vehicleSpeed", DBUS_TYPE_UINT16, 0 },
+    { "ShiftPosition", "/org/automotive/runningstatus/transmission",
+      "org.automotive.transmission", DBUS_TYPE_BYTE, ICO_SYC_APC_REGULATION_SHIFT_PARKING },
+    { "LeftTurn", "/org/automotive/runningstatus/lightStatus",
+      "org.automotive.lightStatus", DBUS_TYPE_BOOLEAN, 0 },
+    { "RightTurn", "/org/automotive/runningstatus/lightStatus",
+      "org.automotive.lightStatus", DBUS_TYPE_BOOLEAN, 0 },
+    { NULL, NULL, NULL, 0, 0 }
+};
+
+static DBusConnection   *connection = NULL;
+static int              signal_on = 1;          /* emit PropertiesChanged   */
+static int              ngets = 0;
+static int              nsignals = 0;
+
+/* vehicle signal record(replay)    */
+#define AMB_LINE_MAX    256
+typedef struct _amb_record  {
+    long    time;                       /* time from start of record(ms)            */
+    int     idx;                        /* index of amb_property                    */
+    int     value;                      /* value                                    */
+} amb_record_t;
+static amb_record_t     *records = NULL;
+static int              nrecords = 0;
+static int              replayed = 0;           /* replayed records         */
+static int              replay_nowait = 0;      /* replay without wait(-x)  */
+static long             replay_start = -1;      /* start time of replay(ms) */
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_append_value: append value of property as variant
+ *
+ * @param[in]   iter            D-Bus message iterator
+ * @param[in]   prop            property
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+amb_append_value(DBusMessageIter *iter, const struct _amb_property *prop)
+{
+    DBusMessageIter variant;
+    char        sig[2];
+    uint16_t    u16;
+    uint8_t     u8;
+    dbus_bool_t b;
+    int32_t     i32;
+
+    sig[0] = (char)prop->type;
+    sig[1] = 0;
+    dbus_message_iter_open_container(iter, DBUS_TYPE_VARIANT, sig, &variant);
+    switch (prop->type) {
+    case DBUS_TYPE_UINT16:
+        u16 = (uint16_t)prop->value;
+        dbus_message_iter_append_basic(&variant, prop->type, &u16);
+        break;
+    case DBUS_TYPE_BYTE:
+        u8 = (uint8_t)prop->value;
+        dbus_message_iter_append_basic(&variant, prop->type, &u8);
+        break;
+    case DBUS_TYPE_BOOLEAN:
+        b = prop->value ? TRUE : FALSE;
+        dbus_message_iter_append_basic(&variant, prop->type, &b);
+        break;
+    default:
+        i32 = prop->value;
+        dbus_message_iter_append_basic(&variant, prop->type, &i32);
+        break;
+    }
+    dbus_message_iter_close_container(iter, &variant);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_changed: emit PropertiesChanged of property
+ *
+ * @param[in]   prop            changed property
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+amb_changed(const struct _amb_property *prop)
+{
+    DBusMessage     *message;
+    DBusMessageIter iter;
+    DBusMessageIter dict;
+    DBusMessageIter entry;
+    DBusMessageIter invalidated;
+
+    if (! signal_on)    {
+        printf("amb_fake: %s = %d (no signal)\n", prop->property, prop->value);
+        return;
+    }
+    message = dbus_message_new_signal(prop->path, AMB_PROPERTIES, "PropertiesChanged");
+    if (! message)  {
+        fprintf(stderr, "amb_fake: No Memory\n");
+        return;
+    }
+    dbus_message_iter_init_append(message, &iter);
+    dbus_message_iter_append_basic(&iter, DBUS_TYPE_STRING, &prop->interface);
+    dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, "{sv}", &dict);
+    dbus_message_iter_open_container(&dict, DBUS_TYPE_DICT_ENTRY, NULL, &entry);
+    dbus_message_iter_append_basic(&entry, DBUS_TYPE_STRING, &prop->property);
+    amb_append_value(&entry, prop);
+    dbus_message_iter_close_container(&dict, &entry);
+    dbus_message_iter_close_container(&iter, &dict);
+    dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, "s", &invalidated);
+    dbus_message_iter_close_container(&iter, &invalidated);
+
+    dbus_connection_send(connection, message, NULL);
+    dbus_connection_flush(connection);
+    dbus_message_unref(message);
+    nsignals ++;
+    printf("amb_fake: %s = %d\n", prop->property, prop->value);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_set: change value of property
+ *
+ * @param[in]   property        property name
+ * @param[in]   value           new value
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+amb_set(const char *property, const int value)
+{
+    int     idx;
+
+    for (idx = 0; amb_property[idx].property; idx++)    {
+        if (strcmp(amb_property[idx].property, property) == 0) break;
+    }
+    if ((! amb_property[idx].property) || (amb_property[idx].value == value))   {
+        return;
+    }
+    amb_property[idx].value = value;
+    amb_changed(&amb_property[idx]);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_now: current monotonic time(milli seconds)
+ *
+ * @param       none
+ * @return      current time
+ */
+/*--------------------------------------------------------------------------*/
+static long
+amb_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000L) + (ts.tv_nsec / 1000000L);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_load: load vehicle signal record
+ *          (<time(ms)> <property> <value>, made by ico_syc_apc_regulation_record)
+ *
+ * @param[in]   file            record file name
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+amb_load(const char *file)
+{
+    FILE    *fp;
+    char    line[AMB_LINE_MAX];
+    char    property[AMB_LINE_MAX];
+    amb_record_t    *p;
+    long    time;
+    double  value;
+    int     size = 0;
+    int     idx;
+
+    fp = fopen(file, "r");
+    if (! fp)   {
+        fprintf(stderr, "amb_fake: can not open %s\n", file);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), fp))   {
+        if ((line[0] == '#') ||
+            (sscanf(line, "%ld %255s %lf", &time, property, &value) != 3))  {
+            continue;
+        }
+        for (idx = 0; amb_property[idx].property; idx++)    {
+            if (strcmp(amb_property[idx].property, property) == 0) break;
+        }
+        if (! amb_property[idx].property)   {
+            fprintf(stderr, "amb_fake: %s is not supported, skipped\n", property);
+            continue;
+        }
+        if (nrecords >= size)   {
+            size += 256;
+            p = realloc(records, sizeof(amb_record_t) * size);
+            if (! p)    {
+                fprintf(stderr, "amb_fake: No Memory\n");
+                fclose(fp);
+                return -1;
+            }
+            records = p;
+        }
+        records[nrecords].time = time;
+        records[nrecords].idx = idx;
+        records[nrecords].value = (int)value;
+        nrecords ++;
+    }
+    fclose(fp);
+    printf("amb_fake: %d records of %s\n", nrecords, file);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_replay: replay vehicle signal record of now
+ *
+ * @param       none
+ * @return      wait time to next record(ms, -1=no record)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+amb_replay(void)
+{
+    long    now;
+
+    if ((replay_start < 0) || (replayed >= nrecords))    {
+        return -1;
+    }
+    now = amb_now() - replay_start;
+    while (replayed < nrecords) {
+        if ((! replay_nowait) && (records[replayed].time > now))    {
+            return (int)(records[replayed].time - now);
+        }
+        amb_set(amb_property[records[replayed].idx].property, records[replayed].value);
+        replayed ++;
+    }
+    printf("amb_fake: replay end(records=%d time=%ld ms)\n", nrecords, amb_now() - replay_start);
+    return -1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_message: receive method call(D-Bus filter)
+ *
+ * @param[in]   conn            D-Bus connection
+ * @param[in]   message         received message
+ * @param[in]   user_data       user data(unused)
+ * @return      result
+ */
+/*--------------------------------------------------------------------------*/
+static DBusHandlerResult
+amb_message(DBusConnection *conn, DBusMessage *message, void *user_data)
+{
+    DBusMessage     *reply;
+    DBusMessageIter iter;
+    const char      *interface = NULL;
+    const char      *property = NULL;
+    const char      *path;
+    int             idx;
+
+    if (! dbus_message_is_method_call(message, AMB_PROPERTIES, "Get"))  {
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    }
+    path = dbus_message_get_path(message);
+    if (! dbus_message_get_args(message, NULL, DBUS_TYPE_STRING, &interface,
+                                DBUS_TYPE_STRING, &property, DBUS_TYPE_INVALID)) {
+        interface = "";
+        property = "";
+    }
+    for (idx = 0; amb_property[idx].property; idx++)    {
+        if ((strcmp(amb_property[idx].property, property) == 0) &&
+            (strcmp(amb_property[idx].interface, interface) == 0) &&
+            (path) && (strcmp(amb_property[idx].path, path) == 0)) break;
+    }
+    if (amb_property[idx].property) {
+        reply = dbus_message_new_method_return(message);
+        if (reply)  {
+            dbus_message_iter_init_append(reply, &iter);
+            amb_append_value(&iter, &amb_property[idx]);
+        }
+    }
+    else    {
+        reply = dbus_message_new_error(message, "org.freedesktop.DBus.Error.UnknownProperty",
+                                       property);
+    }
+    if (reply)  {
+        dbus_connection_send(conn, reply, NULL);
+        dbus_message_unref(reply);
+    }
+    ngets ++;
+    if ((records) && (replay_start < 0))    {
+        /* regulation controller is started, replay record  */
+        printf("amb_fake: replay start\n");
+        replay_start = amb_now();
+    }
+    return DBUS_HANDLER_RESULT_HANDLED;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_command: execute command of stdin
+ *
+ * @param[in]   line            command line
+ * @return      result
+ * @retval      0               continue
+ * @retval      1               quit
+ */
+/*--------------------------------------------------------------------------*/
+static int
+amb_command(char *line)
+{
+    char    *cmd;
+    char    *arg;
+    int     shift;
+
+    cmd = strtok(line, " \t\r\n");
+    arg = strtok(NULL, " \t\r\n");
+    if ((! cmd) || (cmd[0] == '#')) {
+        return 0;
+    }
+    if (strcasecmp(cmd, "quit") == 0)   {
+        return 1;
+    }
+    if (! arg)  {
+        fprintf(stderr, "amb_fake: %s needs argument\n", cmd);
+        return 0;
+    }
+    if (strcasecmp(cmd, "speed") == 0)  {
+        amb_set("VehicleSpeed", strtol(arg, (char **)0, 0));
+    }
+    else if (strcasecmp(cmd, "shift") == 0) {
+        if (strcasecmp(arg, "park") == 0)           shift = ICO_SYC_APC_REGULATION_SHIFT_PARKING;
+        else if (strcasecmp(arg, "neutral") == 0)   shift = ICO_SYC_APC_REGULATION_SHIFT_NEUTRALS;
+        else if (strcasecmp(arg, "drive") == 0)     shift = ICO_SYC_APC_REGULATION_SHIFT_DRIVE;
+        else if (strcasecmp(arg, "reverse") == 0)   shift = ICO_SYC_APC_REGULATION_SHIFT_REVERSES;
+        else                                        shift = strtol(arg, (char **)0, 0);
+        amb_set("ShiftPosition", shift);
+    }
+    else if (strcasecmp(cmd, "blinker") == 0)   {
+        amb_set("LeftTurn", strcasecmp(arg, "left") == 0);
+        amb_set("RightTurn", strcasecmp(arg, "right") == 0);
+    }
+    else if (strcasecmp(cmd, "signal") == 0)    {
+        signal_on = (strcasecmp(arg, "off") != 0);
+    }
+    else    {
+        fprintf(stderr, "amb_fake: unknown command(%s)\n", cmd);
+    }
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    DBusError       error;
+    struct pollfd   fds[2];
+    char            line[128];
+    int             fd;
+    int             timeout;
+    int             i;
+
+    for (i = 1; i < argc; i++)  {
+        if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc)) {
+            if (amb_load(argv[++i]) < 0)    {
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "-x") == 0)    {
+            replay_nowait = 1;
+        }
+        else    {
+            fprintf(stderr, "usage: %s [-r record [-x]]\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    dbus_error_init(&error);
+    connection = dbus_bus_get(DBUS_BUS_SYSTEM, &error);
+    if (! connection)   {
+        fprintf(stderr, "%s: can not connect D-Bus(%s)\n", argv[0], error.message);
+        exit(1);
+    }
+    if (dbus_bus_request_name(connection, AMB_SERVICE, DBUS_NAME_FLAG_DO_NOT_QUEUE,
+                              &error) != DBUS_REQUEST_NAME_REPLY_PRIMARY_OWNER) {
+        fprintf(stderr, "%s: can not own %s\n", argv[0], AMB_SERVICE);
+        exit(1);
+    }
+    dbus_connection_add_filter(connection, amb_message, NULL, NULL);
+    if (! dbus_connection_get_unix_fd(connection, &fd)) {
+        fprintf(stderr, "%s: no D-Bus fd\n", argv[0]);
+        exit(1);
+    }
+    printf("amb_fake: ready\n");
+    fflush(stdout);
+
+    fds[0].fd = 0;
+    fds[0].events = POLLIN;
+    fds[1].fd = fd;
+    fds[1].events = POLLIN;
+    while (1)   {
+        while (dbus_connection_dispatch(connection) == DBUS_DISPATCH_DATA_REMAINS)  ;
+        timeout = amb_replay();
+        fflush(stdout);
+        if ((fds[0].fd < 0) && ((! records) || (replayed >= nrecords))) {
+            /* end of stdin and replay  */
+            break;
+        }
+        if (poll(fds, 2, timeout) < 0)  continue;
+
+        if (fds[1].revents) {
+            (void) dbus_connection_read_write(connection, 0);
+        }
+        if (fds[0].revents) {
+            if (! fgets(line, sizeof(line), stdin)) {
+                /* end of stdin, wait end of replay */
+                fds[0].fd = -1;
+            }
+            else if (amb_command(line)) {
+                break;
+            }
+            fflush(stdout);
+        }
+    }
+    printf("amb_fake: Get=%d PropertiesChanged=%d replayed=%d\n", ngets, nsignals, replayed);
+    exit(0);
+}
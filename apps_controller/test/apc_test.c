@@ -22,59 +22,259 @@
 #include    <sys/ioctl.h>
 #include    <sys/time.h>
 #include    <fcntl.h>
+#include    <poll.h>
+#include    <time.h>
 #include    <Ecore.h>
 
 #include    "ico_syc_apc.h"
 #include    "ico_syc_apc_private.h"
 
-static Ecore_Task_Cb ecore_timer = NULL;
-static void *ecore_user_data = NULL;
-static int  time_ms = 100;
+/* Ecore dummy main loop(fd handlers, timers and idlers)   */
+#define TEST_HANDLER_MAX    8
+#define TEST_TIMER_MAX      32
+#define TEST_IDLER_MAX      8
+
+static struct _test_handler {
+    int             used;
+    int             fd;
+    int             flags;              /* requested Ecore_Fd_Handler_Flags     */
+    int             active;             /* occurred Ecore_Fd_Handler_Flags      */
+    Ecore_Fd_Cb     func;
+    void            *data;
+}                   handlers[TEST_HANDLER_MAX];
+
+static struct _test_timer   {
+    int             used;               /* serial number of timer(0=free)       */
+    double          interval;           /* interval(sec)                        */
+    double          expire;             /* expire time(sec)                     */
+    Ecore_Task_Cb   func;
+    void            *data;
+}                   timers[TEST_TIMER_MAX];
+static int          timer_serial = 0;
+
+static struct _test_idler   {
+    int             used;
+    Ecore_Task_Cb   func;
+    void            *data;
+}                   idlers[TEST_IDLER_MAX];
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   test_now: current monotonic time(sec)
+ *
+ * @param       none
+ * @return      current time
+ */
+/*--------------------------------------------------------------------------*/
+static double
+test_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1000000000.0);
+}
 
 /* Ecore dummy routine  */
 Ecore_Fd_Handler *
 ecore_main_fd_handler_add(int fd, Ecore_Fd_Handler_Flags flags, Ecore_Fd_Cb func,
                           const void *data, Ecore_Fd_Cb buf_func, const void *buf_data)
 {
-    apfw_trace("TEST: dummyy ecore_main_fd_handler_add(%d,%d,%08x,%08x,%08x,%08x)",
-               fd, (int)flags, (int)func, (int)data, (int)buf_func, (int)buf_data);
-    return (Ecore_Fd_Handler *)0x12345678;
+    int     i;
+
+    apfw_trace("TEST: dummyy ecore_main_fd_handler_add(%d,%d)", fd, (int)flags);
+    for (i = 0; i < TEST_HANDLER_MAX; i++)  {
+        if (! handlers[i].used) break;
+    }
+    if (i >= TEST_HANDLER_MAX)  {
+        apfw_error("TEST: ecore_main_fd_handler_add: too many handlers");
+        return NULL;
+    }
+    handlers[i].used = 1;
+    handlers[i].fd = fd;
+    handlers[i].flags = (int)flags;
+    handlers[i].active = 0;
+    handlers[i].func = func;
+    handlers[i].data = (void *)data;
+    return (Ecore_Fd_Handler *)&handlers[i];
 }
 
 Eina_Bool
 ecore_main_fd_handler_active_get(Ecore_Fd_Handler *fd_handler,
                                  Ecore_Fd_Handler_Flags flags)
 {
-    apfw_trace("TEST: dummyy ecore_main_fd_handler_active_get(%08x,%d)",
-               (int)fd_handler, (int)flags);
-    return EINA_FALSE;
+    struct _test_handler    *handler = (struct _test_handler *)fd_handler;
+
+    return (handler->active & (int)flags) ? EINA_TRUE : EINA_FALSE;
 }
 
 void
 ecore_main_fd_handler_active_set(Ecore_Fd_Handler *fd_handler,
                                  Ecore_Fd_Handler_Flags flags)
 {
-    apfw_trace("TEST: dummyy ecore_main_fd_handler_active_set(%08x,%d)",
-               (int)fd_handler, (int)flags);
+    ((struct _test_handler *)fd_handler)->flags = (int)flags;
 }
 
 void *
 ecore_main_fd_handler_del(Ecore_Fd_Handler *fd_handler)
 {
-    apfw_trace("TEST: dummyy ecore_main_fd_handler_del(%08x)", (int)fd_handler);
-    return NULL;
+    struct _test_handler    *handler = (struct _test_handler *)fd_handler;
+
+    apfw_trace("TEST: dummyy ecore_main_fd_handler_del(%d)", handler->fd);
+    handler->used = 0;
+    return handler->data;
 }
 
 Ecore_Timer *
 ecore_timer_add(double dtime, Ecore_Task_Cb func, const void *user_data)
 {
-    ecore_timer = func;
-    ecore_user_data = (void *)user_data;
-    time_ms = (int)(dtime * 1000);
-    if (time_ms < 10)       time_ms = 10;
-    if (time_ms >= 1000)    time_ms = 990;
+    int     i;
+
+    for (i = 0; i < TEST_TIMER_MAX; i++)    {
+        if (! timers[i].used)   break;
+    }
+    if (i >= TEST_TIMER_MAX)    {
+        apfw_error("TEST: ecore_timer_add: too many timers");
+        return NULL;
+    }
+    timers[i].used = ++timer_serial;
+    timers[i].interval = dtime;
+    timers[i].expire = test_now() + dtime;
+    timers[i].func = func;
+    timers[i].data = (void *)user_data;
+    return (Ecore_Timer *)&timers[i];
+}
+
+void *
+ecore_timer_del(Ecore_Timer *timer)
+{
+    struct _test_timer  *t = (struct _test_timer *)timer;
+
+    if (! t)    {
+        return NULL;
+    }
+    t->used = 0;
+    return t->data;
+}
+
+Ecore_Idler *
+ecore_idler_add(Ecore_Task_Cb func, const void *data)
+{
+    int     i;
+
+    for (i = 0; i < TEST_IDLER_MAX; i++)    {
+        if (! idlers[i].used)   break;
+    }
+    if (i >= TEST_IDLER_MAX)    {
+        apfw_error("TEST: ecore_idler_add: too many idlers");
+        return NULL;
+    }
+    idlers[i].used = 1;
+    idlers[i].func = func;
+    idlers[i].data = (void *)data;
+    return (Ecore_Idler *)&idlers[i];
+}
+
+void *
+ecore_idler_del(Ecore_Idler *idler)
+{
+    struct _test_idler  *p = (struct _test_idler *)idler;
+
+    if (! p)    {
+        return NULL;
+    }
+    p->used = 0;
+    return p->data;
+}
+
+Ecore_Idle_Enterer *
+ecore_idle_enterer_add(Ecore_Task_Cb func, const void *data)
+{
+    return (Ecore_Idle_Enterer *)ecore_idler_add(func, data);
+}
 
-    return (Ecore_Timer *)ecore_timer;
+void *
+ecore_idle_enterer_del(Ecore_Idle_Enterer *enterer)
+{
+    return ecore_idler_del((Ecore_Idler *)enterer);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   test_loop: dummy Ecore main loop(one iteration)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+test_loop(void)
+{
+    struct pollfd   fds[TEST_HANDLER_MAX];
+    int     idx[TEST_HANDLER_MAX];
+    int     nfds = 0;
+    int     timeout = 1000;
+    double  now;
+    int     serial;
+    int     i;
+
+    /* idlers           */
+    for (i = 0; i < TEST_IDLER_MAX; i++)    {
+        if ((idlers[i].used) &&
+            ((*idlers[i].func)(idlers[i].data) == ECORE_CALLBACK_CANCEL))   {
+            idlers[i].used = 0;
+        }
+    }
+
+    /* wait fd events until the earliest timer  */
+    now = test_now();
+    for (i = 0; i < TEST_TIMER_MAX; i++)    {
+        if ((timers[i].used) && ((int)((timers[i].expire - now) * 1000) < timeout))   {
+            timeout = (int)((timers[i].expire - now) * 1000);
+            if (timeout < 0)    timeout = 0;
+        }
+    }
+    for (i = 0; i < TEST_IDLER_MAX; i++)    {
+        if (idlers[i].used) timeout = 0;
+    }
+    for (i = 0; i < TEST_HANDLER_MAX; i++)  {
+        if (! handlers[i].used) continue;
+        fds[nfds].fd = handlers[i].fd;
+        fds[nfds].events = 0;
+        if (handlers[i].flags & ECORE_FD_READ)  fds[nfds].events |= POLLIN;
+        if (handlers[i].flags & ECORE_FD_WRITE) fds[nfds].events |= POLLOUT;
+        fds[nfds].revents = 0;
+        idx[nfds++] = i;
+    }
+    if (poll(fds, nfds, timeout) > 0)   {
+        for (i = 0; i < nfds; i++)  {
+            if ((! fds[i].revents) || (! handlers[idx[i]].used))    continue;
+            handlers[idx[i]].active = 0;
+            if (fds[i].revents & POLLIN)    handlers[idx[i]].active |= ECORE_FD_READ;
+            if (fds[i].revents & POLLOUT)   handlers[idx[i]].active |= ECORE_FD_WRITE;
+            if (fds[i].revents & (POLLERR|POLLHUP)) {
+                handlers[idx[i]].active |= ECORE_FD_ERROR;
+            }
+            if ((*handlers[idx[i]].func)(handlers[idx[i]].data,
+                                         (Ecore_Fd_Handler *)&handlers[idx[i]])
+                == ECORE_CALLBACK_CANCEL)   {
+                handlers[idx[i]].used = 0;
+            }
+        }
+    }
+
+    /* expired timers   */
+    now = test_now();
+    for (i = 0; i < TEST_TIMER_MAX; i++)    {
+        if ((! timers[i].used) || (timers[i].expire > now)) continue;
+        timers[i].expire += timers[i].interval;
+        serial = timers[i].used;
+        if (((*timers[i].func)(timers[i].data) == ECORE_CALLBACK_CANCEL) &&
+            (timers[i].used == serial)) {
+            /* not deleted(and added again) in callback */
+            timers[i].used = 0;
+        }
+    }
 }
 
 static void displaycontrol(const Ico_Uxf_conf_application *conf, const int control)
@@ -92,28 +292,29 @@ static void inputcontrol(const Ico_Uxf_conf_application *conf, const int control
     apfw_trace("TEST: inputcontrol(%s, %d)", conf->appid, control);
 }
 
+static void regulation(const ico_apc_regulation_change_t *change, void *user_data)
+{
+    int         category;
+
+    for (category = 0; category < ICO_UXF_CATEGORY_MAX; category++)    {
+        if ((change->changed & ICO_SYC_APC_CATEGORY_BIT(category)) == 0)    continue;
+        apfw_trace("TEST: regulation(%d, view=%d sound=%d input=%d)", category,
+                   change->control[category].display, change->control[category].sound,
+                   change->control[category].input);
+    }
+}
+
 int main(int argc, char *argv[])
 {
     int         ret;
-    Eina_Bool   bret;
 
     ret = ico_syc_apc_init(displaycontrol, soundcontrol, inputcontrol);
     apfw_trace("TEST: ico_syc_apc_init() = %d", ret);
+    ico_syc_apc_regulation_set_listener(regulation, ICO_SYC_APC_CATEGORY_ALL, NULL);
 
     while (1)   {
-        usleep(time_ms * 1000);
-
-        if (ecore_timer)    {
-            apfw_trace("TEST: call ecore_timer");
-            bret = (*ecore_timer)(ecore_user_data);
-            apfw_trace("TEST: ret  ecore_timer(%d)", (int)bret);
-        }
-        else    {
-            apfw_trace("TEST: NO  ecore_timer");
-            break;
-        }
+        test_loop();
     }
 
     exit(0);
 }
-
@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   benchmark of zone request arbitration(priority queue)
+ *
+ *          usage: bench_reqheap [-n requests] [-l loops]
+ *          (requests are concurrent requests in one zone, default 1000.
+ *           measures sorted linked list(old arbitration, active application
+ *           aging rewrites all priorities) and indexed binary heap(active
+ *           application aging by epoch), and checks order of the heap)
+ *
+ * @date    Feb-28-2013
+ */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <unistd.h>
+#include    <string.h>
+#include    <time.h>
+
+#include    "ico_syc_apc.h"
+#include    "ico_syc_apc_private.h"
+
+/* number of applications that makes requests   */
+#define BENCH_APPS      64
+
+/* measured times(micro seconds)    */
+typedef struct _bench_result {
+    int     count;
+    long    add;
+    long    update;
+    long    active;
+    long    del;
+} bench_result_t;
+
+static ico_apc_request_t    *reqs;
+static const char           *appatom[BENCH_APPS];
+static unsigned int         epoch = 0;
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_now: current monotonic time(micro seconds)
+ *
+ * @param       none
+ * @return      current time
+ */
+/*--------------------------------------------------------------------------*/
+static long
+bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000L) + (ts.tv_nsec / 1000L);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_setreq: set request priority like app_getdisplay
+ *
+ * @param[in]   req             request block
+ * @param[in]   idx             request number
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+bench_setreq(ico_apc_request_t *req, const int idx)
+{
+    memset(req, 0, sizeof(ico_apc_request_t));
+    req->appatom = appatom[idx % BENCH_APPS];
+    req->resid = ICO_APF_RESID_BASIC_SCREEN;
+    req->id = idx;
+    req->hidx = -1;
+    req->prio = (rand() % 8) * ICO_UXF_PRIO_CATEGORY + (rand() % 40);
+    if (rand() % 4) {
+        req->prio |= ICO_UXF_PRIO_REGULATION;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   list_link: link request to sorted list(old arbitration)
+ *
+ * @param[in]   top             top of request list
+ * @param[in]   req             request block
+ * @param[in]   equal           insert before same priority(1) or after(0)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+list_link(ico_apc_request_t **top, ico_apc_request_t *req, const int equal)
+{
+    ico_apc_request_t   *p;
+    ico_apc_request_t   *bp;
+
+    /* search same request      */
+    for (p = *top; p; p = p->next)  {
+        if ((p->appatom == req->appatom) && (p->id == req->id)) break;
+    }
+    if (p)  {
+        return;
+    }
+
+    /* search insert position   */
+    bp = NULL;
+    for (p = *top; p; p = p->next)  {
+        if ((p->prio < req->prio) || ((equal) && (p->prio == req->prio)))  break;
+        bp = p;
+    }
+    req->next = p;
+    if (bp) {
+        bp->next = req;
+    }
+    else    {
+        *top = req;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   list_unlink: unlink request from sorted list(old arbitration)
+ *
+ * @param[in]   top             top of request list
+ * @param[in]   req             request block
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+list_unlink(ico_apc_request_t **top, ico_apc_request_t *req)
+{
+    ico_apc_request_t   *p;
+    ico_apc_request_t   *bp;
+
+    bp = NULL;
+    for (p = *top; p; p = p->next)  {
+        if (p == req)   break;
+        bp = p;
+    }
+    if (! p)    return;
+    if (bp) {
+        bp->next = req->next;
+    }
+    else    {
+        *top = req->next;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_list: measure sorted linked list
+ *
+ * @param[in]   num             number of requests
+ * @param[out]  result          measured result
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+bench_list(const int num, bench_result_t *result)
+{
+    ico_apc_request_t   *top = NULL;
+    ico_apc_request_t   *p;
+    long    start;
+    int     i;
+
+    srand(1);
+    start = bench_now();
+    for (i = 0; i < num; i++)   {
+        bench_setreq(&reqs[i], i);
+        list_link(&top, &reqs[i], 1);
+    }
+    result->add += bench_now() - start;
+
+    /* regulation change        */
+    start = bench_now();
+    for (i = 0; i < num; i++)   {
+        p = &reqs[rand() % num];
+        p->prio ^= ICO_UXF_PRIO_REGULATION;
+        list_unlink(&top, p);
+        list_link(&top, p, 0);
+    }
+    result->update += bench_now() - start;
+
+    /* active application change(rewrite all active priorities)    */
+    start = bench_now();
+    for (i = 0; i < num; i++)   {
+        for (p = top; p; p = p->next)   {
+            if (p->prio & ICO_UXF_PRIO_ACTIVEAPP)   {
+                p->prio -= ICO_UXF_PRIO_ACTIVECOUNT;
+            }
+        }
+        p = &reqs[rand() % num];
+        p->prio |= ICO_UXF_PRIO_ACTIVEAPP;
+        list_unlink(&top, p);
+        list_link(&top, p, 1);
+    }
+    result->active += bench_now() - start;
+
+    start = bench_now();
+    for (i = 0; i < num; i++)   {
+        list_unlink(&top, &reqs[(i * 7919) % num]);
+    }
+    result->del += bench_now() - start;
+    result->count ++;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_check: check order of heap(pop all requests)
+ *
+ * @param[in]   heap            request priority queue
+ * @return      result
+ * @retval      0               order is correct
+ * @retval      -1              order error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+bench_check(ico_apc_reqheap_t *heap)
+{
+    ico_apc_request_t   *p;
+    ico_apc_request_t   *bp = NULL;
+    ico_apc_request_t   *next;
+
+    while (heap->num > 0)   {
+        p = ICO_APC_REQHEAP_TOP(heap);
+        next = ico_syc_apc_reqheap_next(heap);
+        if ((bp) && (ico_syc_apc_reqheap_cmp(bp, p) <= 0))  {
+            fprintf(stderr, "bench_reqheap: order error(%08x > %08x)\n", p->prio, bp->prio);
+            return -1;
+        }
+        ico_syc_apc_reqheap_del(heap, p);
+        if (ICO_APC_REQHEAP_TOP(heap) != next)  {
+            fprintf(stderr, "bench_reqheap: next error\n");
+            return -1;
+        }
+        bp = p;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_heap: measure indexed binary heap
+ *
+ * @param[in]   num             number of requests
+ * @param[in]   check           check order of heap
+ * @param[out]  result          measured result
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+bench_heap(const int num, const int check, bench_result_t *result)
+{
+    ico_apc_reqheap_t   heap;
+    ico_apc_request_t   *p;
+    long    start;
+    int     i;
+
+    memset(&heap, 0, sizeof(heap));
+    srand(1);
+    start = bench_now();
+    for (i = 0; i < num; i++)   {
+        bench_setreq(&reqs[i], i);
+        if (ico_syc_apc_reqheap_add(&heap, &reqs[i]) != ICO_SYC_EOK)    {
+            return -1;
+        }
+    }
+    result->add += bench_now() - start;
+
+    /* regulation change        */
+    start = bench_now();
+    for (i = 0; i < num; i++)   {
+        p = &reqs[rand() % num];
+        p->prio ^= ICO_UXF_PRIO_REGULATION;
+        ico_syc_apc_reqheap_update(&heap, p, 0);
+    }
+    result->update += bench_now() - start;
+
+    /* active application change(aging by epoch)    */
+    start = bench_now();
+    for (i = 0; i < num; i++)   {
+        p = &reqs[rand() % num];
+        p->actepoch = ++epoch;
+        ico_syc_apc_reqheap_update(&heap, p, 1);
+    }
+    result->active += bench_now() - start;
+
+    if ((check) && (bench_check(&heap) < 0))    {
+        ico_syc_apc_reqheap_free(&heap);
+        return -1;
+    }
+
+    start = bench_now();
+    for (i = 0; i < num; i++)   {
+        ico_syc_apc_reqheap_del(&heap, &reqs[(i * 7919) % num]);
+    }
+    result->del += bench_now() - start;
+    result->count ++;
+
+    ico_syc_apc_reqheap_free(&heap);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_print: print measured result
+ *
+ * @param[in]   title       title of result
+ * @param[in]   num         number of requests
+ * @param[in]   result      measured result
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+bench_print(const char *title, const int num, const bench_result_t *result)
+{
+    if (result->count <= 0) {
+        printf("%-6s: no data\n", title);
+        return;
+    }
+    printf("%-6s: requests=%d add=%6ld us regulation=%6ld us active=%6ld us "
+           "release=%6ld us\n", title, num,
+           result->add / result->count, result->update / result->count,
+           result->active / result->count, result->del / result->count);
+}
+
+int
+main(int argc, char *argv[])
+{
+    bench_result_t  list;
+    bench_result_t  heap;
+    char    name[32];
+    int     num = 1000;
+    int     loops = 20;
+    int     i;
+
+    for (i = 1; i < argc; i++)  {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) {
+            num = strtol(argv[++i], (char **)0, 0);
+        }
+        else if ((strcmp(argv[i], "-l") == 0) && (i + 1 < argc))    {
+            loops = strtol(argv[++i], (char **)0, 0);
+        }
+        else    {
+            fprintf(stderr, "usage: %s [-n requests] [-l loops]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (num <= 0)   num = 1;
+    if (loops <= 0) loops = 1;
+
+    /* log output is not measured   */
+    setenv("ICO_IVI_NO_LOG", "1", 1);
+    ico_uxf_log_setlevel(0);
+
+    reqs = malloc(sizeof(ico_apc_request_t) * num);
+    if (! reqs) {
+        fprintf(stderr, "%s: No Memory\n", argv[0]);
+        exit(1);
+    }
+    for (i = 0; i < BENCH_APPS; i++)    {
+        snprintf(name, sizeof(name), "org.tizen.ico.bench%d", i);
+        appatom[i] = ico_uxf_misc_intern(name);
+    }
+
+    /* check order of heap  */
+    memset(&heap, 0, sizeof(heap));
+    if (bench_heap(num, 1, &heap) < 0)  {
+        fprintf(stderr, "%s: heap check Error\n", argv[0]);
+        exit(1);
+    }
+
+    memset(&list, 0, sizeof(list));
+    memset(&heap, 0, sizeof(heap));
+    for (i = 0; i < loops; i++) {
+        bench_list(num, &list);
+        (void) bench_heap(num, 0, &heap);
+    }
+    bench_print("list", num, &list);
+    bench_print("heap", num, &heap);
+
+    free(reqs);
+    exit(0);
+}
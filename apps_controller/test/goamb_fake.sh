@@ -0,0 +1,15 @@
+#!/bin/sh
+#
+# fake AMB on private D-Bus daemon(test of regulation controller)
+#   commands of amb_fake are read from stdin(speed 40, shift drive, blinker left,
+#   signal off, quit ...), run apc_test with printed DBUS_SYSTEM_BUS_ADDRESS
+#   replay of drive cycle: goamb_fake.sh -r drive_cycle.rec [-x]
+#   (record with ICO_SYC_APC_VEHICLE_RECORD=<file> of apc_test or HomeScreen)
+
+eval `dbus-daemon --session --fork --print-address=1 --print-pid=1 | \
+      { read addr; read pid; echo "DBUS_ADDR=$addr DBUS_PID=$pid"; }`
+export DBUS_SYSTEM_BUS_ADDRESS=$DBUS_ADDR
+echo "export DBUS_SYSTEM_BUS_ADDRESS=$DBUS_SYSTEM_BUS_ADDRESS"
+
+./amb_fake $*
+kill $DBUS_PID
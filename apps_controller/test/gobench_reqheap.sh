@@ -0,0 +1,4 @@
+#!/bin/sh
+
+export LD_LIBRARY_PATH=../../ico-app-framework/.libs:$LD_LIBRARY_PATH
+./bench_reqheap $*
@@ -0,0 +1,6 @@
+#!/bin/sh
+
+export LD_LIBRARY_PATH=../../ico-app-framework/.libs:$LD_LIBRARY_PATH
+export UIFW_CONFDIR=../../res/config
+export UIFW_NOCONFCACHE=1
+./sim_apc $*
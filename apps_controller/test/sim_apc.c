@@ -0,0 +1,2171 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   deterministic simulation of AppsController(arbitration benchmark)
+ *
+ *          usage: sim_apc [-f trace] [-g apps] [-n events] [-s seed] [-b 0|1]
+ *                         [-r record] [-p] [-m count] [-v]
+ *          (-f replays a trace file(see sim_apc.trace, sim_reload.trace is
+ *           live reload of system configuration, sim_prelaunch.trace is
+ *           pre-launch of HomeScreen), -g generates random
+ *           load of apps applications and events requests by seed.
+ *           -r replays vehicle signal record(see drive_cycle.rec, recorded by
+ *           ICO_SYC_APC_VEHICLE_RECORD) by injection to regulation controller,
+ *           at virtual clock(as fast as possible), with or without applications.
+ *           AppsController(control, regulation and request heap) runs with
+ *           fakes of Ecore(virtual clock), resource server, window/sound/input
+ *           control and AMB(D-Bus), no need Weston nor AMB.
+ *           -p makes subscription of PropertiesChanged fail(AMB polling).
+ *           -m makes every count-th command to Multi Sound Manager fail and
+ *           reports streams whose mute state differs from the sound resource.
+ *           reports grant latency(virtual time from request to acquired),
+ *           cpu time of each event, visibility flips per second, regulation
+ *           transitions, cpu time of rule engine and heap use.
+ *           except cpu time, result is same at every run)
+ *
+ * @date    Feb-28-2013
+ */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <stdarg.h>
+#include    <unistd.h>
+#include    <string.h>
+#include    <strings.h>
+#include    <time.h>
+#include    <malloc.h>
+#include    <dbus/dbus.h>
+#include    <Ecore.h>
+
+#include    "ico_apf.h"
+#include    "ico_uxf.h"
+#include    "ico_apf_ecore.h"
+#include    "ico_uxf_conf_ecore.h"
+#include    "ico_syc_apc.h"
+#include    "ico_syc_apc_private.h"
+
+/* limits of simulation                         */
+#define SIM_APPS_MAX        256                 /* maximum number of applications   */
+#define SIM_PENDING_MAX     16                  /* not granted requests of an app   */
+#define SIM_DRAIN_MS        3000                /* run after last event(ms)         */
+#define SIM_LINE_MAX        256                 /* maximum length of trace line     */
+
+/* simulation event                             */
+#define SIM_EV_GET          1                   /* get resource                     */
+#define SIM_EV_REL          2                   /* release resource                 */
+#define SIM_EV_ACK          3                   /* reply OK                         */
+#define SIM_EV_NAK          4                   /* reply NG                         */
+#define SIM_EV_SPEED        5                   /* vehicle speed change             */
+#define SIM_EV_SHIFT        6                   /* shift position change            */
+#define SIM_EV_BLINKER      7                   /* blinker change                   */
+#define SIM_EV_ACTIVE       8                   /* active application change        */
+#define SIM_EV_EXIT         9                   /* application exit(disconnect)     */
+#define SIM_EV_VEHICLE      10                  /* vehicle signal record(injection) */
+#define SIM_EV_RELOAD       11                  /* live reload without a zone       */
+#define SIM_EV_WINDOW       12                  /* main window created              */
+#define SIM_EV_PRELAUNCH    13                  /* pre-launch start/end/cancel      */
+
+typedef struct _sim_event   {
+    double  time;                               /* event time(virtual, ms)          */
+    int     seq;                                /* order in same time               */
+    short   type;                               /* event type(SIM_EV_xxx)           */
+    short   app;                                /* application index                */
+    short   resid;                              /* resource id                      */
+    short   id;                                 /* request object                   */
+    int     value;                              /* vehicle value                    */
+    double  vehicle;                            /* vehicle value of record          */
+    char    device[ICO_UXF_MAX_DEVICE_NAME+1];  /* zone name(empty=default)         */
+    char    property[32];                       /* vehicle property of record       */
+} sim_event_t;
+
+/* simulated application                        */
+typedef struct _sim_pending {
+    double  time;                               /* request time(ms)                 */
+    short   resid;                              /* resource id                      */
+    short   id;                                 /* request object                   */
+} sim_pending_t;
+
+typedef struct _sim_app {
+    int     reply;                              /* auto reply latency(ms, <0=none)  */
+    int     visible;                            /* last display control             */
+    int     sound;                              /* last sound control               */
+    int     mute;                               /* mute state of Multi Sound Manager*/
+                                                /* (-1=no command)                  */
+    int     npending;                           /* number of not granted requests   */
+    sim_pending_t   pending[SIM_PENDING_MAX];   /* not granted requests             */
+} sim_app_t;
+
+/* virtual Ecore timer                          */
+typedef struct _sim_timer   {
+    struct _sim_timer   *next;                  /* timer list link                  */
+    double          deadline;                   /* expire time(virtual, sec)        */
+    double          interval;                   /* interval(sec)                    */
+    Ecore_Task_Cb   func;                       /* callback                         */
+    void            *data;                      /* user data                        */
+    int             deleted;                    /* deleted in callback              */
+} sim_timer_t;
+
+/* Ecore idle enterer                           */
+typedef struct _sim_idler   {
+    struct _sim_idler   *next;                  /* idler list link                  */
+    Ecore_Task_Cb   func;                       /* callback                         */
+    void            *data;                      /* user data                        */
+} sim_idler_t;
+
+/* fake AMB reply delay(sec)                    */
+#define SIM_AMB_DELAY       0.002
+
+/* fake D-Bus message(AMB reply or PropertiesChanged)   */
+struct DBusMessage  {
+    int     msgtype;                            /* DBUS_MESSAGE_TYPE_xxx            */
+    int     type;                               /* argument type of value           */
+    char    property[64];                       /* property name                    */
+    const char  *path;                          /* object path(signal)              */
+    const char  *interface;                     /* interface of property(signal)    */
+    int     value;                              /* property value                   */
+};
+struct DBusPendingCall  {
+    DBusMessage *reply;                         /* reply message                    */
+    DBusPendingCallNotifyFunction   notify;     /* reply callback                   */
+    void        *user_data;                     /* user data of callback            */
+    Ecore_Timer *timer;                         /* reply delay                      */
+};
+
+/* measured samples                             */
+typedef struct _sim_samples {
+    double  *val;                               /* samples                          */
+    int     num;                                /* number of samples                */
+    int     size;                               /* size of samples                  */
+} sim_samples_t;
+
+/* simulated environment                        */
+static double               sim_now = 0.0;      /* virtual clock(sec)               */
+static int                  sim_seq = 0;
+static sim_event_t          *events = NULL;     /* event queue(binary heap by time) */
+static int                  nevents = 0;
+static int                  sevents = 0;
+static double               lastevent = 0.0;    /* time of last trace event(ms)     */
+static sim_timer_t          *timers = NULL;
+static sim_timer_t          *firing = NULL;
+static sim_idler_t          *idlers = NULL;
+static ico_apf_resource_notify_cb_t resource_cb = NULL;
+static void                 *resource_cb_data = NULL;
+static Ico_Uxf_Sys_Config   *confsys = NULL;
+static Ico_Uxf_App_Config   confapp;
+static sim_app_t            simapp[SIM_APPS_MAX];
+static int                  napps = 0;
+static int                  verbose = 0;
+static const char           *activeapp = NULL;
+
+/* vehicle state(answered by fake AMB)          */
+static DBusHandleMessageFunction    amb_filter = NULL;
+static int                  amb_nomatch = 0;    /* subscription fails(-p)           */
+static int                  amb_gets = 0;       /* Get requests                     */
+static int                  amb_signals = 0;    /* PropertiesChanged signals        */
+static int                  vehicle_speed = 0;
+static int                  vehicle_shift = ICO_SYC_APC_REGULATION_SHIFT_PARKING;
+static int                  vehicle_blinker = ICO_SYC_APC_REGULATION_BLINKER_NONE;
+
+/* measured result                              */
+static sim_samples_t        grant;              /* grant latency(ms)                */
+static sim_samples_t        cpu;                /* cpu time of event(us)            */
+static int                  dispflips = 0;
+static int                  soundflips = 0;
+static int                  windowctls = 0;
+static int                  soundcmds = 0;
+static int                  soundfail = 0;      /* every n-th sound command fails   */
+static int                  soundfails = 0;     /* failed sound commands            */
+static int                  replies = 0;
+static int                  regdisplay = 0;     /* regulation transitions           */
+static int                  regsound = 0;
+static int                  reginput = 0;
+static int                  vehicles = 0;       /* injected vehicle signals         */
+static Ico_Uxf_SysUpdate_Cb sysupdate = NULL;   /* live reload callback             */
+static Ico_Uxf_Hook         windowhook = NULL;  /* window create/destroy hook       */
+static Ico_Uxf_Sys_Config   *confnow = NULL;    /* reloaded system configuration    */
+static int                  reloads = 0;        /* live reloads                     */
+static int                  reloadfails = 0;    /* failed live reloads              */
+static long                 mem_base = 0;
+static long                 mem_peak = 0;
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_cputime: current monotonic time(micro seconds)
+ *
+ * @param       none
+ * @return      current time
+ */
+/*--------------------------------------------------------------------------*/
+static double
+sim_cputime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000.0) + (ts.tv_nsec / 1000.0);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_heapuse: current heap use(bytes)
+ *
+ * @param       none
+ * @return      allocated bytes
+ */
+/*--------------------------------------------------------------------------*/
+static long
+sim_heapuse(void)
+{
+    struct mallinfo mi;
+
+    mi = mallinfo();
+    return (long)mi.uordblks + (long)mi.hblkhd;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_sample: add measured sample
+ *
+ * @param[in]   samples         samples
+ * @param[in]   val             sample value
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_sample(sim_samples_t *samples, const double val)
+{
+    double  *nval;
+
+    if (samples->num >= samples->size)  {
+        nval = realloc(samples->val, sizeof(double) * (samples->size * 2 + 1024));
+        if (! nval) {
+            return;
+        }
+        samples->val = nval;
+        samples->size = samples->size * 2 + 1024;
+    }
+    samples->val[samples->num++] = val;
+}
+
+/*==============================================================================*/
+/* event queue(binary heap ordered by time and sequence)                        */
+/*==============================================================================*/
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_evcmp: compare events(static function)
+ *
+ * @param[in]   a               event 1
+ * @param[in]   b               event 2
+ * @return      <0: a is earlier, >0: b is earlier
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_evcmp(const sim_event_t *a, const sim_event_t *b)
+{
+    if (a->time != b->time) {
+        return (a->time < b->time) ? -1 : 1;
+    }
+    return a->seq - b->seq;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_evput: put event to event queue
+ *
+ * @param[in]   ev              event(copied)
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error(out of memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_evput(const sim_event_t *ev)
+{
+    sim_event_t *nevent;
+    sim_event_t wk;
+    int     i, parent;
+
+    if (nevents >= sevents) {
+        nevent = realloc(events, sizeof(sim_event_t) * (sevents * 2 + 256));
+        if (! nevent)   {
+            fprintf(stderr, "sim_apc: No Memory\n");
+            return -1;
+        }
+        events = nevent;
+        sevents = sevents * 2 + 256;
+    }
+    wk = *ev;
+    wk.seq = sim_seq++;
+    for (i = nevents++; i > 0; i = parent)  {
+        parent = (i - 1) / 2;
+        if (sim_evcmp(&events[parent], &wk) <= 0)   break;
+        events[i] = events[parent];
+    }
+    events[i] = wk;
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_evget: get the earliest event from event queue
+ *
+ * @param[out]  ev              event
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_evget(sim_event_t *ev)
+{
+    sim_event_t last;
+    int     i, child;
+
+    *ev = events[0];
+    last = events[--nevents];
+    for (i = 0; (child = i * 2 + 1) < nevents; i = child)   {
+        if ((child + 1 < nevents) && (sim_evcmp(&events[child+1], &events[child]) < 0)) {
+            child ++;
+        }
+        if (sim_evcmp(&last, &events[child]) <= 0)  break;
+        events[i] = events[child];
+    }
+    events[i] = last;
+}
+
+/*==============================================================================*/
+/* Ecore fake(virtual clock)                                                    */
+/*==============================================================================*/
+double
+ecore_time_get(void)
+{
+    return sim_now;
+}
+
+double
+ecore_loop_time_get(void)
+{
+    return sim_now;
+}
+
+Ecore_Timer *
+ecore_timer_add(double dtime, Ecore_Task_Cb func, const void *user_data)
+{
+    sim_timer_t *timer;
+
+    timer = malloc(sizeof(sim_timer_t));
+    if (! timer)    {
+        return NULL;
+    }
+    memset(timer, 0, sizeof(sim_timer_t));
+    timer->deadline = sim_now + dtime;
+    timer->interval = dtime;
+    timer->func = func;
+    timer->data = (void *)user_data;
+    timer->next = timers;
+    timers = timer;
+    return (Ecore_Timer *)timer;
+}
+
+void *
+ecore_timer_del(Ecore_Timer *timer)
+{
+    sim_timer_t *t = (sim_timer_t *)timer;
+    sim_timer_t *p;
+    sim_timer_t *bp;
+    void        *data;
+
+    if (! t)    {
+        return NULL;
+    }
+    data = t->data;
+    if (t == firing)    {
+        /* deleted in own callback, release after callback  */
+        t->deleted = 1;
+        return data;
+    }
+    bp = NULL;
+    for (p = timers; p; p = p->next)    {
+        if (p == t) break;
+        bp = p;
+    }
+    if (! p)    {
+        return NULL;
+    }
+    if (bp) bp->next = t->next;
+    else    timers = t->next;
+    free(t);
+    return data;
+}
+
+Ecore_Idle_Enterer *
+ecore_idle_enterer_add(Ecore_Task_Cb func, const void *data)
+{
+    sim_idler_t *idler;
+    sim_idler_t *p;
+
+    idler = malloc(sizeof(sim_idler_t));
+    if (! idler)    {
+        return NULL;
+    }
+    idler->func = func;
+    idler->data = (void *)data;
+    idler->next = NULL;
+    /* idle enterers are called in order of registration    */
+    if (idlers) {
+        for (p = idlers; p->next; p = p->next)  ;
+        p->next = idler;
+    }
+    else    {
+        idlers = idler;
+    }
+    return (Ecore_Idle_Enterer *)idler;
+}
+
+void *
+ecore_idle_enterer_del(Ecore_Idle_Enterer *enterer)
+{
+    sim_idler_t *idler = (sim_idler_t *)enterer;
+    sim_idler_t *p;
+    sim_idler_t *bp;
+    void        *data;
+
+    bp = NULL;
+    for (p = idlers; p; p = p->next)    {
+        if (p == idler) break;
+        bp = p;
+    }
+    if (! p)    {
+        return NULL;
+    }
+    if (bp) bp->next = p->next;
+    else    idlers = p->next;
+    data = p->data;
+    free(p);
+    return data;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_idle: call idle enterers(main loop goes to idle)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_idle(void)
+{
+    sim_idler_t *p;
+    sim_idler_t *next;
+
+    for (p = idlers; p; p = next)   {
+        next = p->next;
+        if ((*p->func)(p->data) == ECORE_CALLBACK_CANCEL)   {
+            (void) ecore_idle_enterer_del((Ecore_Idle_Enterer *)p);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_nexttimer: get the earliest timer
+ *
+ * @param       none
+ * @return      timer(NULL=no timer)
+ */
+/*--------------------------------------------------------------------------*/
+static sim_timer_t *
+sim_nexttimer(void)
+{
+    sim_timer_t *p;
+    sim_timer_t *next = NULL;
+
+    for (p = timers; p; p = p->next)    {
+        if ((! next) || (p->deadline < next->deadline)) {
+            next = p;
+        }
+    }
+    return next;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_firetimer: call timer callback
+ *
+ * @param[in]   timer           expired timer
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_firetimer(sim_timer_t *timer)
+{
+    Eina_Bool   ret;
+
+    firing = timer;
+    ret = (*timer->func)(timer->data);
+    firing = NULL;
+    if ((ret == ECORE_CALLBACK_RENEW) && (! timer->deleted))    {
+        timer->deadline += timer->interval;
+    }
+    else    {
+        timer->deleted = 0;
+        (void) ecore_timer_del((Ecore_Timer *)timer);
+    }
+}
+
+/*==============================================================================*/
+/* AMB(D-Bus) fake, answers current vehicle state and notifies change           */
+/*==============================================================================*/
+void
+dbus_error_init(DBusError *error)
+{
+    memset(error, 0, sizeof(DBusError));
+}
+
+void
+dbus_error_free(DBusError *error)
+{
+    memset(error, 0, sizeof(DBusError));
+}
+
+dbus_bool_t
+dbus_error_is_set(const DBusError *error)
+{
+    return error->name ? TRUE : FALSE;
+}
+
+DBusConnection *
+dbus_bus_get_private(DBusBusType type, DBusError *error)
+{
+    return (DBusConnection *)&confapp;
+}
+
+void
+dbus_connection_set_exit_on_disconnect(DBusConnection *connection,
+                                       dbus_bool_t exit_on_disconnect)
+{
+}
+
+dbus_bool_t
+dbus_connection_set_watch_functions(DBusConnection *connection,
+                                    DBusAddWatchFunction add_function,
+                                    DBusRemoveWatchFunction remove_function,
+                                    DBusWatchToggledFunction toggled_function,
+                                    void *data, DBusFreeFunction free_data_function)
+{
+    /* no socket, replies and signals are delivered by simulation   */
+    return TRUE;
+}
+
+dbus_bool_t
+dbus_connection_set_timeout_functions(DBusConnection *connection,
+                                      DBusAddTimeoutFunction add_function,
+                                      DBusRemoveTimeoutFunction remove_function,
+                                      DBusTimeoutToggledFunction toggled_function,
+                                      void *data, DBusFreeFunction free_data_function)
+{
+    return TRUE;
+}
+
+void
+dbus_connection_set_dispatch_status_function(DBusConnection *connection,
+                                             DBusDispatchStatusFunction function,
+                                             void *data, DBusFreeFunction free_data_function)
+{
+}
+
+dbus_bool_t
+dbus_connection_add_filter(DBusConnection *connection, DBusHandleMessageFunction function,
+                           void *user_data, DBusFreeFunction free_data_function)
+{
+    amb_filter = function;
+    return TRUE;
+}
+
+void
+dbus_connection_remove_filter(DBusConnection *connection, DBusHandleMessageFunction function,
+                              void *user_data)
+{
+    amb_filter = NULL;
+}
+
+void
+dbus_bus_add_match(DBusConnection *connection, const char *rule, DBusError *error)
+{
+    if (amb_nomatch)    {
+        error->name = "org.freedesktop.DBus.Error.AccessDenied";
+        error->message = "match rule is not allowed(simulation)";
+    }
+}
+
+DBusDispatchStatus
+dbus_connection_dispatch(DBusConnection *connection)
+{
+    return DBUS_DISPATCH_COMPLETE;
+}
+
+void
+dbus_connection_close(DBusConnection *connection)
+{
+}
+
+void
+dbus_connection_unref(DBusConnection *connection)
+{
+}
+
+/* watch and timeout are never added, because connection has no socket  */
+int
+dbus_watch_get_unix_fd(DBusWatch *watch)
+{
+    return -1;
+}
+
+unsigned int
+dbus_watch_get_flags(DBusWatch *watch)
+{
+    return 0;
+}
+
+void *
+dbus_watch_get_data(DBusWatch *watch)
+{
+    return NULL;
+}
+
+void
+dbus_watch_set_data(DBusWatch *watch, void *data, DBusFreeFunction free_data_function)
+{
+}
+
+dbus_bool_t
+dbus_watch_handle(DBusWatch *watch, unsigned int flags)
+{
+    return TRUE;
+}
+
+dbus_bool_t
+dbus_watch_get_enabled(DBusWatch *watch)
+{
+    return FALSE;
+}
+
+int
+dbus_timeout_get_interval(DBusTimeout *timeout)
+{
+    return 0;
+}
+
+void *
+dbus_timeout_get_data(DBusTimeout *timeout)
+{
+    return NULL;
+}
+
+void
+dbus_timeout_set_data(DBusTimeout *timeout, void *data, DBusFreeFunction free_data_function)
+{
+}
+
+dbus_bool_t
+dbus_timeout_handle(DBusTimeout *timeout)
+{
+    return TRUE;
+}
+
+dbus_bool_t
+dbus_timeout_get_enabled(DBusTimeout *timeout)
+{
+    return FALSE;
+}
+
+Ecore_Fd_Handler *
+ecore_main_fd_handler_add(int fd, Ecore_Fd_Handler_Flags flags, Ecore_Fd_Cb func,
+                          const void *data, Ecore_Fd_Cb buf_func, const void *buf_data)
+{
+    return NULL;
+}
+
+void *
+ecore_main_fd_handler_del(Ecore_Fd_Handler *fd_handler)
+{
+    return NULL;
+}
+
+Eina_Bool
+ecore_main_fd_handler_active_get(Ecore_Fd_Handler *fd_handler, Ecore_Fd_Handler_Flags flags)
+{
+    return EINA_FALSE;
+}
+
+Ecore_Idler *
+ecore_idler_add(Ecore_Task_Cb func, const void *data)
+{
+    return (Ecore_Idler *)ecore_idle_enterer_add(func, data);
+}
+
+void *
+ecore_idler_del(Ecore_Idler *idler)
+{
+    return ecore_idle_enterer_del((Ecore_Idle_Enterer *)idler);
+}
+
+DBusMessage *
+dbus_message_new_method_call(const char *bus_name, const char *path,
+                             const char *iface, const char *method)
+{
+    DBusMessage *msg;
+
+    msg = malloc(sizeof(DBusMessage));
+    if (msg)    {
+        memset(msg, 0, sizeof(DBusMessage));
+        msg->msgtype = DBUS_MESSAGE_TYPE_METHOD_CALL;
+    }
+    return msg;
+}
+
+dbus_bool_t
+dbus_message_append_args(DBusMessage *message, int first_arg_type, ...)
+{
+    va_list     args;
+    int         type;
+    const char  **str;
+
+    /* arguments are interface and property name    */
+    va_start(args, first_arg_type);
+    for (type = first_arg_type; type != DBUS_TYPE_INVALID; type = va_arg(args, int))  {
+        str = va_arg(args, const char **);
+        if (type == DBUS_TYPE_STRING)   {
+            strncpy(message->property, *str, sizeof(message->property) - 1);
+        }
+    }
+    va_end(args);
+    return TRUE;
+}
+
+dbus_bool_t
+dbus_message_set_destination(DBusMessage *message, const char *destination)
+{
+    return TRUE;
+}
+
+void
+dbus_message_unref(DBusMessage *message)
+{
+    free(message);
+}
+
+int
+dbus_message_get_type(DBusMessage *message)
+{
+    return message->msgtype;
+}
+
+dbus_bool_t
+dbus_message_is_signal(DBusMessage *message, const char *iface, const char *signal_name)
+{
+    return ((message->msgtype == DBUS_MESSAGE_TYPE_SIGNAL) &&
+            (strcmp(iface, DBUS_INTERFACE) == 0) &&
+            (strcmp(signal_name, DBUS_SIGNAL) == 0)) ? TRUE : FALSE;
+}
+
+const char *
+dbus_message_get_path(DBusMessage *message)
+{
+    return message->path;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_value: set current vehicle state to fake message
+ *
+ * @param[out]  msg             message(property is set)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+amb_value(DBusMessage *msg)
+{
+    if (strcmp(msg->property, "VehicleSpeed") == 0) {
+        msg->type = DBUS_TYPE_UINT16;
+        msg->value = vehicle_speed;
+        msg->path = "/org/automotive/runningstatus/vehicleSpeed";
+        msg->interface = "org.automotive.vehicleSpeed";
+    }
+    else if (strcmp(msg->property, "ShiftPosition") == 0)   {
+        msg->type = DBUS_TYPE_BYTE;
+        msg->value = vehicle_shift;
+        msg->path = "/org/automotive/runningstatus/transmission";
+        msg->interface = "org.automotive.transmission";
+    }
+    else if (strcmp(msg->property, "LeftTurn") == 0)    {
+        msg->type = DBUS_TYPE_BOOLEAN;
+        msg->value = (vehicle_blinker == ICO_SYC_APC_REGULATION_BLINKER_LEFT);
+        msg->path = "/org/automotive/runningstatus/lightStatus";
+        msg->interface = "org.automotive.lightStatus";
+    }
+    else if (strcmp(msg->property, "RightTurn") == 0)   {
+        msg->type = DBUS_TYPE_BOOLEAN;
+        msg->value = (vehicle_blinker == ICO_SYC_APC_REGULATION_BLINKER_RIGHT);
+        msg->path = "/org/automotive/runningstatus/lightStatus";
+        msg->interface = "org.automotive.lightStatus";
+    }
+    else    {
+        msg->type = DBUS_TYPE_INT32;
+        msg->value = 0;
+        msg->path = "";
+        msg->interface = "";
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_changed: AMB notifies change of property(PropertiesChanged)
+ *
+ * @param[in]   property        changed property
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+amb_changed(const char *property)
+{
+    DBusMessage msg;
+
+    if ((! amb_filter) || (amb_nomatch))    {
+        /* not subscribed           */
+        return;
+    }
+    memset(&msg, 0, sizeof(msg));
+    msg.msgtype = DBUS_MESSAGE_TYPE_SIGNAL;
+    strncpy(msg.property, property, sizeof(msg.property) - 1);
+    amb_value(&msg);
+    amb_signals ++;
+    (void) (*amb_filter)((DBusConnection *)&confapp, &msg, NULL);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   amb_reply: AMB reply is received(virtual timer)
+ *
+ * @param[in]   data            pending call
+ * @return      always ECORE_CALLBACK_CANCEL
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+amb_reply(void *data)
+{
+    DBusPendingCall *pending = (DBusPendingCall *)data;
+
+    pending->timer = NULL;
+    if (pending->notify)    {
+        (*pending->notify)(pending, pending->user_data);
+    }
+    return ECORE_CALLBACK_CANCEL;
+}
+
+dbus_bool_t
+dbus_connection_send_with_reply(DBusConnection *connection, DBusMessage *message,
+                                DBusPendingCall **pending_return, int timeout_milliseconds)
+{
+    DBusPendingCall *pending;
+    DBusMessage     *reply;
+
+    pending = malloc(sizeof(DBusPendingCall));
+    reply = malloc(sizeof(DBusMessage));
+    if ((! pending) || (! reply))   {
+        free(pending);
+        free(reply);
+        return FALSE;
+    }
+    memset(pending, 0, sizeof(DBusPendingCall));
+    /* AMB answers soon, value at request time  */
+    memcpy(reply, message, sizeof(DBusMessage));
+    reply->msgtype = DBUS_MESSAGE_TYPE_METHOD_RETURN;
+    amb_value(reply);
+    pending->reply = reply;
+    *pending_return = pending;
+    amb_gets ++;
+    return TRUE;
+}
+
+dbus_bool_t
+dbus_pending_call_set_notify(DBusPendingCall *pending, DBusPendingCallNotifyFunction function,
+                             void *user_data, DBusFreeFunction free_user_data)
+{
+    pending->notify = function;
+    pending->user_data = user_data;
+    pending->timer = ecore_timer_add(SIM_AMB_DELAY, amb_reply, pending);
+    return pending->timer ? TRUE : FALSE;
+}
+
+void
+dbus_pending_call_cancel(DBusPendingCall *pending)
+{
+    if (pending->timer) {
+        (void) ecore_timer_del(pending->timer);
+        pending->timer = NULL;
+    }
+}
+
+DBusMessage *
+dbus_pending_call_steal_reply(DBusPendingCall *pending)
+{
+    DBusMessage *reply = pending->reply;
+
+    pending->reply = NULL;
+    return reply;
+}
+
+void
+dbus_pending_call_unref(DBusPendingCall *pending)
+{
+    if (pending)    {
+        dbus_pending_call_cancel(pending);
+        free(pending->reply);
+        free(pending);
+    }
+}
+
+/* iterator: dummy1=message, dummy4=depth, dummy5=argument position
+ *   reply : v
+ *   signal: s a{sv}    (one dictionary entry)  */
+dbus_bool_t
+dbus_message_iter_init(DBusMessage *message, DBusMessageIter *iter)
+{
+    memset(iter, 0, sizeof(DBusMessageIter));
+    iter->dummy1 = message;
+    return TRUE;
+}
+
+void
+dbus_message_iter_recurse(DBusMessageIter *iter, DBusMessageIter *sub)
+{
+    *sub = *iter;
+    sub->dummy4 = iter->dummy4 + 1;
+    sub->dummy5 = 0;
+}
+
+dbus_bool_t
+dbus_message_iter_next(DBusMessageIter *iter)
+{
+    iter->dummy5 ++;
+    return (dbus_message_iter_get_arg_type(iter) != DBUS_TYPE_INVALID) ? TRUE : FALSE;
+}
+
+int
+dbus_message_iter_get_arg_type(DBusMessageIter *iter)
+{
+    DBusMessage *msg = (DBusMessage *)iter->dummy1;
+    static const int    reply[2][1] = {
+        { DBUS_TYPE_VARIANT }, { -1 }
+    };
+    static const int    signal[4][2] = {
+        { DBUS_TYPE_STRING, DBUS_TYPE_ARRAY }, { DBUS_TYPE_DICT_ENTRY, DBUS_TYPE_INVALID },
+        { DBUS_TYPE_STRING, DBUS_TYPE_VARIANT }, { -1, DBUS_TYPE_INVALID }
+    };
+    int     type;
+
+    if (msg->msgtype == DBUS_MESSAGE_TYPE_SIGNAL)   {
+        if ((iter->dummy4 > 3) || (iter->dummy5 > 1))   return DBUS_TYPE_INVALID;
+        type = signal[iter->dummy4][iter->dummy5];
+    }
+    else    {
+        if ((iter->dummy4 > 1) || (iter->dummy5 > 0))   return DBUS_TYPE_INVALID;
+        type = reply[iter->dummy4][iter->dummy5];
+    }
+    return (type < 0) ? msg->type : type;
+}
+
+void
+dbus_message_iter_get_basic(DBusMessageIter *iter, void *value)
+{
+    DBusMessage *msg = (DBusMessage *)iter->dummy1;
+
+    if (dbus_message_iter_get_arg_type(iter) == DBUS_TYPE_STRING)   {
+        /* interface name(top) or property name(dictionary entry)  */
+        *((const char **)value) = (iter->dummy4 == 0) ? msg->interface : msg->property;
+        return;
+    }
+    switch (msg->type)  {
+    case DBUS_TYPE_UINT16:
+        *((uint16_t *)value) = (uint16_t)msg->value;
+        break;
+    case DBUS_TYPE_BYTE:
+        *((uint8_t *)value) = (uint8_t)msg->value;
+        break;
+    case DBUS_TYPE_BOOLEAN:
+        *((dbus_bool_t *)value) = msg->value ? TRUE : FALSE;
+        break;
+    default:
+        *((int32_t *)value) = msg->value;
+        break;
+    }
+}
+
+/*==============================================================================*/
+/* application configuration fake(applications of trace)                        */
+/*==============================================================================*/
+const Ico_Uxf_App_Config *
+ico_uxf_getAppConfig(void)
+{
+    return &confapp;
+}
+
+const Ico_Uxf_conf_application *
+ico_uxf_getAppByAppid(const char *appid)
+{
+    const char  *atom;
+    int         i;
+
+    atom = ico_uxf_misc_findIntern(appid);
+    if (! atom) {
+        return NULL;
+    }
+    for (i = 0; i < confapp.applicationNum; i++)    {
+        if (confapp.application[i].appid == atom)   {
+            return &confapp.application[i];
+        }
+    }
+    return NULL;
+}
+
+const Ico_Uxf_conf_application *
+ico_uxf_getAppByName(const char *name)
+{
+    return ico_uxf_getAppByAppid(name);
+}
+
+int
+ico_uxf_econf_setSysUpdateCb(Ico_Uxf_SysUpdate_Cb func)
+{
+    /* system configuration is reloaded by reload event of trace    */
+    sysupdate = func;
+    return ICO_UXF_EOK;
+}
+
+/*==============================================================================*/
+/* window, sound and input control fake                                         */
+/*==============================================================================*/
+int
+ico_uxf_window_control(const char *appid, const int winidx,
+                       const int control, const int onoff)
+{
+    windowctls ++;
+    return ICO_UXF_EOK;
+}
+
+void
+ico_uxf_window_hook(Ico_Uxf_Hook func)
+{
+    windowhook = func;
+}
+
+Ico_Uxf_InputDev *
+ico_uxf_inputdev_attribute_get(const int devidx)
+{
+    /* no input switch      */
+    return NULL;
+}
+
+Ico_Uxf_InputSw *
+ico_uxf_inputsw_attribute_get(Ico_Uxf_InputDev *inputdev, const int swidx)
+{
+    return NULL;
+}
+
+int
+ico_uxf_input_control(const int add, const char *appid,
+                      const char *device, const int input)
+{
+    return ICO_UXF_EOK;
+}
+
+int
+ico_uxf_process_is_active(const char *process)
+{
+    return ((activeapp) && (ico_uxf_misc_findIntern(process) == activeapp)) ? 1 : 0;
+}
+
+int
+ico_uxf_process_priority(const char *process, const int pid)
+{
+    return 0;
+}
+
+void
+ico_uxf_set_lastapp(const char *appid)
+{
+}
+
+char *
+ico_uxf_getchild_appid(const char *appid)
+{
+    return NULL;
+}
+
+/*==============================================================================*/
+/* resource server fake(simulated applications)                                 */
+/*==============================================================================*/
+int
+ico_apf_ecore_init_server(const char *uri)
+{
+    return ICO_APF_E_NONE;
+}
+
+void
+ico_apf_resource_term_server(void)
+{
+    resource_cb = NULL;
+}
+
+int
+ico_apf_resource_set_event_cb(ico_apf_resource_notify_cb_t callbacks, void *user_data)
+{
+    resource_cb = callbacks;
+    resource_cb_data = user_data;
+    return ICO_APF_RESOURCE_E_NONE;
+}
+
+int
+ico_apf_resource_send_to_soundctl(const ico_apf_sound_state_e cmd, const int pid)
+{
+    int     i;
+
+    soundcmds ++;
+    if (cmd == ICO_APF_SOUND_COMMAND_GETLIST)   {
+        return ICO_APF_RESOURCE_E_NONE;
+    }
+    if ((soundfail > 0) && ((soundcmds % soundfail) == 0))  {
+        soundfails ++;
+        return ICO_APF_RESOURCE_E_COMMUNICATION;
+    }
+    /* mute state of streams(pid is 1000 + application index)   */
+    if ((cmd == ICO_APF_SOUND_COMMAND_ALLMUTEON) || (cmd == ICO_APF_SOUND_COMMAND_ALLMUTEOFF))  {
+        for (i = 0; i < napps; i++) {
+            simapp[i].mute = (cmd == ICO_APF_SOUND_COMMAND_ALLMUTEON) ? 1 : 0;
+        }
+    }
+    else if ((pid >= 1000) && (pid < (1000 + napps)))   {
+        simapp[pid - 1000].mute = (cmd == ICO_APF_SOUND_COMMAND_MUTEON) ? 1 : 0;
+    }
+    return ICO_APF_RESOURCE_E_NONE;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_appidx: get simulated application index
+ *
+ * @param[in]   appid           application id
+ * @return      application index(-1=not simulated application)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_appidx(const char *appid)
+{
+    const Ico_Uxf_conf_application  *conf;
+
+    conf = ico_uxf_getAppByAppid(appid);
+    if (! conf) {
+        return -1;
+    }
+    return conf - confapp.application;
+}
+
+int
+ico_apf_resource_send_to_client(const char *appid, const int event,
+                                const int resource, const char *device, const int id)
+{
+    sim_app_t   *app;
+    sim_event_t ev;
+    int     idx;
+    int     i;
+
+    idx = sim_appidx(appid);
+    if (idx < 0)    {
+        return ICO_APF_RESOURCE_E_INVAL;
+    }
+    app = &simapp[idx];
+
+    if (event == ICO_APF_RESOURCE_STATE_ACQUIRED)   {
+        /* grant latency of the request     */
+        for (i = 0; i < app->npending; i++) {
+            if ((app->pending[i].resid == resource) && (app->pending[i].id == id))  {
+                sim_sample(&grant, sim_now * 1000.0 - app->pending[i].time);
+                app->pending[i] = app->pending[--app->npending];
+                break;
+            }
+        }
+    }
+    if (verbose)    {
+        printf("%9.1f send   %s res=%d id=%d event=%d\n",
+               sim_now * 1000.0, appid, resource, id, event);
+    }
+
+    /* application replies to acquired/deprived of screen and sound  */
+    if ((app->reply >= 0) &&
+        ((event == ICO_APF_RESOURCE_STATE_ACQUIRED) ||
+         (event == ICO_APF_RESOURCE_STATE_DEPRIVED)) &&
+        (resource != ICO_APF_RESID_INPUT_DEV))  {
+        memset(&ev, 0, sizeof(ev));
+        ev.time = sim_now * 1000.0 + app->reply;
+        ev.type = SIM_EV_ACK;
+        ev.app = idx;
+        ev.resid = resource;
+        ev.id = id;
+        (void) sim_evput(&ev);
+    }
+    return ICO_APF_RESOURCE_E_NONE;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_displaycontrol: display control callback(as HomeScreen)
+ *
+ * @param[in]   conf            application configuration
+ * @param[in]   control         1=show, 0=hide
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_displaycontrol(const Ico_Uxf_conf_application *conf, const int control)
+{
+    sim_app_t   *app = &simapp[conf - confapp.application];
+
+    if (app->visible != control)    {
+        app->visible = control;
+        dispflips ++;
+        if (verbose)    {
+            printf("%9.1f %-6s %s\n", sim_now * 1000.0, control ? "show" : "hide",
+                   conf->appid);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_soundcontrol: sound control callback(as HomeScreen)
+ *
+ * @param[in]   conf            application configuration
+ * @param[in]   control         1=unmute, 0=mute
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_soundcontrol(const Ico_Uxf_conf_application *conf, const int control)
+{
+    sim_app_t   *app = &simapp[conf - confapp.application];
+
+    if (app->sound != control)  {
+        app->sound = control;
+        soundflips ++;
+        if (verbose)    {
+            printf("%9.1f %-6s %s\n", sim_now * 1000.0, control ? "unmute" : "mute",
+                   conf->appid);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_inputcontrol: input control callback(as HomeScreen)
+ *
+ * @param[in]   conf            application configuration
+ * @param[in]   control         1=use, 0=unuse
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_inputcontrol(const Ico_Uxf_conf_application *conf, const int control)
+{
+}
+
+/*==============================================================================*/
+/* trace                                                                        */
+/*==============================================================================*/
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_addapp: add simulated application
+ *
+ * @param[in]   appid           application id
+ * @param[in]   category        category name
+ * @param[in]   dispzone        display zone name
+ * @param[in]   soundzone       sound zone name
+ * @param[in]   reply           auto reply latency(ms, <0=no auto reply)
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_addapp(const char *appid, const char *category, const char *dispzone,
+           const char *soundzone, const int reply)
+{
+    Ico_Uxf_conf_application    *conf;
+    int     categoryId;
+
+    if (napps >= SIM_APPS_MAX)  {
+        fprintf(stderr, "sim_apc: too many applications(%s)\n", appid);
+        return -1;
+    }
+    categoryId = ico_uxf_getSysCategoryByName(category);
+    if ((categoryId < 0) || (categoryId >= confsys->categoryNum))   {
+        fprintf(stderr, "sim_apc: %s unknown category(%s)\n", appid, category);
+        return -1;
+    }
+    conf = &confapp.application[napps];
+    memset(conf, 0, sizeof(Ico_Uxf_conf_application));
+    conf->appid = (char *)ico_uxf_misc_intern(appid);
+    conf->name = conf->appid;
+    conf->hostId = confsys->misc.myhostId;
+    conf->kindId = confsys->misc.default_kindId;
+    conf->categoryId = categoryId;
+    conf->displayzoneNum = 1;
+    conf->display[0].displayId = confsys->misc.default_displayId;
+    conf->display[0].layerId = confsys->misc.default_layerId;
+    conf->display[0].zoneId = ico_uxf_getSysDispZoneByName(conf->display[0].displayId,
+                                                           dispzone);
+    conf->soundzoneNum = 1;
+    conf->sound[0].soundId = confsys->misc.default_soundId;
+    conf->sound[0].zoneId = ico_uxf_getSysSoundZoneByName(conf->sound[0].soundId,
+                                                          soundzone);
+    if ((conf->display[0].zoneId < 0) || (conf->sound[0].zoneId < 0))   {
+        fprintf(stderr, "sim_apc: %s unknown zone(%s/%s)\n", appid, dispzone, soundzone);
+        return -1;
+    }
+    memset(&simapp[napps], 0, sizeof(sim_app_t));
+    simapp[napps].mute = -1;
+    simapp[napps].reply = reply;
+    napps ++;
+    confapp.applicationNum = napps;
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_resid: resource name to resource id
+ *
+ * @param[in]   name            resource name(disp/int/on/sound/isound)
+ * @return      resource id(-1=unknown)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_resid(const char *name)
+{
+    if (strcasecmp(name, "disp") == 0)      return ICO_APF_RESID_BASIC_SCREEN;
+    if (strcasecmp(name, "int") == 0)       return ICO_APF_RESID_INT_SCREEN;
+    if (strcasecmp(name, "on") == 0)        return ICO_APF_RESID_ON_SCREEN;
+    if (strcasecmp(name, "sound") == 0)     return ICO_APF_RESID_BASIC_SOUND;
+    if (strcasecmp(name, "isound") == 0)    return ICO_APF_RESID_INT_SOUND;
+    return -1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_shift: shift position name to value
+ *
+ * @param[in]   name            shift position(park/neutral/drive/reverse or number)
+ * @return      shift position
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_shift(const char *name)
+{
+    if (strcasecmp(name, "park") == 0)      return ICO_SYC_APC_REGULATION_SHIFT_PARKING;
+    if (strcasecmp(name, "neutral") == 0)   return ICO_SYC_APC_REGULATION_SHIFT_NEUTRALS;
+    if (strcasecmp(name, "drive") == 0)     return ICO_SYC_APC_REGULATION_SHIFT_DRIVE;
+    if (strcasecmp(name, "reverse") == 0)   return ICO_SYC_APC_REGULATION_SHIFT_REVERSES;
+    return strtol(name, (char **)0, 0);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_load: load trace file
+ *          app <appid> <category> <display zone> <sound zone> <reply(ms)|noreply>
+ *          <time(ms)> get|rel|ack|nak <appid> <resource> <id> [zone]
+ *          <time(ms)> speed <km/h> | shift <position> | blinker none|left|right
+ *          <time(ms)> active <appid> | exit <appid> | window <appid>
+ *          <time(ms)> reload <display zone>
+ *
+ * @param[in]   file            trace file name("-"=stdin)
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_load(const char *file)
+{
+    FILE    *fp;
+    char    line[SIM_LINE_MAX];
+    char    w[6][SIM_LINE_MAX];
+    int     nw;
+    int     lineno = 0;
+    sim_event_t ev;
+
+    fp = (strcmp(file, "-") == 0) ? stdin : fopen(file, "r");
+    if (! fp)   {
+        fprintf(stderr, "sim_apc: can not open %s\n", file);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), fp))   {
+        lineno ++;
+        nw = sscanf(line, "%255s %255s %255s %255s %255s %255s",
+                    w[0], w[1], w[2], w[3], w[4], w[5]);
+        if ((nw <= 0) || (w[0][0] == '#'))  {
+            continue;
+        }
+        if (strcmp(w[0], "app") == 0)   {
+            if ((nw < 6) ||
+                (sim_addapp(w[1], w[2], w[3], w[4],
+                            strcmp(w[5], "noreply") ? strtol(w[5], (char **)0, 0) : -1)
+                    < 0))   {
+                fprintf(stderr, "sim_apc: %s(%d) illegal app\n", file, lineno);
+                goto error;
+            }
+            continue;
+        }
+        memset(&ev, 0, sizeof(ev));
+        ev.time = strtod(w[0], (char **)0);
+        if ((nw >= 3) &&
+            ((strcmp(w[1], "active") == 0) || (strcmp(w[1], "exit") == 0) ||
+             (strcmp(w[1], "window") == 0)))    {
+            if (strcmp(w[1], "active") == 0)       ev.type = SIM_EV_ACTIVE;
+            else if (strcmp(w[1], "exit") == 0)    ev.type = SIM_EV_EXIT;
+            else                                    ev.type = SIM_EV_WINDOW;
+            ev.app = sim_appidx(w[2]);
+        }
+        else if ((nw >= 4) && (strcmp(w[1], "prelaunch") == 0)) {
+            ev.type = SIM_EV_PRELAUNCH;
+            ev.app = sim_appidx(w[2]);
+            if (strcmp(w[3], "start") == 0)
+                ev.value = ICO_SYC_APC_PRELAUNCH_START;
+            else if (strcmp(w[3], "cancel") == 0)
+                ev.value = ICO_SYC_APC_PRELAUNCH_CANCEL;
+            else
+                ev.value = ICO_SYC_APC_PRELAUNCH_END;
+        }
+        else if ((nw >= 3) && (strcmp(w[1], "reload") == 0))    {
+            ev.type = SIM_EV_RELOAD;
+            strncpy(ev.device, w[2], ICO_UXF_MAX_DEVICE_NAME);
+        }
+        else if ((nw >= 3) && (strcmp(w[1], "speed") == 0)) {
+            ev.type = SIM_EV_SPEED;
+            ev.value = strtol(w[2], (char **)0, 0);
+        }
+        else if ((nw >= 3) && (strcmp(w[1], "shift") == 0)) {
+            ev.type = SIM_EV_SHIFT;
+            ev.value = sim_shift(w[2]);
+        }
+        else if ((nw >= 3) && (strcmp(w[1], "blinker") == 0))   {
+            ev.type = SIM_EV_BLINKER;
+            if (strcmp(w[2], "left") == 0)
+                ev.value = ICO_SYC_APC_REGULATION_BLINKER_LEFT;
+            else if (strcmp(w[2], "right") == 0)
+                ev.value = ICO_SYC_APC_REGULATION_BLINKER_RIGHT;
+            else
+                ev.value = ICO_SYC_APC_REGULATION_BLINKER_NONE;
+        }
+        else if (nw >= 5)   {
+            if (strcmp(w[1], "get") == 0)       ev.type = SIM_EV_GET;
+            else if (strcmp(w[1], "rel") == 0)  ev.type = SIM_EV_REL;
+            else if (strcmp(w[1], "ack") == 0)  ev.type = SIM_EV_ACK;
+            else if (strcmp(w[1], "nak") == 0)  ev.type = SIM_EV_NAK;
+            ev.app = sim_appidx(w[2]);
+            ev.resid = sim_resid(w[3]);
+            ev.id = strtol(w[4], (char **)0, 0);
+            if (nw >= 6)    {
+                strncpy(ev.device, w[5], ICO_UXF_MAX_DEVICE_NAME);
+            }
+            if (ev.resid < 0)   ev.type = 0;
+        }
+        if ((ev.type == 0) || (ev.app < 0)) {
+            fprintf(stderr, "sim_apc: %s(%d) illegal event\n", file, lineno);
+            goto error;
+        }
+        if (ev.time > lastevent)    lastevent = ev.time;
+        if (sim_evput(&ev) < 0) goto error;
+    }
+    if (fp != stdin)    fclose(fp);
+    return 0;
+
+error:
+    if (fp != stdin)    fclose(fp);
+    return -1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_loadrecord: load vehicle signal record
+ *          (<time(ms)> <property> <value>, made by ico_syc_apc_regulation_record)
+ *
+ * @param[in]   file            record file name
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_loadrecord(const char *file)
+{
+    FILE    *fp;
+    char    line[SIM_LINE_MAX];
+    char    w[3][SIM_LINE_MAX];
+    int     lineno = 0;
+    sim_event_t ev;
+
+    fp = fopen(file, "r");
+    if (! fp)   {
+        fprintf(stderr, "sim_apc: can not open %s\n", file);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), fp))   {
+        lineno ++;
+        if ((line[0] == '#') ||
+            (sscanf(line, "%255s %255s %255s", w[0], w[1], w[2]) != 3)) {
+            continue;
+        }
+        if (strlen(w[1]) >= sizeof(ev.property))    {
+            fprintf(stderr, "sim_apc: %s(%d) illegal property\n", file, lineno);
+            fclose(fp);
+            return -1;
+        }
+        memset(&ev, 0, sizeof(ev));
+        ev.time = strtod(w[0], (char **)0);
+        ev.type = SIM_EV_VEHICLE;
+        ev.vehicle = strtod(w[2], (char **)0);
+        strcpy(ev.property, w[1]);
+        if (ev.time > lastevent)    lastevent = ev.time;
+        if (sim_evput(&ev) < 0) {
+            fclose(fp);
+            return -1;
+        }
+    }
+    fclose(fp);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_regulation: count regulation transitions(change set listener)
+ *
+ * @param[in]   change          changed categorys and new controls
+ * @param[in]   user_data       user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_regulation(const ico_apc_regulation_change_t *change, void *user_data)
+{
+    int     category;
+
+    for (category = 0; category < ICO_UXF_CATEGORY_MAX; category++) {
+        if ((change->changed & ICO_SYC_APC_CATEGORY_BIT(category)) == 0)    continue;
+        if (change->control[category].display != ICO_SYC_APC_REGULATION_NOCHANGE)
+            regdisplay ++;
+        if (change->control[category].sound != ICO_SYC_APC_REGULATION_NOCHANGE)
+            regsound ++;
+        if (change->control[category].input != ICO_SYC_APC_REGULATION_NOCHANGE)
+            reginput ++;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_generate: generate random load(same seed makes same load)
+ *
+ * @param[in]   apps            number of applications
+ * @param[in]   num             number of events
+ * @param[in]   seed            random seed
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_generate(const int apps, const int num, const unsigned int seed)
+{
+    Ico_Uxf_conf_display    *display;
+    Ico_Uxf_conf_sound      *sound;
+    sim_event_t ev;
+    char    appid[64];
+    double  time = 0.0;
+    int     i, r;
+
+    srand(seed);
+    display = &confsys->display[confsys->misc.default_displayId];
+    sound = &confsys->sound[confsys->misc.default_soundId];
+    for (i = 0; i < apps; i++)  {
+        snprintf(appid, sizeof(appid), "org.tizen.ico.sim%d", i);
+        if (sim_addapp(appid, confsys->category[i % confsys->categoryNum].name,
+                       display->zone[rand() % display->zoneNum].name,
+                       sound->zone[rand() % sound->zoneNum].name,
+                       ((rand() % 16) == 0) ? -1 : 5 + (rand() % 60)) < 0)  {
+            return -1;
+        }
+    }
+
+    for (i = 0; i < num; i++)   {
+        memset(&ev, 0, sizeof(ev));
+        time += rand() % 50;
+        ev.time = time;
+        ev.app = rand() % napps;
+        ev.id = rand() % 4;
+        r = rand() % 100;
+        if (r < 40) {
+            ev.type = SIM_EV_GET;
+            ev.resid = ICO_APF_RESID_BASIC_SCREEN;
+        }
+        else if (r < 55)    {
+            ev.type = SIM_EV_GET;
+            ev.resid = ICO_APF_RESID_BASIC_SOUND;
+        }
+        else if (r < 75)    {
+            ev.type = SIM_EV_REL;
+            ev.resid = ICO_APF_RESID_BASIC_SCREEN;
+        }
+        else if (r < 85)    {
+            ev.type = SIM_EV_REL;
+            ev.resid = ICO_APF_RESID_BASIC_SOUND;
+        }
+        else if (r < 90)    {
+            ev.type = SIM_EV_ACTIVE;
+        }
+        else if (r < 94)    {
+            ev.type = SIM_EV_SPEED;
+            ev.value = (rand() % 3) * 30;
+        }
+        else if (r < 97)    {
+            ev.type = SIM_EV_SHIFT;
+            ev.value = sim_shift(((rand() % 4) == 0) ? "reverse" : "drive");
+        }
+        else    {
+            ev.type = SIM_EV_BLINKER;
+            ev.value = rand() % 3;
+        }
+        if (sim_evput(&ev) < 0) {
+            return -1;
+        }
+    }
+    lastevent = time;
+    return 0;
+}
+
+/*==============================================================================*/
+/* simulation                                                                   */
+/*==============================================================================*/
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_freeconf: free reloaded system configuration
+ *
+ * @param[in]   conf            system configuration(made by sim_reload)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_freeconf(Ico_Uxf_Sys_Config *conf)
+{
+    int     i;
+
+    for (i = 0; i < conf->displayNum; i++)  {
+        free(conf->display[i].zone);
+    }
+    free(conf->display);
+    free(conf);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_reload: live reload of system configuration without a display
+ *          zone(as system.conf that the zone was deleted, zones after the
+ *          zone are renumbered). previous reloaded configuration is released
+ *          at once, so reference to it is detected by memory checker.
+ *
+ * @param[in]   name            display zone name to remove
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_reload(const char *name)
+{
+    Ico_Uxf_Sys_Config          *oldconf;
+    Ico_Uxf_Sys_Config          *newconf;
+    Ico_Uxf_conf_display        *display;
+    Ico_Uxf_conf_display_zone   *zone;
+    int     zoneidx = 0;
+    int     removed;
+    int     i, j, k, n, m;
+
+    oldconf = (confnow) ? confnow : confsys;
+    newconf = malloc(sizeof(Ico_Uxf_Sys_Config));
+    display = malloc(sizeof(Ico_Uxf_conf_display) * (oldconf->displayNum + 1));
+    if ((! newconf) || (! display)) {
+        fprintf(stderr, "sim_apc: No Memory\n");
+        exit(1);
+    }
+    memcpy(newconf, oldconf, sizeof(Ico_Uxf_Sys_Config));
+    memcpy(display, oldconf->display, sizeof(Ico_Uxf_conf_display) * oldconf->displayNum);
+    newconf->display = display;
+
+    for (i = 0; i < newconf->displayNum; i++)   {
+        zone = malloc(sizeof(Ico_Uxf_conf_display_zone) * (display[i].zoneNum + 1));
+        if (! zone) {
+            fprintf(stderr, "sim_apc: No Memory\n");
+            exit(1);
+        }
+        removed = -1;
+        n = 0;
+        for (j = 0; j < display[i].zoneNum; j++)    {
+            if (strcasecmp(oldconf->display[i].zone[j].name, name) == 0)   {
+                removed = j;
+                continue;
+            }
+            zone[n] = oldconf->display[i].zone[j];
+            zone[n].id = n;
+            zone[n].zoneidx = zoneidx ++;
+            zone[n].display = &display[i];
+            n ++;
+        }
+        /* renumber overlap zones   */
+        for (j = 0; (removed >= 0) && (j < n); j++)  {
+            m = 0;
+            for (k = 0; k < zone[j].overlapNum; k++)    {
+                if (zone[j].overlap[k] == removed)  continue;
+                zone[j].overlap[m ++] =
+                    zone[j].overlap[k] - ((zone[j].overlap[k] > removed) ? 1 : 0);
+            }
+            zone[j].overlapNum = m;
+        }
+        display[i].zone = zone;
+        display[i].zoneNum = n;
+    }
+
+    reloads ++;
+    if ((sysupdate) && ((*sysupdate)(newconf, oldconf) != ICO_UXF_EOK)) {
+        /* AppsController still uses current configuration */
+        reloadfails ++;
+        sim_freeconf(newconf);
+        return;
+    }
+    if (verbose)    {
+        printf("%9.1f reload without %s\n", sim_now * 1000.0, name);
+    }
+    if (confnow)    {
+        sim_freeconf(confnow);
+    }
+    confnow = newconf;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_request: send request of simulated application to AppsController
+ *
+ * @param[in]   ev              event
+ * @param[in]   state           command or reply
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_request(const sim_event_t *ev, const int state)
+{
+    ico_apf_resource_notify_info_t  info;
+    Ico_Uxf_conf_application        *conf = &confapp.application[ev->app];
+
+    memset(&info, 0, sizeof(info));
+    info.resid = ev->resid;
+    info.id = ev->id;
+    info.bid = 0;
+    info.pid = 1000 + ev->app;
+    strncpy(info.appid, conf->appid, ICO_UXF_MAX_PROCESS_NAME);
+    info.state = state;
+    if (ev->device[0])  {
+        strcpy(info.device, ev->device);
+    }
+    else if ((ev->resid == ICO_APF_RESID_BASIC_SOUND) ||
+             (ev->resid == ICO_APF_RESID_INT_SOUND))    {
+        strncpy(info.device,
+                confsys->sound[conf->sound[0].soundId].zone[conf->sound[0].zoneId].name,
+                ICO_UXF_MAX_DEVICE_NAME);
+    }
+    else    {
+        strncpy(info.device,
+                confsys->display[conf->display[0].displayId]
+                    .zone[conf->display[0].zoneId].name,
+                ICO_UXF_MAX_DEVICE_NAME);
+    }
+    if (resource_cb)    {
+        (*resource_cb)(&info, resource_cb_data);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_dispatch: dispatch event
+ *
+ * @param[in]   ev              event
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_dispatch(const sim_event_t *ev)
+{
+    sim_app_t   *app = &simapp[ev->app];
+    int     i;
+
+    if (ev->type == SIM_EV_VEHICLE) {
+        if (ico_syc_apc_regulation_inject(ev->property, ev->vehicle) == ICO_SYC_EOK) {
+            vehicles ++;
+        }
+        else if (verbose)   {
+            printf("sim_apc: %.0f unknown vehicle property(%s)\n", ev->time, ev->property);
+        }
+        return;
+    }
+
+    switch (ev->type)   {
+    case SIM_EV_GET:
+        for (i = 0; i < app->npending; i++) {
+            if ((app->pending[i].resid == ev->resid) && (app->pending[i].id == ev->id))
+                break;
+        }
+        if ((i >= app->npending) && (app->npending < SIM_PENDING_MAX))  {
+            app->pending[app->npending].time = ev->time;
+            app->pending[app->npending].resid = ev->resid;
+            app->pending[app->npending].id = ev->id;
+            app->npending ++;
+        }
+        sim_request(ev, ICO_APF_RESOURCE_COMMAND_GET);
+        break;
+    case SIM_EV_REL:
+        for (i = 0; i < app->npending; i++) {
+            if ((app->pending[i].resid == ev->resid) && (app->pending[i].id == ev->id)) {
+                app->pending[i] = app->pending[--app->npending];
+                break;
+            }
+        }
+        sim_request(ev, ICO_APF_RESOURCE_COMMAND_RELEASE);
+        break;
+    case SIM_EV_ACK:
+    case SIM_EV_NAK:
+        replies ++;
+        sim_request(ev, (ev->type == SIM_EV_ACK) ? ICO_APF_RESOURCE_REPLY_OK
+                                                 : ICO_APF_RESOURCE_REPLY_NG);
+        break;
+    case SIM_EV_SPEED:
+        if (vehicle_speed != ev->value) {
+            vehicle_speed = ev->value;
+            amb_changed("VehicleSpeed");
+        }
+        break;
+    case SIM_EV_SHIFT:
+        if (vehicle_shift != ev->value) {
+            vehicle_shift = ev->value;
+            amb_changed("ShiftPosition");
+        }
+        break;
+    case SIM_EV_BLINKER:
+        if (vehicle_blinker != ev->value)   {
+            i = vehicle_blinker;
+            vehicle_blinker = ev->value;
+            if ((i == ICO_SYC_APC_REGULATION_BLINKER_LEFT) ||
+                (ev->value == ICO_SYC_APC_REGULATION_BLINKER_LEFT)) {
+                amb_changed("LeftTurn");
+            }
+            if ((i == ICO_SYC_APC_REGULATION_BLINKER_RIGHT) ||
+                (ev->value == ICO_SYC_APC_REGULATION_BLINKER_RIGHT))    {
+                amb_changed("RightTurn");
+            }
+        }
+        break;
+    case SIM_EV_ACTIVE:
+        activeapp = confapp.application[ev->app].appid;
+        ico_syc_apc_active(activeapp);
+        break;
+    case SIM_EV_EXIT:
+        app->npending = 0;
+        sim_request(ev, ICO_APF_RESOURCE_STATE_DISCONNECTED);
+        break;
+    case SIM_EV_WINDOW:
+        if (windowhook) {
+            (*windowhook)(confapp.application[ev->app].appid, 0x10000 + ev->app,
+                          ICO_UXF_HOOK_WINDOW_CREATE_MAIN);
+        }
+        break;
+    case SIM_EV_PRELAUNCH:
+        (void) ico_syc_apc_prelaunch(confapp.application[ev->app].appid, ev->value);
+        break;
+    case SIM_EV_RELOAD:
+        sim_reload(ev->device);
+        break;
+    default:
+        break;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_run: run simulation until all events are processed
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_run(void)
+{
+    sim_event_t ev;
+    sim_timer_t *timer;
+    double  endtime;
+    double  start;
+    long    mem;
+
+    while (1)   {
+        timer = sim_nexttimer();
+        endtime = (lastevent + SIM_DRAIN_MS) / 1000.0;
+
+        start = sim_cputime();
+        if ((nevents > 0) &&
+            ((! timer) || (events[0].time / 1000.0 <= timer->deadline)))  {
+            sim_evget(&ev);
+            if (ev.time / 1000.0 > sim_now) sim_now = ev.time / 1000.0;
+            sim_dispatch(&ev);
+        }
+        else if ((timer) && (timer->deadline <= endtime))   {
+            if (timer->deadline > sim_now)  sim_now = timer->deadline;
+            sim_firetimer(timer);
+        }
+        else    {
+            break;
+        }
+        /* main loop goes to idle   */
+        sim_idle();
+        sim_sample(&cpu, sim_cputime() - start);
+
+        mem = sim_heapuse();
+        if (mem > mem_peak) mem_peak = mem;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_cmpdouble: compare samples for sort(static function)
+ *
+ * @param[in]   a               sample 1
+ * @param[in]   b               sample 2
+ * @return      result of compare
+ */
+/*--------------------------------------------------------------------------*/
+static int
+sim_cmpdouble(const void *a, const void *b)
+{
+    double  da = *((const double *)a);
+    double  db = *((const double *)b);
+
+    return (da < db) ? -1 : ((da > db) ? 1 : 0);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sim_print: print percentiles of samples
+ *
+ * @param[in]   title           title of samples
+ * @param[in]   unit            unit of samples
+ * @param[in]   samples         samples(sorted by this function)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+sim_print(const char *title, const char *unit, sim_samples_t *samples)
+{
+    int     n = samples->num;
+
+    if (n <= 0) {
+        printf("%-7s: no data\n", title);
+        return;
+    }
+    qsort(samples->val, n, sizeof(double), sim_cmpdouble);
+    printf("%-7s: count=%d p50=%.1f p90=%.1f p99=%.1f max=%.1f %s\n", title, n,
+           samples->val[(n * 50 - 1) / 100], samples->val[(n * 90 - 1) / 100],
+           samples->val[(n * 99 - 1) / 100], samples->val[n - 1], unit);
+}
+
+int
+main(int argc, char *argv[])
+{
+    ico_apc_batch_stats_t   batch;
+    ico_apc_reply_stats_t   reply;
+    ico_apc_soundctl_stats_t    soundctl;
+    ico_apc_regulation_stats_t  rules;
+    ico_apf_resource_notify_info_t  info;
+    const char  *file = NULL;
+    const char  *record = NULL;
+    int     apps = 0;
+    int     num = 10000;
+    int     seed = 1;
+    int     batchmode = 1;
+    int     timeouts = 0;
+    int     mismatch;
+    double  duration;
+    int     i;
+
+    for (i = 1; i < argc; i++)  {
+        if ((strcmp(argv[i], "-f") == 0) && (i + 1 < argc)) {
+            file = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc))    {
+            apps = strtol(argv[++i], (char **)0, 0);
+        }
+        else if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))    {
+            num = strtol(argv[++i], (char **)0, 0);
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc))    {
+            seed = strtol(argv[++i], (char **)0, 0);
+        }
+        else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc))    {
+            batchmode = strtol(argv[++i], (char **)0, 0);
+        }
+        else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc))    {
+            record = argv[++i];
+        }
+        else if (strcmp(argv[i], "-p") == 0)    {
+            amb_nomatch = 1;
+        }
+        else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc))    {
+            soundfail = strtol(argv[++i], (char **)0, 0);
+        }
+        else if (strcmp(argv[i], "-v") == 0)    {
+            verbose = 1;
+        }
+        else    {
+            file = NULL;
+            record = NULL;
+            apps = 0;
+            break;
+        }
+    }
+    if (((! file) && (! record) && (apps <= 0)) || (apps > SIM_APPS_MAX)) {
+        fprintf(stderr, "usage: %s [-f trace] [-g apps] [-n events] [-s seed] "
+                "[-b 0|1] [-r record] [-p] [-m count] [-v]\n", argv[0]);
+        exit(1);
+    }
+
+    /* log output is not measured   */
+    setenv("ICO_IVI_NO_LOG", "1", 1);
+    ico_uxf_log_setlevel(0);
+
+    /* system configuration(system.conf of UIFW_CONFDIR)    */
+    confsys = (Ico_Uxf_Sys_Config *)ico_uxf_getSysConfig();
+    if (! confsys)  {
+        fprintf(stderr, "%s: can not read system configuration\n", argv[0]);
+        exit(1);
+    }
+    memset(&confapp, 0, sizeof(confapp));
+    confapp.application = malloc(sizeof(Ico_Uxf_conf_application) * SIM_APPS_MAX);
+    if (! confapp.application)  {
+        fprintf(stderr, "%s: No Memory\n", argv[0]);
+        exit(1);
+    }
+
+    /* simulated applications and events    */
+    if (((file) && (sim_load(file) < 0)) ||
+        ((apps > 0) && (sim_generate(apps, num, seed) < 0)) ||
+        ((record) && (sim_loadrecord(record) < 0)))  {
+        exit(1);
+    }
+    if ((napps <= 0) && (! record)) {
+        fprintf(stderr, "%s: no application\n", argv[0]);
+        exit(1);
+    }
+    for (i = 0; i < napps; i++) {
+        simapp[i].visible = 0;
+        simapp[i].sound = 0;
+    }
+    /* samples are allocated before measurement of heap use */
+    grant.size = nevents + 1024;
+    grant.val = malloc(sizeof(double) * grant.size);
+    cpu.size = nevents * 4 + 1024;
+    cpu.val = malloc(sizeof(double) * cpu.size);
+    if ((! grant.val) || (! cpu.val))   {
+        fprintf(stderr, "%s: No Memory\n", argv[0]);
+        exit(1);
+    }
+    mem_base = sim_heapuse();
+
+    if (ico_syc_apc_init(sim_displaycontrol, sim_soundcontrol, sim_inputcontrol)
+            != ICO_SYC_EOK) {
+        fprintf(stderr, "%s: ico_syc_apc_init Error\n", argv[0]);
+        exit(1);
+    }
+    ico_syc_apc_batch(batchmode);
+    ico_syc_apc_regulation_set_listener(sim_regulation, ICO_SYC_APC_CATEGORY_ALL, NULL);
+    /* Multi Sound Manager replies to stream list request(no stream)    */
+    memset(&info, 0, sizeof(info));
+    info.state = (ico_apf_resource_state_e)ICO_APF_SOUND_REPLY_LIST;
+    if (resource_cb)    {
+        (*resource_cb)(&info, resource_cb_data);
+    }
+    /* current controls at set are not transitions  */
+    regdisplay = 0;
+    regsound = 0;
+    reginput = 0;
+    mem_peak = sim_heapuse();
+
+    sim_run();
+
+    /* result               */
+    duration = lastevent / 1000.0;
+    if (duration <= 0.0)    duration = 1.0;
+    for (i = 0; i < napps; i++) {
+        if (ico_syc_apc_reply_stats(confapp.application[i].appid, &reply) == ICO_SYC_EOK) {
+            timeouts += reply.timeouts;
+        }
+    }
+    ico_syc_apc_batch_stats(&batch);
+    ico_syc_apc_soundctl_stats(&soundctl);
+    ico_syc_apc_regulation_stats(&rules);
+
+    printf("sim_apc: apps=%d time=%.1f s batch=%d\n", napps, duration, batchmode);
+    sim_print("grant", "ms", &grant);
+    sim_print("cpu", "us", &cpu);
+    printf("flips  : display=%d(%.2f/s) sound=%d(%.2f/s)\n",
+           dispflips, dispflips / duration, soundflips, soundflips / duration);
+    printf("control: window=%d sound=%d replies=%d timeouts=%d\n",
+           windowctls, soundcmds, replies, timeouts);
+    printf("batch  : requests=%d recalcs=%d flips=%d avoided=%d\n",
+           batch.requests, batch.recalcs, batch.flips, batch.avoided);
+    printf("sound  : staged=%d cancelled=%d sent=%d bulk=%d\n",
+           soundctl.staged, soundctl.cancelled, soundctl.sent, soundctl.bulk);
+    if (soundfail > 0)  {
+        /* muted streams of applications that are not muted by HomeScreen    */
+        for (i = 0, mismatch = 0; i < napps; i++)   {
+            if ((simapp[i].mute >= 0) &&
+                (simapp[i].mute != (simapp[i].sound ? 0 : 1)))  mismatch ++;
+        }
+        printf("msm    : failed=%d mismatch=%d\n", soundfails, mismatch);
+    }
+    printf("amb    : %s requests=%d signals=%d\n", amb_nomatch ? "polling" : "signal",
+           amb_gets, amb_signals);
+    printf("rules  : evals=%d predicates=%d categories=%d changes=%d suppressed=%d "
+           "notifies=%d cpu=%d us\n", rules.evals, rules.predicates, rules.categories,
+           rules.changes, rules.suppressed, rules.notifies, rules.cputime);
+    printf("regulation: vehicle=%d display=%d sound=%d input=%d\n",
+           vehicles, regdisplay, regsound, reginput);
+    printf("memory : base=%ld peak=%ld(+%ld) bytes\n",
+           mem_base, mem_peak, mem_peak - mem_base);
+    if (reloads > 0)    {
+        printf("reload : count=%d failed=%d\n", reloads, reloadfails);
+    }
+
+    ico_syc_apc_term();
+    if (confnow)    {
+        sim_freeconf(confnow);
+    }
+    free(grant.val);
+    free(cpu.val);
+    free(events);
+    exit(0);
+}
@@ -1257,9 +1257,9 @@ ico_apf_callback_websock(struct libwebsocket_context * this,
                     if (i < nparam) {
                         pid = strtol(&msg[param[i].start], (char **)0, 0);
                         if (ico_apf_get_app_id(pid, appid) != ICO_APP_CTL_E_NONE)   {
-                            lws_callbacked --;
+                            /* AppsController tracks streams of unknown process */
                             apfw_trace("ico_apf_callback_websock: Unknown pid=%d", pid);
-                            return 0;
+                            appid[0] = 0;
                         }
                     }
                 }
@@ -8,19 +8,28 @@
  */
 /**
  * @brief   Application Framework debug log function
+ *          (log messages are stored to a ring buffer of each thread without
+ *           lock, and formatted and written by the writer thread, or written
+ *           to the binary trace file without format in binary mode)
  *
  * @date    Feb-28-2013
  */
 
 #include    <stdio.h>
+#include    <stdio_ext.h>
 #include    <stdlib.h>
 #include    <stdarg.h>
 #include    <unistd.h>
 #include    <string.h>
+#include    <signal.h>
+#include    <pthread.h>
 #include    <sys/time.h>
 #include    <sys/types.h>
+#include    <fcntl.h>
 #include    <time.h>
+#include    <stdint.h>
 #include    "ico_apf_log.h"
+#include    "ico_apf_trace.h"
 #include    "ico_apf_apimacro.h"
 
 /* variabe & table                          */
@@ -41,6 +50,107 @@ static int      sTimeZone = (99*60*60);
 /* output lines                             */
 static int      sDbgLines = 0;
 
+/* output to log file(=1) or stdout(=0)     */
+static int      sDbgFile = 0;
+
+/* binary trace file                        */
+static int          sTrcMode = 0;       /* binary trace(=1) or text log(=0)         */
+static FILE         *sTrcFd = (FILE *)0;
+static int          sTrcBytes = 0;      /* output bytes                             */
+static unsigned int sTrcGen = 0;        /* generation of trace file                 */
+static unsigned int sTrcSiteId = 0;     /* last call site id                        */
+
+/* exclusive control of log file            */
+static pthread_mutex_t  sDbgMutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/* type of argument of log message          */
+#define ICO_APF_LOG_ARG_NONE    0       /* no argument(unknown conversion)          */
+#define ICO_APF_LOG_ARG_PERCENT 1       /* '%%', no argument                        */
+#define ICO_APF_LOG_ARG_INT     2       /* int(char, short)                         */
+#define ICO_APF_LOG_ARG_LONG    3       /* long(size_t, ptrdiff_t)                  */
+#define ICO_APF_LOG_ARG_LLONG   4       /* long long(intmax_t)                      */
+#define ICO_APF_LOG_ARG_DOUBLE  5       /* double(float)                            */
+#define ICO_APF_LOG_ARG_LDOUBLE 6       /* long double                              */
+#define ICO_APF_LOG_ARG_PTR     7       /* pointer                                  */
+#define ICO_APF_LOG_ARG_STR     8       /* string(copied to string area)            */
+
+#define ICO_APF_LOG_SPECSIZE    32      /* maximum length of a conversion spec      */
+
+/* raw argument of log message(8 bytes, same as binary trace file)   */
+typedef union _ico_apf_log_arg  {
+    long long   ival;                   /* integer, pointer or offset of string area*/
+    double      dval;                   /* floating point                           */
+}   ico_apf_log_arg_t;
+
+/* log message(not formatted)               */
+typedef struct _ico_apf_log_entry   {
+    ico_apf_log_site_t  *site;          /* call site(NULL: no call site)            */
+    const char          *level;         /* log level string(static)                 */
+    const char          *fmt;           /* message format(static)                   */
+    int64_t             time;           /* output time(monotonic, nsec)             */
+    int                 nargs;          /* number of arguments                      */
+    int                 strsize;        /* used size of string area                 */
+    ico_apf_log_arg_t   arg[ICO_APF_LOG_MAXARGS];
+    char                str[ICO_APF_LOG_STRSIZE];
+}   ico_apf_log_entry_t;
+
+/* ring buffer of a thread(single producer and single consumer) */
+typedef struct _ico_apf_log_ring    {
+    struct _ico_apf_log_ring    *next;  /* next ring buffer                         */
+    int                 inuse;          /* owned by a thread(=1) or free(=0)        */
+    unsigned int        head;           /* next write position(updated by owner)    */
+    unsigned int        dropped;        /* dropped messages(updated by owner)       */
+    unsigned int        tail __attribute__((aligned(64)));
+                                        /* next read position(updated by writer)    */
+    unsigned int        reported;       /* reported dropped messages                */
+    ico_apf_log_entry_t entry[ICO_APF_LOG_RINGSIZE];
+}   ico_apf_log_ring_t;
+
+/* ring buffer of current thread            */
+static __thread ico_apf_log_ring_t  *sLogRing = NULL;
+
+/* all ring buffers                         */
+static ico_apf_log_ring_t   *sLogRings = NULL;
+
+/* writer thread                            */
+static int              sLogStarted = 0;
+static int              sLogInitialized = 0;
+static pthread_key_t    sLogKey;
+static pthread_mutex_t  sLogWakeMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   sLogWakeCond = PTHREAD_COND_INITIALIZER;
+
+/* dropped messages of all threads          */
+static unsigned int     sLogDropped = 0;
+static const char       sLogDropFmt[] = "%u log messages dropped(total %u)\n";
+
+/* static functions                         */
+static void ico_apf_log_openfile(const char *prog);
+static void ico_apf_log_closefile(void);
+static void ico_apf_log_prepare(void);
+static int ico_apf_log_timezone(void);
+static int ico_apf_log_timestr(char *buf, const int size, const time_t sec,
+                               const int msec, const char *level,
+                               const int pid, const int tz);
+static const char *ico_apf_log_spec(const char *fmt, char *spec,
+                                    int *type, int *stars);
+static void ico_apf_log_vstore(ico_apf_log_site_t *site, const char *level,
+                               const char *fmt, va_list list);
+static void ico_apf_log_text(const ico_apf_log_entry_t *entry,
+                             const int64_t basetime);
+static void ico_apf_log_trcopen(void);
+static void ico_apf_log_trcclose(void);
+static void ico_apf_log_trcput(const int type, const unsigned int id,
+                               const int64_t time, const void *data,
+                               const int size);
+static int ico_apf_log_trcwrite(const ico_apf_log_entry_t *entry,
+                                const int64_t basetime);
+static void ico_apf_log_drain(void);
+static void *ico_apf_log_writer(void *arg);
+static ico_apf_log_ring_t *ico_apf_log_attach(void);
+static void ico_apf_log_detach(void *arg);
+static void ico_apf_log_atfork(void);
+static void ico_apf_log_atexit(void);
+
 
 /*--------------------------------------------------------------------------*/
 /**
@@ -56,20 +166,8 @@ ico_apf_log_print(const char *fmt, ...)
 {
     va_list     list;
 
-    if (! sDbgFd)   {
-        ico_apf_log_open(NULL);
-    }
-#if ICO_APF_LOG_STDOUT == 0
-    else if (sDbgLines >= (ICO_APF_LOG_MAXLINES-2)) {
-        if (sDbgLines >= ICO_APF_LOG_MAXLINES)  {
-            ico_apf_log_close();
-            ico_apf_log_open(sDbgProg);
-        }
-        else    {
-            fflush(sDbgFd);
-        }
-    }
-#endif /*ICO_APF_LOG_STDOUT*/
+    pthread_mutex_lock(&sDbgMutex);
+    ico_apf_log_prepare();
     if (sDbgFd) {
         va_start(list, fmt);
         vfprintf(sDbgFd, fmt, list);
@@ -78,9 +176,54 @@ ico_apf_log_print(const char *fmt, ...)
             fflush(sDbgFd);
         }
     }
-    if (sDbgFd != stdout)   {
+    if (sDbgFile)   {
         sDbgLines ++;
     }
+    pthread_mutex_unlock(&sDbgMutex);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_async: store log message to the ring buffer of
+ *                             current thread(format and arguments only,
+ *                             the message is formatted by writer thread)
+ *
+ * @param[in]   level   log level string(header of log message, static)
+ * @param[in]   fmt     message format(same as printf, static)
+ * @param[in]   ...     arguments if need
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API void
+ico_apf_log_async(const char *level, const char *fmt, ...)
+{
+    va_list     list;
+
+    va_start(list, fmt);
+    ico_apf_log_vstore(NULL, level, fmt, list);
+    va_end(list);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_trace: store log message of the call site to the
+ *                             ring buffer of current thread(used by log
+ *                             macros, function and source line are not
+ *                             copied, they are in call site)
+ *
+ * @param[in]   site    call site(static)
+ * @param[in]   ...     arguments if need
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API void
+ico_apf_log_trace(ico_apf_log_site_t *site, ...)
+{
+    va_list     list;
+
+    va_start(list, site);
+    ico_apf_log_vstore(site, site->level, site->fmt, list);
+    va_end(list);
 }
 
 /*--------------------------------------------------------------------------*/
@@ -93,17 +236,420 @@ ico_apf_log_print(const char *fmt, ...)
 /*--------------------------------------------------------------------------*/
 ICO_APF_API void
 ico_apf_log_open(const char *prog)
+{
+    pthread_mutex_lock(&sDbgMutex);
+    /* trace file of new program name is opened at next output  */
+    ico_apf_log_trcclose();
+    ico_apf_log_openfile(prog);
+    pthread_mutex_unlock(&sDbgMutex);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_close: close log file
+ *
+ * @param       nothing
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API void
+ico_apf_log_close(void)
+{
+    /* output log messages in ring buffers to current log file  */
+    ico_apf_log_drain();
+
+    pthread_mutex_lock(&sDbgMutex);
+    ico_apf_log_trcclose();
+    ico_apf_log_closefile();
+    pthread_mutex_unlock(&sDbgMutex);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_flush: flush log file
+ *
+ * @param       nothing
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API void
+ico_apf_log_flush(void)
+{
+    ico_apf_log_drain();
+
+    pthread_mutex_lock(&sDbgMutex);
+    if ((sDbgFd != NULL) && (ico_apf_log_flushmode == 0))   {
+        fflush(sDbgFd);
+    }
+    if ((sTrcFd != NULL) && (ico_apf_log_flushmode == 0))   {
+        fflush(sTrcFd);
+    }
+    pthread_mutex_unlock(&sDbgMutex);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_curtime: create current time string
+ *
+ * @param[in]   level   log level string(header of log message)
+ * @return      current time string
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API char *
+ico_apf_log_curtime(const char *level)
+{
+    struct timeval  NowTime;
+    static char     sBuf[28];
+
+    gettimeofday(&NowTime, (struct timezone *)0);
+    ico_apf_log_timestr(sBuf, sizeof(sBuf), NowTime.tv_sec,
+                        (int)NowTime.tv_usec/1000, level,
+                        getpid(), ico_apf_log_timezone());
+
+    return sBuf;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_setlevel: set log output level
+ *
+ * @param[in]   loglevel    log output level
+ *                          (with ICO_APF_LOG_FLUSH/NOFLUSH, ICO_APF_LOG_BINARY/TEXT)
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API void
+ico_apf_log_setlevel(const int loglevel)
+{
+    ico_apf_log_level = loglevel & (~(ICO_APF_LOG_FLUSH|ICO_APF_LOG_NOFLUSH|
+                                      ICO_APF_LOG_BINARY|ICO_APF_LOG_TEXT));
+
+    if (loglevel & (ICO_APF_LOG_FLUSH|ICO_APF_LOG_NOFLUSH))    {
+        if (loglevel & ICO_APF_LOG_FLUSH)  {
+            ico_apf_log_flushmode = 1;
+        }
+        else    {
+            ico_apf_log_flushmode = 0;
+        }
+    }
+    if (loglevel & (ICO_APF_LOG_BINARY|ICO_APF_LOG_TEXT))  {
+        /* binary trace is written by writer thread, the mode is changed
+           at next output of writer thread                              */
+        if (loglevel & ICO_APF_LOG_BINARY)  {
+            sTrcMode = 1;
+        }
+        else    {
+            sTrcMode = 0;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_dropped: number of log messages dropped by
+ *                               overflow of ring buffers
+ *
+ * @param       nothing
+ * @return      number of dropped log messages
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API unsigned int
+ico_apf_log_dropped(void)
+{
+    return __atomic_load_n(&sLogDropped, __ATOMIC_RELAXED);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_trace_format: format a log message from raw arguments
+ *                                (common with text log file and decoder of
+ *                                 binary trace file)
+ *
+ * @param[out]  buf     formatted log message(with time header and new line)
+ * @param[in]   size    size of buf
+ * @param[in]   info    log message
+ * @return      length of formatted log message
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API int
+ico_apf_trace_format(char *buf, const int size, const ico_apf_trace_info_t *info)
+{
+    const ico_apf_log_arg_t *arg = (const ico_apf_log_arg_t *)info->arg;
+    const char  *p;
+    const char  *str;
+    char        spec[ICO_APF_LOG_SPECSIZE];
+    int         type;
+    int         stars;
+    int         idx = 0;
+    int         len;
+    int         n;
+    int         w0, w1;
+
+    len = ico_apf_log_timestr(buf, size, (time_t)(info->time / 1000000000LL),
+                              (int)((info->time % 1000000000LL) / 1000000),
+                              info->level, info->pid, info->timezone);
+    if (len < (size - 2))   {
+        buf[len++] = '>';
+        buf[len++] = ' ';
+    }
+
+#define ICO_APF_LOG_FMTARG(val) \
+    ((stars == 0) ? snprintf(&buf[len], size - len, spec, val) : \
+     ((stars == 1) ? snprintf(&buf[len], size - len, spec, w0, val) : \
+      snprintf(&buf[len], size - len, spec, w0, w1, val)))
+
+    for (p = info->fmt; (*p != 0) && (len < (size - 1)); )    {
+        if (*p != '%')  {
+            buf[len++] = *p++;
+            continue;
+        }
+        p = ico_apf_log_spec(p, spec, &type, &stars);
+        if (type == ICO_APF_LOG_ARG_PERCENT)    {
+            buf[len++] = '%';
+            continue;
+        }
+        if (type == ICO_APF_LOG_ARG_NONE)   {
+            /* unknown conversion, output conversion spec as it is  */
+            len += snprintf(&buf[len], size - len, "%s", spec);
+            continue;
+        }
+        if ((stars > 2) || ((idx + stars) >= info->nargs))  {
+            /* not stored argument, output conversion spec as it is */
+            len += snprintf(&buf[len], size - len, "%s", spec);
+            idx += stars + 1;
+            continue;
+        }
+        w0 = (stars > 0) ? (int)arg[idx].ival : 0;
+        w1 = (stars > 1) ? (int)arg[idx+1].ival : 0;
+        idx += stars;
+        if ((type == ICO_APF_LOG_ARG_LONG) && (info->longsize < (int)sizeof(long)))   {
+            /* long of 32 bits writer, remove length modifier   */
+            memmove(&spec[strlen(spec)-2], &spec[strlen(spec)-1], 2);
+            type = ICO_APF_LOG_ARG_INT;
+        }
+        switch (type)   {
+        case ICO_APF_LOG_ARG_INT:
+            n = ICO_APF_LOG_FMTARG((int)arg[idx].ival);
+            break;
+        case ICO_APF_LOG_ARG_LONG:
+            n = ICO_APF_LOG_FMTARG((long)arg[idx].ival);
+            break;
+        case ICO_APF_LOG_ARG_LLONG:
+            n = ICO_APF_LOG_FMTARG(arg[idx].ival);
+            break;
+        case ICO_APF_LOG_ARG_DOUBLE:
+            n = ICO_APF_LOG_FMTARG(arg[idx].dval);
+            break;
+        case ICO_APF_LOG_ARG_LDOUBLE:
+            n = ICO_APF_LOG_FMTARG((long double)arg[idx].dval);
+            break;
+        case ICO_APF_LOG_ARG_PTR:
+            n = ICO_APF_LOG_FMTARG((void *)(uintptr_t)arg[idx].ival);
+            break;
+        default:
+            if ((arg[idx].ival >= 0) && (arg[idx].ival < info->strsize))  {
+                str = &info->str[arg[idx].ival];
+            }
+            else    {
+                str = "";
+            }
+            n = ICO_APF_LOG_FMTARG(str);
+            break;
+        }
+        if (n > 0)  {
+            /* width of argument may be larger than the buffer  */
+            len += (n < (size - len)) ? n : (size - len);
+        }
+        idx ++;
+    }
+#undef ICO_APF_LOG_FMTARG
+
+    if ((info->func) && (len < (size - 1)))  {
+        /* call site                    */
+        len += snprintf(&buf[len], size - len, " (%s,%s:%d)\n",
+                        info->func, info->file, info->line);
+    }
+    if (len > (size - 1))   {
+        /* truncated, terminate by new line     */
+        len = size - 1;
+        buf[len-1] = '\n';
+    }
+    buf[len] = 0;
+    return len;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_vstore: store log message to the ring buffer of
+ *                              current thread(static function)
+ *
+ * @param[in]   site    call site(NULL: no call site)
+ * @param[in]   level   log level string(static)
+ * @param[in]   fmt     message format(static)
+ * @param[in]   list    arguments
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_vstore(ico_apf_log_site_t *site, const char *level,
+                   const char *fmt, va_list list)
+{
+    ico_apf_log_ring_t  *ring;
+    ico_apf_log_entry_t *entry;
+    const char          *p;
+    const char          *str;
+    unsigned int        head;
+    unsigned int        tail;
+    int                 type;
+    int                 stars;
+    int                 nargs;
+    int                 strsize;
+    int                 len;
+    struct timespec     NowTime;
+    char                sBuf[28];
+
+    ring = sLogRing;
+    if ((! ring) || (! __atomic_load_n(&sLogStarted, __ATOMIC_RELAXED)))    {
+        ring = ico_apf_log_attach();
+        if (! ring) {
+            /* writer thread not available, output on this thread   */
+            pthread_mutex_lock(&sDbgMutex);
+            ico_apf_log_prepare();
+            if (sDbgFd) {
+                clock_gettime(CLOCK_REALTIME, &NowTime);
+                ico_apf_log_timestr(sBuf, sizeof(sBuf), NowTime.tv_sec,
+                                    (int)(NowTime.tv_nsec / 1000000), level,
+                                    getpid(), ico_apf_log_timezone());
+                fprintf(sDbgFd, "%s> ", sBuf);
+                vfprintf(sDbgFd, fmt, list);
+                if (site)   {
+                    fprintf(sDbgFd, " (%s,%s:%d)\n", site->func, site->file, site->line);
+                }
+                if (ico_apf_log_flushmode)  {
+                    fflush(sDbgFd);
+                }
+            }
+            if (sDbgFile)   {
+                sDbgLines ++;
+            }
+            pthread_mutex_unlock(&sDbgMutex);
+            return;
+        }
+    }
+
+    head = ring->head;
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if ((head - tail) >= ICO_APF_LOG_RINGSIZE)  {
+        /* ring buffer full, drop this message  */
+        __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&sLogDropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    entry = &ring->entry[head & (ICO_APF_LOG_RINGSIZE-1)];
+    clock_gettime(CLOCK_MONOTONIC, &NowTime);
+    entry->time = ((int64_t)NowTime.tv_sec * 1000000000LL) + NowTime.tv_nsec;
+    entry->site = site;
+    entry->level = level;
+    entry->fmt = fmt;
+
+    /* store raw arguments by the conversion of format  */
+    nargs = 0;
+    strsize = 0;
+    for (p = fmt; *p; ) {
+        if (*p != '%')  {
+            p ++;
+            continue;
+        }
+        p = ico_apf_log_spec(p, NULL, &type, &stars);
+        if ((type == ICO_APF_LOG_ARG_NONE) || (type == ICO_APF_LOG_ARG_PERCENT))  {
+            continue;
+        }
+        if ((nargs + stars) >= ICO_APF_LOG_MAXARGS) {
+            break;
+        }
+        for (; stars > 0; stars--)  {
+            entry->arg[nargs++].ival = va_arg(list, int);
+        }
+        switch (type)   {
+        case ICO_APF_LOG_ARG_INT:
+            entry->arg[nargs].ival = va_arg(list, int);
+            break;
+        case ICO_APF_LOG_ARG_LONG:
+            entry->arg[nargs].ival = va_arg(list, long);
+            break;
+        case ICO_APF_LOG_ARG_LLONG:
+            entry->arg[nargs].ival = va_arg(list, long long);
+            break;
+        case ICO_APF_LOG_ARG_DOUBLE:
+            entry->arg[nargs].dval = va_arg(list, double);
+            break;
+        case ICO_APF_LOG_ARG_LDOUBLE:
+            entry->arg[nargs].dval = (double)va_arg(list, long double);
+            break;
+        case ICO_APF_LOG_ARG_PTR:
+            entry->arg[nargs].ival = (long long)(uintptr_t)va_arg(list, void *);
+            break;
+        default:
+            /* string is copied, it may be released after return    */
+            str = va_arg(list, const char *);
+            if (! str)  {
+                str = "(null)";
+            }
+            len = strlen(str);
+            if (len > (ICO_APF_LOG_STRSIZE - 1 - strsize))  {
+                len = ICO_APF_LOG_STRSIZE - 1 - strsize;
+            }
+            if (len < 0)    {
+                len = 0;
+            }
+            entry->arg[nargs].ival = strsize;
+            if (strsize < ICO_APF_LOG_STRSIZE)  {
+                memcpy(&entry->str[strsize], str, len);
+                entry->str[strsize + len] = 0;
+                strsize += len + 1;
+            }
+            else    {
+                entry->arg[nargs].ival = -1;
+            }
+            break;
+        }
+        nargs ++;
+    }
+    entry->nargs = nargs;
+    entry->strsize = strsize;
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+    if ((head - tail) == (ICO_APF_LOG_RINGSIZE/2))  {
+        /* half full, wake up writer thread     */
+        pthread_cond_signal(&sLogWakeCond);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_openfile: open log file(static function)
+ *
+ * @param[in]   prog    program name
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_openfile(const char *prog)
 {
 #if ICO_APF_LOG_STDOUT == 0
     int     idx;
+    int     fd;
     char    sPath[128];
     char    sPath2[128];
 #endif /*ICO_APF_LOG_STDOUT*/
 
     if (sDbgFd) {
         fflush(sDbgFd);
-        if (sDbgFd != stdout)   {
+        if ((sDbgFd != stdout) && ((! sDbgFile) || (! prog) || (*prog == 0)))   {
             fclose(sDbgFd);
+            sDbgFd = (FILE *)0;
         }
     }
 
@@ -111,10 +657,11 @@ ico_apf_log_open(const char *prog)
 
     if ((! prog) || (*prog == 0))   {
         sDbgFd = stdout;
+        sDbgFile = 0;
         sDbgProg[0] = 0;
         return;
     }
-    else    {
+    else if (prog != sDbgProg)  {
         strncpy(sDbgProg, prog, sizeof(sDbgProg)-1);
         sDbgProg[sizeof(sDbgProg)-1] = 0;
     }
@@ -137,11 +684,24 @@ ico_apf_log_open(const char *prog)
         }
         (void) rename(sPath, sPath2);
     }
+    if ((sDbgFd) && (sDbgFile)) {
+        /* change the file under the current stream, so stdout and stderr
+           redirected to the log file are kept valid                    */
+        fd = open(sPath, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+        if (fd >= 0)    {
+            (void) dup2(fd, fileno(sDbgFd));
+            close(fd);
+        }
+        return;
+    }
     sDbgFd = fopen(sPath, "w");
     if (! sDbgFd)   {
         sDbgFd = stdout;
+        sDbgFile = 0;
+        return;
     }
-    else if ((ico_apf_log_initialized == 0) &&
+    sDbgFile = 1;
+    if ((ico_apf_log_initialized == 0) &&
              (sDbgFd != stdout) && (sDbgFd != stderr))  {
         ico_apf_log_initialized = 1;
         fflush(stdout);
@@ -154,14 +714,14 @@ ico_apf_log_open(const char *prog)
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_apf_log_close: close log file
+ * @brief   ico_apf_log_closefile: close log file(static function)
  *
  * @param       nothing
  * @return      nothing
  */
 /*--------------------------------------------------------------------------*/
-ICO_APF_API void
-ico_apf_log_close(void)
+static void
+ico_apf_log_closefile(void)
 {
 #if ICO_APF_LOG_STDOUT == 0
     if (sDbgFd) {
@@ -170,77 +730,706 @@ ico_apf_log_close(void)
             fclose(sDbgFd);
         }
         sDbgFd = (FILE *)0;
+        sDbgFile = 0;
     }
 #endif /*ICO_APF_LOG_STDOUT*/
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_apf_log_flush: flush log file
+ * @brief   ico_apf_log_prepare: open or change log file before output
+ *                               (static function, called with lock)
  *
  * @param       nothing
  * @return      nothing
  */
 /*--------------------------------------------------------------------------*/
-ICO_APF_API void
-ico_apf_log_flush(void)
+static void
+ico_apf_log_prepare(void)
 {
-    if ((sDbgFd != NULL) && (ico_apf_log_flushmode == 0))   {
-        fflush(sDbgFd);
+    if (! sDbgFd)   {
+        ico_apf_log_openfile(NULL);
     }
+#if ICO_APF_LOG_STDOUT == 0
+    else if (sDbgLines >= (ICO_APF_LOG_MAXLINES-2)) {
+        if (sDbgLines >= ICO_APF_LOG_MAXLINES)  {
+            ico_apf_log_openfile(sDbgProg);
+        }
+        else    {
+            fflush(sDbgFd);
+        }
+    }
+#endif /*ICO_APF_LOG_STDOUT*/
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_apf_log_curtime: create current time string
+ * @brief   ico_apf_log_timezone: local time difference(static function)
  *
- * @param[in]   level   log level string(header of log message)
- * @return      current time string
+ * @param       nothing
+ * @return      local time difference(sec)
  */
 /*--------------------------------------------------------------------------*/
-ICO_APF_API char *
-ico_apf_log_curtime(const char *level)
+static int
+ico_apf_log_timezone(void)
 {
-    struct timeval  NowTime;
     extern long     timezone;
-    static char     sBuf[28];
 
-    gettimeofday(&NowTime, (struct timezone *)0);
     if (sTimeZone > (24*60*60)) {
         tzset();
         sTimeZone = timezone;
     }
-    NowTime.tv_sec -= sTimeZone;
+    return sTimeZone;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_timestr: create time string(static function)
+ *
+ * @param[out]  buf     time string
+ * @param[in]   size    size of buf
+ * @param[in]   sec     time(seconds since the Epoch)
+ * @param[in]   msec    time(milli seconds)
+ * @param[in]   level   log level string(header of log message)
+ * @param[in]   pid     process id
+ * @param[in]   tz      local time difference(sec)
+ * @return      length of time string
+ */
+/*--------------------------------------------------------------------------*/
+static int
+ico_apf_log_timestr(char *buf, const int size, const time_t sec,
+                    const int msec, const char *level,
+                    const int pid, const int tz)
+{
+    time_t          lsec;
 
-    sprintf(sBuf, "%02d:%02d:%02d.%03d[%s]@%d",
-            (int)((NowTime.tv_sec/3600) % 24),
-            (int)((NowTime.tv_sec/60) % 60),
-            (int)(NowTime.tv_sec % 60),
-            (int)NowTime.tv_usec/1000, level, getpid());
+    lsec = sec - tz;
 
-    return sBuf;
+    return snprintf(buf, size, "%02d:%02d:%02d.%03d[%s]@%d",
+                    (int)((lsec/3600) % 24), (int)((lsec/60) % 60),
+                    (int)(lsec % 60), msec, level, pid);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_apf_log_setlevel: set log output level
+ * @brief   ico_apf_log_spec: analyze a conversion spec of format
+ *                            (static function)
  *
- * @param[in]   loglevel    log output level
+ * @param[in]   fmt     conversion spec(top is '%')
+ * @param[out]  spec    copy of conversion spec(if NULL, not copy)
+ * @param[out]  type    type of argument(ICO_APF_LOG_ARG_xxx)
+ * @param[out]  stars   number of '*'(int arguments before the argument)
+ * @return      next of conversion spec
+ */
+/*--------------------------------------------------------------------------*/
+static const char *
+ico_apf_log_spec(const char *fmt, char *spec, int *type, int *stars)
+{
+    const char  *p = fmt + 1;
+    int         lng = 0;
+    int         len;
+
+    *type = ICO_APF_LOG_ARG_NONE;
+    *stars = 0;
+
+    if (*p == '%')  {
+        *type = ICO_APF_LOG_ARG_PERCENT;
+        p ++;
+    }
+    else    {
+        /* flags, width and precision   */
+        while ((*p != 0) && (strchr("-+ #0'I123456789.*", *p) != NULL))  {
+            if (*p == '*')  {
+                (*stars) ++;
+            }
+            p ++;
+        }
+        /* length modifier              */
+        for (; *p != 0; p++)    {
+            if ((*p == 'h') || (*p == 'l')) {
+                lng += (*p == 'l') ? 1 : 0;
+            }
+            else if ((*p == 'q') || (*p == 'j') || (*p == 'L'))  {
+                lng = 2;
+            }
+            else if ((*p == 'z') || (*p == 't'))    {
+                lng = 1;
+            }
+            else    {
+                break;
+            }
+        }
+        /* conversion                   */
+        if (*p != 0)    {
+            if (strchr("diouxXc", *p) != NULL)  {
+                *type = (lng == 0) ? ICO_APF_LOG_ARG_INT :
+                        ((lng == 1) ? ICO_APF_LOG_ARG_LONG : ICO_APF_LOG_ARG_LLONG);
+            }
+            else if (strchr("eEfFgGaA", *p) != NULL)    {
+                *type = (lng >= 2) ? ICO_APF_LOG_ARG_LDOUBLE : ICO_APF_LOG_ARG_DOUBLE;
+            }
+            else if (*p == 'p') {
+                *type = ICO_APF_LOG_ARG_PTR;
+            }
+            else if (*p == 's') {
+                *type = ICO_APF_LOG_ARG_STR;
+            }
+            p ++;
+        }
+    }
+
+    if (spec)   {
+        len = p - fmt;
+        if (len >= ICO_APF_LOG_SPECSIZE)    {
+            len = ICO_APF_LOG_SPECSIZE - 1;
+            *type = ICO_APF_LOG_ARG_NONE;
+        }
+        memcpy(spec, fmt, len);
+        spec[len] = 0;
+    }
+    return p;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_drain: format and write log messages in all ring
+ *                             buffers(static function)
+ *
+ * @param       nothing
  * @return      nothing
  */
 /*--------------------------------------------------------------------------*/
-ICO_APF_API void
-ico_apf_log_setlevel(const int loglevel)
+static void
+ico_apf_log_drain(void)
 {
-    ico_apf_log_level = loglevel & (~(ICO_APF_LOG_FLUSH|ICO_APF_LOG_NOFLUSH));
+    ico_apf_log_ring_t  *ring;
+    ico_apf_log_ring_t  *oldest;
+    ico_apf_log_entry_t *entry;
+    ico_apf_log_entry_t *oldentry;
+    ico_apf_log_entry_t drop;
+    ico_apf_log_arg_t   *arg;
+    unsigned int        dropped;
+    int64_t             basetime;
+    int                 count = 0;
+    struct timespec     NowTime;
 
-    if (loglevel & (ICO_APF_LOG_FLUSH|ICO_APF_LOG_NOFLUSH))    {
-        if (loglevel & ICO_APF_LOG_FLUSH)  {
-            ico_apf_log_flushmode = 1;
+    pthread_mutex_lock(&sDbgMutex);
+
+    /* difference of real time and monotonic time of entries    */
+    clock_gettime(CLOCK_REALTIME, &NowTime);
+    basetime = ((int64_t)NowTime.tv_sec * 1000000000LL) + NowTime.tv_nsec;
+    clock_gettime(CLOCK_MONOTONIC, &NowTime);
+    basetime -= ((int64_t)NowTime.tv_sec * 1000000000LL) + NowTime.tv_nsec;
+
+    if ((! sTrcMode) && (sTrcFd))   {
+        /* changed to text log      */
+        ico_apf_log_trcclose();
+    }
+
+    /* output messages of all threads in order of time  */
+    for (;;)    {
+        oldest = NULL;
+        oldentry = NULL;
+        for (ring = __atomic_load_n(&sLogRings, __ATOMIC_ACQUIRE); ring;
+             ring = ring->next)    {
+            if (ring->tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE))  {
+                continue;
+            }
+            entry = &ring->entry[ring->tail & (ICO_APF_LOG_RINGSIZE-1)];
+            if ((! oldentry) || (entry->time < oldentry->time)) {
+                oldest = ring;
+                oldentry = entry;
+            }
+        }
+        if (! oldest)   {
+            break;
+        }
+        if (ico_apf_log_trcwrite(oldentry, basetime) != 0)  {
+            ico_apf_log_text(oldentry, basetime);
+        }
+        __atomic_store_n(&oldest->tail, oldest->tail + 1, __ATOMIC_RELEASE);
+        count ++;
+    }
+
+    /* report dropped messages          */
+    for (ring = __atomic_load_n(&sLogRings, __ATOMIC_ACQUIRE); ring;
+         ring = ring->next)    {
+        dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+        if (dropped == ring->reported)  {
+            continue;
+        }
+        memset(&drop, 0, sizeof(drop));
+        drop.level = "WRN";
+        drop.fmt = sLogDropFmt;
+        drop.time = ((int64_t)NowTime.tv_sec * 1000000000LL) + NowTime.tv_nsec;
+        drop.nargs = 2;
+        arg = drop.arg;
+        arg[0].ival = dropped - ring->reported;
+        arg[1].ival = ico_apf_log_dropped();
+        if (ico_apf_log_trcwrite(&drop, basetime) != 0) {
+            ico_apf_log_text(&drop, basetime);
+        }
+        ring->reported = dropped;
+        count ++;
+    }
+
+    if ((count > 0) && (ico_apf_log_flushmode)) {
+        if (sDbgFd) {
+            fflush(sDbgFd);
+        }
+        if (sTrcFd) {
+            fflush(sTrcFd);
+        }
+    }
+
+    pthread_mutex_unlock(&sDbgMutex);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_text: format and write a log message to text log file
+ *                            (static function, called with lock)
+ *
+ * @param[in]   entry       log message
+ * @param[in]   basetime    real time - monotonic time(nsec)
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_text(const ico_apf_log_entry_t *entry, const int64_t basetime)
+{
+    ico_apf_trace_info_t    info;
+    char                    line[ICO_APF_LOG_LINESIZE];
+
+    memset(&info, 0, sizeof(info));
+    info.level = entry->level;
+    info.fmt = entry->fmt;
+    if (entry->site)    {
+        info.func = entry->site->func;
+        info.file = entry->site->file;
+        info.line = entry->site->line;
+    }
+    info.pid = getpid();
+    info.timezone = ico_apf_log_timezone();
+    info.longsize = sizeof(long);
+    info.time = entry->time + basetime;
+    info.nargs = entry->nargs;
+    info.arg = entry->arg;
+    info.str = entry->str;
+    info.strsize = entry->strsize;
+    ico_apf_trace_format(line, sizeof(line), &info);
+
+    ico_apf_log_prepare();
+    if (sDbgFd) {
+        fputs(line, sDbgFd);
+    }
+    if (sDbgFile)   {
+        sDbgLines ++;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_trcopen: open or change binary trace file
+ *                               (static function, called with lock)
+ *
+ * @param       nothing
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_trcopen(void)
+{
+    ico_apf_trace_head_t    head;
+    struct timespec         NowTime;
+    int                     idx;
+    char                    sPath[128];
+    char                    sPath2[128];
+
+    ico_apf_log_trcclose();
+
+    snprintf(sPath, sizeof(sPath)-1, "%s/%s.%s%d", ICO_APF_LOG_DIR, sDbgProg,
+             ICO_APF_TRACE_SUFFIX, ICO_APF_LOG_MAXFILES-1);
+    (void) remove(sPath);
+
+    for (idx = (ICO_APF_LOG_MAXFILES-1); idx > 0; idx--)    {
+        strcpy(sPath2, sPath);
+        if (idx > 1)    {
+            snprintf(sPath, sizeof(sPath)-1, "%s/%s.%s%d",
+                     ICO_APF_LOG_DIR, sDbgProg, ICO_APF_TRACE_SUFFIX, idx-1);
         }
         else    {
-            ico_apf_log_flushmode = 0;
+            snprintf(sPath, sizeof(sPath)-1, "%s/%s.%s",
+                     ICO_APF_LOG_DIR, sDbgProg, ICO_APF_TRACE_SUFFIX);
+        }
+        (void) rename(sPath, sPath2);
+    }
+    sTrcFd = fopen(sPath, "we");
+    if (! sTrcFd)   {
+        return;
+    }
+
+    /* call site definitions are written again in new file      */
+    sTrcGen ++;
+
+    memset(&head, 0, sizeof(head));
+    memcpy(head.magic, ICO_APF_TRACE_MAGIC, sizeof(head.magic));
+    head.version = ICO_APF_TRACE_VERSION;
+    head.endian = ICO_APF_TRACE_ENDIAN;
+    head.pid = getpid();
+    head.timezone = ico_apf_log_timezone();
+    head.longsize = sizeof(long);
+    head.ptrsize = sizeof(void *);
+    clock_gettime(CLOCK_REALTIME, &NowTime);
+    head.basetime = ((int64_t)NowTime.tv_sec * 1000000000LL) + NowTime.tv_nsec;
+    clock_gettime(CLOCK_MONOTONIC, &NowTime);
+    head.basetime -= ((int64_t)NowTime.tv_sec * 1000000000LL) + NowTime.tv_nsec;
+    strncpy(head.prog, sDbgProg, sizeof(head.prog)-1);
+    (void) fwrite(&head, sizeof(head), 1, sTrcFd);
+    sTrcBytes = sizeof(head);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_trcclose: close binary trace file
+ *                                (static function, called with lock)
+ *
+ * @param       nothing
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_trcclose(void)
+{
+    if (sTrcFd) {
+        fclose(sTrcFd);
+        sTrcFd = (FILE *)0;
+    }
+    sTrcBytes = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_trcput: write a record to binary trace file
+ *                              (static function, called with lock)
+ *
+ * @param[in]   type    record type(ICO_APF_TRACE_xxx)
+ * @param[in]   id      call site id
+ * @param[in]   time    monotonic time(nsec)
+ * @param[in]   data    record data(record header is not included)
+ * @param[in]   size    size of data
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_trcput(const int type, const unsigned int id, const int64_t time,
+                   const void *data, const int size)
+{
+    static const char   pad[ICO_APF_TRACE_ALIGN];
+    ico_apf_trace_rec_t rec;
+
+    rec.type = type;
+    rec.size = (sizeof(rec) + size + ICO_APF_TRACE_ALIGN - 1)
+               & (~(ICO_APF_TRACE_ALIGN - 1));
+    rec.id = id;
+    rec.time = time;
+    (void) fwrite(&rec, sizeof(rec), 1, sTrcFd);
+    (void) fwrite(data, size, 1, sTrcFd);
+    if (rec.size > (sizeof(rec) + size))    {
+        (void) fwrite(pad, rec.size - (sizeof(rec) + size), 1, sTrcFd);
+    }
+    sTrcBytes += rec.size;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_trcwrite: write a log message to binary trace file
+ *                                (static function, called with lock)
+ *
+ * @param[in]   entry       log message
+ * @param[in]   basetime    real time - monotonic time(nsec)
+ * @return      result
+ * @retval      0           success
+ * @retval      -1          not binary mode(write to text log file)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+ico_apf_log_trcwrite(const ico_apf_log_entry_t *entry, const int64_t basetime)
+{
+    ico_apf_log_site_t      *site = entry->site;
+    ico_apf_trace_site_t    *def;
+    ico_apf_trace_msg_t     *msg;
+    ico_apf_trace_info_t    info;
+    uint32_t                total;
+    char                    buf[ICO_APF_LOG_LINESIZE];
+    int                     len;
+    int                     i;
+
+    /* binary trace file needs the program name */
+    if ((! sTrcMode) || (! sDbgFile) || (sDbgProg[0] == 0)) {
+        return -1;
+    }
+    if ((! sTrcFd) || (sTrcBytes >= ICO_APF_LOG_MAXBYTES))  {
+        ico_apf_log_trcopen();
+        if (! sTrcFd)   {
+            return -1;
+        }
+    }
+
+    if (! site) {
+        if (entry->fmt == sLogDropFmt)  {
+            /* dropped messages                 */
+            total = (uint32_t)entry->arg[1].ival;
+            ico_apf_log_trcput(ICO_APF_TRACE_DROP, (unsigned int)entry->arg[0].ival,
+                               entry->time, &total, sizeof(total));
+            return 0;
+        }
+        /* message without call site is formatted   */
+        memset(&info, 0, sizeof(info));
+        info.level = entry->level;
+        info.fmt = entry->fmt;
+        info.pid = getpid();
+        info.timezone = ico_apf_log_timezone();
+        info.longsize = sizeof(long);
+        info.time = entry->time + basetime;
+        info.nargs = entry->nargs;
+        info.arg = entry->arg;
+        info.str = entry->str;
+        info.strsize = entry->strsize;
+        len = ico_apf_trace_format(buf, sizeof(buf), &info);
+        ico_apf_log_trcput(ICO_APF_TRACE_TEXT, 0, entry->time, buf, len + 1);
+        return 0;
+    }
+
+    if ((site->id == 0) || (site->gen != sTrcGen))  {
+        /* first output of the call site in this file   */
+        if (site->id == 0)  {
+            site->id = ++sTrcSiteId;
+        }
+        site->gen = sTrcGen;
+
+        def = (ico_apf_trace_site_t *)buf;
+        memset(def, 0, sizeof(ico_apf_trace_site_t));
+        def->line = site->line;
+        len = sizeof(ico_apf_trace_site_t);
+        len += snprintf(&buf[len], sizeof(buf) - len, "%s", site->level) + 1;
+        if (len < (int)sizeof(buf)) {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s", site->func) + 1;
+        }
+        if (len < (int)sizeof(buf)) {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s", site->file) + 1;
+        }
+        if (len < (int)sizeof(buf)) {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s", site->fmt) + 1;
+        }
+        if (len > (int)sizeof(buf)) {
+            len = sizeof(buf);
+            buf[len-1] = 0;
+        }
+        ico_apf_log_trcput(ICO_APF_TRACE_SITE, site->id, 0,
+                           &buf[sizeof(ico_apf_trace_rec_t)],
+                           len - sizeof(ico_apf_trace_rec_t));
+    }
+
+    /* raw arguments and used string area           */
+    msg = (ico_apf_trace_msg_t *)buf;
+    memset(msg, 0, sizeof(ico_apf_trace_msg_t));
+    msg->nargs = entry->nargs;
+    msg->strsize = entry->strsize;
+    len = sizeof(ico_apf_trace_msg_t);
+    for (i = 0; i < entry->nargs; i++)  {
+        memcpy(&buf[len], &entry->arg[i], sizeof(ico_apf_log_arg_t));
+        len += sizeof(ico_apf_log_arg_t);
+    }
+    memcpy(&buf[len], entry->str, entry->strsize);
+    len += entry->strsize;
+    ico_apf_log_trcput(ICO_APF_TRACE_MSG, site->id, entry->time,
+                       &buf[sizeof(ico_apf_trace_rec_t)],
+                       len - sizeof(ico_apf_trace_rec_t));
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_writer: writer thread(static function)
+ *
+ * @param[in]   arg     unused
+ * @return      never return
+ */
+/*--------------------------------------------------------------------------*/
+static void *
+ico_apf_log_writer(void *arg)
+{
+    struct timespec timeout;
+    sigset_t        mask;
+
+    /* signals are handled by application threads   */
+    sigfillset(&mask);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    for (;;)    {
+        clock_gettime(CLOCK_REALTIME, &timeout);
+        timeout.tv_nsec += ICO_APF_LOG_INTERVAL * 1000000L;
+        if (timeout.tv_nsec >= 1000000000L) {
+            timeout.tv_sec ++;
+            timeout.tv_nsec -= 1000000000L;
+        }
+        pthread_mutex_lock(&sLogWakeMutex);
+        (void) pthread_cond_timedwait(&sLogWakeCond, &sLogWakeMutex, &timeout);
+        pthread_mutex_unlock(&sLogWakeMutex);
+
+        ico_apf_log_drain();
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_attach: start writer thread and get ring buffer of
+ *                              current thread(static function)
+ *
+ * @param       nothing
+ * @return      ring buffer of current thread
+ * @retval      NULL        writer thread not available
+ */
+/*--------------------------------------------------------------------------*/
+static ico_apf_log_ring_t *
+ico_apf_log_attach(void)
+{
+    ico_apf_log_ring_t  *ring;
+    pthread_t           thread;
+    pthread_attr_t      attr;
+    int                 inuse;
+
+    if (! __atomic_load_n(&sLogStarted, __ATOMIC_ACQUIRE))  {
+        pthread_mutex_lock(&sDbgMutex);
+        if (! sLogInitialized)  {
+            if (pthread_key_create(&sLogKey, ico_apf_log_detach) != 0)    {
+                pthread_mutex_unlock(&sDbgMutex);
+                return NULL;
+            }
+            (void) pthread_atfork(NULL, NULL, ico_apf_log_atfork);
+            (void) atexit(ico_apf_log_atexit);
+            sLogInitialized = 1;
+        }
+        if (! sLogStarted)  {
+            pthread_attr_init(&attr);
+            pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+            if (pthread_create(&thread, &attr, ico_apf_log_writer, NULL) == 0)   {
+                __atomic_store_n(&sLogStarted, 1, __ATOMIC_RELEASE);
+            }
+            pthread_attr_destroy(&attr);
+        }
+        pthread_mutex_unlock(&sDbgMutex);
+        if (! sLogStarted)  {
+            return NULL;
+        }
+    }
+    if (sLogRing)   {
+        return sLogRing;
+    }
+
+    /* reuse a ring buffer of the exited thread */
+    for (ring = __atomic_load_n(&sLogRings, __ATOMIC_ACQUIRE); ring;
+         ring = ring->next)    {
+        inuse = 0;
+        if (__atomic_compare_exchange_n(&ring->inuse, &inuse, 1, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))    {
+            break;
         }
     }
+    if (! ring) {
+        ring = calloc(1, sizeof(ico_apf_log_ring_t));
+        if (! ring) {
+            return NULL;
+        }
+        ring->inuse = 1;
+        ring->next = __atomic_load_n(&sLogRings, __ATOMIC_RELAXED);
+        while (! __atomic_compare_exchange_n(&sLogRings, &ring->next, ring, 0,
+                                             __ATOMIC_RELEASE, __ATOMIC_RELAXED))  {
+            ;
+        }
+    }
+    (void) pthread_setspecific(sLogKey, ring);
+    sLogRing = ring;
+    return ring;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_detach: release ring buffer at exit of the thread
+ *                              (static function)
+ *
+ * @param[in]   arg     ring buffer of the thread
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_detach(void *arg)
+{
+    ico_apf_log_ring_t  *ring = (ico_apf_log_ring_t *)arg;
+
+    /* messages left in the ring buffer are written by writer thread    */
+    __atomic_store_n(&ring->inuse, 0, __ATOMIC_RELEASE);
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_atfork: writer thread does not exist in child
+ *                              process(static function)
+ *
+ * @param       nothing
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_atfork(void)
+{
+    pthread_mutex_t     mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+    pthread_mutex_t     wmutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t      cond = PTHREAD_COND_INITIALIZER;
+    ico_apf_log_ring_t  *ring;
+
+    sDbgMutex = mutex;
+    sLogWakeMutex = wmutex;
+    sLogWakeCond = cond;
+    sLogStarted = 0;
+
+    /* messages in ring buffers are written by parent process   */
+    for (ring = sLogRings; ring; ring = ring->next) {
+        ring->tail = ring->head;
+        ring->reported = ring->dropped;
+    }
+
+    /* trace file is shared with parent process, child writes text log  */
+    /* (records buffered by parent are discarded, parent writes them)   */
+    sTrcMode = 0;
+    if (sTrcFd) {
+        __fpurge(sTrcFd);
+        fclose(sTrcFd);
+        sTrcFd = (FILE *)0;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_apf_log_atexit: output log messages in ring buffers at exit
+ *                              (static function)
+ *
+ * @param       nothing
+ * @return      nothing
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_apf_log_atexit(void)
+{
+    ico_apf_log_drain();
+    pthread_mutex_lock(&sDbgMutex);
+    if (sDbgFd) {
+        fflush(sDbgFd);
+    }
+    if (sTrcFd) {
+        fflush(sTrcFd);
+    }
+    pthread_mutex_unlock(&sDbgMutex);
+}
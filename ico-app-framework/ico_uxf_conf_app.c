@@ -37,19 +37,34 @@
 #define APP_CONF_EVENT_OK           (0)
 #define APP_CONF_EVENT_FAIL         (1)
 
+#define APP_CONF_PKG_APPS_MAX       (8)     /* maximum applications in a package    */
+#define APP_CONF_GROW_APPS          (16)    /* minimum growth of application table  */
+#define APP_CONF_RETRY_MAX          (250)   /* maximum retry count of AIL read      */
+#define APP_CONF_RETRY_WAIT         (20)    /* wait of AIL read without timer(ms)   */
+
 typedef struct _conf_pkgmgr_event conf_pkgmgr_event_t;
 
 struct _conf_pkgmgr_event {
     conf_pkgmgr_event_t *next;
     char pkg_name[ICO_UXF_MAX_PROCESS_NAME];
     int type;
+    int retry;                              /* retry count of AIL read              */
 };
 
 /*==============================================================================*/
 /* define static function prototype                                             */
 /*==============================================================================*/
 static Ico_Uxf_App_Config *readAilApplist(void);
-static void ico_uxf_conf_remakeAppHash(void);
+static void readAilPackage(const char *pkg_name, Ico_Uxf_App_Config *work);
+static void loadAppAttr(void);
+static void ico_uxf_conf_remakeAppHash(Ico_Uxf_App_Config *config);
+static void ico_uxf_conf_linkAppHash(Ico_Uxf_App_Config *config, const int idx);
+static Ico_Uxf_conf_application *ico_uxf_conf_findApp(Ico_Uxf_App_Config *config,
+                                                      const char *appid);
+static Ico_Uxf_conf_application *ico_uxf_conf_findAppName(Ico_Uxf_App_Config *config,
+                                                          const char *name);
+static int ico_uxf_conf_copyApp(const int capacity, const Ico_Uxf_conf_application *remove);
+static int ico_uxf_conf_updatePackage(const conf_pkgmgr_event_t *event);
 static int ico_uxf_conf_pkgmgrEvent(int req_id, const char *pkg_type,
                     const char *pkg_name, const char *key, const char *val,
                     const void *pmsg, void *data);
@@ -64,9 +79,15 @@ static Ico_Uxf_App_Config   *_ico_app_config = NULL;
 static Ico_Uxf_App_Config   *_ico_app_config_update = NULL;
 static Ico_Uxf_Sys_Config   *sys_config = NULL;
 static GKeyFile             *sappfile = NULL;
+static time_t               sappfile_mtime = 0;
+static off_t                sappfile_size = -1;
+static int                  app_config_capacity = 0;
+static GList                *app_config_retired = NULL;
 
 static pkgmgr_client        *conf_pc = NULL;
 static conf_pkgmgr_event_t  *conf_prog_event = NULL;
+static conf_pkgmgr_event_t  *conf_retry_event = NULL;
+static void                 (*conf_retry_func)(void) = NULL;
 static Ico_Uxf_AppUpdata_Cb conf_cb_func = NULL;
 
 /*--------------------------------------------------------------------------*/
@@ -226,7 +247,7 @@ infoAilpkg(const ail_appinfo_h appinfo, void *data)
 
     if ((package != NULL) && (*package != 0))   {
         apptbl = &_ico_app_config_update->application[_ico_app_config_update->applicationNum];
-        apptbl->appid = strdup(package);
+        apptbl->appid = (char *)ico_uxf_misc_intern(package);
         if (icon)   {
             apptbl->icon_key_name = strdup(icon);
         }
@@ -234,10 +255,10 @@ infoAilpkg(const ail_appinfo_h appinfo, void *data)
             apptbl->icon_key_name = strdup("\0");
         }
         if ((name != NULL) && (*name != 0)) {
-            apptbl->name = strdup(name);
+            apptbl->name = (char *)ico_uxf_misc_intern(name);
         }
         else    {
-            apptbl->name = strdup(package);
+            apptbl->name = apptbl->appid;
         }
 
         /* set default values       */
@@ -743,7 +764,6 @@ readAilApplist(void)
 {
     int     ret, num, wnum;
     ail_filter_h filter;
-    GError  *error = NULL;
 
     _ico_app_config_update->applicationNum = 0;
 
@@ -755,27 +775,11 @@ readAilApplist(void)
     }
 
     /* read system configuration file for application default category  */
-    sappfile = g_key_file_new();
-
-    GString* filepath = g_string_new("xx");
-    g_string_printf(filepath, "%s/%s", sys_config->misc.confdir, ICO_UXF_CONFIG_APPATTR);
-
-    if (! g_key_file_load_from_file(sappfile, filepath->str,
-                                    G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS,
-                                    &error)) {
-        apfw_error("readAilApplist: %s %s", (char *)filepath->str, error->message);
-        g_key_file_free(sappfile);
-        sappfile = NULL;
-    }
-    g_string_free(filepath, TRUE);
+    loadAppAttr();
 
     /* count packages */
     ret = ail_filter_count_appinfo(NULL, &num);
     if (ret != AIL_ERROR_OK) {
-        if( sappfile)   {
-            g_key_file_free(sappfile);
-            sappfile = NULL;
-        }
         apfw_trace("readAilApplist: Leave(Ail:cannot count appinfo) = %d", ret);
         return NULL;
     }
@@ -785,10 +789,6 @@ readAilApplist(void)
     ail_filter_add_str(filter, AIL_PROP_TYPE_STR, "menu");
     ret = ail_filter_count_appinfo(filter, &num);
     if (ret != AIL_ERROR_OK) {
-        if( sappfile)   {
-            g_key_file_free(sappfile);
-            sappfile = NULL;
-        }
         apfw_trace("readAilApplist: Leave(Ail:cannot count appinfo(menu)) = %d", ret);
         return NULL;
     }
@@ -799,10 +799,6 @@ readAilApplist(void)
     ail_filter_add_str(filter, AIL_PROP_TYPE_STR, "Application");
     ret = ail_filter_count_appinfo(filter, &wnum);
     if (ret != AIL_ERROR_OK) {
-        if( sappfile)   {
-            g_key_file_free(sappfile);
-            sappfile = NULL;
-        }
         apfw_trace("readAilApplist: Leave(Ail:cannot count appinfo(Application)) = %d", ret);
         return NULL;
     }
@@ -811,15 +807,12 @@ readAilApplist(void)
     num += wnum;
 
     _ico_app_config_update->application = g_new0(Ico_Uxf_conf_application, num);
+    app_config_capacity = num;
 
     ail_filter_new(&filter);
     ret = ail_filter_add_str(filter, AIL_PROP_TYPE_STR, "menu");
     ret = ail_filter_list_appinfo_foreach(filter, infoAilpkg, (void *)num);
     if (ret != AIL_ERROR_OK) {
-        if( sappfile)   {
-            g_key_file_free(sappfile);
-            sappfile = NULL;
-        }
         ail_filter_destroy(filter);
         apfw_trace("readAilApplist: Leave(Ail:cannot get appinfo(menu)) = %d", ret);
         return NULL;
@@ -830,10 +823,6 @@ readAilApplist(void)
     ail_filter_add_str(filter, AIL_PROP_TYPE_STR, "Application");
     ret = ail_filter_list_appinfo_foreach(filter, infoAilpkg, (void *)num);
     if (ret != AIL_ERROR_OK) {
-        if( sappfile)   {
-            g_key_file_free(sappfile);
-            sappfile = NULL;
-        }
         ail_filter_destroy(filter);
         apfw_trace("readAilApplist: Leave(Ail:cannot get appinfo(Application)) = %d", ret);
         return NULL;
@@ -841,27 +830,124 @@ readAilApplist(void)
     ail_filter_destroy(filter);
 
     if (_ico_app_config_update->ailNum != num) {
-        if( sappfile)   {
-            g_key_file_free(sappfile);
-            sappfile = NULL;
-        }
         apfw_trace("readAilApplist: Leave(cannot read ail correctly %d =! %d",
                     _ico_app_config_update->ailNum, num);
         return NULL;
     }
 
     /* create Hash Table                    */
-    ico_uxf_conf_remakeAppHash();
-
-    if( sappfile)   {
-        g_key_file_free(sappfile);
-    }
+    ico_uxf_conf_remakeAppHash(_ico_app_config_update);
 
     apfw_trace("readAilApplist: Leave");
 
     return _ico_app_config_update;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   infoAilpkgType: callback function for a package from AppCore(static function)
+ *          select only "menu" and "Application" type same as readAilApplist
+ *
+ * @param[in]   appinfo         AppCore(AIL) application information
+ * @param[in]   data            user data(application index)
+ * @return      result
+ * @retval      AIL_CB_RET_CONTINUE success(continue next application)
+ * @retval      AIL_CB_RET_CANCEL   error(stop all application search)
+ */
+/*--------------------------------------------------------------------------*/
+static ail_cb_ret_e
+infoAilpkgType(const ail_appinfo_h appinfo, void *data)
+{
+    char    *type;
+
+    ail_appinfo_get_str(appinfo, AIL_PROP_TYPE_STR, &type);
+    if ((strcmp(type, "menu") != 0) && (strcmp(type, "Application") != 0))   {
+        return AIL_CB_RET_CONTINUE;
+    }
+    return infoAilpkg(appinfo, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   readAilPackage: get application configuration of one package
+ *          from AppCore(static function)
+ *
+ * @param[in]   pkg_name        package name
+ * @param[out]  work            application configuration of the package
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+readAilPackage(const char *pkg_name, Ico_Uxf_App_Config *work)
+{
+    int     ret;
+    ail_filter_h filter;
+
+    /* system configuration may be replaced by live reload  */
+    sys_config = (Ico_Uxf_Sys_Config *)ico_uxf_getSysConfig();
+    loadAppAttr();
+
+    work->application = g_new0(Ico_Uxf_conf_application, APP_CONF_PKG_APPS_MAX);
+    _ico_app_config_update = work;
+
+    ail_filter_new(&filter);
+    ail_filter_add_str(filter, AIL_PROP_PACKAGE_STR, pkg_name);
+    ret = ail_filter_list_appinfo_foreach(filter, infoAilpkgType,
+                                          (void *)(APP_CONF_PKG_APPS_MAX - 1));
+    ail_filter_destroy(filter);
+
+    _ico_app_config_update = _ico_app_config;
+
+    if (ret != AIL_ERROR_OK) {
+        apfw_trace("readAilPackage: Ail:cannot get appinfo(%s) = %d", pkg_name, ret);
+        work->applicationNum = 0;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   loadAppAttr: read application attribute file if changed(static function)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+loadAppAttr(void)
+{
+    GError  *error = NULL;
+    struct stat buff;
+
+    GString* filepath = g_string_new("xx");
+    g_string_printf(filepath, "%s/%s", sys_config->misc.confdir, ICO_UXF_CONFIG_APPATTR);
+
+    memset(&buff, 0, sizeof(buff));
+    if (stat(filepath->str, &buff) != 0)    {
+        buff.st_size = -1;
+    }
+    if ((sappfile) && (buff.st_mtime == sappfile_mtime) && (buff.st_size == sappfile_size))  {
+        /* not changed          */
+        g_string_free(filepath, TRUE);
+        return;
+    }
+    if (sappfile)   {
+        g_key_file_free(sappfile);
+    }
+    sappfile_mtime = buff.st_mtime;
+    sappfile_size = buff.st_size;
+
+    sappfile = g_key_file_new();
+    if (! g_key_file_load_from_file(sappfile, filepath->str,
+                                    G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS,
+                                    &error)) {
+        apfw_error("loadAppAttr: %s %s", (char *)filepath->str, error->message);
+        g_clear_error(&error);
+        g_key_file_free(sappfile);
+        sappfile = NULL;
+    }
+    g_string_free(filepath, TRUE);
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_uxf_closeAppConfig: close application configuration table
@@ -877,54 +963,195 @@ ico_uxf_closeAppConfig(void)
         g_free(_ico_app_config->application);
         g_free(_ico_app_config);
         _ico_app_config = NULL;
+        _ico_app_config_update = NULL;
+        app_config_capacity = 0;
     }
+    g_list_free_full(app_config_retired, g_free);
+    app_config_retired = NULL;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_uxf_conf_remakeAppHash: make application hash table(static function)
  *
- * @param       none
+ * @param[in]   config      application configuration table
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 static void
-ico_uxf_conf_remakeAppHash(void)
+ico_uxf_conf_remakeAppHash(Ico_Uxf_App_Config *config)
 {
     int         i;
+
+    memset(config->hashidtable, 0, sizeof(config->hashidtable));
+    memset(config->hashnametable, 0, sizeof(config->hashnametable));
+    memset(config->hashlabeltable, 0, sizeof(config->hashlabeltable));
+
+    for (i = 0; i < config->applicationNum; i++)  {
+        ico_uxf_conf_linkAppHash(config, i);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_linkAppHash: add an application to hash table(static function)
+ *
+ * @param[in]   config      application configuration table
+ * @param[in]   idx         index of the application
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_uxf_conf_linkAppHash(Ico_Uxf_App_Config *config, const int idx)
+{
     int         hash;
     Ico_Uxf_conf_application    *app;
 
-    memset(_ico_app_config_update->hashnametable, 0, sizeof(_ico_app_config_update->hashnametable));
-
-    for (i = 0; i < _ico_app_config_update->applicationNum; i++)  {
+    config->application[idx].nextidhash = NULL;
+    hash = ICO_UXF_MISC_HASHBYID(idx);
+    app = config->hashidtable[hash];
+    if (! app) {
+        config->hashidtable[hash] = &config->application[idx];
+    }
+    else    {
+        while (app->nextidhash)    {
+            app = app->nextidhash;
+        }
+        app->nextidhash = &config->application[idx];
+    }
 
-        _ico_app_config_update->application[i].nextidhash = NULL;
-        hash = ICO_UXF_MISC_HASHBYID(i);
-        app = _ico_app_config_update->hashidtable[hash];
-        if (! app) {
-            _ico_app_config_update->hashidtable[hash] = &_ico_app_config_update->application[i];
+    config->application[idx].nextnamehash = NULL;
+    hash = ICO_UXF_MISC_HASHBYNAME(config->application[idx].appid);
+    app = config->hashnametable[hash];
+    if (! app) {
+        config->hashnametable[hash] = &config->application[idx];
+    }
+    else    {
+        while (app->nextnamehash)  {
+            app = app->nextnamehash;
         }
-        else    {
-            while (app->nextidhash)    {
-                app = app->nextidhash;
-            }
-            app->nextidhash = &_ico_app_config_update->application[i];
+        app->nextnamehash = &config->application[idx];
+    }
+
+    config->application[idx].nextlabelhash = NULL;
+    hash = ICO_UXF_MISC_HASHBYNAME(config->application[idx].name);
+    app = config->hashlabeltable[hash];
+    if (! app) {
+        config->hashlabeltable[hash] = &config->application[idx];
+    }
+    else    {
+        while (app->nextlabelhash) {
+            app = app->nextlabelhash;
         }
+        app->nextlabelhash = &config->application[idx];
+    }
+}
 
-        _ico_app_config_update->application[i].nextnamehash = NULL;
-        hash = ICO_UXF_MISC_HASHBYNAME(_ico_app_config_update->application[i].appid);
-        app = _ico_app_config_update->hashnametable[hash];
-        if (! app) {
-            _ico_app_config_update->hashnametable[hash] = &_ico_app_config_update->application[i];
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_findApp: find application by application Id(static function)
+ *
+ * @param[in]   config      application configuration table
+ * @param[in]   appid       application Id
+ * @return      application configuration
+ * @retval      !=NULL          success(application configuration address)
+ * @retval      ==NULL          error(application dose not exist)
+ */
+/*--------------------------------------------------------------------------*/
+static Ico_Uxf_conf_application *
+ico_uxf_conf_findApp(Ico_Uxf_App_Config *config, const char *appid)
+{
+    Ico_Uxf_conf_application    *top;
+    Ico_Uxf_conf_application    *app;
+    const char  *atom;
+
+    top = config->hashnametable[ICO_UXF_MISC_HASHBYNAME(appid)];
+
+    /* same string is same atom, compare address at first  */
+    atom = ico_uxf_misc_findIntern(appid);
+    if (atom)   {
+        for (app = top; app; app = app->nextnamehash)   {
+            if (app->appid == atom) return app;
         }
-        else    {
-            while (app->nextnamehash)  {
-                app = app->nextnamehash;
-            }
-            app->nextnamehash = &_ico_app_config_update->application[i];
+    }
+    /* no distinction of an english capital letter/small   */
+    for (app = top; app; app = app->nextnamehash)   {
+        if (strcasecmp(app->appid, appid) == 0) break;
+    }
+    return app;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_findAppName: find application by application name
+ *          (static function)
+ *
+ * @param[in]   config      application configuration table
+ * @param[in]   name        application name
+ * @return      application configuration
+ * @retval      !=NULL          success(application configuration address)
+ * @retval      ==NULL          error(application dose not exist)
+ */
+/*--------------------------------------------------------------------------*/
+static Ico_Uxf_conf_application *
+ico_uxf_conf_findAppName(Ico_Uxf_App_Config *config, const char *name)
+{
+    Ico_Uxf_conf_application    *top;
+    Ico_Uxf_conf_application    *app;
+    const char  *atom;
+
+    top = config->hashlabeltable[ICO_UXF_MISC_HASHBYNAME(name)];
+
+    atom = ico_uxf_misc_findIntern(name);
+    if (atom)   {
+        for (app = top; app; app = app->nextlabelhash)  {
+            if (app->name == atom)  return app;
         }
     }
+    for (app = top; app; app = app->nextlabelhash)  {
+        if (strcasecmp(app->name, name) == 0)   break;
+    }
+    return app;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_copyApp: copy application table to new table(static function)
+ *          old table is not released until ico_uxf_closeAppConfig, because
+ *          the caller may have an address of the application configuration.
+ *
+ * @param[in]   capacity    number of applications of new table
+ * @param[in]   remove      application to remove(if NULL, no remove)
+ * @return      result
+ * @retval      ICO_UXF_EOK     success
+ * @retval      ICO_UXF_ENOMEM  error(out of memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+ico_uxf_conf_copyApp(const int capacity, const Ico_Uxf_conf_application *remove)
+{
+    Ico_Uxf_conf_application    *newtable;
+    int     i, num;
+
+    newtable = g_try_new0(Ico_Uxf_conf_application, capacity);
+    if (! newtable) {
+        apfw_error("ico_uxf_conf_copyApp: No Memory(%d)", capacity);
+        return ICO_UXF_ENOMEM;
+    }
+    num = 0;
+    for (i = 0; i < _ico_app_config->applicationNum; i++)   {
+        if (&_ico_app_config->application[i] == remove) continue;
+        memcpy(&newtable[num++], &_ico_app_config->application[i],
+               sizeof(Ico_Uxf_conf_application));
+    }
+    app_config_retired = g_list_prepend(app_config_retired, _ico_app_config->application);
+
+    _ico_app_config->application = newtable;
+    _ico_app_config->applicationNum = num;
+    app_config_capacity = capacity;
+    ico_uxf_conf_remakeAppHash(_ico_app_config);
+
+    return ICO_UXF_EOK;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -945,12 +1172,7 @@ ico_uxf_getAppByAppid(const char *appid)
     if (!_ico_app_config)  {
         (void)ico_uxf_getAppConfig();
     }
-    app = _ico_app_config->hashnametable[ICO_UXF_MISC_HASHBYNAME(appid)];
-
-    while (app)    {
-        if (strcasecmp(app->appid, appid) == 0)   break;
-        app = app->nextnamehash;
-    }
+    app = ico_uxf_conf_findApp(_ico_app_config, appid);
     if (! app)  {
         apfw_warn("ico_uxf_getAppByAppid: appid(%s) dose not exist", appid);
     }
@@ -970,19 +1192,13 @@ ico_uxf_getAppByAppid(const char *appid)
 ICO_APF_API const Ico_Uxf_conf_application *
 ico_uxf_getAppByName(const char *name)
 {
-    int     i;
-    Ico_Uxf_conf_application    *app = NULL;
+    Ico_Uxf_conf_application    *app;
 
     if (!_ico_app_config)  {
         (void)ico_uxf_getAppConfig();
     }
 
-    for (i = 0; i < _ico_app_config->applicationNum; i++)   {
-        if (strcasecmp(_ico_app_config->application[i].name, name) == 0)    {
-            app = &_ico_app_config->application[i];
-            break;
-        }
-    }
+    app = ico_uxf_conf_findAppName(_ico_app_config, name);
     if (! app)  {
         apfw_warn("ico_uxf_getAppByName: name(%s) dose not exist", name);
     }
@@ -1151,7 +1367,7 @@ ico_uxf_conf_startEvent(const char *pkg_name, int type)
             apfw_warn("ico_uxf_conf_startEvent: cannot allocate memory");
             return ICO_UXF_ENOMEM;
         }
-        memset(new, 0, sizeof(new));
+        memset(new, 0, sizeof(conf_pkgmgr_event_t));
         /* insert queue */
         event = conf_prog_event;
         while (event) {
@@ -1183,20 +1399,15 @@ ico_uxf_conf_startEvent(const char *pkg_name, int type)
  * @param[in]   status          end status
  * @return      result
  * @retval      ICO_UXF_EOK     success
+ * @retval      ICO_UXF_ENOSYS  error(start event dose not exist)
  */
 /*--------------------------------------------------------------------------*/
 static int
 ico_uxf_conf_endEvent(const char *pkg_name, int status)
 {
-    int     type;
-    int     cnt;
-    int     ii, jj;
-    int     exist = 0;
     conf_pkgmgr_event_t *current = NULL;
     conf_pkgmgr_event_t *event;
     conf_pkgmgr_event_t *bevent;
-    static Ico_Uxf_App_Config *config = NULL;
-    static Ico_Uxf_App_Config *tmp = NULL;
 
     apfw_trace("ico_uxf_conf_endEvent: Enter(pkg=%s, stat=%d)", pkg_name, status);
     /* get start event from queue */
@@ -1225,79 +1436,191 @@ ico_uxf_conf_endEvent(const char *pkg_name, int status)
         return ICO_UXF_ENOSYS;
     }
 
-    type = current->type;
+    if ((status == APP_CONF_EVENT_OK) &&
+        (ico_uxf_conf_updatePackage(current) == ICO_UXF_EAGAIN))    {
+        /* AIL database is not updated yet                                  */
+        current->retry = 0;
+        current->next = conf_retry_event;
+        conf_retry_event = current;
+        if (conf_retry_func)    {
+            /* retry later by the timer of main loop without blocking       */
+            conf_retry_func();
+            apfw_trace("ico_uxf_conf_endEvent: Leave(retry later)");
+            return ICO_UXF_EOK;
+        }
+        /* no retry timer(only ico_uxf_conf_setAppUpdateCb), retry here     */
+        do  {
+            usleep(APP_CONF_RETRY_WAIT * 1000);
+        } while (ico_uxf_conf_retryAppEvent());
+        apfw_trace("ico_uxf_conf_endEvent: Leave(retried)");
+        return ICO_UXF_EOK;
+    }
     free(current);
 
-    if (status == APP_CONF_EVENT_OK) {
-        config = g_new0(Ico_Uxf_App_Config, 1);
-        _ico_app_config_update = config;
-        config = readAilApplist();
-        cnt = 0;
-        while (! config) {
-            usleep(10000);
-            apfw_trace("ico_uxf_conf_endEvent: Retry %d", cnt);
-            config = readAilApplist();
-            if (cnt > 500) {
-                break;
-            }
-            else {
-                cnt++;
-            }
+    apfw_trace("ico_uxf_conf_endEvent: Leave");
+
+    return ICO_UXF_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_updatePackage: update application table for a package
+ *          only the package is read from AppCore, and application table and
+ *          hash table are updated incrementally(static function)
+ *
+ * @param[in]   event           package event
+ * @return      result
+ * @retval      ICO_UXF_EOK     success
+ * @retval      ICO_UXF_EAGAIN  package dose not exist in AppCore yet
+ * @retval      ICO_UXF_ENOMEM  error(out of memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+ico_uxf_conf_updatePackage(const conf_pkgmgr_event_t *event)
+{
+    Ico_Uxf_App_Config          work;
+    Ico_Uxf_conf_application    *app;
+    int     i, idx;
+    int     relabel;
+
+    apfw_trace("ico_uxf_conf_updatePackage: Enter(pkg=%s, type=%d)",
+               event->pkg_name, event->type);
+
+    if (! _ico_app_config)  {
+        /* not read yet, all applications are read at first access  */
+        apfw_trace("ico_uxf_conf_updatePackage: Leave(not read yet)");
+        return ICO_UXF_EOK;
+    }
+
+    if (event->type == ICO_UXF_CONF_EVENT_UNINSTALL)    {
+        app = ico_uxf_conf_findApp(_ico_app_config, event->pkg_name);
+        if (! app)  {
+            apfw_trace("ico_uxf_conf_updatePackage: Leave(%s dose not exist)",
+                       event->pkg_name);
+            return ICO_UXF_EOK;
         }
-        if (! config) {
-            apfw_warn("ico_uxf_getAppByAppid: cannot access ail normally");
-            return ICO_UXF_EBUSY;
+        if (ico_uxf_conf_copyApp(app_config_capacity, app) != ICO_UXF_EOK)  {
+            return ICO_UXF_ENOMEM;
         }
-        tmp = config;
-        /* old list */
-        config = _ico_app_config;
-        /* new list */
-        _ico_app_config = tmp;
-
-        if (type == ICO_UXF_CONF_EVENT_INSTALL) {
-            for (ii = 0; ii < _ico_app_config->applicationNum; ii++) {
-                exist = 0;
-                for (jj = 0; jj < config->applicationNum; jj++) {
-                    if (strcmp(_ico_app_config->application[ii].appid,
-                               config->application[jj].appid) == 0) {
-                        exist = 1;
-                        break;
-                    }
-                }
-                if ((exist == 0) && conf_cb_func) {
-                    conf_cb_func(_ico_app_config->application[ii].appid,
-                                 ICO_UXF_CONF_EVENT_INSTALL);
-                }
+        _ico_app_config->ailNum --;
+        /* app is in the old table, it is available until close */
+        if (conf_cb_func)   {
+            conf_cb_func(app->appid, ICO_UXF_CONF_EVENT_UNINSTALL);
+        }
+        apfw_trace("ico_uxf_conf_updatePackage: Leave(uninstall, num=%d)",
+                   _ico_app_config->applicationNum);
+        return ICO_UXF_EOK;
+    }
+
+    /* install, read only this package      */
+    memset(&work, 0, sizeof(work));
+    readAilPackage(event->pkg_name, &work);
+    if (work.applicationNum <= 0)   {
+        g_free(work.application);
+        apfw_trace("ico_uxf_conf_updatePackage: Leave(EAGAIN)");
+        return ICO_UXF_EAGAIN;
+    }
+
+    for (i = 0; i < work.applicationNum; i++)   {
+        app = ico_uxf_conf_findApp(_ico_app_config, work.application[i].appid);
+        if (app)    {
+            /* update of installed application, same address and same hash  */
+            work.application[i].nextidhash = app->nextidhash;
+            work.application[i].nextnamehash = app->nextnamehash;
+            work.application[i].nextlabelhash = app->nextlabelhash;
+            relabel = (app->name != work.application[i].name);
+            memcpy(app, &work.application[i], sizeof(Ico_Uxf_conf_application));
+            if (relabel)    {
+                /* application name was changed, remake name hash   */
+                ico_uxf_conf_remakeAppHash(_ico_app_config);
             }
+            apfw_trace("ico_uxf_conf_updatePackage: update(%s)", app->appid);
+            continue;
         }
-        else if (type == ICO_UXF_CONF_EVENT_UNINSTALL) {
-            for (jj = 0; jj < config->applicationNum; jj++) {
-                exist = 0;
-                for (ii = 0; ii < _ico_app_config->applicationNum; ii++) {
-                    if (strcmp(config->application[jj].appid,
-                               _ico_app_config->application[ii].appid) == 0) {
-                        exist = 1;
-                        break;
-                    }
-                }
-                if ((exist == 0) && conf_cb_func) {
-                    conf_cb_func(config->application[jj].appid,
-                                 ICO_UXF_CONF_EVENT_UNINSTALL);
-                }
+        if (_ico_app_config->applicationNum >= app_config_capacity) {
+            if (ico_uxf_conf_copyApp(app_config_capacity * 2 + APP_CONF_GROW_APPS, NULL)
+                    != ICO_UXF_EOK) {
+                g_free(work.application);
+                return ICO_UXF_ENOMEM;
             }
         }
-        /* free old list */
-        if (config != NULL) {
-            g_free(config->application);
-            g_free(config);
+        idx = _ico_app_config->applicationNum;
+        memcpy(&_ico_app_config->application[idx], &work.application[i],
+               sizeof(Ico_Uxf_conf_application));
+        ico_uxf_conf_linkAppHash(_ico_app_config, idx);
+        _ico_app_config->applicationNum ++;
+        _ico_app_config->ailNum ++;
+
+        if (conf_cb_func)   {
+            conf_cb_func(_ico_app_config->application[idx].appid,
+                         ICO_UXF_CONF_EVENT_INSTALL);
         }
     }
+    g_free(work.application);
 
-    apfw_trace("ico_uxf_conf_endEvent: Leave");
-
+    apfw_trace("ico_uxf_conf_updatePackage: Leave(install, num=%d)",
+               _ico_app_config->applicationNum);
     return ICO_UXF_EOK;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_setAppRetryCb: set function that starts the retry timer
+ *          of package events(internal function, the timer is added to the
+ *          main loop by ico_uxf_conf_ecore)
+ *
+ * @param[in]   retry           function that starts the retry timer
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_uxf_conf_setAppRetryCb(void (*retry)(void))
+{
+    conf_retry_func = retry;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_retryAppEvent: retry package events that the package
+ *          was not found in AppCore(internal function, called by the retry
+ *          timer of main loop)
+ *
+ * @param       none
+ * @return      retry events remain
+ * @retval      1               retry events remain(continue timer)
+ * @retval      0               no retry event
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_uxf_conf_retryAppEvent(void)
+{
+    conf_pkgmgr_event_t *event;
+    conf_pkgmgr_event_t *bevent;
+    conf_pkgmgr_event_t *next;
+
+    bevent = NULL;
+    for (event = conf_retry_event; event; event = next)   {
+        next = event->next;
+        if ((ico_uxf_conf_updatePackage(event) == ICO_UXF_EAGAIN) &&
+            (++event->retry < APP_CONF_RETRY_MAX))    {
+            bevent = event;
+            continue;
+        }
+        if (event->retry >= APP_CONF_RETRY_MAX) {
+            apfw_warn("ico_uxf_conf_retryAppEvent: cannot access ail normally(%s)",
+                      event->pkg_name);
+        }
+        if (bevent) {
+            bevent->next = next;
+        }
+        else    {
+            conf_retry_event = next;
+        }
+        free(event);
+    }
+    return (conf_retry_event) ? 1 : 0;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_uxf_setAppUpdateCb:
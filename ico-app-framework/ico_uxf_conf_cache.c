@@ -0,0 +1,886 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   user experiance library(compiled cache of system configuration)
+ *
+ *          The parsed system configuration is written next to the configuration
+ *          file as a relocatable image (no pointers, all references are offsets
+ *          from the top of the image, all strings are interned in one pool).
+ *          Every process maps the image read-only, so the pages are shared.
+ *          The image is rebuilt only when the configuration file was changed.
+ *
+ * @date    Feb-28-2013
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#include "ico_apf_log.h"
+#include "ico_apf_apimacro.h"
+#include "ico_uxf_conf_common.h"
+
+/*==============================================================================*/
+/* define                                                                       */
+/*==============================================================================*/
+#define ICO_UXF_CONF_CACHE_MAGIC    "ICOSYSC"   /* image magic (8 bytes with NULL)  */
+#define ICO_UXF_CONF_CACHE_VERSION  4           /* image format version             */
+#define ICO_UXF_CONF_CACHE_ALIGN    8           /* alignment of tables in image     */
+
+/* regulation predicate(fixed table in header) */
+typedef struct _conf_cache_regulation {
+    int16_t     signal;
+    int16_t     op;
+    int16_t     valueNum;
+    int16_t     res;
+    double      value[ICO_UXF_REGULATION_VALUE_MAX];
+    double      hysteresis;
+    int32_t     debounce_on;
+    int32_t     debounce_off;
+} conf_cache_regulation;
+
+/* image header                                 */
+typedef struct _conf_cache_head {
+    char        magic[8];                   /* ICO_UXF_CONF_CACHE_MAGIC         */
+    uint32_t    version;                    /* ICO_UXF_CONF_CACHE_VERSION       */
+    uint32_t    abi;                        /* size check of the image records  */
+    uint32_t    size;                       /* total size of the image          */
+    uint32_t    strpool;                    /* offset of the string pool        */
+    uint32_t    strsize;                    /* size of the string pool          */
+    uint32_t    res;                        /* (unused)                         */
+    uint64_t    src_mtime;                  /* modify time of source(sec)       */
+    uint64_t    src_mtime_nsec;             /* modify time of source(nano sec)  */
+    uint64_t    src_size;                   /* size of source file              */
+    uint64_t    src_ino;                    /* inode number of source file      */
+    int32_t     loglevel;
+    int32_t     logflush;
+    int32_t     logbinary;
+    int32_t     appscontrollerport;
+    int32_t     soundpluginport;
+    int16_t     default_hostId;
+    int16_t     default_kindId;
+    int16_t     default_categoryId;
+    int16_t     default_displayId;
+    int16_t     default_layerId;
+    int16_t     default_dispzoneId;
+    int16_t     default_soundId;
+    int16_t     default_soundzoneId;
+    int16_t     default_inputdevId;
+    int16_t     default_inputswId;
+    int16_t     hostNum;
+    int16_t     categoryNum;
+    int16_t     kindNum;
+    int16_t     displayNum;
+    int16_t     soundNum;
+    int16_t     inputdevNum;
+    uint32_t    host;                       /* offset of conf_cache_host[]      */
+    uint32_t    category;                   /* offset of conf_cache_category[]  */
+    uint32_t    kind;                       /* offset of conf_cache_kind[]      */
+    uint32_t    display;                    /* offset of conf_cache_display[]   */
+    uint32_t    sound;                      /* offset of conf_cache_sound[]     */
+    uint32_t    inputdev;                   /* offset of conf_cache_inputdev[]  */
+    conf_cache_regulation regulation[ICO_UXF_REGULATION_MAX];
+} conf_cache_head;
+
+/* image records, strings are offsets in the string pool(0 is NULL) */
+typedef struct _conf_cache_host {
+    int32_t     id;
+    uint32_t    name;
+    uint32_t    address;
+    uint32_t    homescreen;
+    int32_t     type;
+} conf_cache_host;
+
+typedef struct _conf_cache_category {
+    int32_t     id;
+    uint32_t    name;
+    int16_t     view;
+    int16_t     type;
+    int16_t     sound;
+    int16_t     input;
+    int16_t     priority;
+    int16_t     replymin;
+    int16_t     replymax;
+    int16_t     res;
+} conf_cache_category;
+
+typedef struct _conf_cache_kind {
+    int32_t     id;
+    uint32_t    name;
+    int16_t     priv;
+    int16_t     priority;
+} conf_cache_kind;
+
+typedef struct _conf_cache_layer {
+    int32_t     id;
+    uint32_t    name;
+    int32_t     menuoverlap;
+} conf_cache_layer;
+
+typedef struct _conf_cache_dispzone {
+    int32_t     id;
+    uint32_t    name;
+    int16_t     x;
+    int16_t     y;
+    int16_t     width;
+    int16_t     height;
+    int16_t     zoneidx;
+    uint8_t     overlapNum;
+    uint8_t     overlap[ZONE_MAX_OVERLAP];
+} conf_cache_dispzone;
+
+typedef struct _conf_cache_display {
+    int32_t     id;
+    uint32_t    name;
+    uint32_t    wayland;
+    int16_t     hostId;
+    int16_t     displayno;
+    int16_t     type;
+    int16_t     width;
+    int16_t     height;
+    int16_t     inch;
+    int16_t     layerNum;
+    int16_t     zoneNum;
+    uint32_t    layer;                      /* offset of conf_cache_layer[]     */
+    uint32_t    zone;                       /* offset of conf_cache_dispzone[]  */
+} conf_cache_display;
+
+typedef struct _conf_cache_soundzone {
+    int32_t     id;
+    uint32_t    name;
+    int16_t     zoneidx;
+    uint8_t     overlapNum;
+    uint8_t     overlap[ZONE_MAX_OVERLAP];
+} conf_cache_soundzone;
+
+typedef struct _conf_cache_sound {
+    int32_t     id;
+    uint32_t    name;
+    int16_t     hostId;
+    int16_t     soundno;
+    int16_t     type;
+    int16_t     zoneNum;
+    uint32_t    zone;                       /* offset of conf_cache_soundzone[] */
+} conf_cache_sound;
+
+typedef struct _conf_cache_inputsw {
+    uint32_t    name;
+    uint32_t    appid;
+} conf_cache_inputsw;
+
+typedef struct _conf_cache_inputdev {
+    int32_t     id;
+    uint32_t    name;
+    int16_t     inputswNum;
+    int16_t     res;
+    uint32_t    inputsw;                    /* offset of conf_cache_inputsw[]   */
+} conf_cache_inputdev;
+
+/* image builder                                */
+typedef struct _conf_cache_builder {
+    GByteArray  *image;                     /* tables                           */
+    GByteArray  *pool;                      /* string pool                      */
+    GHashTable  *intern;                    /* string => offset in pool         */
+} conf_cache_builder;
+
+/*==============================================================================*/
+/* static tables                                                                */
+/*==============================================================================*/
+static void     *cache_image = NULL;        /* mapped image                     */
+static size_t   cache_size = 0;             /* size of mapped image             */
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_cache_abi: size check value of the image records(static function)
+ *
+ * @param       none
+ * @return      check value
+ */
+/*--------------------------------------------------------------------------*/
+static uint32_t
+conf_cache_abi(void)
+{
+    return (uint32_t)(sizeof(conf_cache_head) + sizeof(conf_cache_host) +
+                      sizeof(conf_cache_category) + sizeof(conf_cache_kind) +
+                      sizeof(conf_cache_layer) + sizeof(conf_cache_dispzone) +
+                      sizeof(conf_cache_display) + sizeof(conf_cache_soundzone) +
+                      sizeof(conf_cache_sound) + sizeof(conf_cache_inputsw) +
+                      sizeof(conf_cache_inputdev) + sizeof(conf_cache_regulation)) |
+           ((uint32_t)ZONE_MAX_OVERLAP << 24);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_cache_alloc: allocate a zero cleared table in the image(static function)
+ *
+ * @param[in]   b               image builder
+ * @param[in]   size            table size
+ * @return      offset of the table from top of image
+ */
+/*--------------------------------------------------------------------------*/
+static uint32_t
+conf_cache_alloc(conf_cache_builder *b, const size_t size)
+{
+    uint32_t    offset;
+
+    offset = (b->image->len + ICO_UXF_CONF_CACHE_ALIGN - 1)
+             & ~(ICO_UXF_CONF_CACHE_ALIGN - 1);
+    g_byte_array_set_size(b->image, offset + size);
+    memset(b->image->data + offset, 0, size);
+    return offset;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_cache_str: intern a string into the string pool(static function)
+ *
+ * @param[in]   b               image builder
+ * @param[in]   str             string(NULL allowed)
+ * @return      offset in string pool
+ * @retval      0               NULL string
+ * @retval      > 0             offset of interned string
+ */
+/*--------------------------------------------------------------------------*/
+static uint32_t
+conf_cache_str(conf_cache_builder *b, const char *str)
+{
+    gpointer    offset;
+    uint32_t    newoffset;
+
+    if (! str)  {
+        return 0;
+    }
+    offset = g_hash_table_lookup(b->intern, str);
+    if (offset) {
+        return GPOINTER_TO_UINT(offset);
+    }
+    newoffset = b->pool->len;
+    g_byte_array_append(b->pool, (const guint8 *)str, strlen(str) + 1);
+    g_hash_table_insert(b->intern, (gpointer)str, GUINT_TO_POINTER(newoffset));
+    return newoffset;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_cache_rec: get address of the record in the image(static function)
+ *
+ * @param[in]   b               image builder
+ * @param[in]   offset          offset of table
+ * @param[in]   idx             index of record
+ * @param[in]   size            size of record
+ * @return      address of record(valid until the next conf_cache_alloc)
+ */
+/*--------------------------------------------------------------------------*/
+static void *
+conf_cache_rec(conf_cache_builder *b, const uint32_t offset, const int idx, const size_t size)
+{
+    return b->image->data + offset + (size * idx);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_saveCache: write the compiled image of system configuration
+ *
+ * @param[in]   cachefile       image file name
+ * @param[in]   src             status of the source configuration file
+ * @param[in]   conf            parsed system configuration
+ * @return      result
+ * @retval      ICO_UXF_EOK     success
+ * @retval      ICO_UXF_EIO     error(can not write image file)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_uxf_conf_saveCache(const char *cachefile, const struct stat *src,
+                       const Ico_Uxf_Sys_Config *conf)
+{
+    conf_cache_builder  b;
+    conf_cache_head     *head;
+    uint32_t    offset;
+    uint32_t    tbl;
+    char        tmpfile[ICO_UXF_CONF_DIR_MAX+64];
+    FILE        *fp;
+    int         i, j;
+    int         ret = ICO_UXF_EOK;
+
+    apfw_trace("ico_uxf_conf_saveCache: Enter(%s)", cachefile);
+
+    b.image = g_byte_array_new();
+    b.pool = g_byte_array_new();
+    b.intern = g_hash_table_new(g_str_hash, g_str_equal);
+    g_byte_array_append(b.pool, (const guint8 *)"", 1);     /* offset 0 is NULL */
+
+    (void)conf_cache_alloc(&b, sizeof(conf_cache_head));
+
+    /* host                 */
+    tbl = conf_cache_alloc(&b, sizeof(conf_cache_host) * conf->hostNum);
+    ((conf_cache_head *)b.image->data)->host = tbl;
+    for (i = 0; i < conf->hostNum; i++) {
+        conf_cache_host *rec = conf_cache_rec(&b, tbl, i, sizeof(conf_cache_host));
+        rec->id = conf->host[i].id;
+        rec->name = conf_cache_str(&b, conf->host[i].name);
+        rec->address = conf_cache_str(&b, conf->host[i].address);
+        rec->homescreen = conf_cache_str(&b, conf->host[i].homescreen);
+        rec->type = conf->host[i].type;
+    }
+
+    /* category             */
+    tbl = conf_cache_alloc(&b, sizeof(conf_cache_category) * conf->categoryNum);
+    ((conf_cache_head *)b.image->data)->category = tbl;
+    for (i = 0; i < conf->categoryNum; i++) {
+        conf_cache_category *rec = conf_cache_rec(&b, tbl, i, sizeof(conf_cache_category));
+        rec->id = conf->category[i].id;
+        rec->name = conf_cache_str(&b, conf->category[i].name);
+        rec->view = conf->category[i].view;
+        rec->type = conf->category[i].type;
+        rec->sound = conf->category[i].sound;
+        rec->input = conf->category[i].input;
+        rec->priority = conf->category[i].priority;
+        rec->replymin = conf->category[i].replymin;
+        rec->replymax = conf->category[i].replymax;
+    }
+
+    /* kind                 */
+    tbl = conf_cache_alloc(&b, sizeof(conf_cache_kind) * conf->kindNum);
+    ((conf_cache_head *)b.image->data)->kind = tbl;
+    for (i = 0; i < conf->kindNum; i++) {
+        conf_cache_kind *rec = conf_cache_rec(&b, tbl, i, sizeof(conf_cache_kind));
+        rec->id = conf->kind[i].id;
+        rec->name = conf_cache_str(&b, conf->kind[i].name);
+        rec->priv = conf->kind[i].priv;
+        rec->priority = conf->kind[i].priority;
+    }
+
+    /* display, layer and zone  */
+    tbl = conf_cache_alloc(&b, sizeof(conf_cache_display) * conf->displayNum);
+    ((conf_cache_head *)b.image->data)->display = tbl;
+    for (i = 0; i < conf->displayNum; i++) {
+        Ico_Uxf_conf_display *display = &conf->display[i];
+        conf_cache_display *rec = conf_cache_rec(&b, tbl, i, sizeof(conf_cache_display));
+        rec->id = display->id;
+        rec->name = conf_cache_str(&b, display->name);
+        rec->wayland = conf_cache_str(&b, display->wayland);
+        rec->hostId = display->hostId;
+        rec->displayno = display->displayno;
+        rec->type = display->type;
+        rec->width = display->width;
+        rec->height = display->height;
+        rec->inch = display->inch;
+        rec->layerNum = display->layerNum;
+        rec->zoneNum = display->zoneNum;
+
+        offset = conf_cache_alloc(&b, sizeof(conf_cache_layer) * display->layerNum);
+        ((conf_cache_display *)conf_cache_rec(&b, tbl, i,
+                                              sizeof(conf_cache_display)))->layer = offset;
+        for (j = 0; j < display->layerNum; j++) {
+            conf_cache_layer *layer = conf_cache_rec(&b, offset, j, sizeof(conf_cache_layer));
+            layer->id = display->layer[j].id;
+            layer->name = conf_cache_str(&b, display->layer[j].name);
+            layer->menuoverlap = display->layer[j].menuoverlap;
+        }
+
+        offset = conf_cache_alloc(&b, sizeof(conf_cache_dispzone) * display->zoneNum);
+        ((conf_cache_display *)conf_cache_rec(&b, tbl, i,
+                                              sizeof(conf_cache_display)))->zone = offset;
+        for (j = 0; j < display->zoneNum; j++)  {
+            conf_cache_dispzone *zone = conf_cache_rec(&b, offset, j,
+                                                       sizeof(conf_cache_dispzone));
+            zone->id = display->zone[j].id;
+            zone->name = conf_cache_str(&b, display->zone[j].name);
+            zone->x = display->zone[j].x;
+            zone->y = display->zone[j].y;
+            zone->width = display->zone[j].width;
+            zone->height = display->zone[j].height;
+            zone->zoneidx = display->zone[j].zoneidx;
+            zone->overlapNum = display->zone[j].overlapNum;
+            memcpy(zone->overlap, display->zone[j].overlap, ZONE_MAX_OVERLAP);
+        }
+    }
+
+    /* sound and zone       */
+    tbl = conf_cache_alloc(&b, sizeof(conf_cache_sound) * conf->soundNum);
+    ((conf_cache_head *)b.image->data)->sound = tbl;
+    for (i = 0; i < conf->soundNum; i++)    {
+        Ico_Uxf_conf_sound *sound = &conf->sound[i];
+        conf_cache_sound *rec = conf_cache_rec(&b, tbl, i, sizeof(conf_cache_sound));
+        rec->id = sound->id;
+        rec->name = conf_cache_str(&b, sound->name);
+        rec->hostId = sound->hostId;
+        rec->soundno = sound->soundno;
+        rec->type = sound->type;
+        rec->zoneNum = sound->zoneNum;
+
+        offset = conf_cache_alloc(&b, sizeof(conf_cache_soundzone) * sound->zoneNum);
+        ((conf_cache_sound *)conf_cache_rec(&b, tbl, i,
+                                            sizeof(conf_cache_sound)))->zone = offset;
+        for (j = 0; j < sound->zoneNum; j++)    {
+            conf_cache_soundzone *zone = conf_cache_rec(&b, offset, j,
+                                                        sizeof(conf_cache_soundzone));
+            zone->id = sound->zone[j].id;
+            zone->name = conf_cache_str(&b, sound->zone[j].name);
+            zone->zoneidx = sound->zone[j].zoneidx;
+            zone->overlapNum = sound->zone[j].overlapNum;
+            memcpy(zone->overlap, sound->zone[j].overlap, ZONE_MAX_OVERLAP);
+        }
+    }
+
+    /* input device and switch  */
+    tbl = conf_cache_alloc(&b, sizeof(conf_cache_inputdev) * conf->inputdevNum);
+    ((conf_cache_head *)b.image->data)->inputdev = tbl;
+    for (i = 0; i < conf->inputdevNum; i++) {
+        Ico_Uxf_conf_inputdev *inputdev = &conf->inputdev[i];
+        conf_cache_inputdev *rec = conf_cache_rec(&b, tbl, i, sizeof(conf_cache_inputdev));
+        rec->id = inputdev->id;
+        rec->name = conf_cache_str(&b, inputdev->name);
+        rec->inputswNum = inputdev->inputswNum;
+
+        offset = conf_cache_alloc(&b, sizeof(conf_cache_inputsw) * inputdev->inputswNum);
+        ((conf_cache_inputdev *)conf_cache_rec(&b, tbl, i,
+                                               sizeof(conf_cache_inputdev)))->inputsw = offset;
+        for (j = 0; j < inputdev->inputswNum; j++)  {
+            conf_cache_inputsw *sw = conf_cache_rec(&b, offset, j,
+                                                    sizeof(conf_cache_inputsw));
+            sw->name = conf_cache_str(&b, inputdev->inputsw[j].name);
+            sw->appid = conf_cache_str(&b, inputdev->inputsw[j].appid);
+        }
+    }
+
+    /* string pool at the end of image  */
+    offset = conf_cache_alloc(&b, b.pool->len);
+    memcpy(b.image->data + offset, b.pool->data, b.pool->len);
+
+    head = (conf_cache_head *)b.image->data;
+    memcpy(head->magic, ICO_UXF_CONF_CACHE_MAGIC, sizeof(head->magic));
+    head->version = ICO_UXF_CONF_CACHE_VERSION;
+    head->abi = conf_cache_abi();
+    head->size = b.image->len;
+    head->strpool = offset;
+    head->strsize = b.pool->len;
+    head->src_mtime = (uint64_t)src->st_mtim.tv_sec;
+    head->src_mtime_nsec = (uint64_t)src->st_mtim.tv_nsec;
+    head->src_size = (uint64_t)src->st_size;
+    head->src_ino = (uint64_t)src->st_ino;
+    head->loglevel = conf->misc.loglevel;
+    head->logflush = conf->misc.logflush;
+    head->logbinary = conf->misc.logbinary;
+    head->appscontrollerport = conf->misc.appscontrollerport;
+    head->soundpluginport = conf->misc.soundpluginport;
+    head->default_hostId = conf->misc.default_hostId;
+    head->default_kindId = conf->misc.default_kindId;
+    head->default_categoryId = conf->misc.default_categoryId;
+    head->default_displayId = conf->misc.default_displayId;
+    head->default_layerId = conf->misc.default_layerId;
+    head->default_dispzoneId = conf->misc.default_dispzoneId;
+    head->default_soundId = conf->misc.default_soundId;
+    head->default_soundzoneId = conf->misc.default_soundzoneId;
+    head->default_inputdevId = conf->misc.default_inputdevId;
+    head->default_inputswId = conf->misc.default_inputswId;
+    head->hostNum = conf->hostNum;
+    head->categoryNum = conf->categoryNum;
+    head->kindNum = conf->kindNum;
+    head->displayNum = conf->displayNum;
+    head->soundNum = conf->soundNum;
+    head->inputdevNum = conf->inputdevNum;
+    for (i = 0; i < ICO_UXF_REGULATION_MAX; i++)    {
+        head->regulation[i].signal = conf->regulation[i].signal;
+        head->regulation[i].op = conf->regulation[i].op;
+        head->regulation[i].valueNum = conf->regulation[i].valueNum;
+        memcpy(head->regulation[i].value, conf->regulation[i].value,
+               sizeof(head->regulation[i].value));
+        head->regulation[i].hysteresis = conf->regulation[i].hysteresis;
+        head->regulation[i].debounce_on = conf->regulation[i].debounce_on;
+        head->regulation[i].debounce_off = conf->regulation[i].debounce_off;
+    }
+
+    /* write to temporary file and rename, mapped images of other process   */
+    /* are not changed                                                      */
+    snprintf(tmpfile, sizeof(tmpfile), "%s.%d", cachefile, getpid());
+    fp = fopen(tmpfile, "wb");
+    if (! fp)   {
+        apfw_trace("ico_uxf_conf_saveCache: Leave(can not create %s, errno=%d)",
+                   tmpfile, errno);
+        ret = ICO_UXF_EIO;
+    }
+    else    {
+        if ((fwrite(b.image->data, 1, b.image->len, fp) != b.image->len) ||
+            (fclose(fp) != 0))  {
+            apfw_warn("ico_uxf_conf_saveCache: can not write %s", tmpfile);
+            (void) unlink(tmpfile);
+            ret = ICO_UXF_EIO;
+        }
+        else if (rename(tmpfile, cachefile) != 0)   {
+            apfw_warn("ico_uxf_conf_saveCache: can not rename to %s(errno=%d)",
+                      cachefile, errno);
+            (void) unlink(tmpfile);
+            ret = ICO_UXF_EIO;
+        }
+        else    {
+            apfw_trace("ico_uxf_conf_saveCache: Leave(EOK, size=%d strings=%d)",
+                       b.image->len, b.pool->len);
+        }
+    }
+
+    g_hash_table_destroy(b.intern);
+    g_byte_array_free(b.pool, TRUE);
+    g_byte_array_free(b.image, TRUE);
+    return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_cache_table: check and get a table in the image(static function)
+ *
+ * @param[in]   head            image header
+ * @param[in]   offset          offset of table
+ * @param[in]   num             number of records
+ * @param[in]   size            size of record
+ * @return      table address
+ * @retval      != NULL         success
+ * @retval      == NULL         error(table is out of image)
+ */
+/*--------------------------------------------------------------------------*/
+static const void *
+conf_cache_table(const conf_cache_head *head, const uint32_t offset,
+                 const int num, const size_t size)
+{
+    if ((num < 0) || (offset < sizeof(conf_cache_head)) ||
+        ((uint64_t)offset + ((uint64_t)num * size) > head->strpool))  {
+        return NULL;
+    }
+    return (const char *)head + offset;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_cache_getstr: get string in the image(static function)
+ *
+ * @param[in]   head            image header
+ * @param[in]   offset          offset in string pool
+ * @return      string address in image(read only)
+ * @retval      NULL            NULL string or illegal offset
+ */
+/*--------------------------------------------------------------------------*/
+static char *
+conf_cache_getstr(const conf_cache_head *head, const uint32_t offset)
+{
+    if ((offset == 0) || (offset >= head->strsize)) {
+        return NULL;
+    }
+    return (char *)head + head->strpool + offset;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_loadCache: map the compiled image of system configuration
+ *
+ * @param[in]   cachefile       image file name
+ * @param[in]   src             status of the source configuration file
+ * @param[out]  conf            system configuration(strings point into the image)
+ * @return      result
+ * @retval      ICO_UXF_EOK     success
+ * @retval      ICO_UXF_ENOENT  error(image does not exist)
+ * @retval      ICO_UXF_EBADF   error(image is old or broken)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_uxf_conf_loadCache(const char *cachefile, const struct stat *src,
+                       Ico_Uxf_Sys_Config *conf)
+{
+    struct stat         st;
+    const conf_cache_head     *head;
+    const conf_cache_host     *host;
+    const conf_cache_category *category;
+    const conf_cache_kind     *kind;
+    const conf_cache_display  *display;
+    const conf_cache_sound    *sound;
+    const conf_cache_inputdev *inputdev;
+    void    *image;
+    int     fd;
+    int     i, j;
+
+    apfw_trace("ico_uxf_conf_loadCache: Enter(%s)", cachefile);
+
+    fd = open(cachefile, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        apfw_trace("ico_uxf_conf_loadCache: Leave(ENOENT)");
+        return ICO_UXF_ENOENT;
+    }
+    if ((fstat(fd, &st) < 0) || (st.st_size < (off_t)sizeof(conf_cache_head)))  {
+        close(fd);
+        apfw_trace("ico_uxf_conf_loadCache: Leave(EBADF, no header)");
+        return ICO_UXF_EBADF;
+    }
+    image = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED)    {
+        apfw_warn("ico_uxf_conf_loadCache: Leave(EBADF, mmap errno=%d)", errno);
+        return ICO_UXF_EBADF;
+    }
+
+    /* check image and source file status   */
+    head = (const conf_cache_head *)image;
+    if ((memcmp(head->magic, ICO_UXF_CONF_CACHE_MAGIC, sizeof(head->magic)) != 0) ||
+        (head->version != ICO_UXF_CONF_CACHE_VERSION) ||
+        (head->abi != conf_cache_abi()) ||
+        (head->size != (uint32_t)st.st_size) ||
+        (head->strsize == 0) ||
+        ((uint64_t)head->strpool + head->strsize != head->size) ||
+        (((const char *)image)[head->size - 1] != 0))    {
+        munmap(image, st.st_size);
+        apfw_trace("ico_uxf_conf_loadCache: Leave(EBADF, illegal image)");
+        return ICO_UXF_EBADF;
+    }
+    if ((head->src_mtime != (uint64_t)src->st_mtim.tv_sec) ||
+        (head->src_mtime_nsec != (uint64_t)src->st_mtim.tv_nsec) ||
+        (head->src_size != (uint64_t)src->st_size) ||
+        (head->src_ino != (uint64_t)src->st_ino))   {
+        munmap(image, st.st_size);
+        apfw_trace("ico_uxf_conf_loadCache: Leave(EBADF, configuration changed)");
+        return ICO_UXF_EBADF;
+    }
+
+    host = conf_cache_table(head, head->host, head->hostNum, sizeof(*host));
+    category = conf_cache_table(head, head->category, head->categoryNum, sizeof(*category));
+    kind = conf_cache_table(head, head->kind, head->kindNum, sizeof(*kind));
+    display = conf_cache_table(head, head->display, head->displayNum, sizeof(*display));
+    sound = conf_cache_table(head, head->sound, head->soundNum, sizeof(*sound));
+    inputdev = conf_cache_table(head, head->inputdev, head->inputdevNum, sizeof(*inputdev));
+    if ((! host) || (! category) || (! kind) || (! display) || (! sound) || (! inputdev)) {
+        munmap(image, st.st_size);
+        apfw_warn("ico_uxf_conf_loadCache: Leave(EBADF, illegal table)");
+        return ICO_UXF_EBADF;
+    }
+    for (i = 0; i < head->displayNum; i++)  {
+        if ((display[i].layerNum > ICO_UXF_DISPLAY_LAYER_MAX) ||
+            (display[i].zoneNum > ICO_UXF_DISPLAY_ZONE_MAX) ||
+            (! conf_cache_table(head, display[i].layer, display[i].layerNum,
+                                sizeof(conf_cache_layer))) ||
+            (! conf_cache_table(head, display[i].zone, display[i].zoneNum,
+                                sizeof(conf_cache_dispzone))))    {
+            break;
+        }
+    }
+    for (j = 0; j < head->soundNum; j++)    {
+        if ((sound[j].zoneNum > ICO_UXF_SOUND_ZONE_MAX) ||
+            (! conf_cache_table(head, sound[j].zone, sound[j].zoneNum,
+                                sizeof(conf_cache_soundzone))))   {
+            break;
+        }
+    }
+    if ((i < head->displayNum) || (j < head->soundNum)) {
+        munmap(image, st.st_size);
+        apfw_warn("ico_uxf_conf_loadCache: Leave(EBADF, illegal zone table)");
+        return ICO_UXF_EBADF;
+    }
+    for (i = 0; i < head->inputdevNum; i++) {
+        if (! conf_cache_table(head, inputdev[i].inputsw, inputdev[i].inputswNum,
+                               sizeof(conf_cache_inputsw)))  {
+            munmap(image, st.st_size);
+            apfw_warn("ico_uxf_conf_loadCache: Leave(EBADF, illegal switch table)");
+            return ICO_UXF_EBADF;
+        }
+    }
+
+    for (i = 0; i < ICO_UXF_REGULATION_MAX; i++)    {
+        if ((head->regulation[i].signal < 0) ||
+            (head->regulation[i].signal >= ICO_UXF_REGULATION_SIG_MAX) ||
+            (head->regulation[i].op < ICO_UXF_REGULATION_OP_EQ) ||
+            (head->regulation[i].op > ICO_UXF_REGULATION_OP_LT) ||
+            (head->regulation[i].valueNum <= 0) ||
+            (head->regulation[i].valueNum > ICO_UXF_REGULATION_VALUE_MAX))  {
+            munmap(image, st.st_size);
+            apfw_warn("ico_uxf_conf_loadCache: Leave(EBADF, illegal regulation)");
+            return ICO_UXF_EBADF;
+        }
+    }
+
+    /* misc                 */
+    conf->misc.loglevel = head->loglevel;
+    conf->misc.logflush = head->logflush;
+    conf->misc.logbinary = head->logbinary;
+    conf->misc.appscontrollerport = head->appscontrollerport;
+    conf->misc.soundpluginport = head->soundpluginport;
+    conf->misc.default_hostId = head->default_hostId;
+    conf->misc.default_kindId = head->default_kindId;
+    conf->misc.default_categoryId = head->default_categoryId;
+    conf->misc.default_displayId = head->default_displayId;
+    conf->misc.default_layerId = head->default_layerId;
+    conf->misc.default_dispzoneId = head->default_dispzoneId;
+    conf->misc.default_soundId = head->default_soundId;
+    conf->misc.default_soundzoneId = head->default_soundzoneId;
+    conf->misc.default_inputdevId = head->default_inputdevId;
+    conf->misc.default_inputswId = head->default_inputswId;
+
+    /* regulation           */
+    for (i = 0; i < ICO_UXF_REGULATION_MAX; i++)    {
+        conf->regulation[i].signal = head->regulation[i].signal;
+        conf->regulation[i].op = head->regulation[i].op;
+        conf->regulation[i].valueNum = head->regulation[i].valueNum;
+        memcpy(conf->regulation[i].value, head->regulation[i].value,
+               sizeof(conf->regulation[i].value));
+        conf->regulation[i].hysteresis = head->regulation[i].hysteresis;
+        conf->regulation[i].debounce_on = head->regulation[i].debounce_on;
+        conf->regulation[i].debounce_off = head->regulation[i].debounce_off;
+    }
+
+    /* host                 */
+    conf->hostNum = head->hostNum;
+    conf->host = g_malloc0(sizeof(Ico_Uxf_conf_host) * head->hostNum);
+    for (i = 0; i < head->hostNum; i++) {
+        conf->host[i].id = host[i].id;
+        conf->host[i].name = conf_cache_getstr(head, host[i].name);
+        conf->host[i].address = conf_cache_getstr(head, host[i].address);
+        conf->host[i].homescreen = conf_cache_getstr(head, host[i].homescreen);
+        conf->host[i].type = host[i].type;
+    }
+
+    /* category             */
+    conf->categoryNum = head->categoryNum;
+    conf->category = g_malloc0(sizeof(Ico_Uxf_conf_category) * head->categoryNum);
+    for (i = 0; i < head->categoryNum; i++) {
+        conf->category[i].id = category[i].id;
+        conf->category[i].name = conf_cache_getstr(head, category[i].name);
+        conf->category[i].view = category[i].view;
+        conf->category[i].type = category[i].type;
+        conf->category[i].sound = category[i].sound;
+        conf->category[i].input = category[i].input;
+        conf->category[i].priority = category[i].priority;
+        conf->category[i].replymin = category[i].replymin;
+        conf->category[i].replymax = category[i].replymax;
+    }
+
+    /* kind                 */
+    conf->kindNum = head->kindNum;
+    conf->kind = g_malloc0(sizeof(Ico_Uxf_conf_kind) * head->kindNum);
+    for (i = 0; i < head->kindNum; i++) {
+        conf->kind[i].id = kind[i].id;
+        conf->kind[i].name = conf_cache_getstr(head, kind[i].name);
+        conf->kind[i].priv = kind[i].priv;
+        conf->kind[i].priority = kind[i].priority;
+    }
+
+    /* display, layer and zone  */
+    conf->displayNum = head->displayNum;
+    conf->display = g_malloc0(sizeof(Ico_Uxf_conf_display) * head->displayNum);
+    for (i = 0; i < head->displayNum; i++) {
+        Ico_Uxf_conf_display *dp = &conf->display[i];
+        const conf_cache_layer *layer = (const conf_cache_layer *)
+                                        ((const char *)image + display[i].layer);
+        const conf_cache_dispzone *zone = (const conf_cache_dispzone *)
+                                          ((const char *)image + display[i].zone);
+        dp->id = display[i].id;
+        dp->name = conf_cache_getstr(head, display[i].name);
+        dp->wayland = conf_cache_getstr(head, display[i].wayland);
+        dp->hostId = display[i].hostId;
+        dp->displayno = display[i].displayno;
+        dp->type = display[i].type;
+        dp->width = display[i].width;
+        dp->height = display[i].height;
+        dp->inch = display[i].inch;
+        dp->layerNum = display[i].layerNum;
+        dp->zoneNum = display[i].zoneNum;
+
+        dp->layer = g_malloc0(sizeof(Ico_Uxf_conf_display_layer) * dp->layerNum);
+        for (j = 0; j < dp->layerNum; j++)  {
+            dp->layer[j].id = layer[j].id;
+            dp->layer[j].name = conf_cache_getstr(head, layer[j].name);
+            dp->layer[j].menuoverlap = layer[j].menuoverlap;
+        }
+        dp->zone = g_malloc0(sizeof(Ico_Uxf_conf_display_zone) * dp->zoneNum);
+        for (j = 0; j < dp->zoneNum; j++)   {
+            dp->zone[j].id = zone[j].id;
+            dp->zone[j].name = conf_cache_getstr(head, zone[j].name);
+            dp->zone[j].x = zone[j].x;
+            dp->zone[j].y = zone[j].y;
+            dp->zone[j].width = zone[j].width;
+            dp->zone[j].height = zone[j].height;
+            dp->zone[j].zoneidx = zone[j].zoneidx;
+            dp->zone[j].display = dp;
+            dp->zone[j].overlapNum = zone[j].overlapNum;
+            memcpy(dp->zone[j].overlap, zone[j].overlap, ZONE_MAX_OVERLAP);
+        }
+    }
+
+    /* sound and zone       */
+    conf->soundNum = head->soundNum;
+    conf->sound = g_malloc0(sizeof(Ico_Uxf_conf_sound) * head->soundNum);
+    for (i = 0; i < head->soundNum; i++) {
+        Ico_Uxf_conf_sound *sp = &conf->sound[i];
+        const conf_cache_soundzone *zone = (const conf_cache_soundzone *)
+                                           ((const char *)image + sound[i].zone);
+        sp->id = sound[i].id;
+        sp->name = conf_cache_getstr(head, sound[i].name);
+        sp->hostId = sound[i].hostId;
+        sp->soundno = sound[i].soundno;
+        sp->type = sound[i].type;
+        sp->zoneNum = sound[i].zoneNum;
+
+        sp->zone = g_malloc0(sizeof(Ico_Uxf_conf_sound_zone) * sp->zoneNum);
+        for (j = 0; j < sp->zoneNum; j++)   {
+            sp->zone[j].id = zone[j].id;
+            sp->zone[j].name = conf_cache_getstr(head, zone[j].name);
+            sp->zone[j].zoneidx = zone[j].zoneidx;
+            sp->zone[j].sound = sp;
+            sp->zone[j].overlapNum = zone[j].overlapNum;
+            memcpy(sp->zone[j].overlap, zone[j].overlap, ZONE_MAX_OVERLAP);
+        }
+    }
+
+    /* input device and switch  */
+    conf->inputdevNum = head->inputdevNum;
+    conf->inputdev = g_malloc0(sizeof(Ico_Uxf_conf_inputdev) * head->inputdevNum);
+    for (i = 0; i < head->inputdevNum; i++) {
+        Ico_Uxf_conf_inputdev *ip = &conf->inputdev[i];
+        const conf_cache_inputsw *sw = (const conf_cache_inputsw *)
+                                       ((const char *)image + inputdev[i].inputsw);
+        ip->id = inputdev[i].id;
+        ip->name = conf_cache_getstr(head, inputdev[i].name);
+        ip->inputswNum = inputdev[i].inputswNum;
+
+        ip->inputsw = g_malloc0(sizeof(Ico_Uxf_conf_inputsw) * ip->inputswNum);
+        for (j = 0; j < ip->inputswNum; j++)    {
+            ip->inputsw[j].inputdev = ip;
+            ip->inputsw[j].name = conf_cache_getstr(head, sw[j].name);
+            ip->inputsw[j].appid = conf_cache_getstr(head, sw[j].appid);
+        }
+    }
+
+    /* keep the image mapped while the configuration is used    */
+    ico_uxf_conf_releaseCache();
+    cache_image = image;
+    cache_size = st.st_size;
+
+    apfw_trace("ico_uxf_conf_loadCache: Leave(EOK, size=%d)", (int)st.st_size);
+    return ICO_UXF_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_releaseCache: unmap the compiled image of system configuration
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_uxf_conf_releaseCache(void)
+{
+    if (cache_image)    {
+        munmap(cache_image, cache_size);
+        cache_image = NULL;
+        cache_size = 0;
+    }
+}
+
@@ -51,6 +51,53 @@ ico_uxf_misc_hashByName(const char *name)
     return hash & (ICO_UXF_MISC_HASHSIZE-1);
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_misc_intern: get a process-wide unique string(atom)
+ *          same strings return same address, so atoms can be compared by
+ *          address(==) instead of strcmp. atom is never released.
+ *
+ * @param[in]   str         string(NULL termination)
+ * @return      atom
+ * @retval      !=NULL      success(unique address of the string)
+ * @retval      ==NULL      str is NULL
+ */
+/*--------------------------------------------------------------------------*/
+const char *
+ico_uxf_misc_intern(const char *str)
+{
+    if (! str)  {
+        return NULL;
+    }
+    return g_intern_string(str);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_misc_findIntern: get an atom of the string, if it was already
+ *          made by ico_uxf_misc_intern(does not make new atom)
+ *
+ * @param[in]   str         string(NULL termination)
+ * @return      atom
+ * @retval      !=NULL      success(unique address of the string)
+ * @retval      ==NULL      string was not interned(or str is NULL)
+ */
+/*--------------------------------------------------------------------------*/
+const char *
+ico_uxf_misc_findIntern(const char *str)
+{
+    GQuark  quark;
+
+    if (! str)  {
+        return NULL;
+    }
+    quark = g_quark_try_string(str);
+    if (quark == 0) {
+        return NULL;
+    }
+    return g_quark_to_string(quark);
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_uxf_conf_getUint: convert value string to value
@@ -105,11 +152,158 @@ ico_uxf_conf_countNumericalKey(GKeyFile *keyfile, const char* group)
     for (i = 0; i < (int)length; i++) {
         int id = ico_uxf_conf_getUint(result[i]);
         if (id >= 0) {
-            list=g_list_append(list,g_strdup(result[i]));
+            list=g_list_prepend(list,g_strdup(result[i]));
         }
     }
     g_strfreev(result);
-    return list;
+    return g_list_reverse(list);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_cmpNumericalKey: compare numerical keys for sort
+ *          (static function)
+ *
+ * @param[in]   a               key index 1
+ * @param[in]   b               key index 2
+ * @param[in]   user_data       key values
+ * @return      result of compare(by key value, same value by order in file)
+ */
+/*--------------------------------------------------------------------------*/
+static gint
+ico_uxf_conf_cmpNumericalKey(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const int   *ids = (const int *)user_data;
+    int     ia = *((const int *)a);
+    int     ib = *((const int *)b);
+
+    if (ids[ia] != ids[ib]) {
+        return (ids[ia] < ids[ib]) ? -1 : 1;
+    }
+    return ia - ib;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_getNumericalKeys: enumerate numerical keys in configuration
+ *          group at once, and sort by key value
+ *
+ * @param[in]   keyfile         configuration file
+ * @param[in]   group           configuration groupe(ex.[display])
+ * @return      numerical keys(release by ico_uxf_conf_freeNumericalKeys)
+ * @retval      !=NULL          success
+ * @retval      ==NULL          error(out of memory)
+ */
+/*--------------------------------------------------------------------------*/
+Ico_Uxf_conf_numkeys *
+ico_uxf_conf_getNumericalKeys(GKeyFile *keyfile, const char *group)
+{
+    Ico_Uxf_conf_numkeys    *keys;
+    gsize   length = 0;
+    int     *ids;
+    int     *order;
+    int     i, num;
+
+    keys = g_try_new0(Ico_Uxf_conf_numkeys, 1);
+    if (! keys) {
+        uifw_error("ico_uxf_conf_getNumericalKeys: No Memory");
+        return NULL;
+    }
+    keys->allkeys = g_key_file_get_keys(keyfile, group, &length, NULL);
+    keys->cur = -1;
+    keys->subkey = g_string_sized_new(64);
+    if ((! keys->allkeys) || (length <= 0)) {
+        return keys;
+    }
+
+    ids = g_new(int, length);
+    order = g_new(int, length);
+    keys->id = g_new(int, length);
+    keys->key = g_new(char *, length);
+
+    num = 0;
+    for (i = 0; i < (int)length; i++)   {
+        ids[i] = ico_uxf_conf_getUint(keys->allkeys[i]);
+        if (ids[i] >= 0)    {
+            order[num++] = i;
+        }
+    }
+    g_qsort_with_data(order, num, sizeof(int), ico_uxf_conf_cmpNumericalKey, ids);
+
+    for (i = 0; i < num; i++)   {
+        keys->id[i] = ids[order[i]];
+        keys->key[i] = keys->allkeys[order[i]];
+    }
+    keys->num = num;
+    g_free(order);
+    g_free(ids);
+    return keys;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_subKey: make sub key of a numerical key(ex. "0.view")
+ *
+ * @param[in]   keys            numerical keys
+ * @param[in]   idx             index of numerical key
+ * @param[in]   suffix          sub key name(ex. ".view")
+ * @return      sub key(it is available until next call with same keys)
+ */
+/*--------------------------------------------------------------------------*/
+const char *
+ico_uxf_conf_subKey(Ico_Uxf_conf_numkeys *keys, const int idx, const char *suffix)
+{
+    if (keys->cur != idx)   {
+        g_string_assign(keys->subkey, keys->key[idx]);
+        keys->cur = idx;
+        keys->curlen = keys->subkey->len;
+    }
+    else    {
+        g_string_truncate(keys->subkey, keys->curlen);
+    }
+    return g_string_append(keys->subkey, suffix)->str;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_subKeyNum: make numbered sub key of a numerical key
+ *          (ex. "0.zone.1")
+ *
+ * @param[in]   keys            numerical keys
+ * @param[in]   idx             index of numerical key
+ * @param[in]   suffix          sub key name(ex. ".zone.")
+ * @param[in]   num             sub key number
+ * @return      sub key(it is available until next call with same keys)
+ */
+/*--------------------------------------------------------------------------*/
+const char *
+ico_uxf_conf_subKeyNum(Ico_Uxf_conf_numkeys *keys, const int idx,
+                       const char *suffix, const int num)
+{
+    (void) ico_uxf_conf_subKey(keys, idx, suffix);
+    g_string_append_printf(keys->subkey, "%d", num);
+    return keys->subkey->str;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_freeNumericalKeys: release numerical keys
+ *
+ * @param[in]   keys            numerical keys(if NULL, nothing to do)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_uxf_conf_freeNumericalKeys(Ico_Uxf_conf_numkeys *keys)
+{
+    if (! keys) {
+        return;
+    }
+    g_free(keys->id);
+    g_free(keys->key);
+    g_strfreev(keys->allkeys);
+    g_string_free(keys->subkey, TRUE);
+    g_free(keys);
 }
 
 /*--------------------------------------------------------------------------*/
@@ -38,11 +38,30 @@ struct _econf_cb_func_info {
     econf_cb_func_info_t *next;
     Ico_Uxf_AppUpdata_Cb func;
 };
+
+typedef struct _econf_sys_cb_info econf_sys_cb_info_t;
+
+struct _econf_sys_cb_info {
+    econf_sys_cb_info_t *next;
+    Ico_Uxf_SysUpdate_Cb func;
+};
+
+/* old system configuration is released after this time(sec), because    */
+/* applications may refer it until they receive the update callback      */
+#define ICO_UXF_ECONF_SYS_GRACE_TIME    10.0
+/* retry interval(sec) of package events that AppCore is not updated yet */
+#define ICO_UXF_ECONF_APP_RETRY_TIME    0.02
 /*==============================================================================*/
 /* define static function prototype                                             */
 /*==============================================================================*/
 static void ico_uxf_econf_updateEvent(const char *appid, int type);
 static Eina_Bool ico_uxf_econf_ecoreEvent(void *data, int type, void *event);
+static void ico_uxf_econf_appRetry(void);
+static Eina_Bool ico_uxf_econf_appRetryTimer(void *data);
+static void ico_uxf_econf_sysNotify(void);
+static void ico_uxf_econf_sysPublish(void *data);
+static Eina_Bool ico_uxf_econf_sysWatch(void *data, Ecore_Fd_Handler *handler);
+static Eina_Bool ico_uxf_econf_sysRelease(void *data);
 
 /*==============================================================================*/
 /* static tables                                                                */
@@ -51,6 +70,10 @@ static int                  econf_event_type = -1;
 static Ecore_Event_Handler   *econf_handle = NULL;
 
 static econf_cb_func_info_t *econf_cb_func = NULL;
+static Ecore_Timer          *econf_retry_timer = NULL;
+
+static Ecore_Fd_Handler     *econf_sys_handle = NULL;
+static econf_sys_cb_info_t  *econf_sys_cb_func = NULL;
 
 /*--------------------------------------------------------------------------*/
 /**
@@ -76,6 +99,7 @@ ico_uxf_econf_setAppUpdateCb(Ico_Uxf_AppUpdata_Cb func)
             apfw_warn("ico_uxf_setAppUpdateCb: cannot add ecore event handler");
             return ICO_UXF_ENOSYS;
         }
+        ico_uxf_conf_setAppRetryCb(ico_uxf_econf_appRetry);
         ico_uxf_conf_setAppUpdateCb(ico_uxf_econf_updateEvent);
     }
     if (func) {
@@ -166,3 +190,192 @@ ico_uxf_econf_ecoreEvent(void *data, int type, void *event)
     return ECORE_CALLBACK_DONE;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_econf_appRetry:
+ *          start retry timer of package events(AppCore is not updated yet)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_uxf_econf_appRetry(void)
+{
+    if (! econf_retry_timer)    {
+        econf_retry_timer = ecore_timer_add(ICO_UXF_ECONF_APP_RETRY_TIME,
+                                            ico_uxf_econf_appRetryTimer, NULL);
+        if (! econf_retry_timer)    {
+            apfw_warn("ico_uxf_econf_appRetry: cannot add timer");
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_econf_appRetryTimer:
+ *          callback function from ecore timer, retry package events
+ *
+ * @param[in]   data            data(unused)
+ * @return      continue timer
+ * @retval      ECORE_CALLBACK_RENEW    retry events remain
+ * @retval      ECORE_CALLBACK_CANCEL   no retry event
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+ico_uxf_econf_appRetryTimer(void *data)
+{
+    if (ico_uxf_conf_retryAppEvent())   {
+        return ECORE_CALLBACK_RENEW;
+    }
+    econf_retry_timer = NULL;
+    return ECORE_CALLBACK_CANCEL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_econf_setSysUpdateCb: set callback function of live reload
+ *          of system configuration. first call starts watch of system.conf.
+ *
+ * @param[in]   func            callback function(if NULL, only start watch)
+ * @return      result
+ * @retval      ICO_UXF_EOK     success
+ * @retval      ICO_UXF_ENOSYS  cannot regist callback
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API int
+ico_uxf_econf_setSysUpdateCb(Ico_Uxf_SysUpdate_Cb func)
+{
+    econf_sys_cb_info_t *func_info;
+    int     fd;
+
+    if (econf_sys_handle == NULL) {
+        fd = ico_uxf_conf_watchSysConfig(ico_uxf_econf_sysNotify);
+        if (fd < 0) {
+            apfw_warn("ico_uxf_econf_setSysUpdateCb: cannot watch system configuration");
+            return ICO_UXF_ENOSYS;
+        }
+        econf_sys_handle = ecore_main_fd_handler_add(fd, ECORE_FD_READ,
+                                                     ico_uxf_econf_sysWatch,
+                                                     NULL, NULL, NULL);
+        if (econf_sys_handle == NULL) {
+            apfw_warn("ico_uxf_econf_setSysUpdateCb: cannot add ecore fd handler");
+            ico_uxf_conf_unwatchSysConfig();
+            return ICO_UXF_ENOSYS;
+        }
+    }
+    if (func) {
+        func_info = malloc(sizeof(econf_sys_cb_info_t));
+        if (! func_info) {
+            apfw_warn("ico_uxf_econf_setSysUpdateCb: cannot allocate memory");
+            return ICO_UXF_ENOSYS;
+        }
+        memset(func_info, 0, sizeof(econf_sys_cb_info_t));
+        func_info->func = func;
+        func_info->next = econf_sys_cb_func;
+        econf_sys_cb_func = func_info;
+    }
+
+    return ICO_UXF_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_econf_sysWatch:
+ *          callback function from ecore when system configuration directory changed
+ *
+ * @param[in]   data            data(unused)
+ * @param[in]   handler         ecore fd handler
+ * @return      always ECORE_CALLBACK_RENEW
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+ico_uxf_econf_sysWatch(void *data, Ecore_Fd_Handler *handler)
+{
+    (void) ico_uxf_conf_readSysWatch();
+
+    return ECORE_CALLBACK_RENEW;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_econf_sysNotify:
+ *          new system configuration is ready(called in reload thread)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_uxf_econf_sysNotify(void)
+{
+    ecore_main_loop_thread_safe_call_async(ico_uxf_econf_sysPublish, NULL);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_econf_sysPublish:
+ *          publish new system configuration and call callback functions
+ *          (called in main loop)
+ *
+ * @param[in]   data            data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_uxf_econf_sysPublish(void *data)
+{
+    econf_sys_cb_info_t *func_info;
+    Ico_Uxf_Sys_Config  *oldconf;
+    const Ico_Uxf_Sys_Config  *newconf;
+    int     inuse = 0;
+
+    oldconf = ico_uxf_conf_publishSysConfig();
+    if (! oldconf) {
+        /* already published    */
+        return;
+    }
+    newconf = ico_uxf_getSysConfig();
+    apfw_trace("ico_uxf_econf_sysPublish: Enter(new=%08x, old=%08x)",
+               (unsigned int)newconf, (unsigned int)oldconf);
+
+    func_info = econf_sys_cb_func;
+    while (func_info) {
+        if ((func_info->func) && (func_info->func(newconf, oldconf) != ICO_UXF_EOK))   {
+            /* callback could not switch to new configuration   */
+            inuse = 1;
+        }
+        func_info = func_info->next;
+    }
+
+    if (inuse)  {
+        /* old configuration is still referred, it is never released   */
+        apfw_warn("ico_uxf_econf_sysPublish: old configuration(%08x) is still used",
+                  (unsigned int)oldconf);
+    }
+    else if (! ecore_timer_add(ICO_UXF_ECONF_SYS_GRACE_TIME,
+                               ico_uxf_econf_sysRelease, oldconf)) {
+        apfw_warn("ico_uxf_econf_sysPublish: cannot add timer, release now");
+        ico_uxf_conf_freeSysConfig(oldconf);
+    }
+
+    apfw_trace("ico_uxf_econf_sysPublish: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_econf_sysRelease:
+ *          release old system configuration after grace period
+ *
+ * @param[in]   data            old system configuration
+ * @return      always ECORE_CALLBACK_CANCEL
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+ico_uxf_econf_sysRelease(void *data)
+{
+    apfw_trace("ico_uxf_econf_sysRelease: release %08x", (unsigned int)data);
+    ico_uxf_conf_freeSysConfig((Ico_Uxf_Sys_Config *)data);
+
+    return ECORE_CALLBACK_CANCEL;
+}
@@ -20,16 +20,65 @@
 #include <string.h>
 #include <sys/time.h>
 #include <sys/file.h>
+#include <sys/inotify.h>
+#include <limits.h>
 #include <errno.h>
+#include <pthread.h>
 
 #include "ico_apf_log.h"
 #include "ico_apf_apimacro.h"
 #include "ico_uxf_conf_common.h"
 
-static Ico_Uxf_Sys_Config   *reloadSysConfig(void);
+static Ico_Uxf_Sys_Config   *reloadSysConfig(Ico_Uxf_Sys_Config *conf, const int live);
+static Ico_Uxf_Sys_Config   *buildSysConfig(Ico_Uxf_Sys_Config *conf, const int live);
+static Ico_Uxf_Sys_Config   *currentSysConfig(void);
+static int                  validSysConfig(const Ico_Uxf_Sys_Config *conf);
+static void                 linkSysInputHash(Ico_Uxf_Sys_Config *conf);
+static void                 *sysReloadThread(void *arg);
 
 static Ico_Uxf_Sys_Config   *_ico_sys_config = NULL;
 
+/* name and default(when not configured) of regulation predicates       */
+/* (defaults are the fixed conditions of old Apps Controller)           */
+static const char           *sys_regulation_name[ICO_UXF_REGULATION_MAX] = {
+    "running", "shift_park", "shift_back", "blinker_left", "blinker_right"
+};
+static const Ico_Uxf_conf_regulation sys_default_regulation[ICO_UXF_REGULATION_MAX] = {
+    /* running: speed >= 4km/h          */
+    { ICO_UXF_REGULATION_SIG_SPEED, ICO_UXF_REGULATION_OP_GE, 1, 0,
+      { 4.0 }, 0.0, 0, 0 },
+    /* shift_park: parking or neutrals  */
+    { ICO_UXF_REGULATION_SIG_SHIFT, ICO_UXF_REGULATION_OP_EQ, 2, 0,
+      { 255.0, 0.0 }, 0.0, 0, 0 },
+    /* shift_back: reverses             */
+    { ICO_UXF_REGULATION_SIG_SHIFT, ICO_UXF_REGULATION_OP_EQ, 1, 0,
+      { 128.0 }, 0.0, 0, 0 },
+    /* blinker_left                     */
+    { ICO_UXF_REGULATION_SIG_BLINKER, ICO_UXF_REGULATION_OP_EQ, 1, 0,
+      { 2.0 }, 0.0, 0, 0 },
+    /* blinker_right                    */
+    { ICO_UXF_REGULATION_SIG_BLINKER, ICO_UXF_REGULATION_OP_EQ, 1, 0,
+      { 1.0 }, 0.0, 0, 0 }
+};
+
+/* configuration in reading by this thread(used by ico_uxf_getSysXxx)   */
+static __thread Ico_Uxf_Sys_Config  *_ico_sys_reading = NULL;
+
+/* configuration that strings are in compiled cache(mapped image)       */
+static Ico_Uxf_Sys_Config   *sys_cached_config = NULL;
+
+/* live reload of system configuration  */
+#define SYS_RELOAD_IDLE     0               /* no reload thread                 */
+#define SYS_RELOAD_RUN      1               /* reload thread is running         */
+#define SYS_RELOAD_AGAIN    2               /* file changed while reloading     */
+
+static int                  sys_watch_fd = -1;      /* inotify file descriptor  */
+static void                 (*sys_reload_notify)(void) = NULL;
+                                                    /* new configuration notify */
+static pthread_mutex_t      sys_reload_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int                  sys_reload_state = SYS_RELOAD_IDLE;
+static Ico_Uxf_Sys_Config   *sys_reload_next = NULL;/* validated configuration  */
+
 
 /*--------------------------------------------------------------------------*/
 /**
@@ -48,7 +97,7 @@ ico_uxf_getSysConfig(void)
         return _ico_sys_config;
     }
     _ico_sys_config = g_new0(Ico_Uxf_Sys_Config,1);
-    return reloadSysConfig();
+    return buildSysConfig(_ico_sys_config, 0);
 }
 
 /*--------------------------------------------------------------------------*/
@@ -158,16 +207,260 @@ pars_dispposition(const char *exp, Ico_Uxf_conf_display *display)
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   reloadSysConfig: load system configuration file(static function)
+ * @brief   pars_regulation: parse regulation predicate(static function)
+ *          (signal;operator;value[,value..][;hysteresis[;debounce_on[;debounce_off]]])
+ *
+ * @param[in]   key             predicate name
+ * @param[in]   list            parameters of predicate
+ * @param[in]   size            number of parameters
+ * @param[out]  regulation      regulation predicate
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              illegal predicate
+ */
+/*--------------------------------------------------------------------------*/
+static int
+pars_regulation(const char *key, char **list, const gsize size,
+                Ico_Uxf_conf_regulation *regulation)
+{
+    Ico_Uxf_conf_regulation wk;
+    char    **values;
+    int     i;
+
+    if (size < 3)   {
+        fprintf(stderr, "[regulation.%s] Too few parameters\n", key);
+        return -1;
+    }
+    memset(&wk, 0, sizeof(wk));
+
+    if (strcasecmp(list[0], "speed") == 0)          wk.signal = ICO_UXF_REGULATION_SIG_SPEED;
+    else if (strcasecmp(list[0], "shift") == 0)     wk.signal = ICO_UXF_REGULATION_SIG_SHIFT;
+    else if (strcasecmp(list[0], "blinker") == 0)   wk.signal = ICO_UXF_REGULATION_SIG_BLINKER;
+    else    {
+        fprintf(stderr, "[regulation.%s: %s] Unknown vehicle signal\n", key, list[0]);
+        return -1;
+    }
+
+    if (strcasecmp(list[1], "eq") == 0)         wk.op = ICO_UXF_REGULATION_OP_EQ;
+    else if (strcasecmp(list[1], "ne") == 0)    wk.op = ICO_UXF_REGULATION_OP_NE;
+    else if (strcasecmp(list[1], "ge") == 0)    wk.op = ICO_UXF_REGULATION_OP_GE;
+    else if (strcasecmp(list[1], "gt") == 0)    wk.op = ICO_UXF_REGULATION_OP_GT;
+    else if (strcasecmp(list[1], "le") == 0)    wk.op = ICO_UXF_REGULATION_OP_LE;
+    else if (strcasecmp(list[1], "lt") == 0)    wk.op = ICO_UXF_REGULATION_OP_LT;
+    else    {
+        fprintf(stderr, "[regulation.%s: %s] Unknown operator\n", key, list[1]);
+        return -1;
+    }
+
+    values = g_strsplit(list[2], ",", ICO_UXF_REGULATION_VALUE_MAX + 1);
+    for (i = 0; values[i]; i++) {
+        if (i >= ICO_UXF_REGULATION_VALUE_MAX)  {
+            fprintf(stderr, "[regulation.%s: %s] Too many values\n", key, list[2]);
+            g_strfreev(values);
+            return -1;
+        }
+        wk.value[i] = strtod(values[i], (char **)0);
+    }
+    g_strfreev(values);
+    wk.valueNum = i;
+    if ((wk.valueNum <= 0) ||
+        ((wk.valueNum > 1) &&
+         (wk.op != ICO_UXF_REGULATION_OP_EQ) && (wk.op != ICO_UXF_REGULATION_OP_NE)))  {
+        fprintf(stderr, "[regulation.%s: %s] Illegal values\n", key, list[2]);
+        return -1;
+    }
+
+    if (size > 3)   wk.hysteresis = strtod(list[3], (char **)0);
+    if (size > 4)   wk.debounce_on = strtol(list[4], (char **)0, 0);
+    if (size > 5)   wk.debounce_off = strtol(list[5], (char **)0, 0);
+    if ((wk.hysteresis < 0.0) || (wk.debounce_on < 0) || (wk.debounce_off < 0))   {
+        fprintf(stderr, "[regulation.%s] Illegal hysteresis or debounce\n", key);
+        return -1;
+    }
+    memcpy(regulation, &wk, sizeof(wk));
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   decideMyHost: decide my host and master host(static function)
  *
  * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+decideMyHost(Ico_Uxf_Sys_Config *conf)
+{
+    const char *penv;
+    int hostid = -1;
+    int dmy1, dmy2, dmy3;
+    char cdmy4[64];
+    int i, j;
+
+    penv = getenv(ICO_UXF_ENV_APPINF);
+    if (penv)  {
+        if (sscanf(penv, "%d %d %d %s %d", &dmy1, &dmy2, &dmy3, cdmy4, &hostid) < 5) {
+            hostid = -1;
+        }
+        apfw_trace("decideMyHost: Env(%s) = %s, hostId = %d",
+                    ICO_UXF_ENV_APPINF, penv, hostid);
+    }
+
+    if (hostid < 0)    {
+        if ((gethostname(cdmy4, sizeof(cdmy4)-1) >= 0) &&
+            (strncmp(cdmy4, "localhost", 9) != 0))   {
+            apfw_trace("hostname = %s", cdmy4);
+            for (j = 0; cdmy4[j]; j++) {
+                if ((cdmy4[j] == ' ') || (cdmy4[j] == '(') ||
+                    (cdmy4[j] == '@') || (cdmy4[j] == ':'))    {
+                    cdmy4[j] = 0;
+                    break;
+                }
+            }
+            for (j = 0; j < conf->hostNum; j++) {
+                if (strcasecmp(conf->host[j].name, cdmy4) == 0)   {
+                    hostid = conf->host[j].id;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (hostid < 0)    {
+        FILE *fp = popen("/sbin/ifconfig", "r");
+        int foundeth = 0;
+        char sBuf[128];
+
+        if (fp)    {
+            while (fgets(sBuf, sizeof(sBuf)-1, fp))  {
+                if ((! foundeth) || (sBuf[0] != ' '))  {
+                    foundeth = 0;
+                    /* skip to "eth" device     */
+                    if (sBuf[0] == ' ' || sBuf[0] == '\t') continue;
+                    if (strncmp(sBuf, "eth", 3) != 0)    continue;
+                }
+                foundeth = 1;
+
+                for (j = 0; sBuf[j]; j++)  {
+                    if (strncmp(&sBuf[j], "inet6", 5) == 0)  continue;
+                    if (strncmp(&sBuf[j], "inet", 4) == 0)   break;
+                }
+                if (sBuf[j])   {
+                    /* forget "inet" device         */
+                    j += 4;
+                    for (; sBuf[j]; j++)   {
+                        if (sBuf[j] == ':')    break;
+                    }
+                    if (sBuf[j] )  {
+                        j++;
+                        int k;
+                        for (k = j +1; sBuf[k]; k++)   {
+                            if (sBuf[k] == ' ' || sBuf[k] == '\t' ||
+                                sBuf[k] == '\n' || sBuf[k] == '\r')    {
+                                sBuf[k] = 0;
+                                break;
+                            }
+                        }
+                        apfw_trace("My Inet Addr = %s", &sBuf[j]);
+                        for (k = 0; k < conf->hostNum; k++) {
+                            if (strcmp(conf->host[k].address, &sBuf[j]) == 0) {
+                                hostid = conf->host[k].id;
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (hostid >= 0)   break;
+            }
+            fclose(fp);
+        }
+    }
+    if (hostid >= 0)   {
+        conf->misc.myhostId = hostid;
+    }
+    else    {
+        apfw_trace("Default Host = 0, %s", ico_uxf_get_SysLocation(0));
+        conf->misc.myhostId = conf->host[0].id;
+    }
+
+    /* The validity of MyHost is checked.       */
+    Ico_Uxf_conf_host *myhost = (Ico_Uxf_conf_host *)
+            ico_uxf_getSysHostById(conf->misc.myhostId);
+    if (! myhost)  {
+        apfw_critical("MyHostId.%d dose not exist, default 0",
+                      conf->misc.myhostId);
+        myhost = &conf->host[0];
+        if (! myhost)  {
+            apfw_error("HostId.0 dose not exist, GiveUp!");
+            exit(1);
+        }
+        conf->misc.myhostId = myhost->id;
+    }
+
+    conf->misc.myaddress =
+            (char *)ico_uxf_get_SysLocation(conf->misc.myhostId);
+    conf->misc.myhostName = myhost->name;
+
+    conf->misc.homescreen = myhost->homescreen;
+
+    if (myhost->homescreen)    {
+        conf->misc.masterhostId = myhost->id;
+    }
+    else    {
+        conf->misc.masterhostId = conf->misc.myhostId;
+
+        for (i = 0; i < conf->hostNum; i++) {
+            if (conf->host[i].homescreen)   {
+                conf->misc.masterhostId = conf->host[i].id;
+                break;
+            }
+        }
+    }
+    conf->misc.masterhostaddress =
+            (char *)ico_uxf_get_SysLocation(conf->misc.masterhostId);
+
+    apfw_trace("MyHost %d[%s] Master Host %d(%s)", conf->misc.myhostId,
+                conf->misc.myaddress, conf->misc.masterhostId,
+                conf->misc.masterhostaddress);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   setSysLogLevel: set log level, flush mode and log format(static function)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+setSysLogLevel(const Ico_Uxf_Sys_Config *conf)
+{
+    if (getenv("ICO_IVI_NO_LOG"))    {
+        ico_uxf_log_setlevel(0);
+    }
+    else    {
+        ico_uxf_log_setlevel(conf->misc.loglevel |
+                             ((conf->misc.logflush) ?
+                                ICO_APF_LOG_FLUSH : ICO_APF_LOG_NOFLUSH) |
+                             ((conf->misc.logbinary) ?
+                                ICO_APF_LOG_BINARY : ICO_APF_LOG_TEXT));
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   reloadSysConfig: load system configuration file(static function)
+ *
+ * @param[out]  conf            system configuration table to read in
+ * @param[in]   live            live reload(=1, not use cache and not exit on error)
  * @return      system configuration table
  * @retval      != NULL         success(system configuration table address)
  * @retval      == NULL         error(can not read configuration file)
  */
 /*--------------------------------------------------------------------------*/
 static Ico_Uxf_Sys_Config *
-reloadSysConfig(void)
+reloadSysConfig(Ico_Uxf_Sys_Config *conf, const int live)
 {
     GKeyFile *keyfile;
     GKeyFileFlags flags;
@@ -175,9 +468,13 @@ reloadSysConfig(void)
     gsize length;
     int i, j, k;
     int zoneidx;
-    GList*  idlist;
+    Ico_Uxf_conf_numkeys    *numkeys;
+    const char  *subkey;
     char*   dirp;
     char*   strp;
+    struct stat srcstat;
+    char    cachefile[ICO_UXF_CONF_DIR_MAX+32];
+    int     usecache = 0;
 
     apfw_trace("reloadSysConfig: Enter");
 
@@ -186,419 +483,389 @@ reloadSysConfig(void)
     if (! dirp)    {
         dirp = ICO_UXF_TOP_TOPDIR;
     }
-    strncpy(_ico_sys_config->misc.topdir, dirp, ICO_UXF_CONF_DIR_MAX);
+    strncpy(conf->misc.topdir, dirp, ICO_UXF_CONF_DIR_MAX);
 
     /* decide top directory in configuration file's     */
     dirp = getenv(ICO_UXF_CONFIG_ENV);
     if (dirp)  {
-        strncpy(_ico_sys_config->misc.confdir, dirp, ICO_UXF_CONF_DIR_MAX);
+        strncpy(conf->misc.confdir, dirp, ICO_UXF_CONF_DIR_MAX);
     }
     else    {
-        snprintf(_ico_sys_config->misc.confdir, ICO_UXF_CONF_DIR_MAX,
-                 "%s/%s", _ico_sys_config->misc.topdir, ICO_UXF_CONFIG_DIR);
-        dirp = _ico_sys_config->misc.confdir;
+        snprintf(conf->misc.confdir, ICO_UXF_CONF_DIR_MAX,
+                 "%s/%s", conf->misc.topdir, ICO_UXF_CONFIG_DIR);
+        dirp = conf->misc.confdir;
+    }
+
+    GString* filepath = g_string_new("xx");
+    g_string_printf(filepath, "%s/%s", dirp, ICO_UXF_CONFIG_SYSTEM);
+
+    /* compiled cache, used when configuration file is not changed  */
+    /* (live reload reads the changed file, and rebuilds cache)     */
+    if ((! getenv(ICO_UXF_CONFIG_NOCACHE_ENV)) && (stat(filepath->str, &srcstat) == 0))   {
+        usecache = 1;
+        snprintf(cachefile, sizeof(cachefile), "%s/%s", dirp, ICO_UXF_CONFIG_SYSCACHE);
+        if ((! live) &&
+            (ico_uxf_conf_loadCache(cachefile, &srcstat, conf) == ICO_UXF_EOK))    {
+            sys_cached_config = conf;
+            linkSysInputHash(conf);
+            g_string_free(filepath, TRUE);
+            setSysLogLevel(conf);
+            decideMyHost(conf);
+            apfw_trace("reloadSysConfig: Leave(cache)");
+            return conf;
+        }
     }
 
     /* A system-wide definition         */
     keyfile = g_key_file_new();
     flags = G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS;
 
-    GString* filepath = g_string_new("xx");
-    g_string_printf(filepath, "%s/%s", dirp, ICO_UXF_CONFIG_SYSTEM);
-
     if (!g_key_file_load_from_file(keyfile, filepath->str, flags, &error)) {
         fprintf(stderr, "%s: %s\n", (char *)filepath->str, error->message);
         g_string_free(filepath, TRUE);
+        g_key_file_free(keyfile);
         return NULL;
     }
     g_string_free(filepath, TRUE);
 
     /* log                      */
-    _ico_sys_config->misc.loglevel
+    conf->misc.loglevel
              = g_key_file_get_integer(keyfile, "log", "loglevel", &error);
     ico_uxf_conf_checkGerror(&error);
-    _ico_sys_config->misc.logflush =
+    conf->misc.logflush =
         ico_uxf_getSysBoolByName(g_key_file_get_string(keyfile, "log", "logflush", &error));
     ico_uxf_conf_checkGerror(&error);
+    strp = g_key_file_get_string(keyfile, "log", "logformat", &error);
+    ico_uxf_conf_checkGerror(&error);
+    conf->misc.logbinary = ((strp) && (strcasecmp(strp, "binary") == 0)) ? 1 : 0;
 
-    /* log setting              */
-    if (getenv("ICO_IVI_NO_LOG"))    {
-        ico_uxf_log_setlevel(0);
-    }
-    else    {
-        ico_uxf_log_setlevel(_ico_sys_config->misc.loglevel |
-                             ((_ico_sys_config->misc.logflush) ?
-                                ICO_APF_LOG_FLUSH : ICO_APF_LOG_NOFLUSH));
+    /* log setting(live reload sets it at publish)  */
+    if (! live) {
+        setSysLogLevel(conf);
     }
 
     /* [category] application category name and attributes          */
-    idlist = ico_uxf_conf_countNumericalKey(keyfile, "category");
-    length = g_list_length(idlist);
-    _ico_sys_config->categoryNum = length;
-    _ico_sys_config->category = g_malloc0(sizeof(Ico_Uxf_conf_category) * length);
+    numkeys = ico_uxf_conf_getNumericalKeys(keyfile, "category");
+    if (! numkeys)  {
+        g_key_file_free(keyfile);
+        return NULL;
+    }
+    length = numkeys->num;
+    conf->categoryNum = length;
+    conf->category = g_malloc0(sizeof(Ico_Uxf_conf_category) * length);
 
     for (i = 0; i < (int)length; i++) {
-        const char* key = (const char*) g_list_nth_data(idlist, i);
+        const char* key = numkeys->key[i];
         const char* g = "category";
-        _ico_sys_config->category[i].id = ico_uxf_conf_getUint(key);
+        const char* subkey;
+        conf->category[i].id = numkeys->id[i];
         ico_uxf_conf_checkGerror(&error);
-        _ico_sys_config->category[i].name = g_key_file_get_string(keyfile, g, key, &error);
+        conf->category[i].name = g_key_file_get_string(keyfile, g, key, &error);
         ico_uxf_conf_checkGerror(&error);
 
         strp = (char *)g_key_file_get_string(keyfile, g,
-                                             ico_uxf_conf_appendStr(key, ".view"), &error);
+                                             ico_uxf_conf_subKey(numkeys, i, ".view"), &error);
         ico_uxf_conf_checkGerror(&error);
         if (strncasecmp(strp, "alway", 5) == 0) {
-            _ico_sys_config->category[i].view = ICO_UXF_POLICY_ALWAYS;
+            conf->category[i].view = ICO_UXF_POLICY_ALWAYS;
         }
         else if (strncasecmp(strp, "run", 3) == 0)  {
-            _ico_sys_config->category[i].view = ICO_UXF_POLICY_RUNNING;
+            conf->category[i].view = ICO_UXF_POLICY_RUNNING;
         }
         else if (strncasecmp(strp, "park", 4) == 0) {
-            _ico_sys_config->category[i].view = ICO_UXF_POLICY_PARKED;
+            conf->category[i].view = ICO_UXF_POLICY_PARKED;
         }
         else if (strncasecmp(strp, "shift_park", 10) == 0)  {
-            _ico_sys_config->category[i].view = ICO_UXF_POLICY_SHIFT_PARKING;
+            conf->category[i].view = ICO_UXF_POLICY_SHIFT_PARKING;
         }
         else if ((strncasecmp(strp, "shift_back", 10) == 0) ||
                  (strncasecmp(strp, "shift_rev", 9) == 0))  {
-            _ico_sys_config->category[i].view = ICO_UXF_POLICY_SHIFT_REVERSES;
+            conf->category[i].view = ICO_UXF_POLICY_SHIFT_REVERSES;
         }
         else if (strcasecmp(strp, "blinker_left") == 0)   {
-            _ico_sys_config->category[i].view = ICO_UXF_POLICY_BLINKER_LEFT;
+            conf->category[i].view = ICO_UXF_POLICY_BLINKER_LEFT;
         }
         else if (strcasecmp(strp, "blinker_right") == 0)  {
-            _ico_sys_config->category[i].view = ICO_UXF_POLICY_BLINKER_RIGHT;
+            conf->category[i].view = ICO_UXF_POLICY_BLINKER_RIGHT;
         }
         else    {
             fprintf(stderr, "[%s.view: %s] Unknown view mode\n", key, strp);
-            g_list_free_full(idlist,g_free);
+            ico_uxf_conf_freeNumericalKeys(numkeys);
             g_key_file_free(keyfile);
             return NULL;
         }
 
         strp = (char *)g_key_file_get_string(keyfile, g,
-                                             ico_uxf_conf_appendStr(key, ".sound"), &error);
+                                             ico_uxf_conf_subKey(numkeys, i, ".sound"), &error);
         ico_uxf_conf_checkGerror(&error);
         if (strncasecmp(strp, "alway", 5) == 0) {
-            _ico_sys_config->category[i].sound = ICO_UXF_POLICY_ALWAYS;
+            conf->category[i].sound = ICO_UXF_POLICY_ALWAYS;
         }
         else if (strncasecmp(strp, "run", 3) == 0)  {
-            _ico_sys_config->category[i].sound = ICO_UXF_POLICY_RUNNING;
+            conf->category[i].sound = ICO_UXF_POLICY_RUNNING;
         }
         else if (strncasecmp(strp, "park", 4) == 0) {
-            _ico_sys_config->category[i].sound = ICO_UXF_POLICY_PARKED;
+            conf->category[i].sound = ICO_UXF_POLICY_PARKED;
         }
         else if (strncasecmp(strp, "shift_park", 10) == 0)  {
-            _ico_sys_config->category[i].sound = ICO_UXF_POLICY_SHIFT_PARKING;
+            conf->category[i].sound = ICO_UXF_POLICY_SHIFT_PARKING;
         }
         else if ((strncasecmp(strp, "shift_back", 10) == 0) ||
                  (strncasecmp(strp, "shift_rev", 9) == 0))  {
-            _ico_sys_config->category[i].sound = ICO_UXF_POLICY_SHIFT_REVERSES;
+            conf->category[i].sound = ICO_UXF_POLICY_SHIFT_REVERSES;
         }
         else if (strcasecmp(strp, "blinker_left") == 0)   {
-            _ico_sys_config->category[i].sound = ICO_UXF_POLICY_BLINKER_LEFT;
+            conf->category[i].sound = ICO_UXF_POLICY_BLINKER_LEFT;
         }
         else if (strcasecmp(strp, "blinker_right") == 0)  {
-            _ico_sys_config->category[i].sound = ICO_UXF_POLICY_BLINKER_RIGHT;
+            conf->category[i].sound = ICO_UXF_POLICY_BLINKER_RIGHT;
         }
         else    {
             fprintf(stderr, "[%s.view: %s] Unknown sound mode\n", key, strp);
-            g_list_free_full(idlist,g_free);
+            ico_uxf_conf_freeNumericalKeys(numkeys);
             g_key_file_free(keyfile);
             return NULL;
         }
 
         strp = (char *)g_key_file_get_string(keyfile, g,
-                                             ico_uxf_conf_appendStr(key, ".input"), &error);
+                                             ico_uxf_conf_subKey(numkeys, i, ".input"), &error);
         ico_uxf_conf_checkGerror(&error);
         if (strncasecmp(strp, "alway", 5) == 0) {
-            _ico_sys_config->category[i].input = ICO_UXF_POLICY_ALWAYS;
+            conf->category[i].input = ICO_UXF_POLICY_ALWAYS;
         }
         else if (strncasecmp(strp, "run", 3) == 0)  {
-            _ico_sys_config->category[i].input = ICO_UXF_POLICY_RUNNING;
+            conf->category[i].input = ICO_UXF_POLICY_RUNNING;
         }
         else if (strncasecmp(strp, "park", 4) == 0) {
-            _ico_sys_config->category[i].input = ICO_UXF_POLICY_PARKED;
+            conf->category[i].input = ICO_UXF_POLICY_PARKED;
         }
         else if (strncasecmp(strp, "shift_park", 10) == 0)  {
-            _ico_sys_config->category[i].input = ICO_UXF_POLICY_SHIFT_PARKING;
+            conf->category[i].input = ICO_UXF_POLICY_SHIFT_PARKING;
         }
         else if ((strncasecmp(strp, "shift_back", 10) == 0) ||
                  (strncasecmp(strp, "shift_rev", 9) == 0))  {
-            _ico_sys_config->category[i].input = ICO_UXF_POLICY_SHIFT_REVERSES;
+            conf->category[i].input = ICO_UXF_POLICY_SHIFT_REVERSES;
         }
         else if (strcasecmp(strp, "blinker_left") == 0)   {
-            _ico_sys_config->category[i].input = ICO_UXF_POLICY_BLINKER_LEFT;
+            conf->category[i].input = ICO_UXF_POLICY_BLINKER_LEFT;
         }
         else if (strcasecmp(strp, "blinker_right") == 0)  {
-            _ico_sys_config->category[i].input = ICO_UXF_POLICY_BLINKER_RIGHT;
+            conf->category[i].input = ICO_UXF_POLICY_BLINKER_RIGHT;
         }
         else    {
             fprintf(stderr, "[%s.view: %s] Unknown input mode\n", key, strp);
-            g_list_free_full(idlist,g_free);
+            ico_uxf_conf_freeNumericalKeys(numkeys);
             g_key_file_free(keyfile);
             return NULL;
         }
-        _ico_sys_config->category[i].priority =
+        conf->category[i].priority =
                                 g_key_file_get_integer(keyfile, g,
-                                ico_uxf_conf_appendStr(key,".priority"), &error);
+                                ico_uxf_conf_subKey(numkeys, i, ".priority"), &error);
         ico_uxf_conf_checkGerror(&error);
 
-        apfw_trace("Categry.%d id = %d name = %s view = %d sound = %d input = %d prio = %d",
-                   i, _ico_sys_config->category[i].id, _ico_sys_config->category[i].name,
-                   _ico_sys_config->category[i].view, _ico_sys_config->category[i].sound,
-                   _ico_sys_config->category[i].input,
-                   _ico_sys_config->category[i].priority);
+        /* bounds of reply timeout(optional, 0=default of Apps Controller)  */
+        subkey = ico_uxf_conf_subKey(numkeys, i, ".replymin");
+        if (g_key_file_has_key(keyfile, g, subkey, NULL))   {
+            conf->category[i].replymin = g_key_file_get_integer(keyfile, g, subkey, &error);
+            ico_uxf_conf_checkGerror(&error);
+        }
+        subkey = ico_uxf_conf_subKey(numkeys, i, ".replymax");
+        if (g_key_file_has_key(keyfile, g, subkey, NULL))   {
+            conf->category[i].replymax = g_key_file_get_integer(keyfile, g, subkey, &error);
+            ico_uxf_conf_checkGerror(&error);
+        }
+        if (conf->category[i].replymin < 0) {
+            conf->category[i].replymin = 0;
+        }
+        if ((conf->category[i].replymax < 0) ||
+            ((conf->category[i].replymax > 0) &&
+             (conf->category[i].replymax < conf->category[i].replymin)))    {
+            fprintf(stderr, "[%s.replymax: %d] Illegal reply timeout, ignored\n",
+                    key, conf->category[i].replymax);
+            conf->category[i].replymax = 0;
+        }
+
+        apfw_trace("Categry.%d id = %d name = %s view = %d sound = %d input = %d prio = %d "
+                   "reply = %d-%d",
+                   i, conf->category[i].id, conf->category[i].name,
+                   conf->category[i].view, conf->category[i].sound,
+                   conf->category[i].input,
+                   conf->category[i].priority,
+                   conf->category[i].replymin, conf->category[i].replymax);
+    }
+    ico_uxf_conf_freeNumericalKeys(numkeys);
+
+    /* [regulation] predicates of regulation policies(optional)     */
+    for (i = 0; i < ICO_UXF_REGULATION_MAX; i++)    {
+        char    **reglist;
+        gsize   regsize;
+
+        memcpy(&conf->regulation[i], &sys_default_regulation[i],
+               sizeof(Ico_Uxf_conf_regulation));
+        if (! g_key_file_has_key(keyfile, "regulation", sys_regulation_name[i], NULL))  {
+            continue;
+        }
+        reglist = g_key_file_get_string_list(keyfile, "regulation", sys_regulation_name[i],
+                                             &regsize, &error);
+        ico_uxf_conf_checkGerror(&error);
+        if (reglist)    {
+            if (pars_regulation(sys_regulation_name[i], reglist, regsize,
+                                &conf->regulation[i]) < 0)  {
+                fprintf(stderr, "[regulation.%s] Illegal predicate, default used\n",
+                        sys_regulation_name[i]);
+            }
+            g_strfreev(reglist);
+        }
+        apfw_trace("Regulation.%s signal = %d op = %d value = %.1f(%d) hys = %.1f "
+                   "debounce = %d/%d", sys_regulation_name[i],
+                   conf->regulation[i].signal, conf->regulation[i].op,
+                   conf->regulation[i].value[0], conf->regulation[i].valueNum,
+                   conf->regulation[i].hysteresis,
+                   conf->regulation[i].debounce_on, conf->regulation[i].debounce_off);
     }
-    g_list_free_full(idlist,g_free);
 
     /* [kind] application kind name and attributes          */
-    idlist = ico_uxf_conf_countNumericalKey(keyfile, "kind");
-    length = g_list_length(idlist);
-    _ico_sys_config->kindNum = length;
-    _ico_sys_config->kind = g_malloc0(sizeof(Ico_Uxf_conf_kind) * length);
+    numkeys = ico_uxf_conf_getNumericalKeys(keyfile, "kind");
+    if (! numkeys)  {
+        g_key_file_free(keyfile);
+        return NULL;
+    }
+    length = numkeys->num;
+    conf->kindNum = length;
+    conf->kind = g_malloc0(sizeof(Ico_Uxf_conf_kind) * length);
 
     for (i = 0; i < (int)length; i++) {
-        const char* key = (const char*) g_list_nth_data(idlist, i);
+        const char* key = numkeys->key[i];
         const char* g = "kind";
-        _ico_sys_config->kind[i].id = ico_uxf_conf_getUint(key);
+        conf->kind[i].id = numkeys->id[i];
         ico_uxf_conf_checkGerror(&error);
-        _ico_sys_config->kind[i].name = g_key_file_get_string(keyfile, g, key, &error);
+        conf->kind[i].name = g_key_file_get_string(keyfile, g, key, &error);
         ico_uxf_conf_checkGerror(&error);
         strp = (char *)g_key_file_get_string(
-                            keyfile, g, ico_uxf_conf_appendStr(key, ".privilege"), &error);
+                            keyfile, g, ico_uxf_conf_subKey(numkeys, i, ".privilege"), &error);
         ico_uxf_conf_checkGerror(&error);
         if (strcasecmp(strp, "almighty") == 0)   {
-            _ico_sys_config->kind[i].priv = ICO_UXF_PRIVILEGE_ALMIGHTY;
+            conf->kind[i].priv = ICO_UXF_PRIVILEGE_ALMIGHTY;
         }
         else if (strcasecmp(strp, "system") == 0)   {
-            _ico_sys_config->kind[i].priv = ICO_UXF_PRIVILEGE_SYSTEM;
+            conf->kind[i].priv = ICO_UXF_PRIVILEGE_SYSTEM;
         }
         else if (strcasecmp(strp, "system.audio") == 0)   {
-            _ico_sys_config->kind[i].priv = ICO_UXF_PRIVILEGE_SYSTEM_AUDIO;
+            conf->kind[i].priv = ICO_UXF_PRIVILEGE_SYSTEM_AUDIO;
         }
         else if (strcasecmp(strp, "system.visible") == 0)   {
-            _ico_sys_config->kind[i].priv = ICO_UXF_PRIVILEGE_SYSTEM_VISIBLE;
+            conf->kind[i].priv = ICO_UXF_PRIVILEGE_SYSTEM_VISIBLE;
         }
         else if (strcasecmp(strp, "maker") == 0)    {
-            _ico_sys_config->kind[i].priv = ICO_UXF_PRIVILEGE_MAKER;
+            conf->kind[i].priv = ICO_UXF_PRIVILEGE_MAKER;
         }
         else if (strcasecmp(strp, "certificate") == 0)  {
-            _ico_sys_config->kind[i].priv = ICO_UXF_PRIVILEGE_CERTIFICATE;
+            conf->kind[i].priv = ICO_UXF_PRIVILEGE_CERTIFICATE;
         }
         else if (strcasecmp(strp, "none") == 0) {
-            _ico_sys_config->kind[i].priv = ICO_UXF_PRIVILEGE_NONE;
+            conf->kind[i].priv = ICO_UXF_PRIVILEGE_NONE;
         }
         else    {
             fprintf(stderr, "[%s.view: %s] Unknown privilege mode\n", key, strp);
-            g_list_free_full(idlist,g_free);
+            ico_uxf_conf_freeNumericalKeys(numkeys);
             g_key_file_free(keyfile);
             return NULL;
         }
         apfw_trace("Kind.%d id = %d name = %s privilege = %d",
-                   i, _ico_sys_config->kind[i].id, _ico_sys_config->kind[i].name,
-                   _ico_sys_config->kind[i].priv);
+                   i, conf->kind[i].id, conf->kind[i].name,
+                   conf->kind[i].priv);
     }
-    g_list_free_full(idlist,g_free);
+    ico_uxf_conf_freeNumericalKeys(numkeys);
 
     /* [port] port numbers              */
-    _ico_sys_config->misc.appscontrollerport
+    conf->misc.appscontrollerport
         = g_key_file_get_integer(keyfile, "port", "appscontrollerport", &error);
     ico_uxf_conf_checkGerror(&error);
-    _ico_sys_config->misc.soundpluginport
+    conf->misc.soundpluginport
         = g_key_file_get_integer(keyfile, "port", "soundpluginport", &error);
     ico_uxf_conf_checkGerror(&error);
-    if (_ico_sys_config->misc.appscontrollerport <= 0)
-        _ico_sys_config->misc.appscontrollerport = 18081;
-    if (_ico_sys_config->misc.soundpluginport <= 0)
-        _ico_sys_config->misc.soundpluginport = 18082;
+    if (conf->misc.appscontrollerport <= 0)
+        conf->misc.appscontrollerport = 18081;
+    if (conf->misc.soundpluginport <= 0)
+        conf->misc.soundpluginport = 18082;
 
     /* hosts                        */
-    idlist = ico_uxf_conf_countNumericalKey(keyfile, "host");
-    length = g_list_length(idlist);
-    _ico_sys_config->hostNum = length;
-    _ico_sys_config->host = g_malloc0(sizeof(Ico_Uxf_conf_host) * length);
+    numkeys = ico_uxf_conf_getNumericalKeys(keyfile, "host");
+    if (! numkeys)  {
+        g_key_file_free(keyfile);
+        return NULL;
+    }
+    length = numkeys->num;
+    conf->hostNum = length;
+    conf->host = g_malloc0(sizeof(Ico_Uxf_conf_host) * length);
 
     for (i = 0; i < (int)length; i++)   {
-        char* key = (char*) g_list_nth_data(idlist, i);
+        const char* key = numkeys->key[i];
         const char* g = "host";
-        _ico_sys_config->host[i].id  = ico_uxf_conf_getUint(key);
-        _ico_sys_config->host[i].name = g_key_file_get_string(keyfile, g, key, &error);
+        conf->host[i].id  = numkeys->id[i];
+        conf->host[i].name = g_key_file_get_string(keyfile, g, key, &error);
         ico_uxf_conf_checkGerror(&error);
 
-        _ico_sys_config->host[i].address
-            = g_key_file_get_string(keyfile, g, ico_uxf_conf_appendStr(key, ".ip"), &error);
+        conf->host[i].address
+            = g_key_file_get_string(keyfile, g, ico_uxf_conf_subKey(numkeys, i, ".ip"), &error);
         ico_uxf_conf_checkGerror(&error);
-        if (g_hostname_is_ip_address(_ico_sys_config->host[i].address)!= TRUE){
+        if (g_hostname_is_ip_address(conf->host[i].address)!= TRUE){
             apfw_error("host[%d] = %s is not ip address style",
-                        _ico_sys_config->host[i].id, _ico_sys_config->host[i].address);
+                        conf->host[i].id, conf->host[i].address);
+            if (live)   {
+                /* running system is not stopped, only this reload fails    */
+                ico_uxf_conf_freeNumericalKeys(numkeys);
+                g_key_file_free(keyfile);
+                return NULL;
+            }
             exit(1);
         }
 
-        _ico_sys_config->host[i].type =
+        conf->host[i].type =
             ico_uxf_getSysHostTypeByName(
                     g_key_file_get_string(keyfile, g,
-                                          ico_uxf_conf_appendStr(key, ".type"), &error));
+                                          ico_uxf_conf_subKey(numkeys, i, ".type"), &error));
         ico_uxf_conf_checkGerror(&error);
 
-        _ico_sys_config->host[i].homescreen =
+        conf->host[i].homescreen =
             g_key_file_get_string(keyfile, g,
-                                  ico_uxf_conf_appendStr(key, ".homescreen"), &error);
+                                  ico_uxf_conf_subKey(numkeys, i, ".homescreen"), &error);
         ico_uxf_conf_checkGerror(&error);
         apfw_trace("Host.%d: Id = %d Name = %s Type = %d Ip = %s HomeScreen = %s",
-            i, _ico_sys_config->host[i].id, (char *)_ico_sys_config->host[i].name,
-            _ico_sys_config->host[i].type, (char *)_ico_sys_config->host[i].address,
-            _ico_sys_config->host[i].homescreen);
+            i, conf->host[i].id, (char *)conf->host[i].name,
+            conf->host[i].type, (char *)conf->host[i].address,
+            conf->host[i].homescreen);
+    }
+    ico_uxf_conf_freeNumericalKeys(numkeys);
+    if ((live) && (conf->hostNum <= 0)) {
+        apfw_error("reloadSysConfig: Leave(no host)");
+        g_key_file_free(keyfile);
+        return NULL;
     }
-    g_list_free_full(idlist,g_free);
 
     /* decide myhost        */
-    const char *penv = getenv(ICO_UXF_ENV_APPINF);
-    int hostid = -1;
-    int dmy1, dmy2, dmy3;
-    char cdmy4[64];
-    if (penv)  {
-        if (sscanf(penv, "%d %d %d %s %d", &dmy1, &dmy2, &dmy3, cdmy4, &hostid) < 5) {
-            hostid = -1;
-        }
-        apfw_trace("reloadSysConfig: Env(%s) = %s, hostId = %d",
-                    ICO_UXF_ENV_APPINF, penv, hostid);
-    }
-
-    if (hostid < 0)    {
-        if ((gethostname(cdmy4, sizeof(cdmy4)-1) >= 0) &&
-            (strncmp(cdmy4, "localhost", 9) != 0))   {
-            apfw_trace("hostname = %s", cdmy4);
-            for (j = 0; cdmy4[j]; j++) {
-                if ((cdmy4[j] == ' ') || (cdmy4[j] == '(') ||
-                    (cdmy4[j] == '@') || (cdmy4[j] == ':'))    {
-                    cdmy4[j] = 0;
-                    break;
-                }
-            }
-            for (j = 0; j < _ico_sys_config->hostNum; j++) {
-                if (strcasecmp(_ico_sys_config->host[j].name, cdmy4) == 0)   {
-                    hostid = _ico_sys_config->host[j].id;
-                    break;
-                }
-            }
-        }
-    }
-
-    if (hostid < 0)    {
-        FILE *fp = popen("/sbin/ifconfig", "r");
-        int foundeth = 0;
-        char sBuf[128];
-
-        if (fp)    {
-            while (fgets(sBuf, sizeof(sBuf)-1, fp))  {
-                if ((! foundeth) || (sBuf[0] != ' '))  {
-                    foundeth = 0;
-                    /* skip to "eth" device     */
-                    if (sBuf[0] == ' ' || sBuf[0] == '\t') continue;
-                    if (strncmp(sBuf, "eth", 3) != 0)    continue;
-                }
-                foundeth = 1;
+    decideMyHost(conf);
 
-                for (j = 0; sBuf[j]; j++)  {
-                    if (strncmp(&sBuf[j], "inet6", 5) == 0)  continue;
-                    if (strncmp(&sBuf[j], "inet", 4) == 0)   break;
-                }
-                if (sBuf[j])   {
-                    /* forget "inet" device         */
-                    j += 4;
-                    for (; sBuf[j]; j++)   {
-                        if (sBuf[j] == ':')    break;
-                    }
-                    if (sBuf[j] )  {
-                        j++;
-                        int k;
-                        for (k = j +1; sBuf[k]; k++)   {
-                            if (sBuf[k] == ' ' || sBuf[k] == '\t' ||
-                                sBuf[k] == '\n' || sBuf[k] == '\r')    {
-                                sBuf[k] = 0;
-                                break;
-                            }
-                        }
-                        apfw_trace("My Inet Addr = %s", &sBuf[j]);
-                        for (k = 0; k < _ico_sys_config->hostNum; k++) {
-                            if (strcmp(_ico_sys_config->host[k].address, &sBuf[j]) == 0) {
-                                hostid = _ico_sys_config->host[k].id;
-                                break;
-                            }
-                        }
-                    }
-                }
-                if (hostid >= 0)   break;
-            }
-            fclose(fp);
-        }
-    }
-    if (hostid >= 0)   {
-        _ico_sys_config->misc.myhostId = hostid;
-    }
-    else    {
-        apfw_trace("Default Host = 0, %s", ico_uxf_get_SysLocation(0));
-        _ico_sys_config->misc.myhostId = _ico_sys_config->host[0].id;
-    }
-
-    /* The validity of MyHost is checked.       */
-    Ico_Uxf_conf_host *myhost = (Ico_Uxf_conf_host *)
-            ico_uxf_getSysHostById(_ico_sys_config->misc.myhostId);
-    if (! myhost)  {
-        apfw_critical("MyHostId.%d dose not exist, default 0",
-                      _ico_sys_config->misc.myhostId);
-        myhost = &_ico_sys_config->host[0];
-        if (! myhost)  {
-            apfw_error("HostId.0 dose not exist, GiveUp!");
-            exit(1);
-        }
-        _ico_sys_config->misc.myhostId = myhost->id;
-    }
-
-    _ico_sys_config->misc.myaddress =
-            (char *)ico_uxf_get_SysLocation(_ico_sys_config->misc.myhostId);
-    _ico_sys_config->misc.myhostName = myhost->name;
-
-    _ico_sys_config->misc.homescreen = myhost->homescreen;
-
-    if (myhost->homescreen)    {
-        _ico_sys_config->misc.masterhostId = myhost->id;
-    }
-    else    {
-        _ico_sys_config->misc.masterhostId = _ico_sys_config->misc.myhostId;
-
-        for (i = 0; i < _ico_sys_config->hostNum; i++) {
-            if (_ico_sys_config->host[i].homescreen)   {
-                _ico_sys_config->misc.masterhostId = _ico_sys_config->host[i].id;
-                break;
-            }
-        }
-    }
-    _ico_sys_config->misc.masterhostaddress =
-            (char *)ico_uxf_get_SysLocation(_ico_sys_config->misc.masterhostId);
-
-    apfw_trace("MyHost %d[%s] Master Host %d(%s)", _ico_sys_config->misc.myhostId,
-                _ico_sys_config->misc.myaddress, _ico_sys_config->misc.masterhostId,
-                _ico_sys_config->misc.masterhostaddress);
-
-    _ico_sys_config->misc.default_hostId = ico_uxf_getSysHostByName(
+    conf->misc.default_hostId = ico_uxf_getSysHostByName(
                             g_key_file_get_string(keyfile, "default", "host", &error));
     ico_uxf_conf_checkGerror(&error);
 
     /* display                  */
-    idlist = ico_uxf_conf_countNumericalKey(keyfile, "display");
-    length = g_list_length(idlist);
-    _ico_sys_config->displayNum = length;
-    _ico_sys_config->display = g_malloc0(sizeof(Ico_Uxf_conf_display) * length);
+    numkeys = ico_uxf_conf_getNumericalKeys(keyfile, "display");
+    if (! numkeys)  {
+        g_key_file_free(keyfile);
+        return NULL;
+    }
+    length = numkeys->num;
+    conf->displayNum = length;
+    conf->display = g_malloc0(sizeof(Ico_Uxf_conf_display) * length);
     zoneidx = 0;
 
     for (i = 0; i < (int)length; i++) {
-        const char* key = (const char*) g_list_nth_data(idlist, i);
+        const char* key = numkeys->key[i];
         const char* g = "display";
-        Ico_Uxf_conf_display *display = &_ico_sys_config->display[i];
-        display->id = ico_uxf_conf_getUint(key);
+        Ico_Uxf_conf_display *display = &conf->display[i];
+        display->id = numkeys->id[i];
         ico_uxf_conf_checkGerror(&error);
         display->name = g_key_file_get_string(keyfile, g, key, &error);
         ico_uxf_conf_checkGerror(&error);
@@ -606,38 +873,38 @@ reloadSysConfig(void)
         display->hostId =
             ico_uxf_getSysHostByName(
                         g_key_file_get_string(keyfile, g,
-                                              ico_uxf_conf_appendStr(key,".host"), &error));
+                                              ico_uxf_conf_subKey(numkeys, i, ".host"), &error));
         ico_uxf_conf_checkGerror(&error);
         display->displayno =
             g_key_file_get_integer(keyfile, g,
-                                   ico_uxf_conf_appendStr(key,".displayno"), &error);
+                                   ico_uxf_conf_subKey(numkeys, i, ".displayno"), &error);
         if (error) {
             display->displayno = -1;
             g_clear_error(&error);
         }
         display->wayland =
             g_key_file_get_string(keyfile, g,
-                                  ico_uxf_conf_appendStr(key,".wayland"), &error);
+                                  ico_uxf_conf_subKey(numkeys, i, ".wayland"), &error);
         ico_uxf_conf_checkGerror(&error);
 
         display->type =
             ico_uxf_getSysDispTypeByName(g_key_file_get_string(keyfile, g,
-                                         ico_uxf_conf_appendStr(key,".type"), &error));
+                                         ico_uxf_conf_subKey(numkeys, i, ".type"), &error));
         ico_uxf_conf_checkGerror(&error);
 
         display->width =
-            g_key_file_get_integer(keyfile, g, ico_uxf_conf_appendStr(key,".width"), &error);
+            g_key_file_get_integer(keyfile, g, ico_uxf_conf_subKey(numkeys, i, ".width"), &error);
         ico_uxf_conf_checkGerror(&error);
         display->height =
-            g_key_file_get_integer(keyfile, g, ico_uxf_conf_appendStr(key,".height"), &error);
+            g_key_file_get_integer(keyfile, g, ico_uxf_conf_subKey(numkeys, i, ".height"), &error);
         ico_uxf_conf_checkGerror(&error);
         display->layerNum =
-            g_key_file_get_integer(keyfile, g, ico_uxf_conf_appendStr(key,".layer"), &error);
+            g_key_file_get_integer(keyfile, g, ico_uxf_conf_subKey(numkeys, i, ".layer"), &error);
         ico_uxf_conf_checkGerror(&error);
 
         /* inch                     */
         display->inch =
-            g_key_file_get_integer(keyfile,g,ico_uxf_conf_appendStr(key,".inch"),&error);
+            g_key_file_get_integer(keyfile,g,ico_uxf_conf_subKey(numkeys, i, ".inch"),&error);
         ico_uxf_conf_checkGerror(&error);
 
         apfw_trace("Display.%d Id = %d Name = %s Host = %d DispNo = %d W/H = %d/%d Wayland = %s inch = %d",
@@ -649,20 +916,19 @@ reloadSysConfig(void)
         int displayer_length;
         gchar **layerlist;
         gsize layersize;
-        GString* layer_key = g_string_new("");
         for (displayer_length = 0;
              displayer_length < ICO_UXF_DISPLAY_LAYER_MAX; displayer_length++)  {
-            g_string_printf(layer_key,"%s.layer.%d",key,displayer_length);
-            if (g_key_file_has_key(keyfile,g,layer_key->str,NULL) != TRUE)   break;
+            subkey = ico_uxf_conf_subKeyNum(numkeys, i, ".layer.", displayer_length);
+            if (g_key_file_has_key(keyfile,g,subkey,NULL) != TRUE)   break;
         }
         apfw_trace("Display.%d layerNum = %d" ,i, displayer_length);
         display->layerNum = displayer_length;
         display->layer = g_malloc0(sizeof(Ico_Uxf_conf_display_layer)*displayer_length);
 
         for (j = 0; j < displayer_length; j++)  {
-            g_string_printf(layer_key,"%s.layer.%d",key,j);
+            subkey = ico_uxf_conf_subKeyNum(numkeys, i, ".layer.", j);
             display->layer[j].id = j;
-            layerlist = g_key_file_get_string_list(keyfile, g, layer_key->str,
+            layerlist = g_key_file_get_string_list(keyfile, g, subkey,
                                                    &layersize, &error);
             ico_uxf_conf_checkGerror(&error);
             if (layersize <= 0) {
@@ -681,15 +947,13 @@ reloadSysConfig(void)
             }
             if (layerlist)  g_strfreev(layerlist);
         }
-        g_string_free(layer_key,TRUE);
 
         /* display zone         */
         int dispzone_length;
-        GString* zone_key = g_string_new("");
         for (dispzone_length = 0;
              dispzone_length < ICO_UXF_DISPLAY_ZONE_MAX; dispzone_length++) {
-            g_string_printf(zone_key,"%s.zone.%d",key,dispzone_length);
-            if (g_key_file_has_key(keyfile,g,zone_key->str,NULL) != TRUE)    break;
+            subkey = ico_uxf_conf_subKeyNum(numkeys, i, ".zone.", dispzone_length);
+            if (g_key_file_has_key(keyfile,g,subkey,NULL) != TRUE)    break;
         }
         apfw_trace("Display.%d zoneNum = %d" ,i, dispzone_length);
         display->zoneNum = dispzone_length;
@@ -701,9 +965,9 @@ reloadSysConfig(void)
         Ico_Uxf_conf_display_zone *zone;
 
         for (j = 0; j < dispzone_length; j++)   {
-            g_string_printf(zone_key,"%s.zone.%d",key,j);
+            subkey = ico_uxf_conf_subKeyNum(numkeys, i, ".zone.", j);
             zonelists[j] = g_key_file_get_string_list(
-                                    keyfile, g, zone_key->str, &zonesizes[j], &error);
+                                    keyfile, g, subkey, &zonesizes[j], &error);
             ico_uxf_conf_checkGerror(&error);
             if ((! zonelists[j]) || (zonesizes[j] <= 0)) {
                 apfw_error("reloadSysConfig: display.%d zone.%d dose not exist",i,j);
@@ -768,33 +1032,36 @@ reloadSysConfig(void)
                        zone->overlapNum, zone->overlap[0], zone->overlap[1],
                        zone->overlap[2], zone->overlap[3], zone->overlap[4]);
         }
-        g_string_free(zone_key,TRUE);
     }
-    g_list_free_full(idlist,g_free);
+    ico_uxf_conf_freeNumericalKeys(numkeys);
 
     /* sound devices                        */
-    idlist = ico_uxf_conf_countNumericalKey(keyfile, "sound");
-    length = g_list_length(idlist);
-    _ico_sys_config->soundNum = length;
-    _ico_sys_config->sound = g_malloc0(sizeof(Ico_Uxf_conf_sound) * length);
+    numkeys = ico_uxf_conf_getNumericalKeys(keyfile, "sound");
+    if (! numkeys)  {
+        g_key_file_free(keyfile);
+        return NULL;
+    }
+    length = numkeys->num;
+    conf->soundNum = length;
+    conf->sound = g_malloc0(sizeof(Ico_Uxf_conf_sound) * length);
     zoneidx = 0;
 
     for (i = 0; i < (int)length; i++) {
-        const char* key = (const char*) g_list_nth_data(idlist, i);
+        const char* key = numkeys->key[i];
         const char* g = "sound";
-        Ico_Uxf_conf_sound *sound = &_ico_sys_config->sound[i];
-        sound->id = ico_uxf_conf_getUint(key);
+        Ico_Uxf_conf_sound *sound = &conf->sound[i];
+        sound->id = numkeys->id[i];
         ico_uxf_conf_checkGerror(&error);
         sound->name = g_key_file_get_string(keyfile, g, key, &error);
         ico_uxf_conf_checkGerror(&error);
 
         sound->hostId =
             ico_uxf_getSysHostByName(g_key_file_get_string(
-                                    keyfile, g, ico_uxf_conf_appendStr(key,".host"), &error));
+                                    keyfile, g, ico_uxf_conf_subKey(numkeys, i, ".host"), &error));
         ico_uxf_conf_checkGerror(&error);
         sound->soundno =
             g_key_file_get_integer(keyfile, g,
-                                   ico_uxf_conf_appendStr(key,".soundno"), &error);
+                                   ico_uxf_conf_subKey(numkeys, i, ".soundno"), &error);
         if (error) {
             sound->soundno = -1;
             g_clear_error(&error);
@@ -805,11 +1072,10 @@ reloadSysConfig(void)
 
         /* sound zone           */
         int sound_length;
-        GString* sound_key = g_string_new("");
         for (sound_length = 0;
              sound_length < ICO_UXF_SOUND_ZONE_MAX; sound_length++) {
-            g_string_printf(sound_key,"%s.zone.%d", key, sound_length);
-            if (g_key_file_has_key(keyfile,g,sound_key->str,NULL) != TRUE)   break;
+            subkey = ico_uxf_conf_subKeyNum(numkeys, i, ".zone.", sound_length);
+            if (g_key_file_has_key(keyfile,g,subkey,NULL) != TRUE)   break;
         }
         apfw_trace("Sound.%d zoneNum = %d" ,i, sound_length);
         sound->zoneNum = sound_length;
@@ -821,9 +1087,9 @@ reloadSysConfig(void)
         Ico_Uxf_conf_sound_zone *zone;
 
         for (j = 0; j < sound_length; j++)  {
-            g_string_printf(sound_key,"%s.zone.%d",key,j);
+            subkey = ico_uxf_conf_subKeyNum(numkeys, i, ".zone.", j);
             zonelists[j] =
-                g_key_file_get_string_list(keyfile,g,sound_key->str,&zonesizes[j],&error);
+                g_key_file_get_string_list(keyfile,g,subkey,&zonesizes[j],&error);
             ico_uxf_conf_checkGerror(&error);
             if ((! zonelists[j]) || (zonesizes[j] <= 0)) {
                 apfw_error("reloadSysConfig: sound.%d zone.%d dose not exist",i,j);
@@ -874,31 +1140,33 @@ reloadSysConfig(void)
                        zone->overlapNum, zone->overlap[0], zone->overlap[1],
                        zone->overlap[2], zone->overlap[3], zone->overlap[4]);
         }
-        g_string_free(sound_key,TRUE);
     }
-    g_list_free_full(idlist,g_free);
+    ico_uxf_conf_freeNumericalKeys(numkeys);
 
     /* input devices                        */
-    idlist = ico_uxf_conf_countNumericalKey(keyfile, "input");
-    length = g_list_length(idlist);
-    _ico_sys_config->inputdevNum = length;
-    _ico_sys_config->inputdev = g_malloc0(sizeof(Ico_Uxf_conf_inputdev) * length);
+    numkeys = ico_uxf_conf_getNumericalKeys(keyfile, "input");
+    if (! numkeys)  {
+        g_key_file_free(keyfile);
+        return NULL;
+    }
+    length = numkeys->num;
+    conf->inputdevNum = length;
+    conf->inputdev = g_malloc0(sizeof(Ico_Uxf_conf_inputdev) * length);
 
     for (i = 0; i < (int)length; i++) {
-        const char* key = (const char*) g_list_nth_data(idlist, i);
+        const char* key = numkeys->key[i];
         const char* g = "input";
-        Ico_Uxf_conf_inputdev *inputdev = &_ico_sys_config->inputdev[i];
-        inputdev->id = ico_uxf_conf_getUint(key);
+        Ico_Uxf_conf_inputdev *inputdev = &conf->inputdev[i];
+        inputdev->id = numkeys->id[i];
         ico_uxf_conf_checkGerror(&error);
         inputdev->name = g_key_file_get_string(keyfile, g, key, &error);
         ico_uxf_conf_checkGerror(&error);
 
         /* input sw             */
         int sw_length;
-        GString* sw_key = g_string_new("");
         for (sw_length = 0;; sw_length++)   {
-            g_string_printf(sw_key,"%s.sw.%d",key,sw_length);
-            if (g_key_file_has_key(keyfile,g,sw_key->str,NULL) != TRUE)  break;
+            subkey = ico_uxf_conf_subKeyNum(numkeys, i, ".sw.", sw_length);
+            if (g_key_file_has_key(keyfile,g,subkey,NULL) != TRUE)  break;
         }
         apfw_trace("Input.%d swNum = %d" ,i, sw_length);
         inputdev->inputswNum = sw_length;
@@ -908,8 +1176,8 @@ reloadSysConfig(void)
         gchar **swlist;
         gsize   swsize;
         for (j = 0; j < sw_length; j++) {
-            g_string_printf(sw_key,"%s.sw.%d",key,j);
-            swlist = g_key_file_get_string_list(keyfile,g,sw_key->str,&swsize,&error);
+            subkey = ico_uxf_conf_subKeyNum(numkeys, i, ".sw.", j);
+            swlist = g_key_file_get_string_list(keyfile,g,subkey,&swsize,&error);
             ico_uxf_conf_checkGerror(&error);
             if ((!swlist) || (swsize <= 0))  {
                 apfw_error("reloadSysConfig: input.%d sw.%d dose not exist",i,j);
@@ -928,55 +1196,60 @@ reloadSysConfig(void)
                        inputdev->inputsw[j].name ? inputdev->inputsw[j].name : " ",
                        inputdev->inputsw[j].appid ? inputdev->inputsw[j].appid : " ");
         }
-        g_string_free(sw_key,TRUE);
     }
-    g_list_free_full(idlist,g_free);
+    ico_uxf_conf_freeNumericalKeys(numkeys);
+    linkSysInputHash(conf);
 
-    _ico_sys_config->misc.default_kindId = ico_uxf_getSysKindByName(
+    conf->misc.default_kindId = ico_uxf_getSysKindByName(
                         g_key_file_get_string(keyfile, "default", "kind", &error));
     ico_uxf_conf_checkGerror(&error);
-    _ico_sys_config->misc.default_categoryId = ico_uxf_getSysCategoryByName(
+    conf->misc.default_categoryId = ico_uxf_getSysCategoryByName(
                         g_key_file_get_string(keyfile, "default", "category", &error));
     ico_uxf_conf_checkGerror(&error);
-    _ico_sys_config->misc.default_displayId = ico_uxf_getSysDisplayByName(
+    conf->misc.default_displayId = ico_uxf_getSysDisplayByName(
                         g_key_file_get_string(keyfile, "default", "display", &error));
     ico_uxf_conf_checkGerror(&error);
-    _ico_sys_config->misc.default_layerId = ico_uxf_getSysLayerByName(
-                        _ico_sys_config->misc.default_displayId,
+    conf->misc.default_layerId = ico_uxf_getSysLayerByName(
+                        conf->misc.default_displayId,
                         g_key_file_get_string(keyfile, "default", "layer", &error));
     ico_uxf_conf_checkGerror(&error);
-    _ico_sys_config->misc.default_dispzoneId = ico_uxf_getSysDispZoneByName(
-                        _ico_sys_config->misc.default_displayId,
+    conf->misc.default_dispzoneId = ico_uxf_getSysDispZoneByName(
+                        conf->misc.default_displayId,
                         g_key_file_get_string(keyfile, "default", "displayzone", &error));
-    _ico_sys_config->misc.default_soundId = ico_uxf_getSysSoundByName(
+    conf->misc.default_soundId = ico_uxf_getSysSoundByName(
                         g_key_file_get_string(keyfile, "default", "sound", &error));
-    _ico_sys_config->misc.default_soundzoneId = ico_uxf_getSysSoundZoneByName(
-                        _ico_sys_config->misc.default_soundId,
+    conf->misc.default_soundzoneId = ico_uxf_getSysSoundZoneByName(
+                        conf->misc.default_soundId,
                         g_key_file_get_string(keyfile, "default", "soundzone", &error));
     ico_uxf_conf_checkGerror(&error);
-    _ico_sys_config->misc.default_inputdevId = ico_uxf_getSysInputdevByName(
+    conf->misc.default_inputdevId = ico_uxf_getSysInputdevByName(
                         g_key_file_get_string(keyfile, "default", "inputdev", &error));
-    _ico_sys_config->misc.default_inputswId = ico_uxf_getSysInputswByName(
-                        _ico_sys_config->misc.default_inputdevId,
+    conf->misc.default_inputswId = ico_uxf_getSysInputswByName(
+                        conf->misc.default_inputdevId,
                         g_key_file_get_string(keyfile, "default", "inputsw", &error));
     ico_uxf_conf_checkGerror(&error);
 
     apfw_trace("Default host = %d kind = %d category = %d disp = %d layer = %d dispzone = %d "
                "sound = %d soundzone = %d input = %d/%d",
-               _ico_sys_config->misc.default_hostId,
-               _ico_sys_config->misc.default_kindId,
-               _ico_sys_config->misc.default_categoryId,
-               _ico_sys_config->misc.default_displayId,
-               _ico_sys_config->misc.default_layerId,
-               _ico_sys_config->misc.default_dispzoneId,
-               _ico_sys_config->misc.default_soundId,
-               _ico_sys_config->misc.default_soundzoneId,
-               _ico_sys_config->misc.default_inputdevId,
-               _ico_sys_config->misc.default_inputswId);
+               conf->misc.default_hostId,
+               conf->misc.default_kindId,
+               conf->misc.default_categoryId,
+               conf->misc.default_displayId,
+               conf->misc.default_layerId,
+               conf->misc.default_dispzoneId,
+               conf->misc.default_soundId,
+               conf->misc.default_soundzoneId,
+               conf->misc.default_inputdevId,
+               conf->misc.default_inputswId);
     g_key_file_free(keyfile);
 
+    /* rebuild compiled cache for next start    */
+    if (usecache)   {
+        (void) ico_uxf_conf_saveCache(cachefile, &srcstat, conf);
+    }
+
     apfw_trace("reloadSysConfig: Leave");
-    return _ico_sys_config;
+    return conf;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -993,14 +1266,13 @@ ICO_APF_API const Ico_Uxf_conf_host *
 ico_uxf_getSysHostById(const int hostId)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
+    conf = currentSysConfig();
 
-    for (i = 0; i < _ico_sys_config->hostNum; i++) {
-        if (_ico_sys_config->host[i].id == hostId) {
-            return &_ico_sys_config->host[i];
+    for (i = 0; i < conf->hostNum; i++) {
+        if (conf->host[i].id == hostId) {
+            return &conf->host[i];
         }
     }
     apfw_warn("ico_uxf_getSysHostById(%d) Illegal Host Number", hostId);
@@ -1021,14 +1293,13 @@ ICO_APF_API const char *
 ico_uxf_get_SysLocation(const int hostId)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
+    conf = currentSysConfig();
 
-    for (i = 0; i < _ico_sys_config->hostNum; i++) {
-        if (_ico_sys_config->host[i].id == hostId) {
-            return _ico_sys_config->host[i].address;
+    for (i = 0; i < conf->hostNum; i++) {
+        if (conf->host[i].id == hostId) {
+            return conf->host[i].address;
         }
     }
     apfw_warn("Ico_uxf_get_SysLocation(%d) Illegal Host Number", hostId);
@@ -1049,14 +1320,13 @@ ICO_APF_API const Ico_Uxf_conf_display *
 ico_uxf_getSysDisplayById(const int displayId)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
+    conf = currentSysConfig();
 
-    for (i = 0; i < _ico_sys_config->displayNum; i++)  {
-        if (_ico_sys_config->display[i].id == displayId)   {
-            return &_ico_sys_config->display[i];
+    for (i = 0; i < conf->displayNum; i++)  {
+        if (conf->display[i].id == displayId)   {
+            return &conf->display[i];
         }
     }
     apfw_warn("ico_uxf_getSysDisplayById(%d) Illegal Display Number", displayId);
@@ -1075,26 +1345,25 @@ ICO_APF_API int
 ico_uxf_getSysHostByName(const char *shost)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
-    if (_ico_sys_config->hostNum <= 0)  {
+    conf = currentSysConfig();
+    if (conf->hostNum <= 0)  {
         apfw_critical("ico_uxf_getSysHostByName: can not read configuration file");
-        return _ico_sys_config->misc.default_hostId;
+        return conf->misc.default_hostId;
     }
 
     if ((! shost) || (*shost == 0))    {
-        return _ico_sys_config->host[0].id;
+        return conf->host[0].id;
     }
 
-    for (i = 0; i < _ico_sys_config->hostNum; i++) {
-        if (strcasecmp(shost, _ico_sys_config->host[i].name) == 0)    {
-            return _ico_sys_config->host[i].id;
+    for (i = 0; i < conf->hostNum; i++) {
+        if (strcasecmp(shost, conf->host[i].name) == 0)    {
+            return conf->host[i].id;
         }
     }
     apfw_warn("ico_uxf_getSysHostByName(%s) Illegal Host Name", shost);
-    return _ico_sys_config->misc.default_hostId;
+    return conf->misc.default_hostId;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1212,22 +1481,21 @@ ICO_APF_API int
 ico_uxf_getSysDisplayByName(const char *sdisplay)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
+    conf = currentSysConfig();
     if ((! sdisplay) || (*sdisplay == 0))  {
         apfw_trace("ico_uxf_getSysDisplayByName(NULL) Illegal Display Name");
-        return _ico_sys_config->misc.default_displayId;
+        return conf->misc.default_displayId;
     }
 
-    for (i = 0; i < _ico_sys_config->displayNum; i++) {
-        if (strcasecmp(sdisplay, _ico_sys_config->display[i].name) == 0)    {
-            return _ico_sys_config->display[i].id;
+    for (i = 0; i < conf->displayNum; i++) {
+        if (strcasecmp(sdisplay, conf->display[i].name) == 0)    {
+            return conf->display[i].id;
         }
     }
     apfw_warn("ico_uxf_getSysDisplayByName(%s) Illegal Display Name", sdisplay);
-    return _ico_sys_config->misc.default_displayId;
+    return conf->misc.default_displayId;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1244,24 +1512,23 @@ ico_uxf_getSysLayerByName(const int display, const char *slayer)
 {
     int     i;
     char    *errp;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
+    conf = currentSysConfig();
 
-    if ((display < 0) || (display >= _ico_sys_config->displayNum)) {
+    if ((display < 0) || (display >= conf->displayNum)) {
         apfw_warn("ico_uxf_getSysLayerByName(%d,%s) Illegal Display Number",
                             display, slayer);
-        return _ico_sys_config->misc.default_layerId;
+        return conf->misc.default_layerId;
     }
     if ((! slayer) || (*slayer == 0))  {
         apfw_trace("ico_uxf_getSysLayerByName(NULL) Illegal Layer Name");
-        return _ico_sys_config->misc.default_layerId;
+        return conf->misc.default_layerId;
     }
 
-    for (i = 0; i < _ico_sys_config->display[display].layerNum; i++)    {
-        if (strcasecmp(slayer, _ico_sys_config->display[display].layer[i].name) == 0)   {
-            return _ico_sys_config->display[display].layer[i].id;
+    for (i = 0; i < conf->display[display].layerNum; i++)    {
+        if (strcasecmp(slayer, conf->display[display].layer[i].name) == 0)   {
+            return conf->display[display].layer[i].id;
         }
     }
 
@@ -1269,7 +1536,7 @@ ico_uxf_getSysLayerByName(const int display, const char *slayer)
     i = strtol(slayer, &errp, 0);
     if ((errp) && (*errp != 0)) {
         apfw_warn("ico_uxf_getSysLayerByName(%d,%s) Illegal Layer Name", display, slayer);
-        i = _ico_sys_config->misc.default_layerId;
+        i = conf->misc.default_layerId;
     }
     return i;
 }
@@ -1286,24 +1553,23 @@ ICO_APF_API int
 ico_uxf_getSysKindByName(const char *skind)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
-    if (_ico_sys_config->kindNum <= 0)  {
+    conf = currentSysConfig();
+    if (conf->kindNum <= 0)  {
         apfw_critical("ico_uxf_getSysKindByName: can not read configuration file");
-        return _ico_sys_config->misc.default_kindId;
+        return conf->misc.default_kindId;
     }
 
     if ((skind) && (*skind != 0))  {
-        for (i = 0; i < _ico_sys_config->kindNum; i++) {
-            if (strcasecmp(skind, _ico_sys_config->kind[i].name) == 0)    {
-                return _ico_sys_config->kind[i].id;
+        for (i = 0; i < conf->kindNum; i++) {
+            if (strcasecmp(skind, conf->kind[i].name) == 0)    {
+                return conf->kind[i].id;
             }
         }
     }
     apfw_warn("ico_uxf_getSysKindByName(%s) Illegal kind name", skind);
-    return _ico_sys_config->misc.default_kindId;
+    return conf->misc.default_kindId;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1318,24 +1584,23 @@ ICO_APF_API int
 ico_uxf_getSysCategoryByName(const char *scategory)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
-    if (_ico_sys_config->categoryNum <= 0)  {
+    conf = currentSysConfig();
+    if (conf->categoryNum <= 0)  {
         apfw_critical("ico_uxf_getSysCategoryByName: can not read configuration file");
-        return _ico_sys_config->misc.default_categoryId;
+        return conf->misc.default_categoryId;
     }
 
     if ((scategory) && (*scategory != 0))  {
-        for (i = 0; i < _ico_sys_config->categoryNum; i++) {
-            if (strcasecmp(scategory, _ico_sys_config->category[i].name) == 0)    {
-                return _ico_sys_config->category[i].id;
+        for (i = 0; i < conf->categoryNum; i++) {
+            if (strcasecmp(scategory, conf->category[i].name) == 0)    {
+                return conf->category[i].id;
             }
         }
     }
     apfw_warn("ico_uxf_getSysCategoryByName(%s) Illegal category name", scategory);
-    return _ico_sys_config->misc.default_categoryId;
+    return conf->misc.default_categoryId;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1351,25 +1616,24 @@ ICO_APF_API int
 ico_uxf_getSysDispZoneByName(const int display, const char *sdispzone)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
-    if ((display < 0) || (display >= _ico_sys_config->displayNum) ||
-        (_ico_sys_config->display[display].zoneNum <= 0))   {
+    conf = currentSysConfig();
+    if ((display < 0) || (display >= conf->displayNum) ||
+        (conf->display[display].zoneNum <= 0))   {
         apfw_critical("ico_uxf_getSysDispZoneByName: can not read configuration file");
-        return _ico_sys_config->misc.default_dispzoneId;
+        return conf->misc.default_dispzoneId;
     }
 
     if ((sdispzone) && (*sdispzone != 0))  {
-        for (i = 0; i < _ico_sys_config->display[display].zoneNum; i++) {
-            if (strcasecmp(sdispzone, _ico_sys_config->display[display].zone[i].name) == 0) {
-                return _ico_sys_config->display[display].zone[i].id;
+        for (i = 0; i < conf->display[display].zoneNum; i++) {
+            if (strcasecmp(sdispzone, conf->display[display].zone[i].name) == 0) {
+                return conf->display[display].zone[i].id;
             }
         }
     }
     apfw_warn("ico_uxf_getSysDispZoneByName(%s) Illegal zone name", sdispzone);
-    return _ico_sys_config->misc.default_dispzoneId;
+    return conf->misc.default_dispzoneId;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1384,24 +1648,23 @@ ICO_APF_API int
 ico_uxf_getSysSoundByName(const char *ssound)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
-    if (_ico_sys_config->soundNum <= 0) {
+    conf = currentSysConfig();
+    if (conf->soundNum <= 0) {
         apfw_critical("ico_uxf_getSysSoundByName: can not read configuration file");
-        return _ico_sys_config->misc.default_soundId;
+        return conf->misc.default_soundId;
     }
 
     if ((ssound) && (*ssound != 0))    {
-        for (i = 0; i < _ico_sys_config->soundNum; i++) {
-            if (strcasecmp(ssound, _ico_sys_config->sound[i].name) == 0)    {
-                return _ico_sys_config->sound[i].id;
+        for (i = 0; i < conf->soundNum; i++) {
+            if (strcasecmp(ssound, conf->sound[i].name) == 0)    {
+                return conf->sound[i].id;
             }
         }
     }
     apfw_warn("ico_uxf_getSysSoundByName(%s) Illegal sound name", ssound);
-    return _ico_sys_config->misc.default_soundId;
+    return conf->misc.default_soundId;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1417,25 +1680,24 @@ ICO_APF_API int
 ico_uxf_getSysSoundZoneByName(const int sound, const char *ssoundzone)
 {
     int     i;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
-    if ((sound < 0) || (sound >= _ico_sys_config->soundNum) ||
-        (_ico_sys_config->sound[sound].zoneNum <= 0))   {
+    conf = currentSysConfig();
+    if ((sound < 0) || (sound >= conf->soundNum) ||
+        (conf->sound[sound].zoneNum <= 0))   {
         apfw_critical("ico_uxf_getSysSoundZoneByName: can not read configuration file");
-        return _ico_sys_config->misc.default_soundzoneId;
+        return conf->misc.default_soundzoneId;
     }
 
     if ((ssoundzone) && (*ssoundzone != 0))    {
-        for (i = 0; i < _ico_sys_config->sound[sound].zoneNum; i++) {
-            if (strcasecmp(ssoundzone, _ico_sys_config->sound[sound].zone[i].name) == 0)    {
-                return _ico_sys_config->sound[sound].zone[i].id;
+        for (i = 0; i < conf->sound[sound].zoneNum; i++) {
+            if (strcasecmp(ssoundzone, conf->sound[sound].zone[i].name) == 0)    {
+                return conf->sound[sound].zone[i].id;
             }
         }
     }
     apfw_warn("ico_uxf_getSysSoundZoneByName(%s) Illegal zone name", ssoundzone);
-    return _ico_sys_config->misc.default_soundzoneId;
+    return conf->misc.default_soundzoneId;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1449,27 +1711,27 @@ ico_uxf_getSysSoundZoneByName(const int sound, const char *ssoundzone)
 ICO_APF_API int
 ico_uxf_getSysInputdevByName(const char *sinputdev)
 {
-    int     i;
+    Ico_Uxf_conf_inputdev   *dev;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
-    if (_ico_sys_config->inputdevNum <= 0)  {
+    conf = currentSysConfig();
+    if (conf->inputdevNum <= 0)  {
         apfw_critical("ico_uxf_getSysInputdevByName: can not read configuration file");
-        return _ico_sys_config->misc.default_inputdevId;
+        return conf->misc.default_inputdevId;
     }
 
     if ((! sinputdev) || (*sinputdev == 0))    {
-        return _ico_sys_config->misc.default_inputdevId;
+        return conf->misc.default_inputdevId;
     }
 
-    for (i = 0; i < _ico_sys_config->inputdevNum; i++) {
-        if (strcasecmp(sinputdev, _ico_sys_config->inputdev[i].name) == 0)    {
-            return _ico_sys_config->inputdev[i].id;
+    for (dev = conf->hashinputdev[ICO_UXF_MISC_HASHBYNAME(sinputdev)]; dev;
+         dev = dev->nexthash)   {
+        if (strcasecmp(sinputdev, dev->name) == 0)  {
+            return dev->id;
         }
     }
     apfw_warn("ico_uxf_getSysInputdevByName(%s) Illegal device Name", sinputdev);
-    return _ico_sys_config->misc.default_inputdevId;
+    return conf->misc.default_inputdevId;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1484,22 +1746,22 @@ ico_uxf_getSysInputdevByName(const char *sinputdev)
 ICO_APF_API int
 ico_uxf_getSysInputswByName(const int inputdev, const char *sinputsw)
 {
-    int     i;
+    Ico_Uxf_conf_inputsw    *sw;
+    Ico_Uxf_Sys_Config  *conf;
 
-    if (!_ico_sys_config) {
-        (void)ico_uxf_getSysConfig();
-    }
-    if ((inputdev < 0) || (inputdev >= _ico_sys_config->inputdevNum) ||
-        (_ico_sys_config->inputdev[inputdev].inputswNum <= 0))  {
+    conf = currentSysConfig();
+    if ((inputdev < 0) || (inputdev >= conf->inputdevNum) ||
+        (conf->inputdev[inputdev].inputswNum <= 0))  {
         apfw_critical("ico_uxf_getSysInputswByName: can not read configuration file");
         return 0;
     }
 
     if ((sinputsw) && (*sinputsw != 0)) {
-        for (i = 0; i < _ico_sys_config->inputdev[inputdev].inputswNum; i++)    {
-            if (strcasecmp(sinputsw, _ico_sys_config->inputdev[inputdev].inputsw[i].name)
-                    == 0)    {
-                return i;
+        for (sw = conf->hashinputsw[ICO_UXF_MISC_HASHBYNAME(sinputsw)]; sw;
+             sw = sw->nexthash) {
+            if ((sw->inputdev == &conf->inputdev[inputdev]) &&
+                (strcasecmp(sinputsw, sw->name) == 0))  {
+                return sw - conf->inputdev[inputdev].inputsw;
             }
         }
     }
@@ -1519,11 +1781,446 @@ ico_uxf_getSysInputswByName(const int inputdev, const char *sinputsw)
 ICO_APF_API void
 ico_uxf_closeSysConfig(void)
 {
+    ico_uxf_conf_unwatchSysConfig();
+
     if (_ico_sys_config != NULL)    {
-        g_free(_ico_sys_config->host);
-        g_free(_ico_sys_config->display);
-        g_free(_ico_sys_config);
+        ico_uxf_conf_freeSysConfig(_ico_sys_config);
         _ico_sys_config = NULL;
     }
+    sys_cached_config = NULL;
+    ico_uxf_conf_releaseCache();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   buildSysConfig: read system configuration to the table(static function)
+ *          ico_uxf_getSysXxxByName in reading refer to this table
+ *
+ * @param[out]  conf            system configuration table to read in
+ * @param[in]   live            live reload(=1) or first read(=0)
+ * @return      system configuration table
+ * @retval      != NULL         success(system configuration table address)
+ * @retval      == NULL         error(can not read configuration file)
+ */
+/*--------------------------------------------------------------------------*/
+static Ico_Uxf_Sys_Config *
+buildSysConfig(Ico_Uxf_Sys_Config *conf, const int live)
+{
+    Ico_Uxf_Sys_Config  *ret;
+
+    _ico_sys_reading = conf;
+    ret = reloadSysConfig(conf, live);
+    _ico_sys_reading = NULL;
+
+    return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   currentSysConfig: get system configuration table for reference
+ *          (static function)
+ *
+ * @param       none
+ * @return      configuration in reading by this thread, or published configuration
+ */
+/*--------------------------------------------------------------------------*/
+static Ico_Uxf_Sys_Config *
+currentSysConfig(void)
+{
+    if (_ico_sys_reading)   {
+        return _ico_sys_reading;
+    }
+    if (! _ico_sys_config)  {
+        (void)ico_uxf_getSysConfig();
+    }
+    return _ico_sys_config;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   validSysConfig: check new system configuration before publish
+ *          (static function)
+ *
+ * @param[in]   conf            system configuration table
+ * @return      result
+ * @retval      1               valid
+ * @retval      0               invalid(keep current configuration)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+validSysConfig(const Ico_Uxf_Sys_Config *conf)
+{
+    int     i, j;
+
+    if ((conf->hostNum <= 0) || (conf->displayNum <= 0) ||
+        (conf->categoryNum <= 0) || (conf->kindNum <= 0))    {
+        apfw_warn("validSysConfig: no host(%d), display(%d), category(%d) or kind(%d)",
+                  conf->hostNum, conf->displayNum, conf->categoryNum, conf->kindNum);
+        return 0;
+    }
+    if (conf->categoryNum > ICO_UXF_CATEGORY_MAX)   {
+        apfw_warn("validSysConfig: too many categories(%d)", conf->categoryNum);
+        return 0;
+    }
+    for (i = 0; i < conf->displayNum; i++)  {
+        for (j = 0; j < conf->display[i].zoneNum; j++)  {
+            if (! conf->display[i].zone[j].name)    {
+                apfw_warn("validSysConfig: display.%d zone.%d has no name", i, j);
+                return 0;
+            }
+        }
+    }
+    for (i = 0; i < conf->soundNum; i++)    {
+        for (j = 0; j < conf->sound[i].zoneNum; j++)    {
+            if (! conf->sound[i].zone[j].name)  {
+                apfw_warn("validSysConfig: sound.%d zone.%d has no name", i, j);
+                return 0;
+            }
+        }
+    }
+    for (i = 0; i < conf->displayNum; i++)  {
+        if (conf->display[i].id == conf->misc.default_displayId)    break;
+    }
+    if ((i >= conf->displayNum) || (conf->misc.default_dispzoneId < 0) ||
+        (conf->misc.default_dispzoneId >= conf->display[i].zoneNum))    {
+        apfw_warn("validSysConfig: illegal default display(%d) or zone(%d)",
+                  conf->misc.default_displayId, conf->misc.default_dispzoneId);
+        return 0;
+    }
+    return 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   linkSysInputHash: make name hash of input devices and switches
+ *          (static function)
+ *
+ * @param[in]   conf            system configuration table
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+linkSysInputHash(Ico_Uxf_Sys_Config *conf)
+{
+    int     i, j;
+    int     hash;
+    Ico_Uxf_conf_inputdev   *dev;
+    Ico_Uxf_conf_inputsw    *sw;
+
+    memset(conf->hashinputdev, 0, sizeof(conf->hashinputdev));
+    memset(conf->hashinputsw, 0, sizeof(conf->hashinputsw));
+
+    /* link in reverse order, same name is found in configuration order */
+    for (i = conf->inputdevNum - 1; i >= 0; i--)    {
+        dev = &conf->inputdev[i];
+        if (dev->name)  {
+            hash = ICO_UXF_MISC_HASHBYNAME(dev->name);
+            dev->nexthash = conf->hashinputdev[hash];
+            conf->hashinputdev[hash] = dev;
+        }
+        for (j = dev->inputswNum - 1; j >= 0; j--)  {
+            sw = &dev->inputsw[j];
+            if (! sw->name) continue;
+            sw->inputdev = dev;
+            hash = ICO_UXF_MISC_HASHBYNAME(sw->name);
+            sw->nexthash = conf->hashinputsw[hash];
+            conf->hashinputsw[hash] = sw;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_freeSysConfig: release system configuration table that
+ *          is not published(replaced by live reload)
+ *
+ * @param[in]   conf            system configuration table(if NULL, nothing to do)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_uxf_conf_freeSysConfig(Ico_Uxf_Sys_Config *conf)
+{
+    int     i, j;
+    int     strings = 1;
+
+    if (! conf) {
+        return;
+    }
+    if (conf == sys_cached_config)  {
+        /* strings are in the mapped image      */
+        strings = 0;
+        sys_cached_config = NULL;
+        ico_uxf_conf_releaseCache();
+    }
+
+    for (i = 0; i < conf->hostNum; i++) {
+        if (strings)    {
+            g_free(conf->host[i].name);
+            g_free(conf->host[i].address);
+            g_free(conf->host[i].homescreen);
+        }
+    }
+    for (i = 0; i < conf->categoryNum; i++) {
+        if (strings)    g_free(conf->category[i].name);
+    }
+    for (i = 0; i < conf->kindNum; i++) {
+        if (strings)    g_free(conf->kind[i].name);
+    }
+    for (i = 0; i < conf->displayNum; i++)  {
+        if (strings)    {
+            g_free(conf->display[i].name);
+            g_free(conf->display[i].wayland);
+            for (j = 0; j < conf->display[i].layerNum; j++) {
+                free(conf->display[i].layer[j].name);
+            }
+            for (j = 0; j < conf->display[i].zoneNum; j++)  {
+                free(conf->display[i].zone[j].name);
+            }
+        }
+        g_free(conf->display[i].layer);
+        g_free(conf->display[i].zone);
+    }
+    for (i = 0; i < conf->soundNum; i++)    {
+        if (strings)    {
+            g_free(conf->sound[i].name);
+            for (j = 0; j < conf->sound[i].zoneNum; j++)    {
+                free(conf->sound[i].zone[j].name);
+            }
+        }
+        g_free(conf->sound[i].zone);
+    }
+    for (i = 0; i < conf->inputdevNum; i++) {
+        if (strings)    {
+            g_free(conf->inputdev[i].name);
+            for (j = 0; j < conf->inputdev[i].inputswNum; j++)  {
+                free(conf->inputdev[i].inputsw[j].name);
+                free(conf->inputdev[i].inputsw[j].appid);
+            }
+        }
+        g_free(conf->inputdev[i].inputsw);
+    }
+    g_free(conf->host);
+    g_free(conf->category);
+    g_free(conf->kind);
+    g_free(conf->display);
+    g_free(conf->sound);
+    g_free(conf->inputdev);
+    g_free(conf);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   sysReloadThread: read changed system configuration(static function)
+ *          the configuration is not published in this thread, main loop
+ *          publishes it by ico_uxf_conf_publishSysConfig after notify.
+ *
+ * @param[in]   arg             (unused)
+ * @return      always NULL
+ */
+/*--------------------------------------------------------------------------*/
+static void *
+sysReloadThread(void *arg)
+{
+    Ico_Uxf_Sys_Config  *conf;
+    Ico_Uxf_Sys_Config  *old = NULL;
+
+    apfw_trace("sysReloadThread: Enter");
+
+    for (;;)    {
+        conf = g_new0(Ico_Uxf_Sys_Config, 1);
+        if ((! buildSysConfig(conf, 1)) || (! validSysConfig(conf)))  {
+            apfw_warn("sysReloadThread: new configuration is not valid, ignored");
+            ico_uxf_conf_freeSysConfig(conf);
+            conf = NULL;
+        }
+
+        pthread_mutex_lock(&sys_reload_mutex);
+        if (sys_reload_state == SYS_RELOAD_AGAIN)   {
+            /* file was changed while reading, read again   */
+            sys_reload_state = SYS_RELOAD_RUN;
+            pthread_mutex_unlock(&sys_reload_mutex);
+            ico_uxf_conf_freeSysConfig(conf);
+            continue;
+        }
+        if (conf)   {
+            old = sys_reload_next;
+            sys_reload_next = conf;
+        }
+        sys_reload_state = SYS_RELOAD_IDLE;
+        pthread_mutex_unlock(&sys_reload_mutex);
+        break;
+    }
+    /* not published configuration is replaced     */
+    ico_uxf_conf_freeSysConfig(old);
+
+    if ((conf) && (sys_reload_notify))  {
+        (*sys_reload_notify)();
+    }
+    apfw_trace("sysReloadThread: Leave(%s)", conf ? "new" : "error");
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_watchSysConfig: start watch of system configuration file
+ *
+ * @param[in]   notify          function called(in reload thread) when new
+ *                              configuration is ready to publish
+ * @return      file descriptor(caller polls it and calls ico_uxf_conf_readSysWatch)
+ * @retval      >= 0            success(inotify file descriptor)
+ * @retval      ICO_UXF_EIO     error(can not watch configuration directory)
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_uxf_conf_watchSysConfig(void (*notify)(void))
+{
+    Ico_Uxf_Sys_Config  *conf;
+
+    if (sys_watch_fd >= 0)  {
+        sys_reload_notify = notify;
+        return sys_watch_fd;
+    }
+    conf = currentSysConfig();
+
+    sys_watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (sys_watch_fd < 0)   {
+        apfw_error("ico_uxf_conf_watchSysConfig: inotify_init1 Error(%d)", errno);
+        return ICO_UXF_EIO;
+    }
+    /* watch directory, because editors replace file by rename  */
+    if (inotify_add_watch(sys_watch_fd, conf->misc.confdir,
+                          IN_CLOSE_WRITE | IN_MOVED_TO) < 0)  {
+        apfw_error("ico_uxf_conf_watchSysConfig: can not watch %s(%d)",
+                   conf->misc.confdir, errno);
+        close(sys_watch_fd);
+        sys_watch_fd = -1;
+        return ICO_UXF_EIO;
+    }
+    sys_reload_notify = notify;
+
+    apfw_trace("ico_uxf_conf_watchSysConfig: watch %s/%s(fd=%d)",
+               conf->misc.confdir, ICO_UXF_CONFIG_SYSTEM, sys_watch_fd);
+    return sys_watch_fd;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_readSysWatch: read events of watch file descriptor, and
+ *          start reload thread if system configuration file was changed
+ *
+ * @param       none
+ * @return      result
+ * @retval      1               reload started
+ * @retval      0               system configuration file is not changed
+ */
+/*--------------------------------------------------------------------------*/
+int
+ico_uxf_conf_readSysWatch(void)
+{
+    char    buf[(sizeof(struct inotify_event) + NAME_MAX + 1) * 4]
+                __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    struct inotify_event    *ev;
+    pthread_t   thread;
+    ssize_t     len;
+    int         offset;
+    int         changed = 0;
+
+    if (sys_watch_fd < 0)   {
+        return 0;
+    }
+    for (;;)    {
+        len = read(sys_watch_fd, buf, sizeof(buf));
+        if (len <= 0)   break;
+        for (offset = 0; offset < (int)len;
+             offset += sizeof(struct inotify_event) + ev->len)   {
+            ev = (struct inotify_event *)&buf[offset];
+            if ((ev->len > 0) && (strcmp(ev->name, ICO_UXF_CONFIG_SYSTEM) == 0))  {
+                changed = 1;
+            }
+        }
+    }
+    if (! changed)  {
+        return 0;
+    }
+    apfw_trace("ico_uxf_conf_readSysWatch: %s changed", ICO_UXF_CONFIG_SYSTEM);
+
+    pthread_mutex_lock(&sys_reload_mutex);
+    if (sys_reload_state != SYS_RELOAD_IDLE)    {
+        /* reload thread reads it again     */
+        sys_reload_state = SYS_RELOAD_AGAIN;
+        pthread_mutex_unlock(&sys_reload_mutex);
+        return 1;
+    }
+    sys_reload_state = SYS_RELOAD_RUN;
+    if (pthread_create(&thread, NULL, sysReloadThread, NULL) != 0)  {
+        apfw_error("ico_uxf_conf_readSysWatch: can not create thread(%d)", errno);
+        sys_reload_state = SYS_RELOAD_IDLE;
+        pthread_mutex_unlock(&sys_reload_mutex);
+        return 0;
+    }
+    (void) pthread_detach(thread);
+    pthread_mutex_unlock(&sys_reload_mutex);
+    return 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_publishSysConfig: publish new system configuration that
+ *          was read by reload thread. ico_uxf_getSysConfig returns new one after
+ *          this call. old configuration is not released, because callers may
+ *          have addresses in it. caller releases it by ico_uxf_conf_freeSysConfig
+ *          after all users changed to new one(grace period).
+ *
+ * @param       none
+ * @return      old system configuration
+ * @retval      != NULL         success(old configuration)
+ * @retval      == NULL         no new configuration
+ */
+/*--------------------------------------------------------------------------*/
+Ico_Uxf_Sys_Config *
+ico_uxf_conf_publishSysConfig(void)
+{
+    Ico_Uxf_Sys_Config  *conf;
+    Ico_Uxf_Sys_Config  *old;
+
+    pthread_mutex_lock(&sys_reload_mutex);
+    conf = sys_reload_next;
+    sys_reload_next = NULL;
+    pthread_mutex_unlock(&sys_reload_mutex);
+
+    if (! conf) {
+        return NULL;
+    }
+    old = _ico_sys_config;
+    g_atomic_pointer_set(&_ico_sys_config, conf);
+    setSysLogLevel(conf);
+
+    apfw_trace("ico_uxf_conf_publishSysConfig: new configuration(%08x, old=%08x)",
+               (int)conf, (int)old);
+    return old;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_conf_unwatchSysConfig: stop watch of system configuration file
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_uxf_conf_unwatchSysConfig(void)
+{
+    if (sys_watch_fd >= 0)  {
+        close(sys_watch_fd);
+        sys_watch_fd = -1;
+    }
+    sys_reload_notify = NULL;
+
+    pthread_mutex_lock(&sys_reload_mutex);
+    ico_uxf_conf_freeSysConfig(sys_reload_next);
+    sys_reload_next = NULL;
+    pthread_mutex_unlock(&sys_reload_mutex);
 }
 
@@ -20,7 +20,11 @@
 #include    <pthread.h>
 #include    <sys/ioctl.h>
 #include    <sys/time.h>
+#include    <sys/resource.h>
+#include    <sys/timerfd.h>
 #include    <fcntl.h>
+#include    <stdint.h>
+#include    <time.h>
 
 #include    "wayland-client.h"
 #include    "ico_window_mgr-client-protocol.h"
@@ -75,6 +79,9 @@ static void ico_uxf_input_inputcb(void *data, struct ico_exinput *ico_exinput,
 /* AppCore(AUL) callback function   */
 static int ico_uxf_aul_aulcb(int pid, void *data);
 
+/* housekeeping timer               */
+static void ico_uxf_timer_expire(void);
+
 /* Variables & Tables               */
 Ico_Uxf_Api_Mng         gIco_Uxf_Api_Mng = { 0 };
 
@@ -154,8 +161,12 @@ ico_uxf_init(const char *name)
     strncpy(gIco_Uxf_Api_Mng.MyProcess, name, ICO_UXF_MAX_PROCESS_NAME);
     gIco_Uxf_Api_Mng.EventMask = 0;
     gIco_Uxf_Api_Mng.WaylandFd = -1;
+    gIco_Uxf_Api_Mng.TimerFd = -1;
     gIco_Uxf_Api_Mng.Wayland_Display = NULL;
-    gIco_Uxf_Api_Mng.InitTimer = ICO_UXF_SUSP_INITTIME;
+    gIco_Uxf_Api_Mng.InitTimer = ico_uxf_timer_now() + (ICO_UXF_SUSP_INITTIME * 1000LL);
+    gIco_Uxf_Api_Mng.NeedTimer = 0;
+    gIco_Uxf_Api_Mng.TimerDeadline = 0;
+    memset(&gIco_Uxf_Api_Mng.TimerStats, 0, sizeof(Ico_Uxf_Timer_Stats));
     gIco_Uxf_Api_Mng.Win_Show_Anima = 1;
     gIco_Uxf_Api_Mng.Win_Hide_Anima = 1;
 
@@ -310,6 +321,13 @@ ico_uxf_init(const char *name)
     gIco_Uxf_Api_Mng.WaylandFd
         = wl_display_get_fd(gIco_Uxf_Api_Mng.Wayland_Display);
 
+    /* housekeeping timer(suspend/resume of applications), armed only when */
+    /* timer is pending, expired by ico_uxf_main_loop_iterate              */
+    gIco_Uxf_Api_Mng.TimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK|TFD_CLOEXEC);
+    if (gIco_Uxf_Api_Mng.TimerFd < 0)   {
+        uifw_warn("ico_uxf_init: timerfd_create Error %d, timer expires at event", errno);
+    }
+
     /* initialize mutex */
     (void) pthread_mutexattr_init(&sMutexAttr);
     if (pthread_mutex_init(&sMutex, &sMutexAttr) != 0) {
@@ -360,6 +378,25 @@ ico_uxf_wl_display_fd(void)
     return gIco_Uxf_Api_Mng.WaylandFd;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_timer_fd: get file descriptor of housekeeping timer
+ *          (if readable, call ico_uxf_main_loop_iterate)
+ *
+ * @param       none
+ * @return      timerfd
+ * @retval      >=0         success(file descriptor)
+ * @retval      < 0         error(no timerfd, timer expires at wayland event)
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API int
+ico_uxf_timer_fd(void)
+{
+    uifw_trace("ico_uxf_timer_fd: fd=%d", gIco_Uxf_Api_Mng.TimerFd);
+
+    return gIco_Uxf_Api_Mng.TimerFd;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_uxf_shutdown: terminate user interface library hor HomeScreen
@@ -410,6 +447,12 @@ ico_uxf_shutdown(void)
         gIco_Uxf_Api_Mng.Wayland_Display = NULL;
     }
 
+    if (gIco_Uxf_Api_Mng.TimerFd >= 0)  {
+        close(gIco_Uxf_Api_Mng.TimerFd);
+        gIco_Uxf_Api_Mng.TimerFd = -1;
+    }
+    gIco_Uxf_Api_Mng.TimerDeadline = 0;
+
     gIco_Uxf_Api_Mng.Initialized = 0;
 
     uifw_trace("ico_uxf_shutdown: Leave(EOK)");
@@ -432,6 +475,9 @@ ico_uxf_main_loop_iterate(void)
     Ico_Uxf_Mng_Callback    *callback;
     Ico_Uxf_Event_Cb        func;
 
+    /* housekeeping timer       */
+    ico_uxf_timer_expire();
+
     wl_display_flush(gIco_Uxf_Api_Mng.Wayland_Display);
 
     arg = 0;
@@ -473,6 +519,9 @@ ico_uxf_main_loop_iterate(void)
 
     ico_uxf_leave_critical();
 
+    /* notify stages of application launch  */
+    ico_uxf_launch_notify();
+
     wl_display_flush(gIco_Uxf_Api_Mng.Wayland_Display);
 }
 
@@ -822,6 +871,7 @@ ico_uxf_window_createdcb(void *data, struct ico_window_mgr *ico_window_mgr,
                 (*gIco_Uxf_Api_Mng.Hook_Window)(prc->attr.process, surfaceid,
                                                 ICO_UXF_HOOK_WINDOW_CREATE_MAIN);
             }
+            ico_uxf_launch_stage(prc, ICO_UXF_LAUNCH_SURFACE);
         }
         else    {
             uifw_trace("ico_uxf_window_createdcb: Sub Window, Dummy Data");
@@ -991,6 +1041,12 @@ ico_uxf_window_visiblecb(void *data, struct ico_window_mgr *ico_window_mgr,
         oraise = win->attr.raise;
     }
 
+    /* first visible of main window of the launching application    */
+    if ((hint == 0) && (ovisible == 1) && (win->mng_process) &&
+        (win->mng_process->attr.mainwin.window == (int)surfaceid))  {
+        ico_uxf_launch_stage(win->mng_process, ICO_UXF_LAUNCH_VISIBLE);
+    }
+
     if ((win->attr.visible != ovisible) ||
         (win->attr.raise != oraise))   {
 
@@ -1415,6 +1471,7 @@ ico_uxf_aul_aulcb(int pid, void *data)
     int                     hash;
     Ico_Uxf_Mng_EventQue    *que;
     int                     dead;
+    int                     nicevalue;
     char                    appid[ICO_UXF_MAX_PROCESS_NAME+1];
 
     dead = (int)data;
@@ -1451,9 +1508,13 @@ ico_uxf_aul_aulcb(int pid, void *data)
         que->detail.event = ICO_UXF_EVENT_TERMPROCESS;
         que->detail.process.status = ICO_UXF_PROCSTATUS_STOP;
 
+        /* dead while launching */
+        ico_uxf_launch_stage(proc, ICO_UXF_LAUNCH_ERROR);
+
         /* delete process info */
         proc->attr.status = ICO_UXF_PROCSTATUS_STOP;
         proc->attr.internalid = -1;
+        proc->nicepid = 0;
         proc->attr.mainwin.window = 0;
         ico_uxf_free_procwin(proc);
     }
@@ -1461,6 +1522,14 @@ ico_uxf_aul_aulcb(int pid, void *data)
         que->detail.event = ICO_UXF_EVENT_EXECPROCESS;
         que->detail.process.status = ICO_UXF_PROCSTATUS_RUN;
 
+        /* cache nice value, resource arbitration uses it without system call */
+        errno = 0;
+        nicevalue = getpriority(PRIO_PROCESS, pid);
+        if ((nicevalue != -1) || (errno == 0))  {
+            proc->nicepid = pid;
+            proc->nice = nicevalue;
+        }
+
         /* setup process info */
         if (proc->attr.status != ICO_UXF_PROCSTATUS_RUN)    {
             proc->attr.internalid = pid;
@@ -1482,6 +1551,7 @@ ico_uxf_aul_aulcb(int pid, void *data)
             }
             proc->attr.status = ICO_UXF_PROCSTATUS_RUN;
         }
+        ico_uxf_launch_stage(proc, ICO_UXF_LAUNCH_RUNNING);
     }
 
     /* notify event */
@@ -1554,46 +1624,142 @@ ico_uxf_getchild_appid(const char *appid)
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_uxf_set_lastapp: save last application
+ * @brief   ico_uxf_timer_now: current time of housekeeping timer(internal function)
  *
- * @param[in]   appid   applicationId (if NULL, no last application)
+ * @param       none
+ * @return      monotonic time(us)
+ */
+/*--------------------------------------------------------------------------*/
+long long
+ico_uxf_timer_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000LL) + (ts.tv_nsec / 1000LL);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_timer_arm: arm housekeeping timer(internal function)
+ *          (timer is armed to the earliest deadline)
+ *
+ * @param[in]   deadline        deadline(us of monotonic clock)
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
-ICO_APF_API void
-ico_uxf_timer_wake(const int msec)
+void
+ico_uxf_timer_arm(const long long deadline)
+{
+    struct itimerspec   its;
+
+    if ((gIco_Uxf_Api_Mng.TimerDeadline > 0) &&
+        (gIco_Uxf_Api_Mng.TimerDeadline <= deadline))   {
+        /* already armed to earlier deadline    */
+        return;
+    }
+    gIco_Uxf_Api_Mng.TimerDeadline = deadline;
+    if (gIco_Uxf_Api_Mng.TimerFd < 0)   {
+        return;
+    }
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = deadline / 1000000LL;
+    its.it_value.tv_nsec = (deadline % 1000000LL) * 1000LL;
+    if (timerfd_settime(gIco_Uxf_Api_Mng.TimerFd, TFD_TIMER_ABSTIME, &its, NULL) < 0) {
+        uifw_warn("ico_uxf_timer_arm: timerfd_settime Error %d", errno);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_timer_set: set suspend/resume timer of process(internal function)
+ *          (suspend is delayed until end of initial no suspend time)
+ *
+ * @param[in]   prc             process management table
+ * @param[in]   msec            delay time(ms)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_uxf_timer_set(Ico_Uxf_Mng_Process *prc, const int msec)
+{
+    long long   deadline;
+
+    deadline = ico_uxf_timer_now() + (msec * 1000LL);
+    if (deadline < gIco_Uxf_Api_Mng.InitTimer)  {
+        deadline = gIco_Uxf_Api_Mng.InitTimer;
+    }
+    prc->suspdeadline = deadline;
+    gIco_Uxf_Api_Mng.NeedTimer = 1;
+    ico_uxf_timer_arm(deadline);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_timer_expire: execute expired suspend/resume timers and
+ *          re-arm housekeeping timer to next deadline(static function)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_uxf_timer_expire(void)
 {
     Ico_Uxf_Mng_Process *proc;
+    Ico_Uxf_Timer_Stats *stats = &gIco_Uxf_Api_Mng.TimerStats;
+    uint64_t    expires;
+    long long   now;
+    long long   late;
+    long long   next;
     int     hash;
 
-    if (gIco_Uxf_Api_Mng.InitTimer > 0) {
-        gIco_Uxf_Api_Mng.InitTimer -= msec;
-        if (gIco_Uxf_Api_Mng.InitTimer > 0) {
-            return;
-        }
-        gIco_Uxf_Api_Mng.InitTimer = 0;
+    if (gIco_Uxf_Api_Mng.TimerDeadline <= 0)    {
+        /* timer is not armed           */
+        return;
+    }
+    now = ico_uxf_timer_now();
+    if (now < gIco_Uxf_Api_Mng.TimerDeadline)   {
+        return;
+    }
+    if (gIco_Uxf_Api_Mng.TimerFd >= 0)  {
+        /* clear readable of timerfd    */
+        (void) read(gIco_Uxf_Api_Mng.TimerFd, &expires, sizeof(expires));
+    }
+
+    /* lateness of timer            */
+    late = now - gIco_Uxf_Api_Mng.TimerDeadline;
+    stats->expires ++;
+    stats->latetotal += late;
+    if (late > stats->latemax)  {
+        stats->latemax = (int)late;
+    }
+    if (late > 10000LL) {
+        stats->late10ms ++;
     }
+    gIco_Uxf_Api_Mng.TimerDeadline = 0;
 
     if (gIco_Uxf_Api_Mng.NeedTimer == 0)    {
         return;
     }
     gIco_Uxf_Api_Mng.NeedTimer = 0;
+    next = 0;
     for (hash = 0; hash < ICO_UXF_MISC_HASHSIZE; hash++)    {
         proc = gIco_Uxf_Api_Mng.Hash_ProcessId[hash];
         while (proc)    {
-            if (proc->susptimer > 0)    {
-                if (msec >= proc->susptimer)    {
-                    proc->susptimer = 0;
+            if (proc->suspdeadline > 0) {
+                if (now >= proc->suspdeadline)  {
+                    proc->suspdeadline = 0;
                     if (proc->attr.suspend) {
                         if (proc->susp == 0)    {
                             proc->susp = 1;
-                            uifw_trace("ico_uxf_timer_wake: CPU suspend pid=%d",
+                            uifw_trace("ico_uxf_timer_expire: CPU suspend pid=%d",
                                        proc->attr.internalid);
                             kill(proc->attr.internalid, SIGSTOP);
                         }
                     }
                     else if (proc->susp == 0)    {
-                        uifw_trace("ico_uxf_timer_wake: CPU resume pid=%d(show=%d)",
+                        uifw_trace("ico_uxf_timer_expire: CPU resume pid=%d(show=%d)",
                                    proc->attr.internalid, proc->showmode);
                         ico_window_mgr_set_visible(gIco_Uxf_Api_Mng.Wayland_WindowMgr,
                                                    proc->attr.mainwin.window,
@@ -1606,13 +1772,48 @@ ico_uxf_timer_wake(const int msec)
                     }
                 }
                 else    {
-                    proc->susptimer -= msec;
                     gIco_Uxf_Api_Mng.NeedTimer ++;
+                    if ((next == 0) || (proc->suspdeadline < next)) {
+                        next = proc->suspdeadline;
+                    }
                 }
             }
             proc = proc->nextidhash;
         }
     }
+    if (next > 0)   {
+        ico_uxf_timer_arm(next);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_timer_wake: execute expired UX-FW timers
+ *          (timers are executed by ico_uxf_main_loop_iterate at readable of
+ *           ico_uxf_timer_fd, this function is for compatibility)
+ *
+ * @param[in]   msec            elapsed time(ms, unused, deadlines are absolute)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API void
+ico_uxf_timer_wake(const int msec)
+{
+    ico_uxf_timer_expire();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_timer_stats: get lateness statistics of housekeeping timer
+ *
+ * @param[out]  stats           statistics
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API void
+ico_uxf_timer_stats(Ico_Uxf_Timer_Stats *stats)
+{
+    memcpy(stats, &gIco_Uxf_Api_Mng.TimerStats, sizeof(Ico_Uxf_Timer_Stats));
 }
 
 /*--------------------------------------------------------------------------*/
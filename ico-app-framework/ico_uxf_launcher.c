@@ -17,6 +17,7 @@
 #include    <unistd.h>
 #include    <string.h>
 #include    <errno.h>
+#include    <sys/resource.h>
 
 #include    "wayland-client.h"
 #include    "wayland-util.h"
@@ -32,6 +33,8 @@ extern Ico_Uxf_Api_Mng         gIco_Uxf_Api_Mng;
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_uxf_process_execute: launch a program
+ *          (stages of launch are recorded to launch latency statistics,
+ *           but not notified)
  *
  * @param[in]   name        program name
  * @return  result
@@ -44,58 +47,402 @@ extern Ico_Uxf_Api_Mng         gIco_Uxf_Api_Mng;
 /*--------------------------------------------------------------------------*/
 ICO_APF_API int
 ico_uxf_process_execute(const char *name)
+{
+    int     ret;
+
+    ret = ico_uxf_process_launch(name, NULL, NULL);
+    if (ret > 0)    {
+        ret = ICO_UXF_EOK;
+    }
+    return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_process_launch: launch a program asynchronously
+ *          (returns after AUL accepted the launch, following stages(process
+ *           running, first surface created and first surface visible) are
+ *           notified to callback function from ico_uxf_main_loop_iterate.
+ *           if the program is launching(by ico_uxf_process_execute or with
+ *           other callback), this function does not launch again but adds
+ *           the callback to the launch, and notifies all stages of the launch)
+ *
+ * @param[in]   name        program name
+ * @param[in]   func        stage callback function(if NULL, not notify)
+ * @param[in]   user_data   callback function's argument
+ * @return  launch handle or error
+ * @retval  > 0                 success(launch handle)
+ * @retval  ICO_UXF_ESRCH       error(not initialized)
+ * @retval  ICO_UXF_ENOENT      error(does not exist)
+ * @retval  ICO_UXF_EBUSY       error(already launched, or too many callbacks)
+ * @retval  ICO_UXF_ENOSYS      error(AUL launch error)
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API int
+ico_uxf_process_launch(const char *name, Ico_Uxf_Launch_Cb func, void *user_data)
 {
     Ico_Uxf_Mng_Process *proc;              /* process management table         */
+    Ico_Uxf_Mng_LaunchWait  *wait;
     int         hash;
-    Ico_Uxf_conf_application    *apptbl = NULL;
+    long long   now;
 
-    uifw_trace("ico_uxf_process_execute: Enter(%s)", name);
+    uifw_trace("ico_uxf_process_launch: Enter(%s,%p)", name, func);
 
     if (gIco_Uxf_Api_Mng.Initialized <= 0) {
-        uifw_warn("ico_uxf_process_execute: Leave(ESRCH)");
+        uifw_warn("ico_uxf_process_launch: Leave(ESRCH)");
         return ICO_UXF_ESRCH;
     }
 
-    for (hash = 0; hash < ICO_UXF_MISC_HASHSIZE; hash++)    {
-        proc = gIco_Uxf_Api_Mng.Hash_ProcessId[hash];
-        while (proc)    {
-            if (strcasecmp(proc->attr.process, name) == 0)  break;
-            proc = proc->nextidhash;
-        }
-        if (proc) break;
+    /* hash value has no distinction of an english capital letter/small */
+    hash = ICO_UXF_MISC_HASHBYNAME(name);
+    proc = gIco_Uxf_Api_Mng.Hash_ProcessId[hash];
+    while (proc)    {
+        if (strcasecmp(proc->attr.process, name) == 0)  break;
+        proc = proc->nextidhash;
     }
 
     if (! proc) {
-        uifw_warn("ico_uxf_process_execute: Leave(ENOENT)");
+        uifw_warn("ico_uxf_process_launch: Leave(ENOENT)");
         return ICO_UXF_ENOENT;
     }
 
     ico_uxf_enter_critical();               /* enter critical section           */
 
     if (proc->attr.status != ICO_UXF_PROCSTATUS_STOP)   {
+        if ((func != NULL) && (proc->launchwaits < ICO_UXF_LAUNCH_WAITERS) &&
+            (proc->launch.stage >= ICO_UXF_LAUNCH_ACCEPTED) &&
+            (proc->launch.stage < ICO_UXF_LAUNCH_VISIBLE))  {
+            /* launching, the callback also waits, notify stages from first */
+            wait = &proc->launchwait[(int)proc->launchwaits];
+            wait->func = func;
+            wait->arg = user_data;
+            wait->notify = ICO_UXF_LAUNCH_REQUEST;
+            proc->launchwaits ++;
+            gIco_Uxf_Api_Mng.LaunchPending ++;
+            ico_uxf_leave_critical();       /* leave critical section           */
+            ico_uxf_timer_arm(ico_uxf_timer_now());
+            uifw_trace("ico_uxf_process_launch: Leave(%s launching, handle=%d)",
+                       proc->attr.process, proc->launch.handle);
+            return proc->launch.handle;
+        }
         ico_uxf_leave_critical();           /* leave critical section           */
-        uifw_warn("ico_uxf_process_execute: Leave(EBUSY)");
+        uifw_warn("ico_uxf_process_launch: Leave(EBUSY)");
         return ICO_UXF_EBUSY;
     }
 
     /* in order to avoid double execute, status set starting    */
     proc->attr.status = ICO_UXF_PROCSTATUS_INIT;
+
+    /* new launch                           */
+    if (proc->launchwaits > 0)  {
+        /* previous launch was not finished(terminated) */
+        gIco_Uxf_Api_Mng.LaunchPending -= proc->launchwaits;
+        proc->launchwaits = 0;
+    }
+    gIco_Uxf_Api_Mng.LaunchHandle ++;
+    if (gIco_Uxf_Api_Mng.LaunchHandle <= 0) {
+        gIco_Uxf_Api_Mng.LaunchHandle = 1;
+    }
+    memset(&proc->launch, 0, sizeof(Ico_Uxf_LaunchInfo));
+    proc->launch.handle = gIco_Uxf_Api_Mng.LaunchHandle;
+    strncpy(proc->launch.process, proc->attr.process, ICO_UXF_MAX_PROCESS_NAME);
+    proc->launch.stage = ICO_UXF_LAUNCH_REQUEST;
+    proc->launch.time[ICO_UXF_LAUNCH_REQUEST] = ico_uxf_timer_now();
+    proc->launchstats.launches ++;
     ico_uxf_leave_critical();               /* leave critical section           */
 
     /* execute program                      */
     proc->attr.internalid = aul_launch_app(name , NULL);
     if (proc->attr.internalid < 0)  {
-        uifw_error("ico_uxf_process_execute: Leave(ENOSYS), Launch App Error(%d)",
+        uifw_error("ico_uxf_process_launch: Leave(ENOSYS), Launch App Error(%d)",
                    proc->attr.internalid);
+        proc->launch.stage = ICO_UXF_LAUNCH_ERROR;
+        proc->launch.result = ICO_UXF_ENOSYS;
+        proc->launchstats.errors ++;
         return ICO_UXF_ENOSYS;
     }
 
     proc->attr.status = ICO_UXF_PROCSTATUS_RUN;
 
-    uifw_trace("ico_uxf_process_execute: Leave(%s)", proc->attr.process);
+    now = ico_uxf_timer_now();
+    proc->launch.pid = proc->attr.internalid;
+    proc->launch.stage = ICO_UXF_LAUNCH_ACCEPTED;
+    proc->launch.time[ICO_UXF_LAUNCH_ACCEPTED] = now;
+    proc->launchstats.stagecount[ICO_UXF_LAUNCH_ACCEPTED] ++;
+    proc->launchstats.stagetotal[ICO_UXF_LAUNCH_ACCEPTED]
+        += now - proc->launch.time[ICO_UXF_LAUNCH_REQUEST];
+    if (func)   {
+        wait = &proc->launchwait[0];
+        wait->func = func;
+        wait->arg = user_data;
+        wait->notify = ICO_UXF_LAUNCH_REQUEST;
+        proc->launchwaits = 1;
+        gIco_Uxf_Api_Mng.LaunchPending ++;
+        /* stages are notified from main loop   */
+        ico_uxf_timer_arm(now);
+    }
+
+    uifw_trace("ico_uxf_process_launch: Leave(%s, handle=%d, %d us)",
+               proc->attr.process, proc->launch.handle,
+               (int)(now - proc->launch.time[ICO_UXF_LAUNCH_REQUEST]));
+    return proc->launch.handle;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_process_launch_info: get stages of the last launch of a program
+ *          (for the caller that could not add callback to the launch)
+ *
+ * @param[in]   process     process id
+ * @param[out]  info        stages of the last launch(stage is reached stage)
+ * @return  result
+ * @retval  ICO_UXF_EOK         success
+ * @retval  ICO_UXF_ESRCH       error(not initialized)
+ * @retval  ICO_UXF_ENOENT      error(does not exist)
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API int
+ico_uxf_process_launch_info(const char *process, Ico_Uxf_LaunchInfo *info)
+{
+    Ico_Uxf_Mng_Process *proc;
+
+    if (gIco_Uxf_Api_Mng.Initialized <= 0) {
+        uifw_warn("ico_uxf_process_launch_info: Leave(ESRCH)");
+        return ICO_UXF_ESRCH;
+    }
+
+    proc = ico_uxf_mng_process(process, 0);
+    if (! proc) {
+        uifw_warn("ico_uxf_process_launch_info: Leave(ENOENT)");
+        return ICO_UXF_ENOENT;
+    }
+    ico_uxf_enter_critical();               /* enter critical section           */
+    memcpy(info, &proc->launch, sizeof(Ico_Uxf_LaunchInfo));
+    ico_uxf_leave_critical();               /* leave critical section           */
+    return ICO_UXF_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_process_launch_stats: get launch latency statistics
+ *
+ * @param[in]   process     process id(if NULL, total of all applications)
+ * @param[out]  stats       launch latency statistics
+ * @return  result
+ * @retval  ICO_UXF_EOK         success
+ * @retval  ICO_UXF_ESRCH       error(not initialized)
+ * @retval  ICO_UXF_ENOENT      error(does not exist)
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API int
+ico_uxf_process_launch_stats(const char *process, Ico_Uxf_LaunchStats *stats)
+{
+    Ico_Uxf_Mng_Process *proc;
+    Ico_Uxf_LaunchStats *ps;
+    int     hash;
+    int     i;
+
+    if (gIco_Uxf_Api_Mng.Initialized <= 0) {
+        uifw_warn("ico_uxf_process_launch_stats: Leave(ESRCH)");
+        return ICO_UXF_ESRCH;
+    }
+
+    if (process)    {
+        proc = ico_uxf_mng_process(process, 0);
+        if (! proc) {
+            uifw_warn("ico_uxf_process_launch_stats: Leave(ENOENT)");
+            return ICO_UXF_ENOENT;
+        }
+        memcpy(stats, &proc->launchstats, sizeof(Ico_Uxf_LaunchStats));
+        return ICO_UXF_EOK;
+    }
+
+    /* total of all applications    */
+    memset(stats, 0, sizeof(Ico_Uxf_LaunchStats));
+    for (hash = 0; hash < ICO_UXF_MISC_HASHSIZE; hash++)    {
+        for (proc = gIco_Uxf_Api_Mng.Hash_ProcessId[hash]; proc;
+             proc = proc->nextidhash)   {
+            ps = &proc->launchstats;
+            stats->launches += ps->launches;
+            stats->errors += ps->errors;
+            stats->visibles += ps->visibles;
+            if (ps->latmax > stats->latmax) {
+                stats->latmax = ps->latmax;
+            }
+            for (i = 0; i < ICO_UXF_LAUNCH_HISTOGRAM; i++)  {
+                stats->histogram[i] += ps->histogram[i];
+            }
+            for (i = 0; i < ICO_UXF_LAUNCH_STAGES; i++) {
+                stats->stagecount[i] += ps->stagecount[i];
+                stats->stagetotal[i] += ps->stagetotal[i];
+            }
+        }
+    }
     return ICO_UXF_EOK;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_launch_stage: record a stage of launch(internal function)
+ *          (stage of the launch that is not in progress is ignored)
+ *
+ * @param[in]   prc         process management table
+ * @param[in]   stage       reached stage(ICO_UXF_LAUNCH_RUNNING/SURFACE/
+ *                          VISIBLE/ERROR)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_uxf_launch_stage(Ico_Uxf_Mng_Process *prc, const int stage)
+{
+    Ico_Uxf_LaunchInfo  *info = &prc->launch;
+    Ico_Uxf_LaunchStats *stats = &prc->launchstats;
+    long long   now;
+    int         latency;
+    int         idx;
+
+    if ((info->stage < ICO_UXF_LAUNCH_ACCEPTED) ||
+        (info->stage >= ICO_UXF_LAUNCH_VISIBLE))    {
+        /* not launching            */
+        return;
+    }
+    if ((stage != ICO_UXF_LAUNCH_ERROR) && (stage <= info->stage))  {
+        /* already reached          */
+        return;
+    }
+
+    if (stage == ICO_UXF_LAUNCH_ERROR)  {
+        uifw_trace("ico_uxf_launch_stage: %s dead at stage %d",
+                   prc->attr.process, info->stage);
+        info->stage = ICO_UXF_LAUNCH_ERROR;
+        info->result = ICO_UXF_ENXIO;
+        stats->errors ++;
+    }
+    else    {
+        now = ico_uxf_timer_now();
+        info->stage = stage;
+        info->time[stage] = now;
+        if ((stage == ICO_UXF_LAUNCH_RUNNING) && (prc->attr.internalid > 0))    {
+            info->pid = prc->attr.internalid;
+        }
+        stats->stagecount[stage] ++;
+        stats->stagetotal[stage] += now - info->time[ICO_UXF_LAUNCH_REQUEST];
+
+        if (stage == ICO_UXF_LAUNCH_VISIBLE)    {
+            latency = (int)((now - info->time[ICO_UXF_LAUNCH_REQUEST]) / 1000LL);
+            stats->visibles ++;
+            if (latency > stats->latmax)    {
+                stats->latmax = latency;
+            }
+            for (idx = 0; idx < (ICO_UXF_LAUNCH_HISTOGRAM - 1); idx++)  {
+                if (latency < (ICO_UXF_LAUNCH_HISTOBASE << idx))    break;
+            }
+            stats->histogram[idx] ++;
+            uifw_info("ico_uxf_launch_stage: %s visible %d ms(running=%d surface=%d)",
+                      prc->attr.process, latency,
+                      info->time[ICO_UXF_LAUNCH_RUNNING] > 0 ?
+                        (int)((info->time[ICO_UXF_LAUNCH_RUNNING]
+                               - info->time[ICO_UXF_LAUNCH_REQUEST]) / 1000LL) : -1,
+                      (int)((info->time[ICO_UXF_LAUNCH_SURFACE]
+                             - info->time[ICO_UXF_LAUNCH_REQUEST]) / 1000LL));
+        }
+    }
+
+    if (prc->launchwaits > 0)   {
+        /* wake up main loop to notify      */
+        ico_uxf_timer_arm(ico_uxf_timer_now());
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_launch_call: notify stages of a launch that are not notified
+ *          yet to a callback function(static function)
+ *
+ * @param[in]   info        stages of the launch(copy)
+ * @param[in]   wait        callback function(copy)
+ * @param[in]   stage       reached stage
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_uxf_launch_call(Ico_Uxf_LaunchInfo *info, const Ico_Uxf_Mng_LaunchWait *wait,
+                    const int stage)
+{
+    int     notify;
+
+    if (stage == ICO_UXF_LAUNCH_ERROR)  {
+        info->stage = ICO_UXF_LAUNCH_ERROR;
+        uifw_trace("ico_uxf_launch_call: Call Launch Callback(%s,%d,%d)",
+                   info->process, info->handle, info->stage);
+        (*wait->func)(info, wait->arg);
+        return;
+    }
+    for (notify = wait->notify + 1; notify <= stage; notify++)  {
+        if (info->time[notify] <= 0)    continue;
+        info->stage = notify;
+        uifw_trace("ico_uxf_launch_call: Call Launch Callback(%s,%d,%d)",
+                   info->process, info->handle, info->stage);
+        (*wait->func)(info, wait->arg);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_launch_notify: notify reached stages of launches to
+ *          callback functions in order of stage(internal function)
+ *          (called from ico_uxf_main_loop_iterate)
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+ico_uxf_launch_notify(void)
+{
+    Ico_Uxf_Mng_Process *proc;
+    Ico_Uxf_Mng_LaunchWait  wait[ICO_UXF_LAUNCH_WAITERS];
+    Ico_Uxf_LaunchInfo  info;
+    int         stage;
+    int         hash;
+    int         num;
+    int         idx;
+
+    if (gIco_Uxf_Api_Mng.LaunchPending <= 0)    {
+        return;
+    }
+
+    for (hash = 0; hash < ICO_UXF_MISC_HASHSIZE; hash++)    {
+        for (proc = gIco_Uxf_Api_Mng.Hash_ProcessId[hash]; proc;
+             proc = proc->nextidhash)   {
+            while (proc->launchwaits > 0)   {
+                stage = proc->launch.stage;
+                memcpy(&info, &proc->launch, sizeof(Ico_Uxf_LaunchInfo));
+                if ((stage == ICO_UXF_LAUNCH_ERROR) || (stage == ICO_UXF_LAUNCH_VISIBLE)) {
+                    /* end of launch, callbacks are released before notify  */
+                    /* because callback may launch again                    */
+                    num = proc->launchwaits;
+                    memcpy(wait, proc->launchwait, sizeof(Ico_Uxf_Mng_LaunchWait) * num);
+                    proc->launchwaits = 0;
+                    gIco_Uxf_Api_Mng.LaunchPending -= num;
+                    for (idx = 0; idx < num; idx++) {
+                        ico_uxf_launch_call(&info, &wait[idx], stage);
+                    }
+                    continue;
+                }
+                /* callback that is not notified the reached stage          */
+                for (idx = 0; idx < proc->launchwaits; idx++)   {
+                    if (proc->launchwait[idx].notify < stage)   break;
+                }
+                if (idx >= proc->launchwaits)   break;
+                memcpy(&wait[0], &proc->launchwait[idx], sizeof(Ico_Uxf_Mng_LaunchWait));
+                proc->launchwait[idx].notify = stage;
+                ico_uxf_launch_call(&info, &wait[0], stage);
+            }
+        }
+    }
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_uxf_process_terminate: finish a program
@@ -136,6 +483,7 @@ ico_uxf_process_terminate(const char *process)
         return ICO_UXF_ENOSYS;
     }
 
+    ico_uxf_launch_stage(proc, ICO_UXF_LAUNCH_ERROR);
     proc->attr.status = ICO_UXF_PROCSTATUS_STOP;
     proc->attr.internalid = -1;
     proc->attr.mainwin.window = 0;
@@ -218,6 +566,50 @@ ico_uxf_process_is_active(const char *process)
     return proc->attr.active;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_uxf_process_priority: get scheduling priority(nice value) of
+ *          the process. nice value is cached when the process is launched,
+ *          and only a process that is not cached(ex. not launched by AUL)
+ *          gets it from system once.
+ *
+ * @param[in]   process     process's identity
+ * @param[in]   pid         process Id
+ * @return  nice value(-20 to 19, 0 if the process does not exist)
+ */
+/*--------------------------------------------------------------------------*/
+ICO_APF_API int
+ico_uxf_process_priority(const char *process, const int pid)
+{
+    Ico_Uxf_Mng_Process *proc = NULL;       /* process management table             */
+    int     nicevalue;
+
+    if (gIco_Uxf_Api_Mng.Initialized > 0)   {
+        proc = ico_uxf_mng_process(process, 0);
+        if ((proc) && (proc->nicepid == pid) && (pid > 0))  {
+            return proc->nice;
+        }
+    }
+
+    /* not cached, get nice value and cache it  */
+    errno = 0;
+    nicevalue = getpriority(PRIO_PROCESS, pid);
+    if ((nicevalue == -1) && (errno != 0))  {
+        /* process already exited       */
+        uifw_trace("ico_uxf_process_priority: %s[%d] dose not exist", process, pid);
+        return 0;
+    }
+    if (nicevalue > 19)         nicevalue = 19;
+    else if (nicevalue < -20)   nicevalue = -20;
+    if ((proc) && (pid > 0))    {
+        uifw_trace("ico_uxf_process_priority: cache %s[%d] nice=%d",
+                   process, pid, nicevalue);
+        proc->nicepid = pid;
+        proc->nice = nicevalue;
+    }
+    return nicevalue;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_uxf_process_window_get: get a window defined by the process
@@ -32,6 +32,7 @@ extern "C" {
 #endif
 
 /* macro                                            */
+#define ICO_UXF_LAUNCH_WAITERS      4       /* callbacks waiting for one launch     */
                                             /* get DisplayId from SurfaceId         */
 #define ICO_UXF_GETDISPLAYID(surfaceid)   \
             ((surfaceid >> 20) & 0x0fff)
@@ -51,6 +52,13 @@ typedef struct  _Ico_Uxf_Mng_EventQue   {
     Ico_Uxf_EventDetail detail;             /* event detail                         */
 }   Ico_Uxf_Mng_EventQue;
 
+/* struct management callback of launch stages      */
+typedef struct  _Ico_Uxf_Mng_LaunchWait {
+    Ico_Uxf_Launch_Cb   func;               /* launch stage callback                */
+    void                *arg;               /* launch stage callback's argument     */
+    int                 notify;             /* last notified launch stage           */
+}   Ico_Uxf_Mng_LaunchWait;
+
 /* struct management window which proccess owns     */
 typedef struct  _Ico_Uxf_Mng_ProcWin    {
     struct _Ico_Uxf_Mng_ProcWin *next;      /* next window                          */
@@ -63,9 +71,18 @@ typedef struct  _Ico_Uxf_Mng_Process    {
     Ico_Uxf_Mng_ProcWin *procwin;           /* process's subwindow                  */
     void                *appconf;           /* configuration table address          */
     struct _Ico_Uxf_Mng_Process *parent;    /* parent process                       */
-    short               susptimer;          /* suspend timer                        */
+    int                 nicepid;            /* process Id of cached nice value      */
+                                            /* (0=not cached)                       */
+    int                 nice;               /* cached nice value(scheduling priority)*/
+    long long           suspdeadline;       /* suspend timer deadline               */
+                                            /* (us of monotonic clock, 0=none)      */
     char                susp;               /* real suspend flag                    */
     char                showmode;           /* resume show mode                     */
+    char                launchwaits;        /* number of launch stage callbacks     */
+    Ico_Uxf_Mng_LaunchWait  launchwait[ICO_UXF_LAUNCH_WAITERS];
+                                            /* callbacks waiting for the launch     */
+    Ico_Uxf_LaunchInfo  launch;             /* stages of last launch                */
+    Ico_Uxf_LaunchStats launchstats;        /* launch latency statistics            */
     Ico_Uxf_ProcessAttr attr;               /* process configuration                */
 }   Ico_Uxf_Mng_Process;
 
@@ -117,7 +134,7 @@ typedef struct  _Ico_Uxf_Api_Mng    {
     short                   Win_Show_Anima; /* Window animation at show             */
     short                   Win_Hide_Anima; /* Window animation at hide             */
     int                     NeedTimer;      /* need timer control                   */
-    int                     InitTimer;      /* initial timer                        */
+    long long               InitTimer;      /* end of initial no suspend time(us)   */
 
     /* process information myprocess        */
     char                    MyProcess[ICO_UXF_MAX_PROCESS_NAME+1];
@@ -159,6 +176,15 @@ typedef struct  _Ico_Uxf_Api_Mng    {
 
     /* Hook routines                    */
     Ico_Uxf_Hook            Hook_Window;        /* Window control hook              */
+
+    /* housekeeping timer               */
+    int                     TimerFd;            /* timerfd of housekeeping          */
+    long long               TimerDeadline;      /* armed deadline(us, 0=disarmed)   */
+    Ico_Uxf_Timer_Stats     TimerStats;         /* lateness of housekeeping timer   */
+
+    /* application launch               */
+    int                     LaunchHandle;       /* last launch handle               */
+    int                     LaunchPending;      /* callbacks waiting for notify     */
 }   Ico_Uxf_Api_Mng;
 
 /* define inner misc function               */
@@ -195,6 +221,14 @@ void ico_uxf_free_procwin(Ico_Uxf_Mng_Process *prc);
 void ico_uxf_window_visible_control(Ico_Uxf_Mng_Window *winmng,
                                     const int show, const int raise);
                                             /* Window visible and cpu control       */
+long long ico_uxf_timer_now(void);          /* monotonic time of timer(us)          */
+void ico_uxf_timer_arm(const long long deadline);
+                                            /* arm housekeeping timer               */
+void ico_uxf_timer_set(Ico_Uxf_Mng_Process *prc, const int msec);
+                                            /* set suspend/resume timer of process  */
+void ico_uxf_launch_stage(Ico_Uxf_Mng_Process *prc, const int stage);
+                                            /* record a stage of launch             */
+void ico_uxf_launch_notify(void);           /* notify stages of launch              */
 int ico_uxf_gl_create_window(const int display, const int layer, const int x,
                              const int y, const int w, const int h, const int full);
                                             /* create window by OpenGL ES/EGL       */
@@ -52,12 +52,11 @@ ico_uxf_window_visible_control(Ico_Uxf_Mng_Window *winmng, const int show, const
 
             /* change to show, application resume   */
             (winmng->mng_process)->attr.suspend = 0;
-            (winmng->mng_process)->susptimer = 0;
+            (winmng->mng_process)->suspdeadline = 0;
             if ((winmng->mng_process)->susp)    {
                 (winmng->mng_process)->susp = 0;
                 (winmng->mng_process)->showmode = showshow;
-                (winmng->mng_process)->susptimer = ICO_UXF_SUSP_DELAY;
-                gIco_Uxf_Api_Mng.NeedTimer = 1;
+                ico_uxf_timer_set(winmng->mng_process, ICO_UXF_SUSP_DELAY);
                 kill((winmng->mng_process)->attr.internalid, SIGCONT);
                 uifw_trace("ico_uxf_window_visible_control: CPU resume(%s)",
                            (winmng->mng_process)->attr.process);
@@ -93,14 +92,13 @@ ico_uxf_window_visible_control(Ico_Uxf_Mng_Window *winmng, const int show, const
         /* change to hide, application suspend  */
         (winmng->mng_process)->attr.suspend = 1;
         (winmng->mng_process)->showmode = showshow;
-        (winmng->mng_process)->susptimer = ICO_UXF_SUSP_DELAY;
-        gIco_Uxf_Api_Mng.NeedTimer = 1;
+        ico_uxf_timer_set(winmng->mng_process, ICO_UXF_SUSP_DELAY);
         uifw_trace("ico_uxf_window_visible_control: set CPU suspend(%s)",
                    (winmng->mng_process)->attr.process);
     }
     else    {
         (winmng->mng_process)->showmode = -1;
-        (winmng->mng_process)->susptimer = 0;
+        (winmng->mng_process)->suspdeadline = 0;
     }
 }
 
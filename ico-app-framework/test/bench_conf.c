@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   benchmark of system configuration load time(process start up)
+ *
+ *          usage: bench_conf [-n count] [-g entries]
+ *          (configuration directory is decided by UIFW_TOPDIR/UIFW_CONFDIR,
+ *           the compiled cache in the directory is rebuilt by this program.
+ *           -g generates a configuration that has the number of categories,
+ *           kinds, display zones, sound zones and input switches in a
+ *           temporary directory, and measures it)
+ *
+ * @date    Feb-28-2013
+ */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <unistd.h>
+#include    <string.h>
+#include    <time.h>
+
+#include    "ico_apf_log.h"
+#include    "ico_uxf_sysdef.h"
+#include    "ico_uxf_conf.h"
+#include    "ico_uxf_conf_def.h"
+
+/* measured load times(micro seconds)   */
+typedef struct _bench_result {
+    int     count;
+    long    total;
+    long    min;
+    long    max;
+} bench_result_t;
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_now: current monotonic time(micro seconds)
+ *
+ * @param       none
+ * @return      current time
+ */
+/*--------------------------------------------------------------------------*/
+static long
+bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000L) + (ts.tv_nsec / 1000L);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_load: load and release system configuration once
+ *
+ * @param[out]  result      measured result
+ * @return      result
+ * @retval      0           success
+ * @retval      -1          error(can not read configuration)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+bench_load(bench_result_t *result)
+{
+    long    start;
+    long    usec;
+
+    start = bench_now();
+    if (! ico_uxf_getSysConfig())   {
+        return -1;
+    }
+    usec = bench_now() - start;
+    ico_uxf_closeSysConfig();
+
+    if ((result->count == 0) || (usec < result->min))   result->min = usec;
+    if (usec > result->max)                             result->max = usec;
+    result->total += usec;
+    result->count ++;
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_print: print measured result
+ *
+ * @param[in]   title       title of result
+ * @param[in]   result      measured result
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+bench_print(const char *title, const bench_result_t *result)
+{
+    if (result->count <= 0) {
+        printf("%-14s: no data\n", title);
+        return;
+    }
+    printf("%-14s: count=%5d avg=%8ld us min=%8ld us max=%8ld us\n", title,
+           result->count, result->total / result->count, result->min, result->max);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_generate: generate a large system configuration
+ *
+ * @param[in]   dir         output directory
+ * @param[in]   entries     number of entries in each table
+ * @return      result
+ * @retval      0           success
+ * @retval      -1          error(can not write configuration)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+bench_generate(const char *dir, const int entries)
+{
+    static const char   *policy[] = { "always", "run", "parked", "shift_park",
+                                      "shift_back", "blinker_left", "blinker_right" };
+    static const char   *privilege[] = { "almighty", "system", "system.audio",
+                                         "system.visible", "maker", "certificate", "none" };
+    char    path[ICO_UXF_CONF_DIR_MAX+32];
+    FILE    *fp;
+    int     i, j, n;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, ICO_UXF_CONFIG_SYSTEM);
+    fp = fopen(path, "w");
+    if (! fp)   {
+        return -1;
+    }
+
+    fprintf(fp, "[host]\n0=Center\n0.type=Center\n0.ip=127.0.0.1\n"
+                "0.homescreen=org.tizen.ico.homescreen\n");
+
+    /* display zones, ICO_UXF_DISPLAY_ZONE_MAX zones in each display    */
+    fprintf(fp, "[display]\n");
+    for (i = 0, n = 0; n < entries; i++)    {
+        fprintf(fp, "%d=Display%d\n%d.host=Center\n%d.displayno=%d\n"
+                    "%d.wayland=wayland-0\n%d.type=Center\n%d.width=1920\n"
+                    "%d.height=1080\n%d.layer=2\n%d.inch=101\n"
+                    "%d.layer.0=BackGround\n%d.layer.1=Application\n",
+                i, i, i, i, i, i, i, i, i, i, i, i, i);
+        for (j = 0; (j < ICO_UXF_DISPLAY_ZONE_MAX) && (n < entries); j++, n++)  {
+            fprintf(fp, "%d.zone.%d=Zone%d;0;64;dispw;disph-64", i, j, n);
+            if (j > 0)  {
+                fprintf(fp, ";Zone%d", n - 1);
+            }
+            fprintf(fp, "\n");
+        }
+    }
+
+    /* sound zones, ICO_UXF_SOUND_ZONE_MAX zones in each sound device   */
+    fprintf(fp, "[sound]\n");
+    for (i = 0, n = 0; n < entries; i++)    {
+        fprintf(fp, "%d=Sound%d\n%d.host=Center\n%d.soundno=%d\n", i, i, i, i, i);
+        for (j = 0; (j < ICO_UXF_SOUND_ZONE_MAX) && (n < entries); j++, n++)    {
+            fprintf(fp, "%d.zone.%d=SZone%d\n", i, j, n);
+        }
+    }
+
+    fprintf(fp, "[port]\nappscontrollerport=18081\nsoundpluginport=8088\n");
+
+    fprintf(fp, "[category]\n");
+    for (i = 0; i < entries; i++)   {
+        fprintf(fp, "%d=Category%d\n%d.type=unknown\n%d.view=%s\n%d.sound=%s\n"
+                    "%d.input=%s\n%d.priority=%d\n",
+                i, i, i, i, policy[i % 7], i, policy[(i + 1) % 7],
+                i, policy[(i + 2) % 7], i, i % 8);
+    }
+
+    fprintf(fp, "[kind]\n");
+    for (i = 0; i < entries; i++)   {
+        fprintf(fp, "%d=Kind%d\n%d.privilege=%s\n%d.priority=%d\n",
+                i, i, i, privilege[i % 7], i, i % 6);
+    }
+
+    fprintf(fp, "[input]\n0=Input0\n");
+    for (i = 0; i < entries; i++)   {
+        fprintf(fp, "0.sw.%d=Switch%d;org.tizen.ico.app%d\n", i, i, i);
+    }
+
+    fprintf(fp, "[default]\nhost=Center\nkind=Kind%d\ncategory=Category0\n"
+                "display=Display0\nlayer=Application\ndisplayzone=Zone0\n"
+                "sound=Sound0\nsoundzone=SZone0\ninputdev=Input0\ninputsw=Switch0\n"
+                "[log]\nloglevel=0\nlogflush=no\n", entries - 1);
+
+    if (fclose(fp) != 0)    {
+        return -1;
+    }
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    bench_result_t  parse;
+    bench_result_t  rebuild;
+    bench_result_t  cached;
+    char    cachefile[ICO_UXF_CONF_DIR_MAX+32];
+    char    gendir[] = "/tmp/bench_conf.XXXXXX";
+    const char  *dirp;
+    int     count = 100;
+    int     entries = 0;
+    int     i;
+
+    for (i = 1; i < argc; i++)  {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) {
+            count = strtol(argv[++i], (char **)0, 0);
+        }
+        else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc))    {
+            entries = strtol(argv[++i], (char **)0, 0);
+        }
+        else    {
+            fprintf(stderr, "usage: %s [-n count] [-g entries]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (count <= 0) count = 1;
+
+    if (entries > 0)    {
+        if ((! mkdtemp(gendir)) || (bench_generate(gendir, entries) < 0))  {
+            fprintf(stderr, "%s: can not generate configuration\n", argv[0]);
+            exit(1);
+        }
+        setenv(ICO_UXF_CONFIG_ENV, gendir, 1);
+        printf("generated     : %s(%d entries)\n", gendir, entries);
+    }
+
+    /* log output is not measured   */
+    setenv("ICO_IVI_NO_LOG", "1", 1);
+    ico_uxf_log_setlevel(0);
+
+    memset(&parse, 0, sizeof(parse));
+    memset(&rebuild, 0, sizeof(rebuild));
+    memset(&cached, 0, sizeof(cached));
+
+    dirp = getenv(ICO_UXF_CONFIG_ENV);
+    if (dirp)   {
+        snprintf(cachefile, sizeof(cachefile), "%s/%s", dirp, ICO_UXF_CONFIG_SYSCACHE);
+    }
+    else    {
+        dirp = getenv(ICO_UXF_TOP_ENV);
+        snprintf(cachefile, sizeof(cachefile), "%s/%s/%s",
+                 dirp ? dirp : ICO_UXF_TOP_TOPDIR, ICO_UXF_CONFIG_DIR,
+                 ICO_UXF_CONFIG_SYSCACHE);
+    }
+
+    /* GKeyFile parse without cache     */
+    setenv(ICO_UXF_CONFIG_NOCACHE_ENV, "1", 1);
+    for (i = 0; i < count; i++) {
+        if (bench_load(&parse) < 0) {
+            fprintf(stderr, "%s: can not read system configuration\n", argv[0]);
+            exit(1);
+        }
+    }
+    unsetenv(ICO_UXF_CONFIG_NOCACHE_ENV);
+
+    /* parse and write compiled cache   */
+    for (i = 0; i < count; i++) {
+        (void) unlink(cachefile);
+        (void) bench_load(&rebuild);
+    }
+
+    /* map compiled cache               */
+    for (i = 0; i < count; i++) {
+        (void) bench_load(&cached);
+    }
+    if (access(cachefile, R_OK) != 0)   {
+        fprintf(stderr, "%s: %s can not be created, cache is not measured\n",
+                argv[0], cachefile);
+    }
+
+    bench_print("parse", &parse);
+    bench_print("parse+rebuild", &rebuild);
+    bench_print("cached", &cached);
+    if ((cached.count > 0) && (cached.total > 0))   {
+        printf("speed up      : %ld.%02ld times\n",
+               (parse.total / parse.count) / (cached.total / cached.count),
+               (((parse.total / parse.count) * 100) /
+                (cached.total / cached.count)) % 100);
+    }
+
+    if (entries > 0)    {
+        /* remove generated configuration   */
+        char    path[ICO_UXF_CONF_DIR_MAX+32];
+        snprintf(path, sizeof(path), "%s/%s", gendir, ICO_UXF_CONFIG_SYSTEM);
+        (void) unlink(path);
+        (void) unlink(cachefile);
+        (void) rmdir(gendir);
+    }
+    exit(0);
+}
+
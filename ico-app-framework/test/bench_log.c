@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   benchmark of debug log output cost on the calling thread
+ *
+ *          usage: bench_log [-n count] [-t threads] [-f]
+ *          (measures a typical uifw_trace on the calling thread, output on
+ *           the calling thread(ico_apf_log_print) and output by the writer
+ *           thread(ico_apf_log_async). -f flushes the log file every line.
+ *           log is written to ICO_APF_LOG_DIR/bench_log.log)
+ *
+ * @date    Feb-28-2013
+ */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <unistd.h>
+#include    <string.h>
+#include    <time.h>
+#include    <pthread.h>
+
+#include    "ico_apf_log.h"
+
+/* measured output times(nano seconds)  */
+typedef struct _bench_result {
+    int     count;
+    long    total;
+    long    max;
+} bench_result_t;
+
+/* messages in one burst(writer thread drains the ring buffer between bursts) */
+#define BENCH_BURST     (ICO_APF_LOG_RINGSIZE/2)
+
+static int  bench_count = 100000;
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_now: current monotonic time(nano seconds)
+ *
+ * @param       none
+ * @return      current time
+ */
+/*--------------------------------------------------------------------------*/
+static long
+bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000000L) + ts.tv_nsec;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_output: output log messages in bursts
+ *
+ * @param[in]   async       output by writer thread(1) or calling thread(0)
+ * @param[out]  result      measured result
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+bench_output(const int async, bench_result_t *result)
+{
+    static const char   *name = "org.tizen.ico.app-bench";
+    long    start;
+    long    nsec;
+    int     i;
+
+    for (i = 0; i < bench_count; i++)   {
+        start = bench_now();
+        if (async)  {
+            ico_apf_log_async("DBG", "bench_output: Enter(%s,%d,%08x) (%s,%s:%d)\n",
+                              name, i, i * 7, __func__, __FILE__, __LINE__);
+        }
+        else    {
+            ico_apf_log_print("%s> bench_output: Enter(%s,%d,%08x) (%s,%s:%d)\n",
+                              ico_apf_log_curtime("DBG"), name, i, i * 7,
+                              __func__, __FILE__, __LINE__);
+        }
+        nsec = bench_now() - start;
+
+        if (nsec > result->max) result->max = nsec;
+        result->total += nsec;
+        result->count ++;
+
+        if ((i % BENCH_BURST) == (BENCH_BURST - 1)) {
+            /* interval between bursts  */
+            usleep(ICO_APF_LOG_INTERVAL * 1000 + 10000);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_thread: output thread
+ *
+ * @param[in]   arg         measured result
+ * @return      NULL
+ */
+/*--------------------------------------------------------------------------*/
+static void *
+bench_thread(void *arg)
+{
+    bench_output(1, (bench_result_t *)arg);
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   bench_print: print measured result
+ *
+ * @param[in]   title       title of result
+ * @param[in]   result      measured result
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+bench_print(const char *title, const bench_result_t *result)
+{
+    if (result->count <= 0) {
+        printf("%-10s: no data\n", title);
+        return;
+    }
+    printf("%-10s: count=%7d avg=%6ld ns max=%8ld ns\n", title,
+           result->count, result->total / result->count, result->max);
+}
+
+int
+main(int argc, char *argv[])
+{
+    bench_result_t  sync;
+    bench_result_t  async;
+    bench_result_t  *thread;
+    pthread_t       *tid;
+    FILE            *out;
+    int     threads = 0;
+    int     flush = 0;
+    int     i;
+
+    for (i = 1; i < argc; i++)  {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) {
+            bench_count = strtol(argv[++i], (char **)0, 0);
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))    {
+            threads = strtol(argv[++i], (char **)0, 0);
+        }
+        else if (strcmp(argv[i], "-f") == 0)    {
+            flush = 1;
+        }
+        else    {
+            fprintf(stderr, "usage: %s [-n count] [-t threads] [-f]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (bench_count <= 0)   bench_count = 1;
+
+    /* stdout is redirected to log file, print result to saved stdout   */
+    out = fdopen(dup(fileno(stdout)), "w");
+    if (! out)  {
+        out = stderr;
+    }
+    ico_apf_log_open("bench_log");
+    ico_apf_log_setlevel(ICO_APF_LOG_DEBUG |
+                         (flush ? ICO_APF_LOG_FLUSH : ICO_APF_LOG_NOFLUSH));
+
+    memset(&sync, 0, sizeof(sync));
+    memset(&async, 0, sizeof(async));
+
+    bench_output(0, &sync);
+    bench_output(1, &async);
+    ico_apf_log_flush();
+
+    stdout = out;
+    bench_print("print", &sync);
+    bench_print("async", &async);
+
+    if (threads > 0)    {
+        thread = calloc(threads, sizeof(bench_result_t));
+        tid = calloc(threads, sizeof(pthread_t));
+        if ((! thread) || (! tid))  {
+            fprintf(stderr, "%s: no memory\n", argv[0]);
+            exit(1);
+        }
+        for (i = 0; i < threads; i++)   {
+            (void) pthread_create(&tid[i], NULL, bench_thread, &thread[i]);
+        }
+        for (i = 0; i < threads; i++)   {
+            char    title[24];
+            (void) pthread_join(tid[i], NULL);
+            snprintf(title, sizeof(title), "thread%d", i);
+            bench_print(title, &thread[i]);
+        }
+        ico_apf_log_flush();
+    }
+    printf("dropped   : %u\n", ico_apf_log_dropped());
+    exit(0);
+}
@@ -0,0 +1,5 @@
+#!/bin/sh
+
+export LD_LIBRARY_PATH=../.libs:$LD_LIBRARY_PATH
+export UIFW_CONFDIR=${UIFW_CONFDIR:-../../res/config}
+./bench_conf $*
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+export LD_LIBRARY_PATH=../.libs:$LD_LIBRARY_PATH
+./test_log $*
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   round trip test of debug log output by the writer thread
+ *
+ *          usage: test_log
+ *          (log messages stored by the calling thread(ico_apf_log_trace)
+ *           and written by the writer thread must be same as the output
+ *           on the calling thread(ico_apf_log_print) except the time.
+ *           tests conversions, copy of %s arguments, truncation of
+ *           arguments and strings, and the record of dropped messages.
+ *           log is written to ICO_APF_LOG_DIR/test_log.log)
+ *
+ * @date    Mar-04-2013
+ */
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <unistd.h>
+#include    <string.h>
+#include    <stdarg.h>
+#include    <stdint.h>
+
+#include    "ico_apf_log.h"
+
+/* expected log lines   */
+#define TEST_MAXLINES   (ICO_APF_LOG_RINGSIZE + 64)
+
+/* messages sent while the writer thread is stopped     */
+#define TEST_DROPS      (ICO_APF_LOG_RINGSIZE + 40)
+
+/* log message of call site and expected output on the calling thread   */
+#define TEST_LOG(expfmt, fmt, ...)  \
+    {static ico_apf_log_site_t _test_site = {"DBG",fmt,__func__,__FILE__,__LINE__,0,0}; \
+     test_expect(&_test_site, expfmt, ##__VA_ARGS__); \
+     ico_apf_log_trace(&_test_site, ##__VA_ARGS__); }
+
+static char *test_lines[TEST_MAXLINES];
+static int  test_nlines = 0;
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   test_expect: format expected log line same as ico_apf_log_print
+ *                       of log macros(without time)
+ *
+ * @param[in]   site        call site(NULL: no call site)
+ * @param[in]   fmt         expected format
+ * @param[in]   ...         arguments
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+test_expect(const ico_apf_log_site_t *site, const char *fmt, ...)
+{
+    va_list list;
+    char    *line;
+    int     len;
+
+    if (test_nlines >= TEST_MAXLINES)   {
+        fprintf(stderr, "test_log: too many lines\n");
+        exit(1);
+    }
+    line = malloc(ICO_APF_LOG_LINESIZE);
+    if (! line) {
+        fprintf(stderr, "test_log: no memory\n");
+        exit(1);
+    }
+    len = snprintf(line, ICO_APF_LOG_LINESIZE, "[%s]@%d> ",
+                   site ? site->level : "WRN", getpid());
+    va_start(list, fmt);
+    len += vsnprintf(&line[len], ICO_APF_LOG_LINESIZE - len, fmt, list);
+    va_end(list);
+    if (site)   {
+        snprintf(&line[len], ICO_APF_LOG_LINESIZE - len, " (%s,%s:%d)\n",
+                 site->func, site->file, site->line);
+    }
+    test_lines[test_nlines++] = line;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   test_format: conversions of arguments
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+test_format(void)
+{
+    TEST_LOG("int %d %i %u %x %X %o %#x %+05d %c|", "int %d %i %u %x %X %o %#x %+05d %c|",
+             -12, 34, 3000000000u, 0xbeef, 0xBEEF, 8, 255, 7, 'Z');
+    TEST_LOG("long %ld %lu %lld %llx %zu %jd %hd|", "long %ld %lu %lld %llx %zu %jd %hd|",
+             -1234567890123L, 4000000000UL, -9876543210987LL, 0x123456789abcULL,
+             (size_t)77, (intmax_t)-5, (short)-3);
+    TEST_LOG("double %f %.3e %g %10.4f %Lf|", "double %f %.3e %g %10.4f %Lf|",
+             3.14159, 12345.678, 0.0001, -2.5, (long double)1.25);
+    TEST_LOG("pointer %p %p|", "pointer %p %p|", (void *)0x1234, (void *)0);
+    TEST_LOG("star %*d|%-*d|%.*f|%*.*s|", "star %*d|%-*d|%.*f|%*.*s|",
+             6, 42, 4, 7, 2, 3.14159, 8, 3, "abcdef");
+    TEST_LOG("percent 100%% %d%%", "percent 100%% %d%%", 50);
+    TEST_LOG("no argument", "no argument");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   test_string: string arguments are copied and truncated
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+test_string(void)
+{
+    char    buf[ICO_APF_LOG_STRSIZE + 128];
+
+    /* argument is released or changed after return     */
+    strcpy(buf, "org.tizen.ico.app-test");
+    TEST_LOG("string %s %s %-8s|%.3s|%s", "string %s %s %-8s|%.3s|%s",
+             buf, "literal", "ab", "abcdef", (char *)0);
+    strcpy(buf, "XXXXXXXXXXXX");
+
+    /* string area is full, rest of strings are empty   */
+    memset(buf, 'a', sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = 0;
+    TEST_LOG("long %.191s|%.0s|%d", "long %s|%s|%d", buf, "next", 9);
+    memset(buf, 'b', sizeof(buf) - 1);
+
+    /* arguments over ICO_APF_LOG_MAXARGS are not stored    */
+    TEST_LOG("args %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %%d %%s",
+             "args %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %s",
+             1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+             21, "over");
+    TEST_LOG("stars %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %%*d",
+             "stars %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %*d",
+             1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+             4, 20);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   test_drop: messages over the ring buffer are dropped and reported
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+test_drop(void)
+{
+    static ico_apf_log_site_t site = {"DBG", "drop %d", __func__, __FILE__, __LINE__, 0, 0};
+    unsigned int    dropped;
+    int     i;
+
+    /* ring buffer is empty     */
+    ico_apf_log_flush();
+    dropped = ico_apf_log_dropped();
+
+    /* writer thread waits for the log file(stdout is the log file)     */
+    flockfile(stdout);
+    for (i = 0; i < TEST_DROPS; i++)    {
+        if (i < ICO_APF_LOG_RINGSIZE)   {
+            test_expect(&site, "drop %d", i);
+        }
+        ico_apf_log_trace(&site, i);
+    }
+    test_expect(NULL, "%u log messages dropped(total %u)\n",
+                TEST_DROPS - ICO_APF_LOG_RINGSIZE,
+                dropped + TEST_DROPS - ICO_APF_LOG_RINGSIZE);
+    funlockfile(stdout);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   test_check: compare log file with expected lines
+ *
+ * @param[in]   out         output of result
+ * @return      number of errors
+ */
+/*--------------------------------------------------------------------------*/
+static int
+test_check(FILE *out)
+{
+    FILE    *fp;
+    char    line[ICO_APF_LOG_LINESIZE];
+    char    *p;
+    int     idx = 0;
+    int     errors = 0;
+
+    fp = fopen(ICO_APF_LOG_DIR "/test_log.log", "r");
+    if (! fp)   {
+        fprintf(out, "test_log: can not open %s/test_log.log\n", ICO_APF_LOG_DIR);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), fp))   {
+        /* skip time of log line    */
+        p = strchr(line, '[');
+        if (! p)    {
+            p = line;
+        }
+        if (idx >= test_nlines) {
+            fprintf(out, "NG  extra line: %s", p);
+            errors ++;
+            continue;
+        }
+        if (strcmp(p, test_lines[idx]) != 0)    {
+            fprintf(out, "NG  line %d\n  expect: %s  output: %s", idx + 1,
+                    test_lines[idx], p);
+            errors ++;
+        }
+        idx ++;
+    }
+    fclose(fp);
+
+    for (; idx < test_nlines; idx++)    {
+        fprintf(out, "NG  missing line %d: %s", idx + 1, test_lines[idx]);
+        errors ++;
+    }
+    return errors;
+}
+
+int
+main(int argc, char *argv[])
+{
+    FILE    *out;
+    int     errors;
+
+    /* stdout is redirected to log file, print result to saved stdout   */
+    out = fdopen(dup(fileno(stdout)), "w");
+    if (! out)  {
+        out = stderr;
+    }
+    ico_apf_log_open("test_log");
+    ico_apf_log_setlevel(ICO_APF_LOG_DEBUG | ICO_APF_LOG_NOFLUSH);
+
+    test_format();
+    test_string();
+    test_drop();
+    ico_apf_log_flush();
+    ico_apf_log_close();
+
+    errors = test_check(out);
+    if (errors > 0) {
+        fprintf(out, "%s: %d errors\n", argv[0], errors);
+    }
+    else    {
+        fprintf(out, "%s: %d lines OK\n", argv[0], test_nlines);
+    }
+    fclose(out);
+    return (errors > 0) ? 1 : 0;
+}
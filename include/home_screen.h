@@ -56,7 +56,11 @@
 #define ICO_HS_CONFIG_TILE_APP_DEFAULT    "none"
 
 #define ICO_HS_CONFIG_WS_PORT       "wsport"
+#define ICO_HS_CONFIG_APC_BATCH     "apc_batch"
 #define ICO_HS_CONFIG_ORIENTAION    "orientation"
+#define ICO_HS_CONFIG_PRELAUNCH_NUM "prelaunch_num"
+#define ICO_HS_CONFIG_PRELAUNCH_MEMORY "prelaunch_memory"
+#define ICO_HS_CONFIG_BOOT_CONCURRENCY "boot_concurrency"
 
 #define ICO_HS_CONFIG_BG            "bgimage"
 
@@ -108,6 +112,27 @@
 #define ICO_HS_SND_CNAME_DEFAULT     "sound_default"
 #define ICO_HS_SND_FNAME_DEFAULT     "default.wav"
 
+/* define for pre-launch */
+#define ICO_HS_PRELAUNCH_MEMORY_DEFAULT (64*1024)
+                  /* memory budget of pre-launched applications(KB)  */
+#define ICO_HS_PRELAUNCH_APPMEMORY   (32*1024)
+                  /* memory of not measured application(KB)          */
+#define ICO_HS_PRELAUNCH_HALFLIFE    (30.0*60.0)
+                  /* half-life of use score(sec)                     */
+#define ICO_HS_PRELAUNCH_MINSCORE    (1.5)
+                  /* minimum use score of pre-launch                 */
+#define ICO_HS_PRELAUNCH_KEEPSCORE   (0.5)
+                  /* bonus score of pre-launched application         */
+
+/* define for boot */
+#define ICO_HS_BOOT_CONCURRENCY_DEFAULT (3)
+                  /* applications launching at the same time         */
+#define ICO_HS_BOOT_TIMEOUT          (5.0)
+                  /* time to wait for window of application(sec)     */
+#define ICO_HS_BOOT_POLL             (0.05)
+                  /* interval to check window of application that    */
+                  /* is launching without boot callback(sec)         */
+
 /*============================================================================*/
 /* definition                                                                 */
 /*============================================================================*/
@@ -125,6 +150,29 @@ struct _hs_window_data {
     int category;
 };
 
+typedef struct _hs_boot_stats hs_boot_stats_t;
+struct _hs_boot_stats {
+    int tiles;          /* tile applications launched at boot           */
+    int tilesend;       /* tile applications that ended launch          */
+    int windows;        /* applications that window appeared            */
+    int failed;         /* applications that could not launch           */
+    int timeouts;       /* applications that window did not appear      */
+    int firsttile;      /* time to first tile window(ms, -1=not yet)    */
+    int alltiles;       /* time to all tile windows(ms, -1=not yet)     */
+};
+
+typedef struct _hs_prelaunch_stats hs_prelaunch_stats_t;
+struct _hs_prelaunch_stats {
+    int uses;           /* uses of applications                         */
+    int hits;           /* uses of pre-launched applications            */
+    int misses;         /* uses with cold launch                        */
+    int launches;       /* background launches                          */
+    int evictions;      /* terminated pre-launched applications         */
+    int apps;           /* current pre-launched applications            */
+    int memory;         /* current memory of pre-launched applications(KB)*/
+    int memorymax;      /* maximum memory of pre-launched applications(KB)*/
+};
+
 /*============================================================================*/
 /* functions                                                                  */
 /*============================================================================*/
@@ -159,6 +207,18 @@ extern char hs_active_onscreen[ICO_UXF_MAX_PROCESS_NAME];
 extern int hs_snd_play(char *wav_file);
 extern char *hs_snd_get_filename(int type);
 extern int hs_snd_init(void);
+
+extern int hs_boot_init(void);
+extern int hs_boot_add(const char *appid, int tile);
+extern void hs_boot_start(void);
+extern void hs_boot_get_stats(hs_boot_stats_t *stats);
+
+extern int hs_prelaunch_init(void);
+extern void hs_prelaunch_used(const char *appid);
+extern void hs_prelaunch_update(void);
+extern int hs_prelaunch_newwindow(const char *appid, const int window);
+extern void hs_prelaunch_terminated(const char *appid);
+extern void hs_prelaunch_get_stats(hs_prelaunch_stats_t *stats);
 #endif    /* _HOME_SCREEN_H_ */
 
 /**
@@ -30,6 +30,20 @@ extern "C" {
 #define ICO_APF_LOG_MAXLINES    10000   /* Maximum output lines of one log file     */
 #define ICO_APF_LOG_MAXFILES    6       /* Maximum number of the log file           */
 
+/* Asynchronous log output      */
+#ifndef ICO_APF_LOG_ASYNC
+#define ICO_APF_LOG_ASYNC       1       /* Log output by writer thread(=1) or       */
+                                        /* on the calling thread(=0)                */
+#endif /*ICO_APF_LOG_ASYNC*/
+#define ICO_APF_LOG_RINGSIZE    256     /* Log messages in ring buffer of a thread  */
+                                        /* (power of 2, overflowed message dropped) */
+#define ICO_APF_LOG_MAXARGS     20      /* Maximum arguments of one log message     */
+#define ICO_APF_LOG_STRSIZE     192     /* String arguments area of one log message */
+#define ICO_APF_LOG_INTERVAL    50      /* Interval of writer thread(ms)            */
+#define ICO_APF_LOG_LINESIZE    1024    /* Maximum length of one log line           */
+#define ICO_APF_LOG_MAXBYTES    (ICO_APF_LOG_MAXLINES*128)
+                                        /* Maximum size of one binary trace file    */
+
 /* Log output level             */
 #define ICO_APF_LOG_DEBUG       128     /* Debug write                              */
 #define ICO_APF_LOG_INFO        64      /* Information                              */
@@ -41,18 +55,48 @@ extern "C" {
 #define ICO_APF_LOG_FLUSH       0x4000  /* Log outout with log flush                */
 #define ICO_APF_LOG_NOFLUSH     0x2000  /* Log output without log flush             */
 
+/* Log output format            */
+#define ICO_APF_LOG_BINARY      0x1000  /* Binary trace file(writer thread only)    */
+#define ICO_APF_LOG_TEXT        0x0800  /* Text log file                            */
+
+/* Call site of log output(static, created by log macros at build time)            */
+typedef struct _ico_apf_log_site    {
+    const char      *level;             /* log level string                         */
+    const char      *fmt;               /* message format                           */
+    const char      *func;              /* function name                            */
+    const char      *file;              /* source file name                         */
+    int             line;               /* source line                              */
+    unsigned int    id;                 /* call site id(0: not registered)          */
+    unsigned int    gen;                /* trace file written the definition        */
+}   ico_apf_log_site_t;
+
 /* Function prototypes          */
 void ico_apf_log_print(const char *fmt, ...);
+void ico_apf_log_async(const char *level, const char *fmt, ...);
+void ico_apf_log_trace(ico_apf_log_site_t *site, ...);
 void ico_apf_log_open(const char *Prog);
 void ico_apf_log_close(void);
 void ico_apf_log_flush(void);
 char *ico_apf_log_curtime(const char *level);
 void ico_apf_log_setlevel(const int loglevel);
+unsigned int ico_apf_log_dropped(void);
 
 /* Current log output level     */
 extern int  ico_apf_log_level;
 
 /* Macros for log output        */
+#if ICO_APF_LOG_ASYNC > 0
+#define ICO_APF_DEBUG(fmt,...)  \
+    {if( ico_apf_log_level >= ICO_APF_LOG_DEBUG) {static ico_apf_log_site_t _ico_apf_log_site = {"DBG",fmt,__func__,__FILE__,__LINE__,0,0}; ico_apf_log_trace(&_ico_apf_log_site,##__VA_ARGS__);} }
+#define ICO_APF_INFO(fmt,...)   \
+    {if( ico_apf_log_level >= ICO_APF_LOG_INFO) {static ico_apf_log_site_t _ico_apf_log_site = {"INF",fmt,__func__,__FILE__,__LINE__,0,0}; ico_apf_log_trace(&_ico_apf_log_site,##__VA_ARGS__);} }
+#define ICO_APF_WARN(fmt,...)   \
+    {if( ico_apf_log_level >= ICO_APF_LOG_WARNING) {static ico_apf_log_site_t _ico_apf_log_site = {"WRN",fmt,__func__,__FILE__,__LINE__,0,0}; ico_apf_log_trace(&_ico_apf_log_site,##__VA_ARGS__);} }
+#define ICO_APF_CRITICAL(fmt,...)   \
+    {if( ico_apf_log_level >= ICO_APF_LOG_CRITICAL) {static ico_apf_log_site_t _ico_apf_log_site = {"CRI",fmt,__func__,__FILE__,__LINE__,0,0}; ico_apf_log_trace(&_ico_apf_log_site,##__VA_ARGS__);} }
+#define ICO_APF_ERROR(fmt,...)  \
+    {if( ico_apf_log_level >= ICO_APF_LOG_ERROR) {static ico_apf_log_site_t _ico_apf_log_site = {"ERR",fmt,__func__,__FILE__,__LINE__,0,0}; ico_apf_log_trace(&_ico_apf_log_site,##__VA_ARGS__);} }
+#else  /*ICO_APF_LOG_ASYNC*/
 #define ICO_APF_DEBUG(fmt,...)  \
     {if( ico_apf_log_level >= ICO_APF_LOG_DEBUG) {ico_apf_log_print("%s> "fmt" (%s,%s:%d)\n",ico_apf_log_curtime("DBG"),##__VA_ARGS__,__func__,__FILE__,__LINE__);} }
 #define ICO_APF_INFO(fmt,...)   \
@@ -63,6 +107,7 @@ extern int  ico_apf_log_level;
     {if( ico_apf_log_level >= ICO_APF_LOG_CRITICAL) {ico_apf_log_print("%s> "fmt" (%s,%s:%d)\n",ico_apf_log_curtime("CRI"),##__VA_ARGS__,__func__,__FILE__,__LINE__);} }
 #define ICO_APF_ERROR(fmt,...)  \
     {if( ico_apf_log_level >= ICO_APF_LOG_ERROR) {ico_apf_log_print("%s> "fmt" (%s,%s:%d)\n",ico_apf_log_curtime("ERR"),##__VA_ARGS__,__func__,__FILE__,__LINE__);} }
+#endif /*ICO_APF_LOG_ASYNC*/
 
 /* Macros for compativility */
 #ifndef apfw_trace
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   Application Framework binary trace file format
+ *          (written by log writer thread in binary mode, and decoded to
+ *           the same text as the log file by ico_decode_trace)
+ *
+ * @date    Feb-28-2013
+ */
+
+#ifndef _ICO_APF_TRACE_H_
+#define _ICO_APF_TRACE_H_
+
+#include    <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Trace file                   */
+#define ICO_APF_TRACE_MAGIC     "ICOTRCE"   /* file magic (8 bytes with NULL)       */
+#define ICO_APF_TRACE_VERSION   1           /* file format version                  */
+#define ICO_APF_TRACE_ENDIAN    0x01020304  /* byte order check                     */
+#define ICO_APF_TRACE_SUFFIX    "trc"       /* suffix of trace file name            */
+#define ICO_APF_TRACE_ALIGN     8           /* alignment of records                 */
+
+/* Record type                  */
+#define ICO_APF_TRACE_SITE      1           /* call site definition                 */
+#define ICO_APF_TRACE_MSG       2           /* log message of a call site           */
+#define ICO_APF_TRACE_TEXT      3           /* formatted log message                */
+#define ICO_APF_TRACE_DROP      4           /* dropped log messages                 */
+
+/* File header                  */
+typedef struct _ico_apf_trace_head  {
+    char        magic[8];                   /* ICO_APF_TRACE_MAGIC                  */
+    uint32_t    version;                    /* ICO_APF_TRACE_VERSION                */
+    uint32_t    endian;                     /* ICO_APF_TRACE_ENDIAN                 */
+    int32_t     pid;                        /* process id of writer                 */
+    int32_t     timezone;                   /* local time difference(sec)           */
+    uint16_t    longsize;                   /* sizeof(long) of writer               */
+    uint16_t    ptrsize;                    /* sizeof(void *) of writer             */
+    uint32_t    res;                        /* (unused)                             */
+    int64_t     basetime;                   /* realtime - monotonic time(nsec)      */
+    char        prog[32];                   /* program name                         */
+}   ico_apf_trace_head_t;
+
+/* Record header(size is multiple of ICO_APF_TRACE_ALIGN)                         */
+typedef struct _ico_apf_trace_rec   {
+    uint16_t    type;                       /* record type(ICO_APF_TRACE_xxx)       */
+    uint16_t    size;                       /* record size including header         */
+    uint32_t    id;                         /* call site id(DROP: dropped messages) */
+    int64_t     time;                       /* monotonic time(nsec)                 */
+}   ico_apf_trace_rec_t;
+
+/* ICO_APF_TRACE_SITE: followed by level, function, file and format strings      */
+typedef struct _ico_apf_trace_site  {
+    ico_apf_trace_rec_t rec;
+    int32_t     line;                       /* source line                          */
+    uint32_t    res;                        /* (unused)                             */
+}   ico_apf_trace_site_t;
+
+/* ICO_APF_TRACE_MSG: followed by nargs 8 bytes raw arguments and string area     */
+typedef struct _ico_apf_trace_msg   {
+    ico_apf_trace_rec_t rec;
+    uint16_t    nargs;                      /* number of arguments                  */
+    uint16_t    strsize;                    /* size of string area                  */
+    uint32_t    res;                        /* (unused)                             */
+}   ico_apf_trace_msg_t;
+
+/* ICO_APF_TRACE_TEXT: followed by formatted log message                          */
+/* ICO_APF_TRACE_DROP: followed by total of dropped messages(uint32_t)            */
+
+/* log message to be formatted(common with log file and trace decoder)            */
+typedef struct _ico_apf_trace_info  {
+    const char      *level;                 /* log level string                     */
+    const char      *fmt;                   /* message format                       */
+    const char      *func;                  /* function name(NULL: not call site)   */
+    const char      *file;                  /* source file name                     */
+    int             line;                   /* source line                          */
+    int             pid;                    /* process id                           */
+    int             timezone;               /* local time difference(sec)           */
+    int             longsize;               /* sizeof(long) of writer               */
+    int64_t         time;                   /* real time(nsec)                      */
+    int             nargs;                  /* number of arguments                  */
+    const void      *arg;                   /* raw arguments(8 bytes each)          */
+    const char      *str;                   /* string area                          */
+    int             strsize;                /* size of string area                  */
+}   ico_apf_trace_info_t;
+
+/* Function prototypes          */
+int ico_apf_trace_format(char *buf, const int size, const ico_apf_trace_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* _ICO_APF_TRACE_H_ */
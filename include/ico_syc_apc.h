@@ -45,12 +45,75 @@ extern "C" {
 #define ICO_SYC_APC_REGULATION_NOREGULATION     (1)
 #define ICO_SYC_APC_REGULATION_NOCHANGE         (9)
 
+/* Pre-launch of application(ico_syc_apc_prelaunch) */
+#define ICO_SYC_APC_PRELAUNCH_END       (0)     /* used by user, request display    */
+#define ICO_SYC_APC_PRELAUNCH_START     (1)     /* launched in background           */
+#define ICO_SYC_APC_PRELAUNCH_CANCEL    (2)     /* evicted or dead in background    */
+
 typedef struct _ico_apc_reguration_control  {
     unsigned char   display;                /* display(1=visible/0=invisible)   */
     unsigned char   sound;                  /* sound(1=play/0=mute)             */
     unsigned char   input;                  /* inputsw(1=use/0=unuse)           */
     unsigned char   res;                    /* (unused)                         */
 } ico_apc_reguration_control_t;
+/* statistics of batch arbitration    */
+typedef struct _ico_apc_batch_stats {
+    int     requests;                       /* number of deferred requests      */
+    int     recalcs;                        /* number of recalculated displays  */
+                                            /* and sounds                       */
+    int     flips;                          /* number of emitted show/hide      */
+                                            /* (active/mute) changes            */
+    int     avoided;                        /* number of show/hide changes that */
+                                            /* avoided by batch arbitration     */
+} ico_apc_batch_stats_t;
+/* statistics of staged Multi Sound Manager commands */
+typedef struct _ico_apc_soundctl_stats {
+    int     staged;                         /* number of staged mute/unmute     */
+    int     cancelled;                      /* number of commands cancelled by  */
+                                            /* opposite command in a turn       */
+    int     sent;                           /* number of sent stream commands   */
+    int     bulk;                           /* number of sent all stream commands*/
+} ico_apc_soundctl_stats_t;
+/* statistics of application reply latency    */
+typedef struct _ico_apc_reply_stats {
+    int     replies;                        /* number of replies(ACK/NAK)       */
+    int     timeouts;                       /* number of reply timeouts         */
+    int     average;                        /* average latency(EWMA, ms)        */
+    int     p95;                            /* 95 percentile latency(ms)        */
+    int     timeout;                        /* current reply timeout(ms)        */
+    int     lower;                          /* lower bound of timeout(ms)       */
+    int     upper;                          /* upper bound of timeout(ms)       */
+    int     category;                       /* category Id of application       */
+} ico_apc_reply_stats_t;
+/* statistics of regulation rule engine       */
+typedef struct _ico_apc_regulation_stats {
+    int     evals;                          /* number of rule engine evaluations*/
+    int     predicates;                     /* number of evaluated predicates   */
+    int     categories;                     /* number of judged categories      */
+    int     changes;                        /* number of predicate changes      */
+    int     suppressed;                     /* number of changes suppressed by  */
+                                            /* hysteresis or debounce           */
+    int     notifies;                       /* number of change set notifies    */
+    int     cputime;                        /* CPU time of evaluations and      */
+                                            /* notifies(us)                     */
+} ico_apc_regulation_stats_t;
+
+/* set of application categorys(bit of category Id) */
+typedef unsigned int ico_apc_category_set_t;
+#define ICO_SYC_APC_CATEGORY_BIT(category)  (((ico_apc_category_set_t)1) << (category))
+#define ICO_SYC_APC_CATEGORY_ALL            ((ico_apc_category_set_t)-1)
+#if ICO_UXF_CATEGORY_MAX > 32
+#error  "ico_apc_category_set_t is too small for ICO_UXF_CATEGORY_MAX"
+#endif
+
+/* regulation changes of one evaluation     */
+typedef struct _ico_apc_regulation_change {
+    ico_apc_category_set_t  changed;        /* changed categorys                */
+                                            /* new controls of changed categorys*/
+                                            /* (NOCHANGE for not changed)       */
+    ico_apc_reguration_control_t    control[ICO_UXF_CATEGORY_MAX];
+} ico_apc_regulation_change_t;
+
                                             /* application context (pointer only)*/
 typedef struct _ico_apc_context *ico_apc_context_h;
 
@@ -58,6 +121,9 @@ typedef struct _ico_apc_context *ico_apc_context_h;
 typedef void (*ico_apc_regulation_cb_t)(const int appcategory,
                                         const ico_apc_reguration_control_t control,
                                         void *user_data);
+                                            /* regulation change set callback   */
+typedef void (*ico_apc_regulation_set_cb_t)(const ico_apc_regulation_change_t *change,
+                                            void *user_data);
                                             /* respurce control                 */
 typedef void (*ico_apc_resource_control_t)(const Ico_Uxf_conf_application *conf,
                                            const int control);
@@ -74,20 +140,42 @@ void ico_syc_apc_term(void);
 int ico_syc_apc_is_waitshow(const char *appid);
                                             /* Select active application        */
 void ico_syc_apc_active(const char *appid);
+                                            /* Set batch arbitration mode       */
+void ico_syc_apc_batch(const int batch);
+                                            /* Get batch arbitration statistics */
+void ico_syc_apc_batch_stats(ico_apc_batch_stats_t *stats);
+                                            /* Get sound command statistics     */
+void ico_syc_apc_soundctl_stats(ico_apc_soundctl_stats_t *stats);
+                                            /* Get reply latency statistics     */
+int ico_syc_apc_reply_stats(const char *appid, ico_apc_reply_stats_t *stats);
+                                            /* Pre-launch of application        */
+int ico_syc_apc_prelaunch(const char *appid, const int prelaunch);
 
 /* Apps Controller regulation control           */
                                             /* regulation controller initialize     */
 int ico_syc_apc_regulation_init(void);
                                             /* regulation controller terminate  */
 int ico_syc_apc_regulation_term(void);
+                                            /* change system configuration      */
+int ico_syc_apc_regulation_reconfig(const Ico_Uxf_Sys_Config *conf);
                                             /* set regulation change listener       */
 void ico_syc_apc_regulation_listener(ico_apc_regulation_cb_t func, void *user_data);
+                                            /* set regulation change set listener*/
+void ico_syc_apc_regulation_set_listener(ico_apc_regulation_set_cb_t func,
+                                         const ico_apc_category_set_t categorys,
+                                         void *user_data);
                                             /* get application visible control  */
 int ico_syc_apc_regulation_app_visible(const int category);
                                             /* get application sound control    */
 int ico_syc_apc_regulation_app_sound(const int category);
                                             /* get application input control    */
 int ico_syc_apc_regulation_app_input(const int category);
+                                            /* get rule engine statistics       */
+void ico_syc_apc_regulation_stats(ico_apc_regulation_stats_t *stats);
+                                            /* record vehicle signals to file   */
+int ico_syc_apc_regulation_record(const char *file);
+                                            /* inject vehicle signal(replay)    */
+int ico_syc_apc_regulation_inject(const char *property, const double value);
 
 #ifdef __cplusplus
 }
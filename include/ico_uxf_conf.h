@@ -49,6 +49,7 @@ typedef struct _ico_uxf_conf_misc {
     int soundpluginport;
     int loglevel;
     int logflush;
+    int logbinary;
 } Ico_Uxf_conf_misc;
 
 typedef struct _ico_uxf_conf_host {
@@ -67,9 +68,21 @@ typedef struct _ico_uxf_conf_category {
     short sound;
     short input;
     short priority;
-    short res;                                  /* (unused)         */
+    short replymin;                             /* reply timeout lower bound(ms) */
+    short replymax;                             /* reply timeout upper bound(ms) */
 } Ico_Uxf_conf_category;
 
+typedef struct _ico_uxf_conf_regulation {
+    short signal;                               /* ICO_UXF_REGULATION_SIG_xxx       */
+    short op;                                   /* ICO_UXF_REGULATION_OP_xxx        */
+    short valueNum;                             /* number of values                 */
+    short res;                                  /* (unused)         */
+    double value[ICO_UXF_REGULATION_VALUE_MAX]; /* values(threshold is value[0])    */
+    double hysteresis;                          /* hysteresis of threshold          */
+    int debounce_on;                            /* stable time to be true(ms)       */
+    int debounce_off;                           /* stable time to be false(ms)      */
+} Ico_Uxf_conf_regulation;
+
 typedef struct _ico_uxf_conf_kind {
     int id;
     char *name;
@@ -95,8 +108,8 @@ typedef struct _ico_uxf_conf_appinput {
 } Ico_Uxf_conf_appinput;
 
 typedef struct _ico_uxf_conf_application {
-    char *appid;
-    char *name;
+    char *appid;                                /* interned(ico_uxf_misc_intern)    */
+    char *name;                                 /* interned(ico_uxf_misc_intern)    */
     char *group;
     char *exec;
     char *type;
@@ -121,6 +134,7 @@ typedef struct _ico_uxf_conf_application {
     Ico_Uxf_conf_appinput   input[ICO_UXF_APPINPUT_MAX];
     struct _ico_uxf_conf_application *nextidhash;
     struct _ico_uxf_conf_application *nextnamehash;
+    struct _ico_uxf_conf_application *nextlabelhash;
 } Ico_Uxf_conf_application;
 
 typedef struct _ico_uxf_conf_display_layer {
@@ -185,6 +199,7 @@ typedef struct _ico_uxf_conf_inputsw {
     struct _ico_uxf_conf_inputdev   *inputdev;
     char *name;
     char *appid;
+    struct _ico_uxf_conf_inputsw    *nexthash;  /* same name hash   */
 } Ico_Uxf_conf_inputsw;
 
 typedef struct _ico_uxf_conf_inputdev {
@@ -193,6 +208,7 @@ typedef struct _ico_uxf_conf_inputdev {
     short inputswNum;
     short res;                                  /* (unused)         */
     Ico_Uxf_conf_inputsw *inputsw;
+    struct _ico_uxf_conf_inputdev   *nexthash;  /* same name hash   */
 } Ico_Uxf_conf_inputdev;
 
 typedef struct _ico_uxf_sys_config {
@@ -209,6 +225,9 @@ typedef struct _ico_uxf_sys_config {
     Ico_Uxf_conf_display *display;
     Ico_Uxf_conf_sound *sound;
     Ico_Uxf_conf_inputdev *inputdev;
+    Ico_Uxf_conf_inputdev *hashinputdev[ICO_UXF_MISC_HASHSIZE];
+    Ico_Uxf_conf_inputsw *hashinputsw[ICO_UXF_MISC_HASHSIZE];
+    Ico_Uxf_conf_regulation regulation[ICO_UXF_REGULATION_MAX];
 } Ico_Uxf_Sys_Config;
 
 typedef struct _ico_uxf_app_config {
@@ -217,9 +236,14 @@ typedef struct _ico_uxf_app_config {
     Ico_Uxf_conf_application *application;
     Ico_Uxf_conf_application *hashidtable[ICO_UXF_MISC_HASHSIZE];
     Ico_Uxf_conf_application *hashnametable[ICO_UXF_MISC_HASHSIZE];
+    Ico_Uxf_conf_application *hashlabeltable[ICO_UXF_MISC_HASHSIZE];
 } Ico_Uxf_App_Config;
 
 typedef void (*Ico_Uxf_AppUpdata_Cb)(const char *appid, int type);
+/* system configuration was replaced by live reload(oldconf is released later, */
+/* return ICO_UXF_EOK, or error if the callback still refers oldconf)         */
+typedef int (*Ico_Uxf_SysUpdate_Cb)(const Ico_Uxf_Sys_Config *newconf,
+                                     const Ico_Uxf_Sys_Config *oldconf);
 
 const Ico_Uxf_Sys_Config* ico_uxf_getSysConfig(void);
 const Ico_Uxf_Sys_Config* ico_uxf_ifGetSysConfig(void);
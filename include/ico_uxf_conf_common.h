@@ -15,6 +15,7 @@
 #ifndef ICO_UXF_CONF_COMMON_H_
 #define ICO_UXF_CONF_COMMON_H_
 
+#include <sys/stat.h>
 #include <glib.h>
 
 #include "ico_uxf_sysdef.h"
@@ -26,11 +27,46 @@
 extern "C" {
 #endif
 
+/* Numerical keys of a configuration group(ex. [display] 0=,1=,...)    */
+typedef struct _ico_uxf_conf_numkeys {
+    int     num;                        /* number of numerical keys         */
+    int     *id;                        /* key values(ascending order)      */
+    char    **key;                      /* key strings(same order of id)    */
+    char    **allkeys;                  /* all keys of the group            */
+    int     cur;                        /* key index in subkey buffer       */
+    int     curlen;                     /* key length in subkey buffer      */
+    GString *subkey;                    /* sub key buffer(ex. "0.zone.1")   */
+} Ico_Uxf_conf_numkeys;
+
 /* Prototyypes of configuration functions           */
 int ico_uxf_conf_getUint(const char* str);
 GList* ico_uxf_conf_countNumericalKey(GKeyFile *keyfile, const char* group);
 const char* ico_uxf_conf_appendStr(const char* str1, const char* str2);
 void ico_uxf_conf_checkGerror(GError** error);
+Ico_Uxf_conf_numkeys *ico_uxf_conf_getNumericalKeys(GKeyFile *keyfile, const char *group);
+const char *ico_uxf_conf_subKey(Ico_Uxf_conf_numkeys *keys, const int idx,
+                                const char *suffix);
+const char *ico_uxf_conf_subKeyNum(Ico_Uxf_conf_numkeys *keys, const int idx,
+                                   const char *suffix, const int num);
+void ico_uxf_conf_freeNumericalKeys(Ico_Uxf_conf_numkeys *keys);
+
+/* Prototyypes of compiled system configuration cache   */
+int ico_uxf_conf_loadCache(const char *cachefile, const struct stat *src,
+                           Ico_Uxf_Sys_Config *conf);
+int ico_uxf_conf_saveCache(const char *cachefile, const struct stat *src,
+                           const Ico_Uxf_Sys_Config *conf);
+void ico_uxf_conf_releaseCache(void);
+
+/* Prototyypes of retry of package events(timer is in main loop library)    */
+void ico_uxf_conf_setAppRetryCb(void (*retry)(void));
+int ico_uxf_conf_retryAppEvent(void);
+
+/* Prototyypes of live reload of system configuration   */
+int ico_uxf_conf_watchSysConfig(void (*notify)(void));
+int ico_uxf_conf_readSysWatch(void);
+Ico_Uxf_Sys_Config *ico_uxf_conf_publishSysConfig(void);
+void ico_uxf_conf_freeSysConfig(Ico_Uxf_Sys_Config *conf);
+void ico_uxf_conf_unwatchSysConfig(void);
 
 #ifdef __cplusplus
 }
@@ -35,6 +35,12 @@ extern "C" {
 #define ICO_UXF_CONFIG_SYSTEM   "system.conf"
 #define ICO_UXF_CONFIG_APPATTR  "app_attr.conf"
 
+/* Compiled cache of system configuration(same directory as system.conf)    */
+#define ICO_UXF_CONFIG_SYSCACHE ".system.conf.cache"
+
+/* Environment variable for disable of the compiled configuration cache     */
+#define ICO_UXF_CONFIG_NOCACHE_ENV  "UIFW_NOCONFCACHE"
+
 /* Directory of application manifest                        */
 #define ICO_UXF_CONFIG_APPSDIR  "apps"
 
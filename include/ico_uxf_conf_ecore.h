@@ -28,6 +28,7 @@ extern "C" {
 #endif
 
 int ico_uxf_econf_setAppUpdateCb(Ico_Uxf_AppUpdata_Cb func);
+int ico_uxf_econf_setSysUpdateCb(Ico_Uxf_SysUpdate_Cb func);
 
 /* define log macros    */
 #ifndef uifw_trace
@@ -55,6 +55,28 @@ extern "C" {
 #define ICO_UXF_POLICY_BLINKER_LEFT     5           /* Blinker is left              */
 #define ICO_UXF_POLICY_BLINKER_RIGHT    6           /* Blinker is right             */
 
+/* Regulation predicate(condition of policy, [regulation] of system.conf)   */
+#define ICO_UXF_REGULATION_RUNNING      0           /* Vehicle is running           */
+#define ICO_UXF_REGULATION_SHIFT_PARKING 1          /* Shift-position is park       */
+#define ICO_UXF_REGULATION_SHIFT_REVERSES 2         /* Shift-position is reverses   */
+#define ICO_UXF_REGULATION_BLINKER_LEFT 3           /* Blinker is left              */
+#define ICO_UXF_REGULATION_BLINKER_RIGHT 4          /* Blinker is right             */
+#define ICO_UXF_REGULATION_MAX          5           /* Number of predicates         */
+
+/* Vehicle signal of regulation predicate   */
+#define ICO_UXF_REGULATION_SIG_SPEED    0           /* Vehicle speed(km/h)          */
+#define ICO_UXF_REGULATION_SIG_SHIFT    1           /* Shift position               */
+#define ICO_UXF_REGULATION_SIG_BLINKER  2           /* Blinker                      */
+#define ICO_UXF_REGULATION_SIG_MAX      3           /* Number of signals            */
+
+/* Operator of regulation predicate         */
+#define ICO_UXF_REGULATION_OP_EQ        0           /* signal is one of values      */
+#define ICO_UXF_REGULATION_OP_NE        1           /* signal is none of values     */
+#define ICO_UXF_REGULATION_OP_GE        2           /* signal >= value              */
+#define ICO_UXF_REGULATION_OP_GT        3           /* signal > value               */
+#define ICO_UXF_REGULATION_OP_LE        4           /* signal <= value              */
+#define ICO_UXF_REGULATION_OP_LT        5           /* signal < value               */
+
 /* Privilege                                */
 #define ICO_UXF_PRIVILEGE_ALMIGHTY      0           /* almighty privilege           */
 #define ICO_UXF_PRIVILEGE_SYSTEM        1           /* system level                 */
@@ -85,6 +107,17 @@ extern "C" {
 #define ICO_UXF_PROCSTATUS_RUN      0x00000002      /* Running                      */
 #define ICO_UXF_PROCSTATUS_TERM     0x00000004      /* Terminating                  */
 
+/* Stage of application launch             */
+#define ICO_UXF_LAUNCH_ERROR        (-1)            /* Launch failed or dead        */
+#define ICO_UXF_LAUNCH_REQUEST      0               /* Launch requested             */
+#define ICO_UXF_LAUNCH_ACCEPTED     1               /* AUL accepted the launch      */
+#define ICO_UXF_LAUNCH_RUNNING      2               /* Process is running           */
+#define ICO_UXF_LAUNCH_SURFACE      3               /* First surface created        */
+#define ICO_UXF_LAUNCH_VISIBLE      4               /* First surface visible        */
+#define ICO_UXF_LAUNCH_STAGES       5               /* Number of stages             */
+#define ICO_UXF_LAUNCH_HISTOGRAM    10              /* Buckets of latency histogram */
+#define ICO_UXF_LAUNCH_HISTOBASE    25              /* First bucket of histogram(ms)*/
+
 /* Window controll hook code                */
 #define ICO_UXF_HOOK_WINDOW_CREATE_MAIN     0x00    /* created main window          */
 #define ICO_UXF_HOOK_WINDOW_CREATE_SUB      0x01    /* created sub window           */
@@ -126,6 +159,10 @@ extern int ico_uxf_misc_hashByName(const char *name);
 #define ICO_UXF_MISC_HASHBYID(v)        (v & (ICO_UXF_MISC_HASHSIZE-1))
 #define ICO_UXF_MISC_HASHBYNAME(name)   ico_uxf_misc_hashByName(name)
 
+/* Interned string(atom), same string has same address  */
+extern const char *ico_uxf_misc_intern(const char *str);
+extern const char *ico_uxf_misc_findIntern(const char *str);
+
 #ifdef __cplusplus
 }
 #endif
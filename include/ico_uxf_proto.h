@@ -34,7 +34,11 @@ int ico_uxf_callback_remove(const unsigned int mask,
                             Ico_Uxf_Event_Cb func, const int arg);
                                         /* Remove event callback function       */
 void ico_uxf_timer_wake(const int msec);
-                                        /* UX-FW timer                          */
+                                        /* UX-FW timer(run expired timers)      */
+int ico_uxf_timer_fd(void);
+                                        /* Get UX-FW housekeeping timer fd      */
+void ico_uxf_timer_stats(Ico_Uxf_Timer_Stats *stats);
+                                        /* Get lateness of housekeeping timer   */
 
 /* Control window                               */
 int ico_uxf_window_event_mask(const int window, const unsigned int mask);
@@ -99,12 +103,21 @@ int ico_uxf_input_control(const int add, const char *appid,
 /* Launcher API                                 */
 int ico_uxf_process_execute(const char *name);
                                         /* Start application                    */
+int ico_uxf_process_launch(const char *name, Ico_Uxf_Launch_Cb func,
+                           void *user_data);
+                                        /* Start application asynchronously    */
+int ico_uxf_process_launch_stats(const char *process, Ico_Uxf_LaunchStats *stats);
+                                        /* Get launch latency statistics        */
+int ico_uxf_process_launch_info(const char *process, Ico_Uxf_LaunchInfo *info);
+                                        /* Get stages of last launch            */
 int ico_uxf_process_terminate(const char *process);
                                         /* Stop application                     */
 int ico_uxf_process_attribute_get(const char *process, Ico_Uxf_ProcessAttr *attr);
                                         /* Get application status               */
 int ico_uxf_process_is_active(const char *process);
                                         /* Get application activity             */
+int ico_uxf_process_priority(const char *process, const int pid);
+                                        /* Get cached scheduling priority(nice) */
 void *ico_uxf_process_exttable_get(const char *process);
                                         /* Get extended table address           */
 int ico_uxf_process_exttable_set(const char *process, void *table);
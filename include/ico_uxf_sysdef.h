@@ -33,6 +33,7 @@ extern "C" {
 #define ICO_UXF_SOUND_ZONE_MAX      10      /* Maximum zone on sound in car         */
 #define ICO_UXF_INPUT_SW_MAX        50      /* Maximum input sw in car              */
 #define ICO_UXF_REGULATION_VIC_MAX  20      /* Maxumum vehicle info for regulation  */
+#define ICO_UXF_REGULATION_VALUE_MAX 4      /* Maximum values of regulation predicate*/
 
 /* Maximum length of string (with out last NULL)    */
 #define ICO_UXF_MAX_PROCESS_NAME    63      /* Maximum length of application name   */
@@ -141,6 +141,44 @@ typedef struct  _Ico_Uxf_ProcessAttr    {
     unsigned char       invisiblecpu;   /* cpu % at invisible                   */
 }   Ico_Uxf_ProcessAttr;
 
+/* Statistics of UX-FW housekeeping timer  */
+typedef struct  _Ico_Uxf_Timer_Stats    {
+    int                 expires;        /* number of timer expirations          */
+    int                 late10ms;       /* expirations later than 10ms          */
+    int                 latemax;        /* maximum lateness(us)                 */
+    int                 res;            /* (unused)                             */
+    long long           latetotal;      /* total lateness(us)                   */
+}   Ico_Uxf_Timer_Stats;
+
+/* Launch stages of application            */
+typedef struct  _Ico_Uxf_LaunchInfo {
+    int                 handle;         /* launch handle                        */
+    char                process[ICO_UXF_MAX_PROCESS_NAME+1];
+                                        /* Application ID                       */
+    int                 pid;            /* process Id(0=not running yet)        */
+    int                 stage;          /* notified stage(ICO_UXF_LAUNCH_xxx)   */
+    int                 result;         /* result(ICO_UXF_EOK or error code)    */
+    long long           time[ICO_UXF_LAUNCH_STAGES];
+                                        /* time of each stage                   */
+                                        /* (us of monotonic clock, 0=not reached)*/
+}   Ico_Uxf_LaunchInfo;
+
+/* Statistics of application launch latency */
+typedef struct  _Ico_Uxf_LaunchStats    {
+    int                 launches;       /* number of launch requests            */
+    int                 errors;         /* launch errors(include dead at launch)*/
+    int                 visibles;       /* launches reached first visible       */
+    int                 latmax;         /* maximum latency to first visible(ms) */
+    int                 histogram[ICO_UXF_LAUNCH_HISTOGRAM];
+                                        /* latency to first visible, bucket[i]  */
+                                        /* is less than HISTOBASE*2^i ms,       */
+                                        /* last bucket is over                  */
+    int                 stagecount[ICO_UXF_LAUNCH_STAGES];
+                                        /* number of launches reached the stage */
+    long long           stagetotal[ICO_UXF_LAUNCH_STAGES];
+                                        /* total time from request to stage(us) */
+}   Ico_Uxf_LaunchStats;
+
 /* Detail of event                          */
 typedef union  _Ico_Uxf_EventDetail    {
     int                 event;          /* Event number                         */
@@ -190,6 +228,9 @@ typedef void (*Ico_Uxf_Event_Cb)(const int event,
 /* Hook function                            */
 typedef void (*Ico_Uxf_Hook)(const char *appid, const int info1, const int info2);
 
+/* Launch stage callback function           */
+typedef void (*Ico_Uxf_Launch_Cb)(const Ico_Uxf_LaunchInfo *info, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
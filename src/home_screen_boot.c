@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   start up applications of homescreen at boot
+ *          (applications are launched from the main loop in parallel up to
+ *           configured concurrency, one launch slot is released when the
+ *           window of the application appeared)
+ *
+ * @date    Apr-04-2013
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "ico_uxf.h"
+#include "ico_uxf_conf_def.h"
+#include "home_screen.h"
+#include "home_screen_conf.h"
+
+/*============================================================================*/
+/* definition                                                                 */
+/*============================================================================*/
+#define HS_BOOT_WAIT            0           /* waiting for launch               */
+#define HS_BOOT_LAUNCHING       1           /* launching(window not appeared)   */
+#define HS_BOOT_DONE            2           /* window appeared                  */
+#define HS_BOOT_FAILED          3           /* launch failed                    */
+#define HS_BOOT_TIMEOUT         4           /* window did not appear in time    */
+
+typedef struct _hs_boot_app hs_boot_app_t;
+struct _hs_boot_app {
+    char appid[ICO_UXF_MAX_PROCESS_NAME+1];
+    int tile;                               /* tile application(1)/other(0)     */
+    int state;                              /* launch state                     */
+    int handle;                             /* launch handle(waiting without    */
+                                            /* callback)                        */
+    Ecore_Timer *timer;                     /* timeout of launch                */
+    Ecore_Timer *poll;                      /* check of window(waiting without  */
+                                            /* callback)                        */
+};
+
+/*============================================================================*/
+/* static(internal) functions prototype                                       */
+/*============================================================================*/
+static int hs_boot_now(void);
+static void hs_boot_end(hs_boot_app_t *app, int state);
+static Eina_Bool hs_boot_idler(void *data);
+static Eina_Bool hs_boot_timeout(void *data);
+static Eina_Bool hs_boot_poll(void *data);
+static int hs_boot_haswindow(const char *appid);
+static void hs_boot_launchcb(const Ico_Uxf_LaunchInfo *info, void *user_data);
+
+/*============================================================================*/
+/* variabe                                                                    */
+/*============================================================================*/
+static struct timespec hs_boot_start_time;  /* start time of HomeScreen         */
+static int hs_boot_concurrency = ICO_HS_BOOT_CONCURRENCY_DEFAULT;
+static int hs_boot_inflight = 0;            /* launching applications           */
+static int hs_boot_next = 0;                /* next application to launch       */
+static int hs_boot_appnum = 0;
+static hs_boot_app_t hs_boot_apps[ICO_HS_APP_NUM_MAX];
+static Ecore_Idler *hs_boot_idle = NULL;
+static hs_boot_stats_t hs_boot_stats;
+
+/*============================================================================*/
+/* functions                                                                  */
+/*============================================================================*/
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_init
+ *          start time measurement of boot and read configuration.
+ *
+ * @param       none
+ * @return      result
+ * @retval      ICO_HS_OK           success
+ */
+/*--------------------------------------------------------------------------*/
+int
+hs_boot_init(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &hs_boot_start_time);
+
+    hs_boot_concurrency = hs_conf_get_integer(ICO_HS_CONFIG_HOMESCREEN,
+                                              ICO_HS_CONFIG_BOOT_CONCURRENCY,
+                                              ICO_HS_BOOT_CONCURRENCY_DEFAULT);
+    if (hs_boot_concurrency <= 0) {
+        hs_boot_concurrency = 1;
+    }
+    hs_boot_inflight = 0;
+    hs_boot_next = 0;
+    hs_boot_appnum = 0;
+    memset(hs_boot_apps, 0, sizeof(hs_boot_apps));
+    memset(&hs_boot_stats, 0, sizeof(hs_boot_stats));
+    hs_boot_stats.firsttile = -1;
+    hs_boot_stats.alltiles = -1;
+
+    uifw_trace("hs_boot_init: concurrency=%d", hs_boot_concurrency);
+    return ICO_HS_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_add
+ *          add the application to launch at boot.
+ *
+ * @param[in]   appid               application id
+ * @param[in]   tile                tile application(1)/other(0)
+ * @return      result
+ * @retval      ICO_HS_OK           success
+ * @retval      ICO_HS_ERR          too many applications
+ */
+/*--------------------------------------------------------------------------*/
+int
+hs_boot_add(const char *appid, int tile)
+{
+    hs_boot_app_t *app;
+
+    if (hs_boot_appnum >= ICO_HS_APP_NUM_MAX) {
+        uifw_warn("hs_boot_add: Leave(too many applications)");
+        return ICO_HS_ERR;
+    }
+    app = &hs_boot_apps[hs_boot_appnum++];
+    memset(app, 0, sizeof(hs_boot_app_t));
+    strncpy(app->appid, appid, ICO_UXF_MAX_PROCESS_NAME);
+    app->tile = tile;
+    app->state = HS_BOOT_WAIT;
+    if (tile) {
+        hs_boot_stats.tiles++;
+    }
+    return ICO_HS_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_start
+ *          start launching added applications. applications are launched
+ *          from the main loop, so HomeScreen is drawn without waiting for
+ *          the launches.
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+hs_boot_start(void)
+{
+    uifw_trace("hs_boot_start: %d applications(%d tiles)",
+               hs_boot_appnum, hs_boot_stats.tiles);
+
+    if ((hs_boot_next < hs_boot_appnum) && (!hs_boot_idle)) {
+        hs_boot_idle = ecore_idler_add(hs_boot_idler, NULL);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_get_stats
+ *          get statistics of boot.
+ *
+ * @param[out]  stats               statistics
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+hs_boot_get_stats(hs_boot_stats_t *stats)
+{
+    memcpy(stats, &hs_boot_stats, sizeof(hs_boot_stats_t));
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_now
+ *          elapsed time from start of HomeScreen.
+ *
+ * @param       none
+ * @return      elapsed time(ms)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+hs_boot_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int)(((ts.tv_sec - hs_boot_start_time.tv_sec) * 1000)
+                 + ((ts.tv_nsec - hs_boot_start_time.tv_nsec) / 1000000));
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_end
+ *          end of launch of the application, release the launch slot.
+ *
+ * @param[in]   app                 boot application
+ * @param[in]   state               end state(HS_BOOT_DONE/FAILED/TIMEOUT)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+hs_boot_end(hs_boot_app_t *app, int state)
+{
+    int now;
+
+    if (app->state == HS_BOOT_LAUNCHING) {
+        hs_boot_inflight--;
+    }
+    if (app->timer) {
+        ecore_timer_del(app->timer);
+        app->timer = NULL;
+    }
+    if (app->poll) {
+        ecore_timer_del(app->poll);
+        app->poll = NULL;
+    }
+    app->state = state;
+    now = hs_boot_now();
+
+    if (state == HS_BOOT_DONE) {
+        hs_boot_stats.windows++;
+        if (app->tile) {
+            if (hs_boot_stats.firsttile < 0) {
+                hs_boot_stats.firsttile = now;
+            }
+        }
+    }
+    else if (state == HS_BOOT_TIMEOUT) {
+        hs_boot_stats.timeouts++;
+    }
+    else {
+        hs_boot_stats.failed++;
+    }
+    if (app->tile) {
+        hs_boot_stats.tilesend++;
+        if (hs_boot_stats.tilesend >= hs_boot_stats.tiles) {
+            hs_boot_stats.alltiles = now;
+            uifw_info("hs_boot_end: tiles=%d first=%dms all=%dms failed=%d "
+                      "timeouts=%d concurrency=%d", hs_boot_stats.tiles,
+                      hs_boot_stats.firsttile, hs_boot_stats.alltiles,
+                      hs_boot_stats.failed, hs_boot_stats.timeouts,
+                      hs_boot_concurrency);
+        }
+    }
+    uifw_trace("hs_boot_end: %s state=%d %dms", app->appid, state, now);
+
+    /* launch next application */
+    hs_boot_start();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_idler
+ *          launch one application at idle of the main loop.
+ *
+ * @param[in]   data                user data(unused)
+ * @return      result
+ * @retval      ECORE_CALLBACK_RENEW    more applications to launch
+ * @retval      ECORE_CALLBACK_CANCEL   no application or no launch slot
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+hs_boot_idler(void *data)
+{
+    hs_boot_app_t *app;
+    Ico_Uxf_LaunchInfo info;
+    int ret;
+    int idx;
+
+    if ((hs_boot_next >= hs_boot_appnum) ||
+        (hs_boot_inflight >= hs_boot_concurrency)) {
+        hs_boot_idle = NULL;
+        return ECORE_CALLBACK_CANCEL;
+    }
+
+    app = &hs_boot_apps[hs_boot_next++];
+    ret = ico_uxf_process_launch(app->appid, hs_boot_launchcb, app);
+    uifw_trace("hs_boot_idler: launch %s = %d(%dms)", app->appid, ret, hs_boot_now());
+    if (ret > 0) {
+        app->state = HS_BOOT_LAUNCHING;
+        hs_boot_inflight++;
+        app->timer = ecore_timer_add(ICO_HS_BOOT_TIMEOUT, hs_boot_timeout, app);
+    }
+    else if ((ret == ICO_UXF_EBUSY) && (hs_boot_haswindow(app->appid))) {
+        /* already running */
+        hs_boot_end(app, HS_BOOT_DONE);
+    }
+    else if (ret == ICO_UXF_EBUSY) {
+        /* running without window or launching without boot callback, */
+        /* wait for the window by checking stage of the launch        */
+        memset(&info, 0, sizeof(info));
+        (void) ico_uxf_process_launch_info(app->appid, &info);
+        uifw_trace("hs_boot_idler: %s has no window(handle=%d stage=%d)",
+                   app->appid, info.handle, info.stage);
+        app->handle = info.handle;
+        app->state = HS_BOOT_LAUNCHING;
+        hs_boot_inflight++;
+        app->timer = ecore_timer_add(ICO_HS_BOOT_TIMEOUT, hs_boot_timeout, app);
+        app->poll = ecore_timer_add(ICO_HS_BOOT_POLL, hs_boot_poll, app);
+    }
+    else {
+        uifw_warn("hs_boot_idler: launch %s error(%d)", app->appid, ret);
+        if (app->tile) {
+            /* free the tile of the application that could not launch */
+            idx = hs_tile_get_index_app(app->appid);
+            if (idx >= 0) {
+                hs_tile_free_app(idx);
+            }
+        }
+        hs_boot_end(app, HS_BOOT_FAILED);
+    }
+
+    if ((hs_boot_next >= hs_boot_appnum) ||
+        (hs_boot_inflight >= hs_boot_concurrency)) {
+        hs_boot_idle = NULL;
+        return ECORE_CALLBACK_CANCEL;
+    }
+    return ECORE_CALLBACK_RENEW;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_timeout
+ *          window of the application did not appear in time
+ *          (application without window), release the launch slot.
+ *
+ * @param[in]   data                boot application
+ * @return      result
+ * @retval      ECORE_CALLBACK_CANCEL
+ *                                  delete this handler
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+hs_boot_timeout(void *data)
+{
+    hs_boot_app_t *app = (hs_boot_app_t *)data;
+
+    uifw_trace("hs_boot_timeout: %s", app->appid);
+    app->timer = NULL;
+    if (app->state == HS_BOOT_LAUNCHING) {
+        hs_boot_end(app, HS_BOOT_TIMEOUT);
+    }
+    return ECORE_CALLBACK_CANCEL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_poll
+ *          check window of the application that is waited without boot
+ *          callback, end when the window appeared or the launch failed.
+ *
+ * @param[in]   data                boot application
+ * @return      result
+ * @retval      ECORE_CALLBACK_RENEW    window has not appeared
+ * @retval      ECORE_CALLBACK_CANCEL   end of wait
+ */
+/*--------------------------------------------------------------------------*/
+static Eina_Bool
+hs_boot_poll(void *data)
+{
+    hs_boot_app_t *app = (hs_boot_app_t *)data;
+    Ico_Uxf_LaunchInfo info;
+
+    if (app->state != HS_BOOT_LAUNCHING) {
+        app->poll = NULL;
+        return ECORE_CALLBACK_CANCEL;
+    }
+    if (hs_boot_haswindow(app->appid)) {
+        app->poll = NULL;
+        hs_boot_end(app, HS_BOOT_DONE);
+        return ECORE_CALLBACK_CANCEL;
+    }
+    memset(&info, 0, sizeof(info));
+    if ((ico_uxf_process_launch_info(app->appid, &info) == ICO_UXF_EOK) &&
+        (info.handle == app->handle) && (info.stage == ICO_UXF_LAUNCH_ERROR)) {
+        app->poll = NULL;
+        hs_boot_end(app, HS_BOOT_FAILED);
+        return ECORE_CALLBACK_CANCEL;
+    }
+    return ECORE_CALLBACK_RENEW;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_haswindow
+ *          check whether the application has created its main window.
+ *
+ * @param[in]   appid               application id
+ * @return      result
+ * @retval      1                   main window exists
+ * @retval      0                   no window
+ */
+/*--------------------------------------------------------------------------*/
+static int
+hs_boot_haswindow(const char *appid)
+{
+    Ico_Uxf_ProcessAttr attr;
+
+    if ((ico_uxf_process_attribute_get(appid, &attr) == ICO_UXF_EOK) &&
+        (attr.mainwin.window > 0)) {
+        return 1;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_boot_launchcb
+ *          callback at stage of boot launch.
+ *
+ * @param[in]   info                launch stages
+ * @param[in]   user_data           boot application
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+hs_boot_launchcb(const Ico_Uxf_LaunchInfo *info, void *user_data)
+{
+    hs_boot_app_t *app = (hs_boot_app_t *)user_data;
+
+    if (app->state != HS_BOOT_LAUNCHING) {
+        /* already timed out */
+        return;
+    }
+    if (info->stage == ICO_UXF_LAUNCH_SURFACE) {
+        hs_boot_end(app, HS_BOOT_DONE);
+    }
+    else if (info->stage == ICO_UXF_LAUNCH_ERROR) {
+        hs_boot_end(app, HS_BOOT_FAILED);
+    }
+}
@@ -93,6 +93,8 @@ static hs_lib_poll_t *hs_polls_free = NULL;
 static void hs_lib_handle_command(hs_lib_msg_t *msg);
 static void hs_lib_handle_application(hs_lib_msg_t *msg);
 static void hs_lib_handle_onscreen(hs_lib_msg_t *msg);
+static void hs_lib_show_app(const char *appid);
+static void hs_lib_launchcb(const Ico_Uxf_LaunchInfo *info, void *user_data);
 static hs_lib_msg_t *hs_lib_alloc_msg(char *data, int len);
 static void hs_lib_free_msg(hs_lib_msg_t *msg);
 static void hs_lib_free_handle(hs_lib_handle_t *handle);
@@ -502,6 +504,62 @@ hs_lib_handle_onscreen(hs_lib_msg_t *msg)
 
     uifw_trace("hs_lib_handle_onscreen: Leave");
 }
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_lib_show_app
+ *          set the application to tile and show the application screen.
+ *
+ * @param[in]   appid               application id
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+hs_lib_show_app(const char *appid)
+{
+    Ico_Uxf_ProcessAttr attr;
+    int ret;
+    int idx;
+
+    ret = ico_uxf_process_attribute_get(appid, &attr);
+    if ((ret >= 0) && (attr.status == ICO_UXF_PROCSTATUS_RUN)) {
+        idx = hs_tile_get_index_app(appid);
+        if (idx < 0) {
+            idx = hs_tile_get_minchange();
+        }
+        hs_tile_set_app(idx, appid);
+    }
+
+    /* show the application screen*/
+    hs_show_appscreen(appid);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_lib_launchcb
+ *          callback at stage of the application launch requested by
+ *          statusbar, show the application at creating its window.
+ *
+ * @param[in]   info                launch stages
+ * @param[in]   user_data           user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+hs_lib_launchcb(const Ico_Uxf_LaunchInfo *info, void *user_data)
+{
+    uifw_trace("hs_lib_launchcb: %s stage=%d", info->process, info->stage);
+
+    if ((info->stage == ICO_UXF_LAUNCH_SURFACE) ||
+        (info->stage == ICO_UXF_LAUNCH_ERROR)) {
+        hs_lib_show_app(info->process);
+    }
+    else if (info->stage == ICO_UXF_LAUNCH_VISIBLE) {
+        uifw_trace("hs_lib_launchcb: %s visible %d ms", info->process,
+                   (int)((info->time[ICO_UXF_LAUNCH_VISIBLE]
+                          - info->time[ICO_UXF_LAUNCH_REQUEST]) / 1000LL));
+    }
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   hs_lib_handle_statusbar
@@ -519,10 +577,7 @@ hs_lib_handle_statusbar(hs_lib_msg_t *msg)
     char tmp_buf[ICO_HS_MSG_SIZE];
     char *cmd;
     Ico_Uxf_ProcessWin wins[1];
-    Ico_Uxf_ProcessAttr attr;
     int ret;
-    int idx;
-    int cnt = 0;
 
     uifw_trace("hs_lib_handle_statusbar: Enter(%s)", msg->data);
 
@@ -558,45 +613,21 @@ hs_lib_handle_statusbar(hs_lib_msg_t *msg)
         /* show the application on the application screen */
         cmd = get_parsed_str(msg->data, tmp_buf, sizeof(tmp_buf), 1);
         if (cmd) {
-            /* wait for creating the application's window */
             memset(wins, 0, sizeof(wins));
-            while (wins[0].window <= 0) {
-                ret = ico_uxf_process_window_get(cmd, wins, 1);
-                if (ret > 0) {
-                    ret = ico_uxf_process_attribute_get(cmd, &attr);
-                    if (wins[0].window > 0) {
-                        break;
-                    }
-                    else if ((ret >= 0) && (attr.status != ICO_UXF_PROCSTATUS_RUN)) {
-                        /* launch the application */
-                        ret = ico_uxf_process_execute(cmd);
-                    }
-                }
-                else {
-                    /* unknown application */
-                    break;
-                }
-                usleep(10000);
-                ecore_main_loop_iterate();
-
-                if (cnt > 100) {
-                    break;
-                }
-                else {
-                    cnt++;
-                }
+            ret = ico_uxf_process_window_get(cmd, wins, 1);
+            if ((ret > 0) && (wins[0].window <= 0)) {
+                /* launch the application(or wait for launching by boot or */
+                /* pre-launch too), and show it at creating its window     */
+                ret = ico_uxf_process_launch(cmd, hs_lib_launchcb, NULL);
             }
-            ret = ico_uxf_process_attribute_get(cmd, &attr);
-            if ((ret >= 0) && (attr.status == ICO_UXF_PROCSTATUS_RUN)) {
-                idx = hs_tile_get_index_app(cmd);
-                if (idx < 0) {
-                    idx = hs_tile_get_minchange();
-                }
-                hs_tile_set_app(idx, cmd);
+            else {
+                ret = ICO_UXF_EOK;
+            }
+            if (ret <= 0) {
+                /* already created window, running without launch stages, */
+                /* unknown or can not launch                               */
+                hs_lib_show_app(cmd);
             }
-
-            /* show the application screen*/
-            hs_show_appscreen(cmd);
         }
         /* send "Receive OK" message to statusbar */
         send = hs_lib_alloc_msg("RECEIVE OK", strlen("RECEIVE OK"));
@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <pthread.h>
+#include <poll.h>
 #include <libwebsockets.h>
 
 #include "ico_apf.h"
@@ -41,6 +42,7 @@
 #define ICO_HS_WINDOW_TYPE_BG    (1)
 #define ICO_HS_WINDOW_TYPE_TOUCH (2)
 #define ICO_HS_TOUCH_TIME_OUT    (1.0) /* Long press for timer */
+#define ICO_HS_WAIT_SCREEN_TIME  (10)  /* wait time for screen size(ms) */
 typedef struct _hs_tile_info hs_tile_info_t;
 typedef struct _hs_tile_hide hs_tile_hide_t;
 
@@ -101,8 +103,7 @@ static void hs_touch_down_tile(void *data, Evas *evas, Evas_Object *obj, void *e
 static void hs_add_touch_listener(Evas *canvas_fg);
 static void hs_add_bg_image(Evas *canvas_bg);
 static void hs_terminate_all_app(void);
-static void hs_regulation_listener(const int appcategory,
-                                   const ico_apc_reguration_control_t control,
+static void hs_regulation_listener(const ico_apc_regulation_change_t *change,
                                    void *user_data);
 
 /*============================================================================*/
@@ -194,7 +195,12 @@ hs_uxf_event(int ev, Ico_Uxf_EventDetail dd, int arg)
             }
             else {
                 /* other normal application */
-                if (hs_is_special_app(winAttr.process) == FALSE) {
+                if ((hs_is_special_app(winAttr.process) == FALSE) &&
+                    (winAttr.subwindow == 0) &&
+                    (hs_prelaunch_newwindow(winAttr.process, dd.window.window) != 0)) {
+                    /* pre-launched application, keep hidden */
+                }
+                else if (hs_is_special_app(winAttr.process) == FALSE) {
                     if (hs_is_noicon_app(winAttr.process) != FALSE) {
                         hs_set_appscreen(winAttr.process);
                         if (hs_stat_touch == ICO_HS_TOUCH_IN_SHOW) {
@@ -217,6 +223,7 @@ hs_uxf_event(int ev, Ico_Uxf_EventDetail dd, int arg)
         uifw_trace("hs_uxf_event: ICO_UXF_EVENT_TERMPROCESS");
 
         if (strlen(dd.process.process) != 0) {
+            hs_prelaunch_terminated(dd.process.process);
             idx = hs_tile_get_index_app(dd.process.process);
             if (idx >= 0) {
                 hs_tile_free_app(idx);
@@ -260,7 +267,8 @@ hs_uxf_event(int ev, Ico_Uxf_EventDetail dd, int arg)
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   hs_ecore_uxf_eventfd
- *          callback function of wayland fd event that is used in UXF.
+ *          callback function of wayland fd and housekeeping timer fd
+ *          event that is used in UXF.
  *          if the fd has event, ecore call this function.
  *
  * @param[in]   data                user data
@@ -637,7 +645,7 @@ hs_show_appscreen(const char *appid)
 /**
  * @brief   hs_tile_start_apps
  *          launch the default application that indicated by configuration
- *          file.
+ *          file(launched in parallel after HomeScreen started main loop).
  *
  * @param       none
  * @return      none
@@ -660,7 +668,7 @@ hs_tile_start_apps(void)
         sprintf(cName, ICO_HS_CONFIG_TILE_APP"%d", idx);
         appName = hs_conf_get_string(ICO_HS_CONFIG_HOMESCREEN, cName, NULL);
         if ((appName != NULL) && (strcmp(appName, "none") != 0)) {
-            ret = ico_uxf_process_execute(appName);
+            ret = hs_boot_add(appName, 1);
             if (ret >= 0) {
                 uifw_trace("hs_tile_start_apps: execute tile[%d]=%s", idx, appName);
                 memset(tinfo->appid, 0, ICO_UXF_MAX_PROCESS_NAME + 1);
@@ -678,7 +686,7 @@ hs_tile_start_apps(void)
             if (! strcmp(hs_tile_info[idx2].appid, appConf->application[idx1].appid)) break;
         }
         if (idx2 >= hs_tile_cnt)    {
-            ret = ico_uxf_process_execute(appConf->application[idx1].appid);
+            ret = hs_boot_add(appConf->application[idx1].appid, 0);
             if (ret >= 0) {
                 uifw_trace("hs_tile_start_apps: execute no tile[%d]=%s",
                            idx, appConf->application[idx1].appid);
@@ -691,6 +699,9 @@ hs_tile_start_apps(void)
         }
     }
     hs_notile_cnt = idx - hs_tile_cnt;
+
+    /* launch applications in parallel from the main loop */
+    hs_boot_start();
 }
 
 /*--------------------------------------------------------------------------*/
@@ -717,6 +728,7 @@ hs_tile_init_info(void)
     int mSide, mTop;
     int colcnt, rowcnt, tilecnt, tilesize;
     int try = 0;
+    struct pollfd pfd;
     hs_tile_info_t *tinfo;
 
     /* count tile */
@@ -738,16 +750,19 @@ hs_tile_init_info(void)
     }
     memset(hs_tile_info, 0, sizeof(hs_tile_info_t) * (tilecnt + ICO_HS_NOTILE_APP_MAX));
 
-    /* get screen size */
+    /* get screen size(wait for wayland output event, not sleep) */
     ico_uxf_window_screen_size_get(&dispW, &dispH);
     while ((dispW < 0) || (dispH < 0)) {
-        ico_uxf_main_loop_iterate();
         try++;
         if (try > 10) {
             uifw_warn("hs_tile_init_info: Leave(cannot get screen size)");
             return ICO_HS_ERR;
         }
-        usleep(10000);
+        pfd.fd = ico_uxf_wl_display_fd();
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        (void) poll(&pfd, 1, ICO_HS_WAIT_SCREEN_TIME);
+        ico_uxf_main_loop_iterate();
         ico_uxf_window_screen_size_get(&dispW, &dispH);
     }
     width = dispW;
@@ -1123,10 +1138,13 @@ hs_tile_set_app(int idx, const char *appid)
 
     uifw_trace("hs_tile_set_app: Enter(idx=%d appid=%s)", idx, appid);
 
-    if ((idx < 0) && (idx >= hs_tile_cnt)) {
+    if ((idx < 0) || (idx >= hs_tile_cnt)) {
         return;
     }
 
+    /* learn use of the application for pre-launch */
+    hs_prelaunch_used(appid);
+
     /* check whether the app is same as tile one */
     tinfo = &hs_tile_info[idx];
     if (strcmp(tinfo->appid, appid) == 0) {
@@ -1912,22 +1930,27 @@ hs_input_control(const Ico_Uxf_conf_application *conf, const int inputsw)
 /**
  * @brief   hs_regulation_listener: change regulation callback(static function)
  *
- * @param[in]   appcategory     category Id
- * @param[in]   control         control(display/sound/input active/inactive)
+ * @param[in]   change          changed categorys and controls
+ *                              (display/sound/input active/inactive)
  * @param[in]   user_data       user data(unused)
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 static void
-hs_regulation_listener(const int appcategory,
-                       const ico_apc_reguration_control_t control, void *user_data)
+hs_regulation_listener(const ico_apc_regulation_change_t *change, void *user_data)
 {
-    if ((appcategory == hs_regulation_category) &&
-        (control.display != ICO_SYC_APC_REGULATION_NOCHANGE))   {
+    const ico_apc_reguration_control_t  *control;
+
+    if ((hs_regulation_category < 0) ||
+        ((change->changed & ICO_SYC_APC_CATEGORY_BIT(hs_regulation_category)) == 0))  {
+        return;
+    }
+    control = &change->control[hs_regulation_category];
+    if (control->display != ICO_SYC_APC_REGULATION_NOCHANGE)   {
         uifw_trace("hs_regulation_listener: Enter(category=%d disp=%d)",
-                   appcategory, control.display);
+                   hs_regulation_category, control->display);
 
-        if (control.display == ICO_SYC_APC_REGULATION_REGULATION)   {
+        if (control->display == ICO_SYC_APC_REGULATION_REGULATION)   {
             /* Invisible by reguration      */
             if (hs_regulation_visible)  {
                 hs_regulation_visible = 0;
@@ -1989,6 +2012,8 @@ main(int argc, char *argv[])
                                        ICO_HS_APPID_DEFAULT_ONS),
             ICO_UXF_MAX_PROCESS_NAME);
     hs_snd_init();
+    /* measure time to tile applications from here */
+    hs_boot_init();
 
     /* init for window mgr */
     ret = ico_uxf_init(hs_name_homescreen);
@@ -2038,6 +2063,12 @@ main(int argc, char *argv[])
     if (ret != ICO_SYC_EOK) {
         uifw_error("ico_syc_apc_init err=%d", ret);
     }
+    /* arbitrate requests of a main loop turn(ex. tile apps) at once */
+    ico_syc_apc_batch(hs_conf_get_integer(ICO_HS_CONFIG_HOMESCREEN,
+                                          ICO_HS_CONFIG_APC_BATCH, 1));
+
+    /* pre-launch of frequently used applications */
+    hs_prelaunch_init();
 
     /* start default tile apps */
     hs_tile_start_apps();
@@ -2049,6 +2080,12 @@ main(int argc, char *argv[])
     ecore_main_fd_handler_add(ico_uxf_wl_display_fd(), ECORE_FD_READ,
                               hs_ecore_uxf_eventfd, NULL, /* data */
                               NULL, NULL);
+    /* add callbacks for UX-FW timer(application suspend/resume)   */
+    if (ico_uxf_timer_fd() >= 0)    {
+        ecore_main_fd_handler_add(ico_uxf_timer_fd(), ECORE_FD_READ,
+                                  hs_ecore_uxf_eventfd, NULL, /* data */
+                                  NULL, NULL);
+    }
     ecore_main_loop_iterate();
     ico_uxf_main_loop_iterate();
 
@@ -2057,7 +2094,10 @@ main(int argc, char *argv[])
 
     /* initiailze regulation control    */
     hs_regulation_category = ico_uxf_getSysCategoryByName("CarSetting");
-    ico_syc_apc_regulation_listener(hs_regulation_listener, NULL);
+    if (hs_regulation_category >= 0)    {
+        ico_syc_apc_regulation_set_listener(hs_regulation_listener,
+                              ICO_SYC_APC_CATEGORY_BIT(hs_regulation_category), NULL);
+    }
 
     if (hs_regulation_visible)  {
         uifw_trace("main: no regulation");
@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   predictive pre-launch of applications of homescreen
+ *          (frequently and recently used applications are launched in
+ *           background under a memory budget, and kept hidden and suspended
+ *           until the user shows them)
+ *
+ * @date    Apr-04-2013
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+
+#include "ico_uxf.h"
+#include "ico_uxf_conf_def.h"
+#include "ico_syc_apc.h"
+#include "home_screen.h"
+#include "home_screen_conf.h"
+
+/*============================================================================*/
+/* definition                                                                 */
+/*============================================================================*/
+#define HS_PRELAUNCH_NONE       0           /* not pre-launched                 */
+#define HS_PRELAUNCH_LAUNCHING  1           /* launching in background          */
+#define HS_PRELAUNCH_HIDDEN     2           /* launched, hidden and suspended   */
+
+typedef struct _hs_prelaunch_app hs_prelaunch_app_t;
+struct _hs_prelaunch_app {
+    char appid[ICO_UXF_MAX_PROCESS_NAME+1];
+    int state;                              /* pre-launch state                 */
+    int failed;                             /* dead in background(not pre-launch*/
+                                            /* until next use)                  */
+    int memkb;                              /* last measured resident size(KB)  */
+    int launches;                           /* launches of UX-FW statistics     */
+    double score;                           /* use score(decayed by recency)    */
+    double last;                            /* time of last use(sec)            */
+};
+
+/*============================================================================*/
+/* static(internal) functions prototype                                       */
+/*============================================================================*/
+static double hs_prelaunch_now(void);
+static hs_prelaunch_app_t *hs_prelaunch_get_app(const char *appid, int create);
+static double hs_prelaunch_score(hs_prelaunch_app_t *app, double now);
+static int hs_prelaunch_memory(hs_prelaunch_app_t *app);
+static void hs_prelaunch_launchcb(const Ico_Uxf_LaunchInfo *info, void *user_data);
+
+/*============================================================================*/
+/* variabe                                                                    */
+/*============================================================================*/
+static int hs_prelaunch_num = -1;           /* max pre-launched apps(0=off)     */
+static int hs_prelaunch_budget = 0;         /* memory budget(KB)                */
+static int hs_prelaunch_pending = 0;        /* launching in background          */
+static int hs_prelaunch_appnum = 0;
+static hs_prelaunch_app_t hs_prelaunch_apps[ICO_HS_APP_NUM_MAX];
+static hs_prelaunch_stats_t hs_prelaunch_stats;
+
+/*============================================================================*/
+/* functions                                                                  */
+/*============================================================================*/
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_init
+ *          read configuration of pre-launch.
+ *
+ * @param       none
+ * @return      result
+ * @retval      ICO_HS_OK           success
+ */
+/*--------------------------------------------------------------------------*/
+int
+hs_prelaunch_init(void)
+{
+    hs_prelaunch_num = hs_conf_get_integer(ICO_HS_CONFIG_HOMESCREEN,
+                                           ICO_HS_CONFIG_PRELAUNCH_NUM, 0);
+    hs_prelaunch_budget = hs_conf_get_integer(ICO_HS_CONFIG_HOMESCREEN,
+                                              ICO_HS_CONFIG_PRELAUNCH_MEMORY,
+                                              ICO_HS_PRELAUNCH_MEMORY_DEFAULT);
+    hs_prelaunch_pending = 0;
+    hs_prelaunch_appnum = 0;
+    memset(hs_prelaunch_apps, 0, sizeof(hs_prelaunch_apps));
+    memset(&hs_prelaunch_stats, 0, sizeof(hs_prelaunch_stats));
+
+    uifw_trace("hs_prelaunch_init: num=%d memory=%dKB",
+               hs_prelaunch_num, hs_prelaunch_budget);
+    return ICO_HS_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_used
+ *          learn that the user used the application(set to the tile).
+ *          if the application was pre-launched, it is counted as a hit,
+ *          if it was launched just now, it is counted as a miss.
+ *
+ * @param[in]   appid               application id
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+hs_prelaunch_used(const char *appid)
+{
+    hs_prelaunch_app_t *app;
+    Ico_Uxf_LaunchStats stats;
+    double now;
+
+    if (hs_prelaunch_num <= 0) {
+        return;
+    }
+    app = hs_prelaunch_get_app(appid, 1);
+    if (!app) {
+        return;
+    }
+
+    now = hs_prelaunch_now();
+    app->score = hs_prelaunch_score(app, now) + 1.0;
+    app->last = now;
+    app->failed = 0;
+    hs_prelaunch_stats.uses++;
+
+    memset(&stats, 0, sizeof(stats));
+    (void) ico_uxf_process_launch_stats(appid, &stats);
+    if (app->state != HS_PRELAUNCH_NONE) {
+        /* pre-launched application, now it is user's application */
+        hs_prelaunch_stats.hits++;
+        if (app->state == HS_PRELAUNCH_LAUNCHING) {
+            hs_prelaunch_pending = 0;
+        }
+        app->state = HS_PRELAUNCH_NONE;
+        /* AppsController requests display of the window */
+        (void) ico_syc_apc_prelaunch(appid, ICO_SYC_APC_PRELAUNCH_END);
+    }
+    else if (stats.launches > app->launches) {
+        /* cold launch by the user */
+        hs_prelaunch_stats.misses++;
+    }
+    app->launches = stats.launches;
+
+    uifw_info("hs_prelaunch_used: %s score=%.2f uses=%d hits=%d misses=%d "
+              "hitrate=%d%% memory=%dKB(max %dKB)", appid, app->score,
+              hs_prelaunch_stats.uses, hs_prelaunch_stats.hits,
+              hs_prelaunch_stats.misses,
+              (hs_prelaunch_stats.hits + hs_prelaunch_stats.misses) > 0 ?
+                hs_prelaunch_stats.hits * 100 /
+                    (hs_prelaunch_stats.hits + hs_prelaunch_stats.misses) : 0,
+              hs_prelaunch_stats.memory, hs_prelaunch_stats.memorymax);
+
+    hs_prelaunch_update();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_update
+ *          select top score applications under the memory budget,
+ *          terminate pre-launched applications out of selection, and
+ *          launch one selected application in background.
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+hs_prelaunch_update(void)
+{
+    Ico_Uxf_ProcessAttr attr;
+    Ico_Uxf_LaunchStats stats;
+    hs_prelaunch_app_t *app;
+    hs_prelaunch_app_t *launch = NULL;
+    char select[ICO_HS_APP_NUM_MAX];
+    double now;
+    double score;
+    double appscore;
+    int ii, idx;
+    int cnt = 0;
+    int memory = 0;
+    int memkb;
+    int ret;
+
+    if (hs_prelaunch_num <= 0) {
+        return;
+    }
+
+    /* select applications in order of score */
+    now = hs_prelaunch_now();
+    memset(select, 0, sizeof(select));
+    while (cnt < hs_prelaunch_num) {
+        idx = -1;
+        score = ICO_HS_PRELAUNCH_MINSCORE;
+        for (ii = 0; ii < hs_prelaunch_appnum; ii++) {
+            app = &hs_prelaunch_apps[ii];
+            if ((select[ii] != 0) || (app->failed != 0)) {
+                continue;
+            }
+            if (app->state == HS_PRELAUNCH_NONE) {
+                /* running by the user, no need to pre-launch */
+                ret = ico_uxf_process_attribute_get(app->appid, &attr);
+                if ((ret < 0) || (attr.status != ICO_UXF_PROCSTATUS_STOP)) {
+                    select[ii] = 2;
+                    continue;
+                }
+            }
+            /* pre-launched application is kept against near score  */
+            appscore = hs_prelaunch_score(app, now);
+            if (app->state != HS_PRELAUNCH_NONE) {
+                appscore += ICO_HS_PRELAUNCH_KEEPSCORE;
+            }
+            if (appscore >= score) {
+                idx = ii;
+                score = appscore;
+            }
+        }
+        if (idx < 0) {
+            break;
+        }
+        app = &hs_prelaunch_apps[idx];
+        memkb = hs_prelaunch_memory(app);
+        if ((memory + memkb) > hs_prelaunch_budget) {
+            /* over the memory budget, not selected */
+            select[idx] = 2;
+            continue;
+        }
+        select[idx] = 1;
+        memory += memkb;
+        cnt++;
+        if ((app->state == HS_PRELAUNCH_NONE) && (!launch)) {
+            launch = app;
+        }
+    }
+
+    /* terminate pre-launched applications not selected */
+    for (ii = 0; ii < hs_prelaunch_appnum; ii++) {
+        app = &hs_prelaunch_apps[ii];
+        if ((app->state != HS_PRELAUNCH_NONE) && (select[ii] != 1)) {
+            uifw_trace("hs_prelaunch_update: evict %s", app->appid);
+            if (app->state == HS_PRELAUNCH_LAUNCHING) {
+                hs_prelaunch_pending = 0;
+            }
+            app->state = HS_PRELAUNCH_NONE;
+            (void) ico_syc_apc_prelaunch(app->appid, ICO_SYC_APC_PRELAUNCH_CANCEL);
+            (void) ico_uxf_process_terminate(app->appid);
+            hs_prelaunch_stats.evictions++;
+        }
+    }
+
+    hs_prelaunch_stats.apps = 0;
+    hs_prelaunch_stats.memory = 0;
+    for (ii = 0; ii < hs_prelaunch_appnum; ii++) {
+        app = &hs_prelaunch_apps[ii];
+        if (app->state != HS_PRELAUNCH_NONE) {
+            hs_prelaunch_stats.apps++;
+            hs_prelaunch_stats.memory += hs_prelaunch_memory(app);
+        }
+    }
+    if (hs_prelaunch_stats.memory > hs_prelaunch_stats.memorymax) {
+        hs_prelaunch_stats.memorymax = hs_prelaunch_stats.memory;
+    }
+
+    /* launch one application at a time, next is launched at its surface */
+    if ((launch) && (hs_prelaunch_pending == 0)) {
+        /* AppsController holds display request of the window */
+        (void) ico_syc_apc_prelaunch(launch->appid, ICO_SYC_APC_PRELAUNCH_START);
+        ret = ico_uxf_process_launch(launch->appid, hs_prelaunch_launchcb, NULL);
+        uifw_trace("hs_prelaunch_update: launch %s(score=%.2f) = %d",
+                   launch->appid, launch->score, ret);
+        if (ret <= 0) {
+            (void) ico_syc_apc_prelaunch(launch->appid, ICO_SYC_APC_PRELAUNCH_CANCEL);
+        }
+        else {
+            launch->state = HS_PRELAUNCH_LAUNCHING;
+            hs_prelaunch_pending = 1;
+            hs_prelaunch_stats.launches++;
+            hs_prelaunch_stats.apps++;
+            hs_prelaunch_stats.memory += hs_prelaunch_memory(launch);
+            if (hs_prelaunch_stats.memory > hs_prelaunch_stats.memorymax) {
+                hs_prelaunch_stats.memorymax = hs_prelaunch_stats.memory;
+            }
+            /* own launch is not a cold launch of the user */
+            if (ico_uxf_process_launch_stats(launch->appid, &stats) == ICO_UXF_EOK) {
+                launch->launches = stats.launches;
+            }
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_newwindow
+ *          hide the created window of the pre-launched application.
+ *          (AppsController does not request display of the window until
+ *           hs_prelaunch_used, the hidden application is suspended by UX-FW,
+ *           and it is resumed when the window is shown)
+ *
+ * @param[in]   appid               application id
+ * @param[in]   window              created window
+ * @return      result
+ * @retval      1                   pre-launched application(window hidden)
+ * @retval      0                   other application
+ */
+/*--------------------------------------------------------------------------*/
+int
+hs_prelaunch_newwindow(const char *appid, const int window)
+{
+    hs_prelaunch_app_t *app;
+
+    app = hs_prelaunch_get_app(appid, 0);
+    if ((!app) || (app->state == HS_PRELAUNCH_NONE)) {
+        return 0;
+    }
+    uifw_trace("hs_prelaunch_newwindow: hide %s(%08x)", appid, window);
+    ico_uxf_window_hide(window);
+    return 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_terminated
+ *          the application terminated. pre-launched application that dead
+ *          in background is not pre-launched again until next use.
+ *
+ * @param[in]   appid               application id
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+hs_prelaunch_terminated(const char *appid)
+{
+    hs_prelaunch_app_t *app;
+
+    app = hs_prelaunch_get_app(appid, 0);
+    if ((!app) || (app->state == HS_PRELAUNCH_NONE)) {
+        return;
+    }
+    uifw_trace("hs_prelaunch_terminated: %s", appid);
+    if (app->state == HS_PRELAUNCH_LAUNCHING) {
+        hs_prelaunch_pending = 0;
+    }
+    app->state = HS_PRELAUNCH_NONE;
+    (void) ico_syc_apc_prelaunch(appid, ICO_SYC_APC_PRELAUNCH_CANCEL);
+    app->failed = 1;
+    hs_prelaunch_update();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_get_stats
+ *          get statistics of pre-launch.
+ *
+ * @param[out]  stats               statistics
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+void
+hs_prelaunch_get_stats(hs_prelaunch_stats_t *stats)
+{
+    memcpy(stats, &hs_prelaunch_stats, sizeof(hs_prelaunch_stats_t));
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_now
+ *          current monotonic time.
+ *
+ * @param       none
+ * @return      current time(sec)
+ */
+/*--------------------------------------------------------------------------*/
+static double
+hs_prelaunch_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1000000000.0);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_get_app
+ *          get pre-launch information of the application.
+ *
+ * @param[in]   appid               application id
+ * @param[in]   create              create if not exist(1)/not create(0)
+ * @return      pre-launch information
+ * @retval      !=NULL              success
+ * @retval      NULL                not exist or table overflow
+ */
+/*--------------------------------------------------------------------------*/
+static hs_prelaunch_app_t *
+hs_prelaunch_get_app(const char *appid, int create)
+{
+    hs_prelaunch_app_t *app;
+    int ii;
+
+    for (ii = 0; ii < hs_prelaunch_appnum; ii++) {
+        if (strncmp(hs_prelaunch_apps[ii].appid, appid,
+                    ICO_UXF_MAX_PROCESS_NAME) == 0) {
+            return &hs_prelaunch_apps[ii];
+        }
+    }
+    if ((create == 0) || (hs_prelaunch_appnum >= ICO_HS_APP_NUM_MAX)) {
+        return NULL;
+    }
+    app = &hs_prelaunch_apps[hs_prelaunch_appnum++];
+    memset(app, 0, sizeof(hs_prelaunch_app_t));
+    strncpy(app->appid, appid, ICO_UXF_MAX_PROCESS_NAME);
+    return app;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_score
+ *          use score of the application at the time.
+ *          (each use adds 1.0, the score halves every half-life)
+ *
+ * @param[in]   app                 pre-launch information
+ * @param[in]   now                 current time(sec)
+ * @return      score
+ */
+/*--------------------------------------------------------------------------*/
+static double
+hs_prelaunch_score(hs_prelaunch_app_t *app, double now)
+{
+    if (app->score <= 0.0) {
+        return 0.0;
+    }
+    return app->score * pow(0.5, (now - app->last) / ICO_HS_PRELAUNCH_HALFLIFE);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_memory
+ *          memory cost of the application. resident size is measured while
+ *          it is running, otherwise last measured or default size is used.
+ *
+ * @param[in]   app                 pre-launch information
+ * @return      memory cost(KB)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+hs_prelaunch_memory(hs_prelaunch_app_t *app)
+{
+    Ico_Uxf_ProcessAttr attr;
+    FILE *fp;
+    char path[64];
+    long size;
+    long resident;
+
+    if ((ico_uxf_process_attribute_get(app->appid, &attr) >= 0) &&
+        (attr.status == ICO_UXF_PROCSTATUS_RUN) && (attr.internalid > 0)) {
+        snprintf(path, sizeof(path), "/proc/%d/statm", attr.internalid);
+        fp = fopen(path, "r");
+        if (fp) {
+            if (fscanf(fp, "%ld %ld", &size, &resident) == 2) {
+                app->memkb = (int)(resident * (sysconf(_SC_PAGESIZE) / 1024));
+            }
+            fclose(fp);
+        }
+    }
+    if (app->memkb <= 0) {
+        return ICO_HS_PRELAUNCH_APPMEMORY;
+    }
+    return app->memkb;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hs_prelaunch_launchcb
+ *          callback at stage of background launch, launch next application
+ *          when the surface of launched application was created.
+ *
+ * @param[in]   info                launch stages
+ * @param[in]   user_data           user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+hs_prelaunch_launchcb(const Ico_Uxf_LaunchInfo *info, void *user_data)
+{
+    hs_prelaunch_app_t *app;
+
+    if ((info->stage != ICO_UXF_LAUNCH_SURFACE) &&
+        (info->stage != ICO_UXF_LAUNCH_ERROR)) {
+        return;
+    }
+    app = hs_prelaunch_get_app(info->process, 0);
+    if ((!app) || (app->state != HS_PRELAUNCH_LAUNCHING)) {
+        /* already used by the user or evicted */
+        return;
+    }
+    uifw_trace("hs_prelaunch_launchcb: %s stage=%d", info->process, info->stage);
+
+    hs_prelaunch_pending = 0;
+    if (info->stage == ICO_UXF_LAUNCH_SURFACE) {
+        app->state = HS_PRELAUNCH_HIDDEN;
+    }
+    else {
+        app->state = HS_PRELAUNCH_NONE;
+        app->failed = 1;
+        (void) ico_syc_apc_prelaunch(info->process, ICO_SYC_APC_PRELAUNCH_CANCEL);
+    }
+    hs_prelaunch_update();
+}
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2013, TOYOTA MOTOR CORPORATION.
+ *
+ * This program is licensed under the terms and conditions of the
+ * Apache License, version 2.0.  The full text of the Apache License is at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ */
+/**
+ * @brief   tool that decodes binary trace files to text log
+ *          (output is same as the text log file, the trace file can be
+ *           decoded on the host, the format is in ico_apf_trace.h)
+ *
+ * @date    Feb-28-2013
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ico_apf_log.h"
+#include "ico_apf_trace.h"
+
+/*============================================================================*/
+/* Define fixed parameters                                                    */
+/*============================================================================*/
+#define DECODE_MAXSITES 0x100000            /* maximum call site id             */
+
+/*============================================================================*/
+/* Define data types                                                          */
+/*============================================================================*/
+/* call site in trace file      */
+typedef struct _decode_site {
+    const char *level;
+    const char *func;
+    const char *file;
+    const char *fmt;
+    int line;
+    int defined;
+    unsigned int id;
+    unsigned long count;                    /* number of messages               */
+} decode_site_t;
+
+/*============================================================================*/
+/* static(internal) functions prototype                                       */
+/*============================================================================*/
+static char *decode_read(const char *path, long *size);
+static decode_site_t *decode_site(const unsigned int id);
+static const char *decode_string(const char *str, const char *end);
+static int decode_file(const char *path);
+static int decode_compare(const void *a, const void *b);
+static void decode_usage(const char *prog);
+
+/*============================================================================*/
+/* variabe & table                                                            */
+/*============================================================================*/
+static decode_site_t *decode_sites = NULL;
+static unsigned int decode_sitenum = 0;
+static int decode_count = 0;                /* print count of each call site    */
+static const char decode_dropfmt[] = "%u log messages dropped(total %u)\n";
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   decode_read
+ *          read a trace file to memory.
+ *
+ * @param[in]   path        trace file name
+ * @param[out]  size        size of trace file
+ * @return      trace file image
+ * @retval      NULL        can not read
+ */
+/*--------------------------------------------------------------------------*/
+static char *
+decode_read(const char *path, long *size)
+{
+    FILE *fp;
+    char *image;
+
+    fp = fopen(path, "rb");
+    if (! fp) {
+        return NULL;
+    }
+    if ((fseek(fp, 0, SEEK_END) != 0) || ((*size = ftell(fp)) < 0) ||
+        (fseek(fp, 0, SEEK_SET) != 0)) {
+        fclose(fp);
+        return NULL;
+    }
+    image = malloc(*size + 1);
+    if ((image) && (fread(image, 1, *size, fp) != (size_t)*size)) {
+        free(image);
+        image = NULL;
+    }
+    if (image) {
+        image[*size] = 0;
+    }
+    fclose(fp);
+    return image;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   decode_site
+ *          get the call site of id(call sites are created if not exist).
+ *
+ * @param[in]   id          call site id
+ * @return      call site
+ */
+/*--------------------------------------------------------------------------*/
+static decode_site_t *
+decode_site(const unsigned int id)
+{
+    unsigned int num;
+
+    if (id >= decode_sitenum) {
+        num = (id + 256) & (~255);
+        decode_sites = realloc(decode_sites, num * sizeof(decode_site_t));
+        if (! decode_sites) {
+            fprintf(stderr, "ico_decode_trace: no memory\n");
+            exit(1);
+        }
+        memset(&decode_sites[decode_sitenum], 0,
+               (num - decode_sitenum) * sizeof(decode_site_t));
+        decode_sitenum = num;
+    }
+    decode_sites[id].id = id;
+    return &decode_sites[id];
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   decode_string
+ *          check a string in a record.
+ *
+ * @param[in]   str         string(NULL: previous string was illegal)
+ * @param[in]   end         end of the record
+ * @return      next of the string
+ * @retval      NULL        not terminated in the record
+ */
+/*--------------------------------------------------------------------------*/
+static const char *
+decode_string(const char *str, const char *end)
+{
+    const char *p;
+
+    if ((! str) || (str >= end)) {
+        return NULL;
+    }
+    p = memchr(str, 0, end - str);
+    return p ? (p + 1) : NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   decode_file
+ *          decode a trace file and print text log.
+ *
+ * @param[in]   path        trace file name
+ * @return      result
+ * @retval      0           success
+ * @retval      -1          error(illegal trace file)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+decode_file(const char *path)
+{
+    const ico_apf_trace_head_t *head;
+    const ico_apf_trace_rec_t *rec;
+    const ico_apf_trace_site_t *def;
+    const ico_apf_trace_msg_t *msg;
+    decode_site_t *site;
+    ico_apf_trace_info_t info;
+    int64_t arg[2];
+    char line[ICO_APF_LOG_LINESIZE];
+    const char *level;
+    const char *func;
+    const char *file;
+    const char *fmt;
+    const char *end;
+    char *image;
+    long size;
+    long pos;
+    unsigned int i;
+    int broken;
+
+    image = decode_read(path, &size);
+    if (! image) {
+        fprintf(stderr, "ico_decode_trace: %s can not read\n", path);
+        return -1;
+    }
+    head = (const ico_apf_trace_head_t *)image;
+    if ((size < (long)sizeof(ico_apf_trace_head_t)) ||
+        (memcmp(head->magic, ICO_APF_TRACE_MAGIC, sizeof(head->magic)) != 0) ||
+        (head->version != ICO_APF_TRACE_VERSION)) {
+        fprintf(stderr, "ico_decode_trace: %s is not a trace file\n", path);
+        free(image);
+        return -1;
+    }
+    if (head->endian != ICO_APF_TRACE_ENDIAN) {
+        fprintf(stderr, "ico_decode_trace: %s byte order differs\n", path);
+        free(image);
+        return -1;
+    }
+
+    /* call site definitions are in each file */
+    for (i = 0; i < decode_sitenum; i++) {
+        decode_sites[i].defined = 0;
+    }
+
+    memset(&info, 0, sizeof(info));
+    info.pid = head->pid;
+    info.timezone = head->timezone;
+    info.longsize = head->longsize;
+
+    for (pos = sizeof(ico_apf_trace_head_t);
+         pos + (long)sizeof(ico_apf_trace_rec_t) <= size; pos += rec->size) {
+        rec = (const ico_apf_trace_rec_t *)(image + pos);
+        if ((rec->size < sizeof(ico_apf_trace_rec_t)) ||
+            ((rec->size % ICO_APF_TRACE_ALIGN) != 0) || (pos + rec->size > size)) {
+            /* the last record was not written(writer was terminated) */
+            fprintf(stderr, "ico_decode_trace: %s broken at %ld\n", path, pos);
+            break;
+        }
+        info.time = (int64_t)((uint64_t)rec->time + (uint64_t)head->basetime);
+        end = (const char *)rec + rec->size;
+        broken = 0;
+
+        switch (rec->type) {
+        case ICO_APF_TRACE_SITE:
+            def = (const ico_apf_trace_site_t *)rec;
+            if ((rec->size < sizeof(ico_apf_trace_site_t)) || (rec->id >= DECODE_MAXSITES)) {
+                broken = 1;
+                break;
+            }
+            /* all strings must be terminated in the record */
+            level = (const char *)(def + 1);
+            func = decode_string(level, end);
+            file = decode_string(func, end);
+            fmt = decode_string(file, end);
+            if (! decode_string(fmt, end)) {
+                broken = 1;
+                break;
+            }
+            site = decode_site(rec->id);
+            site->level = level;
+            site->func = func;
+            site->file = file;
+            site->fmt = fmt;
+            site->line = def->line;
+            site->defined = 1;
+            break;
+        case ICO_APF_TRACE_MSG:
+            msg = (const ico_apf_trace_msg_t *)rec;
+            if ((rec->size < sizeof(ico_apf_trace_msg_t)) || (rec->id >= DECODE_MAXSITES) ||
+                (msg->nargs > ICO_APF_LOG_MAXARGS) ||
+                (sizeof(ico_apf_trace_msg_t) + (msg->nargs * sizeof(int64_t)) +
+                 msg->strsize > rec->size)) {
+                broken = 1;
+                break;
+            }
+            info.str = (const char *)(msg + 1) + (msg->nargs * sizeof(int64_t));
+            if ((msg->strsize > 0) && (info.str[msg->strsize - 1] != 0)) {
+                /* last string is not terminated */
+                broken = 1;
+                break;
+            }
+            site = decode_site(rec->id);
+            if (! site->defined) {
+                printf("<unknown call site %u>\n", rec->id);
+                break;
+            }
+            site->count++;
+            info.level = site->level;
+            info.fmt = site->fmt;
+            info.func = site->func;
+            info.file = site->file;
+            info.line = site->line;
+            info.nargs = msg->nargs;
+            info.arg = msg + 1;
+            info.strsize = msg->strsize;
+            ico_apf_trace_format(line, sizeof(line), &info);
+            fputs(line, stdout);
+            break;
+        case ICO_APF_TRACE_TEXT:
+            if (! decode_string((const char *)(rec + 1), end)) {
+                broken = 1;
+                break;
+            }
+            fputs((const char *)(rec + 1), stdout);
+            break;
+        case ICO_APF_TRACE_DROP:
+            if (rec->size < sizeof(ico_apf_trace_rec_t) + sizeof(uint32_t)) {
+                broken = 1;
+                break;
+            }
+            arg[0] = rec->id;
+            arg[1] = *((const uint32_t *)(rec + 1));
+            info.level = "WRN";
+            info.fmt = decode_dropfmt;
+            info.func = NULL;
+            info.nargs = 2;
+            info.arg = arg;
+            info.str = NULL;
+            info.strsize = 0;
+            ico_apf_trace_format(line, sizeof(line), &info);
+            fputs(line, stdout);
+            break;
+        default:
+            /* unknown record, skip */
+            break;
+        }
+        if (broken) {
+            /* illegal record, skip */
+            fprintf(stderr, "ico_decode_trace: %s broken at %ld\n", path, pos);
+        }
+    }
+    /* strings of call sites are in this image */
+    if (decode_count) {
+        for (i = 0; i < decode_sitenum; i++) {
+            if (decode_sites[i].defined) {
+                decode_sites[i].level = strdup(decode_sites[i].level);
+                decode_sites[i].func = strdup(decode_sites[i].func);
+                decode_sites[i].file = strdup(decode_sites[i].file);
+                decode_sites[i].fmt = NULL;
+            }
+        }
+    }
+    free(image);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   decode_compare
+ *          compare count of call sites(for qsort, descending order).
+ *
+ * @param[in]   a           call site
+ * @param[in]   b           call site
+ * @return      compare result
+ */
+/*--------------------------------------------------------------------------*/
+static int
+decode_compare(const void *a, const void *b)
+{
+    const decode_site_t *sa = (const decode_site_t *)a;
+    const decode_site_t *sb = (const decode_site_t *)b;
+
+    if (sa->count == sb->count) {
+        return (int)sa->id - (int)sb->id;
+    }
+    return (sa->count < sb->count) ? 1 : -1;
+}
+
+static void
+decode_usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-c] tracefile...\n"
+                    "       -c: print number of messages of each call site\n", prog);
+    exit(1);
+}
+
+/*--------------------------------------------------------------------------*/
+/*
+ * @brief   decode binary trace files
+ *          trace files are decoded in order of arguments
+ *          (give older file first, ex. prog.trc2 prog.trc1 prog.trc)
+ *
+ * @param   main() finction's standard parameter (argc,argv)
+ * @return  result
+ * @retval  0       success
+ * @retval  1       failed
+ */
+/*--------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    int ret = 0;
+    int files = 0;
+    unsigned int i;
+    int n;
+
+    for (n = 1; n < argc; n++) {
+        if (strcmp(argv[n], "-c") == 0) {
+            decode_count = 1;
+        }
+        else if (argv[n][0] == '-') {
+            decode_usage(argv[0]);
+        }
+    }
+    for (n = 1; n < argc; n++) {
+        if (argv[n][0] == '-') {
+            continue;
+        }
+        files++;
+        if (decode_file(argv[n]) != 0) {
+            ret = 1;
+        }
+    }
+    if (files <= 0) {
+        decode_usage(argv[0]);
+    }
+
+    if ((decode_count) && (decode_sitenum > 0)) {
+        qsort(decode_sites, decode_sitenum, sizeof(decode_site_t), decode_compare);
+        printf("\n%10s %-3s %s\n", "count", "lvl", "call site");
+        for (i = 0; i < decode_sitenum; i++) {
+            if (decode_sites[i].count == 0) {
+                break;
+            }
+            printf("%10lu %-3s %s,%s:%d\n", decode_sites[i].count,
+                   decode_sites[i].level, decode_sites[i].func,
+                   decode_sites[i].file, decode_sites[i].line);
+        }
+    }
+    return ret;
+}